@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V1.0.0
+ * $Revision:   V1.1.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       Controller Area Network (CAN) driver validation 
@@ -62,6 +62,84 @@
 // <o> Transfer timeout
 // <i> Set the transfer timeout (us)
 #define CAN_TRANSFER_TIMEOUT            1000000
+// <h> Bit timing
+// <i> Settings for the bit timing solver used by all tests
+// <o> Nominal sample point <500-950>
+// <i> Set the nominal phase sample point (1/1000 of bit time)
+#define CAN_SAMPLE_POINT                875
+// <o> FD data phase sample point <500-950>
+// <i> Set the CAN FD data phase sample point (1/1000 of bit time)
+#define CAN_SAMPLE_POINT_FD             750
+// <o> Maximum bitrate error <0-20000>
+// <i> Set the maximum deviation of the set bitrate from the configured bitrate (ppm)
+#define CAN_BITRATE_ERR_MAX             5000
+// </h>
+// <h> Bus load benchmark
+// <i> Settings for the CAN_Loopback_BusLoad and CAN_Loopback_BusLoadFD tests
+// <o> Number of frames <1-100000>
+// <i> Set the number of frames sent at each bitrate
+#define CAN_BUS_LOAD_FRAMES             1000
+// <o> Minimum bus load (%) <0-100>
+// <i> Set the bus load below which a warning is reported
+#define CAN_BUS_LOAD_MIN                90
+// </h>
+// <h> Multi object test
+// <i> Settings for the CAN_Loopback_MultiObject test
+// <o> Number of frames per stream <1-100000>
+// <i> Set the number of frames sent on each stream (one extended ID per object)
+#define CAN_MULTI_OBJ_FRAMES            100
+// </h>
+// <h> Burst test
+// <i> Settings for the CAN_Loopback_Burst test
+// <o> Number of frames in burst <2-100000>
+// <i> Set the number of back-to-back frames sent at each bitrate
+#define CAN_BURST_FRAMES                100
+// </h>
+// <h> Latency test
+// <i> Settings for the CAN_Loopback_Latency and CAN_Loopback_LatencyFD tests
+// <o> Number of frames <1-10000>
+// <i> Set the number of frames measured at each bitrate
+#define CAN_LATENCY_FRAMES              100
+// <o> Maximum p99 receive latency (% of wire time) <100-10000>
+// <i> Set the p99 receive latency above which a warning is reported
+#define CAN_LATENCY_MAX                 150
+// </h>
+// <h> Filter scaling test
+// <i> Settings for the CAN_Loopback_FilterScaling test
+// <o> Maximum number of filters <1-256>
+// <i> Set the maximum number of filters added to the receive object
+#define CAN_FILTER_MAX                  64
+// <o> Number of frames <2-10000>
+// <i> Set the number of frames sent at each filter count (half of them with rejected IDs)
+#define CAN_FILTER_FRAMES               200
+// </h>
+// <h> Error recovery test
+// <i> Settings for the CAN_ErrorRecovery test
+// <o> Number of cycles <1-1000>
+// <i> Set the number of error/recovery cycles
+#define CAN_ERROR_CYCLES                10
+// <o> Timeout <1000-10000000>
+// <i> Set the timeout for reaching an error state or recovering from it (us)
+#define CAN_ERROR_TIMEOUT               1000000
+// </h>
+// <h> FD throughput sweep
+// <i> Settings for the CAN_Loopback_ThroughputFD test
+// <o> Nominal bitrate <10-1000>
+// <i> Set the nominal (arbitration) bitrate (kbit/s)
+#define CAN_FD_SWEEP_BITRATE            500
+// <o> Ratio data/arbitration bitrate 1
+// <i> Value zero is ignored
+#define CAN_FD_SWEEP_RATIO_1            2
+// <o> Ratio data/arbitration bitrate 2
+#define CAN_FD_SWEEP_RATIO_2            4
+// <o> Ratio data/arbitration bitrate 3
+#define CAN_FD_SWEEP_RATIO_3            5
+// <o> Ratio data/arbitration bitrate 4
+#define CAN_FD_SWEEP_RATIO_4            8
+// <o> Number of frames <1-10000>
+// <i> Set the number of frames sent for each data size and ratio
+#define CAN_FD_SWEEP_FRAMES             50
+// </h>
 // <h> Tests
 // <i> Enable / disable tests.
 // <q> CAN_GetCapabilities
@@ -78,6 +156,24 @@
 #define CAN_LOOPBACK_TRANSFER_EN        1
 // <q> CAN_Loopback_TransferFD
 #define CAN_LOOPBACK_TRANSFER_FD_EN     1
+// <q> CAN_Loopback_BusLoad
+#define CAN_LOOPBACK_BUS_LOAD_EN        1
+// <q> CAN_Loopback_BusLoadFD
+#define CAN_LOOPBACK_BUS_LOAD_FD_EN     1
+// <q> CAN_Loopback_MultiObject
+#define CAN_LOOPBACK_MULTI_OBJ_EN       1
+// <q> CAN_Loopback_Burst
+#define CAN_LOOPBACK_BURST_EN           1
+// <q> CAN_Loopback_Latency
+#define CAN_LOOPBACK_LATENCY_EN         1
+// <q> CAN_Loopback_LatencyFD
+#define CAN_LOOPBACK_LATENCY_FD_EN      1
+// <q> CAN_Loopback_FilterScaling
+#define CAN_LOOPBACK_FILTER_SCALING_EN  1
+// <q> CAN_ErrorRecovery
+#define CAN_ERROR_RECOVERY_EN           1
+// <q> CAN_Loopback_ThroughputFD
+#define CAN_LOOPBACK_THROUGHPUT_FD_EN   1
 // <q> CAN_CheckInvalidInit
 #define CAN_CHECKINVALIDINIT_EN         1
 // </h>
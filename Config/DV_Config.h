@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V2.0.0
+ * $Revision:   V2.7.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       Driver Validation main configuration file
@@ -32,11 +32,73 @@
 
 // <h> Driver Validation
 // <i> Driver Validation configuration
-//   <o> Report Format <0=> Plain Text <1=> XML
-//   <i> Select report format to plain text or XML
+//   <o> Report Format <0=> Plain Text <1=> XML <2=> JSON Lines
+//   <i> Select report format to plain text, XML or JSON Lines (one JSON object per line)
 #ifndef PRINT_XML_REPORT
 #define PRINT_XML_REPORT                0
 #endif
+//   <q> Keep Driver Powered between Fixture Tests
+//   <i> Consecutive tests using the test group fixture share one initialized and powered driver
+//   <i> When disabled, fixture setup and teardown are executed around each of these tests
+#ifndef DV_KEEP_POWERED
+#define DV_KEEP_POWERED                 1
+#endif
+//   <o> Test Case Timeout (in seconds) <0-86400>
+//   <i> Each test case runs in a supervised thread and is terminated and failed when it exceeds the timeout
+//   <i> Test cases can override the timeout in the test case list (TCDT, TCFT); 0 disables the supervision
+#ifndef DV_TEST_TIMEOUT
+#define DV_TEST_TIMEOUT                 300
+#endif
+//   <e> Checkpoint and Resume
+//   <i> Test progress and results are saved after each test case (retained RAM or user storage functions)
+//   <i> After a reset the run continues with the next test case and earlier results are included in the report
+#ifndef DV_CHECKPOINT
+#define DV_CHECKPOINT                   0
+#endif
+//     <o> Maximum Number of Test Cases <1-4096>
+//     <i> Number of test case results stored in the checkpoint (one byte per test case)
+#ifndef DV_CHECKPOINT_TESTS
+#define DV_CHECKPOINT_TESTS             512
+#endif
+//     <s> Retained RAM Section
+//     <i> Section of default checkpoint storage, it must not be initialized at reset
+//     <i> GNU linker script: place .noinit in a NOLOAD output section
+//     <i> Arm Compiler: use .bss.noinit and place it in an UNINIT execution region of the scatter file
+#ifndef DV_CHECKPOINT_SECTION
+#define DV_CHECKPOINT_SECTION           ".noinit"
+#endif
+//   </e>
+//   <h> Test Sharding
+//   <i> Test cases are distributed to several boards running the same image (balanced by test case duration)
+//     <o> Shard Index <0-254>
+//     <i> Index of this board (0 .. Number of Shards - 1), overridden by DV_SHARD argument of cmsis_dv
+#ifndef DV_SHARD_INDEX
+#define DV_SHARD_INDEX                  0
+#endif
+//     <o> Number of Shards <1-255>
+//     <i> Number of boards sharing the test run (1 = all test cases are executed)
+#ifndef DV_SHARD_COUNT
+#define DV_SHARD_COUNT                  1
+#endif
+//     <o> Default Test Case Duration (in ms) <1-3600000>
+//     <i> Duration assumed for test cases without recorded duration (cmsis_dv_test_duration)
+#ifndef DV_SHARD_DURATION
+#define DV_SHARD_DURATION               1000
+#endif
+//   </h>
+//   <h> Test Repeat
+//   <i> Each enabled test case is executed several times to detect intermittent (flaky) failures
+//     <o> Number of Runs per Test Case <1-10000>
+//     <i> Pass rate, failed runs and run duration statistics are reported for each test case (1 = single run)
+#ifndef DV_REPEAT_COUNT
+#define DV_REPEAT_COUNT                 1
+#endif
+//     <q> Stop at First Failure
+//     <i> Repetition of a test case ends with its first failed run
+#ifndef DV_REPEAT_STOP
+#define DV_REPEAT_STOP                  0
+#endif
+//   </h>
 // </h>
 
 #endif /* DV_CONFIG_H_ */
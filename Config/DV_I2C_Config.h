@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020 Arm Limited. All rights reserved.
+ * Copyright (c) 2015-2026 Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V1.0.0
+ * $Revision:   V1.1.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       Inter-Integrated Circuit (I2C) driver validation 
@@ -37,6 +37,37 @@
 // <i> Choose the Driver_I2C# instance to test.
 // <i> For example to test Driver_I2C0 select 0.
 #define DRV_I2C                         1
+// <h> I2C Server
+// <i> Settings used for command exchange with the I2C Server (driver is the I2C Master).
+// <o> I2C Server address <0x08-0x77>
+// <i> 7-bit address of the I2C Server (must match I2C_SERVER_ADDR in the I2C_Server_Config.h file).
+#define I2C_CFG_SRV_ADDR                0x4A
+// <o> Bus speed <1=> Standard <2=> Fast <3=> Fast+ <4=> High speed
+// <i> Bus speed used for command exchange with the I2C Server.
+#define I2C_CFG_SRV_BUS_SPEED           1
+// <o> Command timeout (ms) <10-10000>
+#define I2C_CFG_SRV_CMD_TOUT            100
+// </h>
+// <h> Data exchange
+// <i> Settings used for data exchange tests.
+// <o> 7-bit address <0x08-0x77>
+// <i> Address used for data exchange with 7-bit addressing (I2C Server address in Master tests, driver own address in Slave tests).
+#define I2C_CFG_ADDR_7BIT               0x55
+// <o> 10-bit address <0x000-0x3FF>
+// <i> Address used for data exchange with 10-bit addressing.
+#define I2C_CFG_ADDR_10BIT              0x2AA
+// <o> Bus speed <1=> Standard <2=> Fast <3=> Fast+ <4=> High speed
+// <i> Bus speed used for all data exchange tests except bus speed tests.
+#define I2C_CFG_BUS_SPEED               2
+// <o> Number of bytes <1-4096>
+// <i> Number of bytes transferred in data exchange tests.
+#define I2C_CFG_NUM                     32
+// <o> Transfer timeout (ms) <10-100000>
+#define I2C_CFG_XFER_TOUT               1000
+// <o> Throughput number of bytes <1-4096>
+// <i> Number of bytes transferred by the throughput test at each bus speed.
+#define I2C_CFG_THROUGHPUT_NUM          1024
+// </h>
 // <h> Tests
 // <i> Enable / disable tests.
 // <q> I2C_GetCapabilities
@@ -55,6 +86,30 @@
 #define I2C_ABORTTRANSFER_EN            1
 // <q> I2C_CheckInvalidInit
 #define I2C_CHECKINVALIDINIT_EN         1
+// <q> I2C_MasterTransmit_7Bit
+#define I2C_MASTERTRANSMIT_7BIT_EN      1
+// <q> I2C_MasterReceive_7Bit
+#define I2C_MASTERRECEIVE_7BIT_EN       1
+// <q> I2C_MasterTransmit_10Bit
+#define I2C_MASTERTRANSMIT_10BIT_EN     1
+// <q> I2C_MasterReceive_10Bit
+#define I2C_MASTERRECEIVE_10BIT_EN      1
+// <q> I2C_MasterRepeatedStart
+#define I2C_MASTERREPEATEDSTART_EN      1
+// <q> I2C_SlaveTransmit
+#define I2C_SLAVETRANSMIT_EN            1
+// <q> I2C_SlaveReceive
+#define I2C_SLAVERECEIVE_EN             1
+// <q> I2C_BusSpeed_Standard
+#define I2C_BUSSPEED_STANDARD_EN        1
+// <q> I2C_BusSpeed_Fast
+#define I2C_BUSSPEED_FAST_EN            1
+// <q> I2C_BusSpeed_FastPlus
+#define I2C_BUSSPEED_FASTPLUS_EN        1
+// <q> I2C_BusSpeed_High
+#define I2C_BUSSPEED_HIGH_EN            1
+// <q> I2C_Throughput
+#define I2C_THROUGHPUT_EN               1
 // </h>
 // </h>
 
@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V1.0.0
+ * $Revision:   V1.4.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       Universal Serial Bus (USB) Device driver validation 
@@ -37,6 +37,31 @@
 // <i> Choose the Driver_USBD# instance to test.
 // <i> For example to test Driver_USBD0 select 0.
 #define DRV_USBD                        0
+// <h> Data transfer
+// <i> Settings of the data transfer tests which require the USBD_Host tool running on the USB host.
+// <o> Vendor ID <0x0000-0xFFFF>
+// <i> Vendor ID of the test device (must match the USBD_Host tool option).
+#define USBD_VID                        0xC251
+// <o> Product ID <0x0000-0xFFFF>
+// <i> Product ID of the test device (must match the USBD_Host tool option).
+#define USBD_PID                        0x1DA0
+// <o> Maximum transfer size (bytes) <512-1048576>
+// <i> Largest transfer size accepted from the host tool (size of the data buffer allocated from the heap).
+#define USBD_XFER_SIZE_MAX              16384
+// <o> Latency samples per phase <1-100000>
+// <i> Number of transfers per phase whose latency is recorded.
+#define USBD_LATENCY_NUM                1000
+// <o> Endpoint event queue length <8-1024>
+// <i> Number of endpoint events buffered between the driver callback and the test thread.
+#define USBD_EVENT_QUEUE_LEN            64
+// <o> Host timeout (s) <1-3600>
+// <i> Test fails if the host tool is inactive for this time.
+#define USBD_HOST_TIMEOUT               60
+// <o> Maximum isochronous duration (ms) <1000-3600000>
+// <i> Longest isochronous phase accepted from the host tool.
+// <i> The timeout of the USBD_Isochronous test is derived from it.
+#define USBD_ISO_DURATION_MAX           120000
+// </h>
 // <h> Tests
 // <i> Enable / disable tests.
 // <q> USBD_GetCapabilities
@@ -47,6 +72,16 @@
 #define USBD_POWERCONTROL_EN            1
 // <q> USBD_CheckInvalidInit
 #define USBD_CHECKINVALIDINIT_EN        1
+// <e> Data transfer
+// <i> Data transfer tests require the USBD_Host tool running on the USB host. Enable / disable data transfer tests.
+#define USBD_DATA_EN                    0
+// <q> USBD_Bulk_Throughput
+#define USBD_BULK_THROUGHPUT_EN         1
+// <q> USBD_Multi_Endpoint
+#define USBD_MULTI_ENDPOINT_EN          1
+// <q> USBD_Isochronous
+#define USBD_ISOCHRONOUS_EN             1
+// </e>
 // </h>
 // </h>
 
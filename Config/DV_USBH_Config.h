@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V1.0.0
+ * $Revision:   V1.2.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       Universal Serial Bus (USB) Host driver validation 
@@ -37,6 +37,42 @@
 // <i> Choose the Driver_USBH# instance to test.
 // <i> For example to test Driver_USBH0 select 0.
 #define DRV_USBH                        0
+// <h> Data transfer
+// <i> Settings of the data transfer tests which require the test device of the USB Device validation connected to the port.
+// <o> Port <0-15>
+// <i> Root hub port the test device is connected to.
+#define USBH_PORT                       0
+// <o> Vendor ID <0x0000-0xFFFF>
+// <i> Vendor ID of the test device (must match the USB Device validation setting).
+#define USBH_VID                        0xC251
+// <o> Product ID <0x0000-0xFFFF>
+// <i> Product ID of the test device (must match the USB Device validation setting).
+#define USBH_PID                        0x1DA0
+// <o> Maximum transfer size (bytes) <4096-1048576>
+// <i> Largest bulk transfer size (size of the data buffer allocated from the heap).
+#define USBH_XFER_SIZE_MAX              16384
+// <o> Bytes per phase <65536-67108864>
+// <i> Number of bytes transferred in each bulk OUT and bulk IN phase.
+#define USBH_BULK_TOTAL                 1048576
+// <o> Multiple pipe duration (ms) <100-60000>
+// <i> Duration of the concurrent bulk and interrupt transfers.
+#define USBH_MULTI_DURATION             2000
+// <o> Isochronous duration (ms) <1000-3600000>
+// <i> Duration of the isochronous streams (several minutes to catch sporadic timing errors).
+#define USBH_ISO_DURATION               120000
+// <o> Isochronous packet size (bytes) <4-512>
+// <i> Bytes per isochronous packet (for example 192 for 48 kHz 16-bit stereo audio at full-speed).
+#define USBH_ISO_PACKET_SIZE            192
+// <o> Latency samples per phase <1-100000>
+// <i> Number of transfers per pipe and phase whose latency is recorded.
+#define USBH_LATENCY_NUM                1000
+// <o> Device timeout (s) <1-3600>
+// <i> Test fails if the test device is not connected within this time.
+#define USBH_DEVICE_TIMEOUT             60
+// <o> Transfer timeout (ms) <10-60000>
+// <i> Pipe transfer is aborted and the test fails if it does not complete within this time.
+#define USBH_XFER_TIMEOUT               1000
+// </h>
 // <h> Tests
 // <i> Enable / disable tests.
 // <q> USBH_GetCapabilities
@@ -47,6 +83,16 @@
 #define USBH_POWERCONTROL_EN            1
 // <q> USBH_CheckInvalidInit
 #define USBH_CHECKINVALIDINIT_EN        1
+// <e> Data transfer
+// <i> Data transfer tests require the test device of the USB Device validation. Enable / disable data transfer tests.
+#define USBH_DATA_EN                    0
+// <q> USBH_Bulk_Throughput
+#define USBH_BULK_THROUGHPUT_EN         1
+// <q> USBH_Multi_Pipe
+#define USBH_MULTI_PIPE_EN              1
+// <q> USBH_Isochronous
+#define USBH_ISOCHRONOUS_EN             1
+// </e>
 // </h>
 // </h>
 
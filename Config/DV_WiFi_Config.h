@@ -17,7 +17,7 @@
  *
  * -----------------------------------------------------------------------------
  *
- * $Revision:   V1.1.0
+ * $Revision:   V1.2.0
  *
  * Project:     CMSIS-Driver Validation
  * Title:       WiFi driver validation configuration file
@@ -252,15 +252,24 @@
 // <q> WIFI_Test_Speed
 // <i> Transmits data and measures transfer speed
 #define WIFI_TEST_SPEED_EN              1
+// <o> Minimum Transfer Speed (in KB/s) <0-1000000>
+// <i> WIFI_Test_Speed fails if transfer speed is lower (0 = not checked)
+#define WIFI_TEST_SPEED_MIN             5
 // <q> WIFI_Concurrent_Socket
 // <i> Transmits data in two sockets simultaneously
 #define WIFI_CONCURRENT_SOCKET_EN       1
 // <q> WIFI_Downstream_Rate
 // <i> Measures the downstream bandwidth
 #define WIFI_DOWNSTREAM_RATE_EN         1
+// <o> Minimum Downstream Rate (in KB/s) <0-1000000>
+// <i> WIFI_Downstream_Rate fails if downstream rate is lower (0 = not checked)
+#define WIFI_DOWNSTREAM_RATE_MIN        0
 // <q> WIFI_Upstream_Rate
 // <i> Measures the upstream bandwidth
 #define WIFI_UPSTREAM_RATE_EN           1
+// <o> Minimum Upstream Rate (in KB/s) <0-1000000>
+// <i> WIFI_Upstream_Rate fails if upstream rate is lower (0 = not checked)
+#define WIFI_UPSTREAM_RATE_MIN          0
 // </e>
 // </h>
 // </h>
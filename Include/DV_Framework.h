@@ -34,13 +34,24 @@
  * Test framework global definitions
  *----------------------------------------------------------------------------*/
 
-/* Test case definition macro                                                 */
-#define TCD(x, y) { (((y) != 0) ? (x) : (NULL)), #x }
+/* Test case fixture modes                                                    */
+#define TC_FIXTURE_NONE     0U        /* Test runs on uninitialized driver    */
+#define TC_FIXTURE_POWERED  1U        /* Test runs on group fixture (Setup)   */
+
+/* Test case definition macros                                                */
+#define TCD(x, y) { (((y) != 0) ? (x) : (NULL)), #x, TC_FIXTURE_NONE,    0U }
+#define TCF(x, y) { (((y) != 0) ? (x) : (NULL)), #x, TC_FIXTURE_POWERED, 0U }
+
+/* Test case definition macros with timeout override (t in seconds)           */
+#define TCDT(x, y, t) { (((y) != 0) ? (x) : (NULL)), #x, TC_FIXTURE_NONE,    (t) }
+#define TCFT(x, y, t) { (((y) != 0) ? (x) : (NULL)), #x, TC_FIXTURE_POWERED, (t) }
 
 /* Test case description structure                                            */
 typedef struct {
   void (*TestFunc)(void);             /* Test function                        */
   const char *TFName;                 /* Test function name string            */
+  uint32_t Fixture;                   /* Test case fixture mode               */
+  uint32_t Timeout;                   /* Timeout in seconds (0 = default)     */
 } const TEST_CASE;
 
 /* Test group description structure                                           */
@@ -51,6 +62,8 @@ typedef struct {
   const char *ReportTitle;            /* Title or name of module under test   */
   void (*Init)(void);                 /* Init function callback               */
   void (*Uninit)(void);               /* Uninit function callback             */
+  void (*Setup)(void);                /* Fixture setup function callback      */
+  void (*Teardown)(void);             /* Fixture teardown function callback   */
 
   TEST_CASE *TC;                      /* Array of test cases                  */
   uint32_t NumOfTC;                   /* Number of test cases (sz of TC array)*/
@@ -40,6 +40,13 @@ typedef enum {
   NOT_EXECUTED
 } TC_RES;
 
+/* Metric direction */
+typedef enum {
+  METRIC_INFO = 0,                      /* Informational, no direction        */
+  METRIC_HIGHER,                        /* Higher value is better             */
+  METRIC_LOWER                          /* Lower value is better              */
+} METRIC_DIR;
+
 /* Test group statistics */
 typedef struct {
   uint32_t idx;                         /* Group index                        */
@@ -60,6 +67,9 @@ typedef struct {
   void (* tc_Detail)  (const char *module, uint32_t line, const char *message);
   void (* tc_Uninit)  (void);
   void (* as_Result)  (TC_RES res);
+  void (* tc_Budget)  (uint32_t used, uint32_t budget);
+  TC_RES (* tc_Result)(void);
+  void (* tc_Repeat)  (void);
 } REPORT_ITF;
 
 /* Global structure for interfacing test report */
@@ -70,5 +80,12 @@ extern void __tg_info    (const char *info);
 /* Assertions and test results */
 extern void __set_result (const char *module, uint32_t line, const char *message, TC_RES res);
 extern void __set_message(const char *module, uint32_t line, const char *message);
+extern void __set_metric (const char *module, uint32_t line, const char *name, double value, const char *unit, METRIC_DIR dir, double threshold);
+extern void __set_metric_threshold (const char *name, double threshold);
+
+/* Latency statistics */
+extern void     __set_percentiles (const char *module, uint32_t line, const char *name, uint32_t *samples, uint32_t cnt, uint64_t ticks_per_s);
+extern void     __set_histogram   (const char *module, uint32_t line, const char *name, const uint32_t *hist, const uint32_t *lim, uint32_t lim_num);
+extern uint32_t __hist_bucket     (const uint32_t *lim, uint32_t lim_num, uint32_t value);
 
 #endif /* __CMSIS_DV_REPORT_H__ */
@@ -31,6 +31,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 typedef unsigned int    BOOL;
 
@@ -72,4 +73,16 @@ typedef unsigned int    BOOL;
 
 #define TEST_MESSAGE(message)                   __set_message(__FILE__, __LINE__, message)
 
+/* Metric macros (threshold METRIC_NO_THRESHOLD disables the threshold check) */
+#define METRIC_NO_THRESHOLD                         ((double)NAN)
+#define TEST_METRIC(name,value,unit)                __set_metric (__FILE__, __LINE__, name, (double)(value), unit, METRIC_INFO,   METRIC_NO_THRESHOLD)
+#define TEST_METRIC_HIGHER(name,value,unit,min)     __set_metric (__FILE__, __LINE__, name, (double)(value), unit, METRIC_HIGHER, (double)(min))
+#define TEST_METRIC_LOWER(name,value,unit,max)      __set_metric (__FILE__, __LINE__, name, (double)(value), unit, METRIC_LOWER,  (double)(max))
+#define TEST_METRIC_THRESHOLD(name,threshold)       __set_metric_threshold (name, (double)(threshold))
+
+/* Latency statistics macros (samples in timer ticks are sorted in place, histogram has one bucket more than limits) */
+#define TEST_PERCENTILES(name,samples,cnt,ticks_per_s)  __set_percentiles (__FILE__, __LINE__, name, samples, cnt, (uint64_t)(ticks_per_s))
+#define TEST_HISTOGRAM(name,hist,lim)                   __set_histogram (__FILE__, __LINE__, name, hist, lim, ARRAY_SIZE(lim))
+#define HISTOGRAM_BUCKET(lim,value)                     __hist_bucket (lim, ARRAY_SIZE(lim), value)
+
 #endif /* __CMSIS_DV_TYPEDEFS_H__ */
@@ -48,9 +48,22 @@
 #define EXPAND_SYMBOL(name, port) name##port
 #define CREATE_SYMBOL(name, port) EXPAND_SYMBOL(name, port)
 
+// Test shard selection (optional argument of cmsis_dv)
+typedef struct {
+  uint32_t index;                       // Shard index (0 .. count - 1)
+  uint32_t count;                       // Number of shards
+} DV_SHARD;
+
 // Test main function
 extern void cmsis_dv (void *argument);
 
+// Checkpoint storage functions (weak, default stores checkpoint in retained RAM)
+extern int32_t cmsis_dv_checkpoint_save (const void *data, uint32_t size);
+extern int32_t cmsis_dv_checkpoint_load (void *data, uint32_t size);
+
+// Recorded test case duration in ms (weak, default 0 = not recorded)
+extern uint32_t cmsis_dv_test_duration (const char *name);
+
 // Init/Uninit and testing functions
 extern void SPI_DV_Initialize (void);
 extern void SPI_DV_Uninitialize (void);
@@ -172,6 +185,8 @@ extern void USART_Event_RI (void);
 
 extern void ETH_DV_Initialize (void);
 extern void ETH_DV_Uninitialize (void);
+extern void ETH_DV_Setup (void);
+extern void ETH_DV_Teardown (void);
 extern void ETH_MAC_GetVersion (void);
 extern void ETH_MAC_GetCapabilities (void);
 extern void ETH_MAC_Initialization (void);
@@ -194,6 +209,10 @@ extern void ETH_Loopback_Transfer (void);
 extern void ETH_Loopback_PTP (void);
 extern void ETH_Loopback_External (void);
 
+extern void I2C_DV_Initialize (void);
+extern void I2C_DV_Uninitialize (void);
+extern void I2C_DV_Setup (void);
+extern void I2C_DV_Teardown (void);
 extern void I2C_GetCapabilities (void);
 extern void I2C_Initialization (void);
 extern void I2C_PowerControl (void);
@@ -202,7 +221,21 @@ extern void I2C_SetOwnAddress (void);
 extern void I2C_BusClear (void);
 extern void I2C_AbortTransfer (void);
 extern void I2C_CheckInvalidInit (void);
+extern void I2C_MasterTransmit_7Bit (void);
+extern void I2C_MasterReceive_7Bit (void);
+extern void I2C_MasterTransmit_10Bit (void);
+extern void I2C_MasterReceive_10Bit (void);
+extern void I2C_MasterRepeatedStart (void);
+extern void I2C_SlaveTransmit (void);
+extern void I2C_SlaveReceive (void);
+extern void I2C_BusSpeed_Standard (void);
+extern void I2C_BusSpeed_Fast (void);
+extern void I2C_BusSpeed_FastPlus (void);
+extern void I2C_BusSpeed_High (void);
+extern void I2C_Throughput (void);
 
+extern void MCI_DV_Setup (void);
+extern void MCI_DV_Teardown (void);
 extern void MCI_GetCapabilities (void);
 extern void MCI_Initialization (void);
 extern void MCI_PowerControl (void);
@@ -211,17 +244,34 @@ extern void MCI_Config_DataWidth (void);
 extern void MCI_Config_CmdLineMode (void);
 extern void MCI_Config_DriverStrength (void);
 extern void MCI_CheckInvalidInit (void);
+extern void MCI_Card_Initialize (void);
+extern void MCI_ReadWrite_Verify (void);
+extern void MCI_Throughput_Read (void);
+extern void MCI_Throughput_Write (void);
+extern void MCI_Latency_Profile (void);
 
+extern void USBD_DV_Setup (void);
+extern void USBD_DV_Teardown (void);
 extern void USBD_GetCapabilities (void);
 extern void USBD_Initialization (void);
 extern void USBD_PowerControl (void);
 extern void USBD_CheckInvalidInit (void);
+extern void USBD_Bulk_Throughput (void);
+extern void USBD_Multi_Endpoint (void);
+extern void USBD_Isochronous (void);
 
+extern void USBH_DV_Setup (void);
+extern void USBH_DV_Teardown (void);
 extern void USBH_GetCapabilities (void);
 extern void USBH_Initialization (void);
 extern void USBH_PowerControl (void);
 extern void USBH_CheckInvalidInit (void);
+extern void USBH_Bulk_Throughput (void);
+extern void USBH_Multi_Pipe (void);
+extern void USBH_Isochronous (void);
 
+extern void CAN_DV_Setup (void);
+extern void CAN_DV_Teardown (void);
 extern void CAN_GetCapabilities (void);
 extern void CAN_Initialization (void);
 extern void CAN_PowerControl (void);
@@ -230,9 +280,20 @@ extern void CAN_Loopback_CheckBitrate (void);
 extern void CAN_Loopback_CheckBitrateFD (void);
 extern void CAN_Loopback_Transfer (void);
 extern void CAN_Loopback_TransferFD (void);
+extern void CAN_Loopback_BusLoad (void);
+extern void CAN_Loopback_BusLoadFD (void);
+extern void CAN_Loopback_MultiObject (void);
+extern void CAN_Loopback_Burst (void);
+extern void CAN_Loopback_Latency (void);
+extern void CAN_Loopback_LatencyFD (void);
+extern void CAN_Loopback_FilterScaling (void);
+extern void CAN_ErrorRecovery (void);
+extern void CAN_Loopback_ThroughputFD (void);
 
 extern void WIFI_DV_Initialize (void);
 extern void WIFI_DV_Uninitialize (void);
+extern void WIFI_DV_Setup (void);
+extern void WIFI_DV_Teardown (void);
 extern void WIFI_GetVersion (void);
 extern void WIFI_GetCapabilities (void);
 extern void WIFI_Initialize_Uninitialize (void);
@@ -50,6 +50,37 @@
                                       // SOF BASEID SRR IDE IDEXT     r1 EDL r0 BRS ESI DLC DATA CRC CRCDEL ACK EOF
 #define CAN_EXT_FRAME_BITS_FD_DATA    (                                              +1  +4      +21     +1         )
 
+// CAN interframe space bits (intermission)
+#define CAN_IFS_BITS                  3U
+
+// Classic CAN extended frame format bits according to ISO 11898-1 (without datafield)
+                                      // SOF BASEID SRR IDE IDEXT RTR r1 r0 DLC DATA CRC CRCDEL ACK EOF
+#define CAN_EXT_FRAME_BITS_CLASSIC    (    1    +11  +1  +1   +18  +1 +1 +1  +4      +15     +1  +2  +7 )
+
+// CAN FD frame bits sent at FD_DATA bitrate according to ISO 11898-1 (without datafield and CRC)
+                                      // ESI DLC SBC CRCDEL
+#define CAN_FD_DATA_BITS_ISO          (   +1  +4  +4     +1 )
+
+// CAN FD CRC bits according to ISO 11898-1 (CRC-17 up to 16 data bytes, CRC-21 above)
+#define CAN_FD_CRC_BITS(size)         (((size) <= 16U) ? 17U : 21U)
+
+// Maximum number of objects used by the throughput tests
+#define CAN_OBJ_MAX                   32U
+
+// First extended ID used by the multi object test streams
+#define CAN_MULTI_OBJ_ID              0x15555500U
+
+// First extended ID used by the filter scaling test
+// Filter f accepts IDs from block CAN_FILTER_ID + (f * 16): offsets 0..3 are accepted, offsets 8..15 are rejected
+#define CAN_FILTER_ID                 0x0AAA0000U
+#define CAN_FILTER_BLOCK              16U
+
+// Bit timing solver limits
+#define CAN_BIT_TQ_MIN                5U        // Minimum number of time quanta per bit
+#define CAN_BIT_TQ_MAX                25U       // Maximum number of time quanta per bit
+#define CAN_BIT_PRESCALER_MAX         1024U     // Maximum bitrate prescaler
+#define CAN_BIT_REPORTED_MAX          16U       // Maximum number of approximated bitrates remembered as reported
+
 // CAN buffer pointers
 static uint8_t *buffer_out;
 static uint8_t *buffer_in;
@@ -85,53 +116,339 @@ static ARM_CAN_OBJ_CAPABILITIES obj_capab;
 
 static char str[128];
 
-// Event flags
-static uint32_t volatile Event;
+// Bit timing
+typedef struct {
+  uint32_t tq;                          // Time quanta per bit
+  uint32_t prescaler;                   // Bitrate prescaler
+  uint32_t bitrate;                     // Resulting bitrate (bit/s)
+  uint32_t prop_seg;                    // Propagation segment (time quanta)
+  uint32_t phase_seg1;                  // Phase segment 1 (time quanta)
+  uint32_t phase_seg2;                  // Phase segment 2 (time quanta)
+  uint32_t sjw;                         // Resynchronization jump width (time quanta)
+  uint32_t sample_point;                // Resulting sample point (1/1000 of bit time)
+  uint32_t err;                         // Bitrate error (ppm)
+} CAN_BIT_TIMING;
+
+// Approximated bitrates already reported (requested bitrate and bitrate select)
+static struct {
+  uint32_t bitrate;
+  uint32_t select;
+} Bit_reported[CAN_BIT_REPORTED_MAX];
+static uint32_t Bit_reported_cnt;
+
+// Object event ring entry
+typedef struct {
+  uint32_t obj_idx;                     // Object index
+  uint32_t event;                       // Object event flags
+  uint32_t tick;                        // System timer count when event was signaled
+} CAN_OBJ_EVENT;
+
+// Object event ring (single producer: object event callback, single consumer: test thread)
+// Size must be a power of 2
+#define CAN_OBJ_EVENT_RING_SIZE       64U
+
+static CAN_OBJ_EVENT     Obj_evt_ring[CAN_OBJ_EVENT_RING_SIZE];
+static uint32_t volatile Obj_evt_head;  // Written by callback only
+static uint32_t volatile Obj_evt_tail;  // Written by test thread only
+static uint32_t volatile Obj_evt_lost;  // Events dropped because the ring was full (written by callback only)
+static uint32_t          Obj_evt_lost_flush;    // Lost event count at last flush (test thread only)
+
+// Throughput tests: transmit object busy flags, receive objects drained in callback and received frame count
+static uint8_t  volatile Obj_tx_busy[CAN_OBJ_MAX];
+static uint8_t  volatile Obj_rx_drain[CAN_OBJ_MAX];
+static uint32_t volatile Obj_rx_cnt[CAN_OBJ_MAX];
+static uint32_t volatile Rx_cnt;
+static ARM_CAN_MSG_INFO  rx_drain_msg_info;
+static uint8_t           rx_drain_data[CAN_MSG_SIZE_FD];
+
+// Multi object test: next expected sequence number and sequence errors per stream (ID offset from CAN_MULTI_OBJ_ID)
+static uint32_t volatile Id_rx_seq[CAN_OBJ_MAX];
+static uint32_t volatile Id_rx_seq_err[CAN_OBJ_MAX];
+
+// Filter scaling test: received frames with IDs that should have been rejected
+static uint32_t volatile Rx_leak_cnt;
+
+// Unit event recorder (index: CAN_UNIT_EVT_ACTIVE .. CAN_UNIT_EVT_BUS_OFF)
+#define CAN_UNIT_EVT_ACTIVE           0U
+#define CAN_UNIT_EVT_WARNING          1U
+#define CAN_UNIT_EVT_PASSIVE          2U
+#define CAN_UNIT_EVT_BUS_OFF          3U
+static uint32_t volatile Unit_evt_cnt[4];       // Number of signaled events
+static uint32_t volatile Unit_evt_tick[4];      // System timer count of last signaled event
+
+// Object event callback execution statistics
+static uint32_t volatile Cb_cnt;
+static uint32_t volatile Cb_ticks;
+
+// Put object event into ring (called from object event callback)
+static void CAN_ObjEventPut (uint32_t obj_idx, uint32_t event, uint32_t tick) {
+  uint32_t head;
+
+  head = Obj_evt_head;
+  if ((head - Obj_evt_tail) < CAN_OBJ_EVENT_RING_SIZE) {
+    Obj_evt_ring[head & (CAN_OBJ_EVENT_RING_SIZE - 1U)].obj_idx = obj_idx;
+    Obj_evt_ring[head & (CAN_OBJ_EVENT_RING_SIZE - 1U)].event   = event;
+    Obj_evt_ring[head & (CAN_OBJ_EVENT_RING_SIZE - 1U)].tick    = tick;
+    __DMB();                            // Entry must be visible before the head index
+    Obj_evt_head = head + 1U;
+  } else {
+    Obj_evt_lost++;
+  }
+}
+
+// Get object event from ring (called from test thread)
+// Returns 1 if an event was retrieved, 0 if the ring is empty
+static uint32_t CAN_ObjEventGet (CAN_OBJ_EVENT *evt) {
+  uint32_t tail;
+
+  tail = Obj_evt_tail;
+  if (tail == Obj_evt_head) {
+    return 0U;
+  }
+  __DMB();                              // Read the entry only after the head index
+  *evt = Obj_evt_ring[tail & (CAN_OBJ_EVENT_RING_SIZE - 1U)];
+  __DMB();                              // Entry must be read before it is released
+  Obj_evt_tail = tail + 1U;
+  return 1U;
+}
+
+// Discard all pending object events and take snapshot of lost event count (called from test thread)
+static void CAN_ObjEventFlush (void) {
+  Obj_evt_tail       = Obj_evt_head;
+  Obj_evt_lost_flush = Obj_evt_lost;
+}
 
-// Object index
-uint32_t Obj_idx;
+// Get number of object events lost since last flush (called from test thread)
+static uint32_t CAN_ObjEventLost (void) {
+  return (Obj_evt_lost - Obj_evt_lost_flush);
+}
 
 // CAN Signal Unit Event Callback
 void CAN_SignalUnitEvent (uint32_t event) {
+  uint32_t idx;
 
   switch (event) {
     case ARM_CAN_EVENT_UNIT_ACTIVE:
+      idx = CAN_UNIT_EVT_ACTIVE;
       break;
     case ARM_CAN_EVENT_UNIT_WARNING:
+      idx = CAN_UNIT_EVT_WARNING;
       break;
     case ARM_CAN_EVENT_UNIT_PASSIVE:
+      idx = CAN_UNIT_EVT_PASSIVE;
       break;
     case ARM_CAN_EVENT_UNIT_BUS_OFF:
+      idx = CAN_UNIT_EVT_BUS_OFF;
       break;
+    default:
+      return;
   }
+  Unit_evt_tick[idx] = GET_SYSTICK();
+  Unit_evt_cnt[idx]++;
 }
 
 // CAN Signal Object Event Callback
 void CAN_SignalObjectEvent (uint32_t obj_idx, uint32_t event) {
-  Obj_idx = obj_idx;
-  Event = event;
+  uint32_t tick, id, seq;
+
+  tick = GET_SYSTICK();
+
+  CAN_ObjEventPut (obj_idx, event, tick);
+
+  if (obj_idx < CAN_OBJ_MAX) {
+    if ((event & ARM_CAN_EVENT_SEND_COMPLETE) != 0U) {
+      Obj_tx_busy[obj_idx] = 0U;
+    }
+    if (((event & ARM_CAN_EVENT_RECEIVE) != 0U) && (Obj_rx_drain[obj_idx] != 0U)) {
+      // Read the message immediately so back-to-back frames do not overrun the receive object
+      drv->MessageRead(obj_idx, &rx_drain_msg_info, rx_drain_data, CAN_MSG_SIZE_FD);
+      Obj_rx_cnt[obj_idx]++;
+      Rx_cnt++;
+
+      // Check sequence number (little endian in first 4 data bytes) of multi object test streams
+      id = (rx_drain_msg_info.id & 0x1FFFFFFFU) - CAN_MULTI_OBJ_ID;
+      if (id < CAN_OBJ_MAX) {
+        seq = (uint32_t)rx_drain_data[0]        | ((uint32_t)rx_drain_data[1] << 8) |
+             ((uint32_t)rx_drain_data[2] << 16) | ((uint32_t)rx_drain_data[3] << 24);
+        if (seq != Id_rx_seq[id]) {
+          Id_rx_seq_err[id]++;
+        }
+        Id_rx_seq[id] = seq + 1U;
+      }
+
+      // Count filter scaling test frames with IDs that should have been rejected
+      id = (rx_drain_msg_info.id & 0x1FFFFFFFU) - CAN_FILTER_ID;
+      if ((id < (CAN_FILTER_MAX * CAN_FILTER_BLOCK)) && ((id % CAN_FILTER_BLOCK) >= 8U)) {
+        Rx_leak_cnt++;
+      }
+    }
+  }
+
+  Cb_cnt++;
+  Cb_ticks += GET_SYSTICK() - tick;
+}
+
+// CAN bit timing solver
+// Enumerates bit times of CAN_BIT_TQ_MAX..CAN_BIT_TQ_MIN time quanta, each with the prescaler closest to the
+// requested bitrate, and returns the one with the smallest bitrate error, then the smallest sample point deviation
+//   clock:        CAN base clock (Hz)
+//   bitrate:      requested bitrate (bit/s)
+//   sample_point: requested sample point (1/1000 of bit time)
+//   tq_skip:      bit mask of time quanta counts to skip (bit n set skips bit time of n time quanta)
+//   bt:           pointer to resulting bit timing
+// Returns 0 on success, -1 if no bit timing within CAN_BITRATE_ERR_MAX was found
+static int32_t CAN_SolveBitTiming (uint32_t clock, uint32_t bitrate, uint32_t sample_point, uint32_t tq_skip, CAN_BIT_TIMING *bt) {
+  uint32_t tq, tseg1, phase2, prescaler, rate, err, sp_dev, best_err, best_sp_dev;
+  int32_t  ret;
+
+  ret         = -1;
+  best_err    = 0xFFFFFFFFU;
+  best_sp_dev = 0xFFFFFFFFU;
+  if ((clock == 0U) || (bitrate == 0U) || (bt == NULL)) {
+    return ret;
+  }
+
+  // Longer bit times first, so equally good solutions use more time quanta
+  for (tq = CAN_BIT_TQ_MAX; tq >= CAN_BIT_TQ_MIN; tq--) {
+    if ((tq_skip & (1UL << tq)) != 0U) {
+      continue;
+    }
+
+    // Prescaler giving the bitrate closest to the requested one
+    prescaler = (uint32_t)(((uint64_t)clock + (((uint64_t)bitrate * tq) / 2U)) / ((uint64_t)bitrate * tq));
+    if ((prescaler == 0U) || (prescaler > CAN_BIT_PRESCALER_MAX)) {
+      continue;
+    }
+    rate = clock / (prescaler * tq);
+    err  = (uint32_t)(((uint64_t)((rate > bitrate) ? (rate - bitrate) : (bitrate - rate)) * 1000000U) / bitrate);
+    if (err > CAN_BITRATE_ERR_MAX) {
+      continue;
+    }
+
+    // Time quanta before sample point (without synchronization segment), at least 1 time quantum in phase segment 2
+    tseg1 = ((tq * sample_point) + 500U) / 1000U;
+    if (tseg1 >= tq) { tseg1 = tq - 1U; }
+    if (tseg1 < 3U)  { continue; }
+    tseg1 -= 1U;
+    phase2 = tq - 1U - tseg1;
+    sp_dev = ((1U + tseg1) * 1000U) / tq;
+    sp_dev = (sp_dev > sample_point) ? (sp_dev - sample_point) : (sample_point - sp_dev);
+
+    if ((err < best_err) || ((err == best_err) && (sp_dev < best_sp_dev))) {
+      best_err          = err;
+      best_sp_dev       = sp_dev;
+      bt->tq            = tq;
+      bt->prescaler     = prescaler;
+      bt->bitrate       = rate;
+      bt->phase_seg2    = phase2;
+      bt->phase_seg1    = (phase2 < (tseg1 - 1U)) ? phase2 : (tseg1 - 1U);
+      bt->prop_seg      = tseg1 - bt->phase_seg1;
+      bt->sjw           = (phase2 < 4U) ? phase2 : 4U;
+      bt->sample_point  = ((1U + tseg1) * 1000U) / tq;
+      bt->err           = err;
+      ret = 0;
+    }
+  }
+  return ret;
+}
+
+// CAN set bitrate of one phase using the bit timing solver
+// Bit timings are tried in order of increasing error until the driver accepts one
+// An approximated bitrate is reported once per test run (first test that sets it)
+static int32_t CAN_SetBitTiming (ARM_CAN_BITRATE_SELECT select, uint32_t bitrate, uint32_t sample_point) {
+  CAN_BIT_TIMING bt;
+  uint32_t tq_skip, i;
+  int32_t  val;
+
+  val     = ARM_DRIVER_ERROR;
+  tq_skip = 0U;
+  while ((val != ARM_DRIVER_OK) && (CAN_SolveBitTiming (drv->GetClock(), bitrate, sample_point, tq_skip, &bt) == 0)) {
+    val = drv->SetBitrate (select, bt.bitrate, ARM_CAN_BIT_PROP_SEG  (bt.prop_seg)   |
+                                               ARM_CAN_BIT_PHASE_SEG1(bt.phase_seg1) |
+                                               ARM_CAN_BIT_PHASE_SEG2(bt.phase_seg2) |
+                                               ARM_CAN_BIT_SJW       (bt.sjw));
+    tq_skip |= 1UL << bt.tq;
+  }
+  if ((val == ARM_DRIVER_OK) && (bt.err != 0U)) {
+    for (i = 0U; i < Bit_reported_cnt; i++) {
+      if ((Bit_reported[i].bitrate == bitrate) && (Bit_reported[i].select == (uint32_t)select)) {
+        break;
+      }
+    }
+    if (i == Bit_reported_cnt) {
+      if (Bit_reported_cnt < CAN_BIT_REPORTED_MAX) {
+        Bit_reported[Bit_reported_cnt].bitrate = bitrate;
+        Bit_reported[Bit_reported_cnt].select  = (uint32_t)select;
+        Bit_reported_cnt++;
+      }
+      snprintf(str,sizeof(str),"[INFO] Bitrate %dbit/s set to %dbit/s (%dppm), %d tq, sample point %d.%d%%",
+               bitrate, bt.bitrate, bt.err, bt.tq, bt.sample_point/10U, bt.sample_point%10U);
+      TEST_MESSAGE(str);
+    }
+  }
+  return val;
+}
+
+// CAN set nominal (and FD data phase) bitrate
+// bitrate: nominal bitrate in kbit/s
+// ratio:   data/arbitration bitrate ratio for CAN FD, 0 to set nominal bitrate only
+static int32_t CAN_SetBitrates (uint32_t bitrate, uint32_t ratio) {
+  int32_t val;
+
+  val = CAN_SetBitTiming (ARM_CAN_BITRATE_NOMINAL, bitrate * 1000U, CAN_SAMPLE_POINT);
+  if ((val == ARM_DRIVER_OK) && (ratio != 0U)) {
+    val = CAN_SetBitTiming (ARM_CAN_BITRATE_FD_DATA, bitrate * 1000U * ratio, CAN_SAMPLE_POINT_FD);
+  }
+  return val;
 }
 
 // CAN transfer
 int8_t CAN_RunTransfer (uint32_t tx_obj_idx, ARM_CAN_MSG_INFO *tx_msg_info, const uint8_t *tx_data,
                         uint32_t rx_obj_idx, ARM_CAN_MSG_INFO *rx_msg_info, uint8_t *rx_data,
                         uint8_t size) {
+  CAN_OBJ_EVENT evt;
   uint32_t tick;
 
-  Event &= ~ARM_CAN_EVENT_RECEIVE;
+  CAN_ObjEventFlush ();
   drv->MessageSend(tx_obj_idx, tx_msg_info, tx_data, size);
 
   tick = GET_SYSTICK();
   do {
-    if ((Event & ARM_CAN_EVENT_RECEIVE)&&(Obj_idx == rx_obj_idx)) {
-      drv->MessageRead(rx_obj_idx, rx_msg_info, rx_data, size);
-      return 0;
+    if (CAN_ObjEventGet (&evt) != 0U) {
+      if (((evt.event & ARM_CAN_EVENT_RECEIVE) != 0U) && (evt.obj_idx == rx_obj_idx)) {
+        drv->MessageRead(rx_obj_idx, rx_msg_info, rx_data, size);
+        return 0;
+      }
     }
   }
   while ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(CAN_TRANSFER_TIMEOUT));
   return -1;
 }
 
+/* Helper function that initializes and powers on the driver for loopback tests */
+void CAN_DV_Setup (void) {
+  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
+}
+
+/* Helper function that powers off and uninitializes the driver after loopback tests */
+void CAN_DV_Teardown (void) {
+  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+// Activate initialization mode and deactivate all objects, driver stays powered for next test
+static void CAN_StopTransfer (void) {
+  uint32_t i;
+
+  TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+  capab = drv->GetCapabilities();
+  for (i = 0U; i < capab.num_objects; i++) {
+    (void)drv->ObjectConfigure(i, ARM_CAN_OBJ_INACTIVE);
+  }
+  CAN_ObjEventFlush();
+}
+
 
 /*-----------------------------------------------------------------------------
  *      Tests
@@ -261,13 +578,12 @@ void CAN_PowerControl (void) {
 \brief  Function: CAN_Loopback_CheckBitrate
 \details
 The test function \b CAN_Loopback_CheckBitrate verifies different bitrates with the sequence:
- - Initialize
- - Power on
  - Change bitrate
  - Transfer and measure transfer time
  - Check received data against sent data
- - Power off
- - Uninitialize
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
 */
 void CAN_Loopback_CheckBitrate (void) {
   int32_t val, i;
@@ -282,12 +598,6 @@ void CAN_Loopback_CheckBitrate (void) {
   uint32_t ticks_expected;
   double rate;
 
-  /* Initialize with callback */
-  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
-
-  /* Power on */
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
-
   /* Check if loopback is available */
   capab = drv->GetCapabilities();
   if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
@@ -318,45 +628,7 @@ void CAN_Loopback_CheckBitrate (void) {
       /* Activate initialization mode */
       TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
 
-      val = ARM_DRIVER_ERROR;
-      if ((clock % (5U*(CAN_BR[bitrate]*1000U))) == 0U) {               // If CAN base clock is divisible by 5 * nominal bitrate without remainder
-        val = drv->SetBitrate   (ARM_CAN_BITRATE_NOMINAL,               // Set nominal bitrate
-                                 CAN_BR[bitrate]*1000U,                 // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (2U) |           // Set propagation segment to 2 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |           // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |           // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));           // Resynchronization jump width is same as phase segment 2
-      }
-      if (val != ARM_DRIVER_OK) {                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (6U*(CAN_BR[bitrate]*1000U))) == 0U) {             // If CAN base clock is divisible by 6 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,               // Set nominal bitrate
-                                 CAN_BR[bitrate]*1000U,                 // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (3U) |           // Set propagation segment to 3 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |           // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |           // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));           // Resynchronization jump width is same as phase segment 2
-        }
-      }
-      if (val != ARM_DRIVER_OK) {                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (8U*(CAN_BR[bitrate]*1000U))) == 0U) {             // If CAN base clock is divisible by 8 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,               // Set nominal bitrate
-                                 CAN_BR[bitrate]*1000U,                 // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (5U) |           // Set propagation segment to 5 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |           // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |           // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));           // Resynchronization jump width is same as phase segment 2
-        }
-      }
-      if (val != ARM_DRIVER_OK) {                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (10U*(CAN_BR[bitrate]*1000U))) == 0U) {            // If CAN base clock is divisible by 10 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,               // Set nominal bitrate
-                                 CAN_BR[bitrate]*1000U,                 // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (6U) |           // Set propagation segment to 6 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |           // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(2U) |           // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                                 ARM_CAN_BIT_SJW       (2U));           // Resynchronization jump width is same as phase segment 2
-        }
-      }
+      val = CAN_SetBitrates (CAN_BR[bitrate], 0U);
       if (val != ARM_DRIVER_OK) {
         snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[bitrate], clock/1000000U);
         TEST_MESSAGE(str);
@@ -414,9 +686,8 @@ void CAN_Loopback_CheckBitrate (void) {
     free(buffer_in);
   }
 
-  /* Power off and uninitialize*/
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
 }
 
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
@@ -424,13 +695,12 @@ void CAN_Loopback_CheckBitrate (void) {
 \brief  Function: CAN_Loopback_CheckBitrateFD
 \details
 The test function \b CAN_Loopback_CheckBitrateFD verifies different bitrates with the sequence:
- - Initialize
- - Power on
  - Change bitrate
  - Transfer and measure transfer time
  - Check received data against sent data
- - Power off
- - Uninitialize
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
 */
 void CAN_Loopback_CheckBitrateFD (void) {
   int32_t val, i;
@@ -445,12 +715,6 @@ void CAN_Loopback_CheckBitrateFD (void) {
   uint32_t ticks_expected;
   double rate;
 
-  /* Initialize with callback */
-  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
-
-  /* Power on */
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
-
   /* Test FD mode */
   capab = drv->GetCapabilities();
   if (capab.fd_mode == 0U) {
@@ -486,69 +750,7 @@ void CAN_Loopback_CheckBitrateFD (void) {
         /* Activate initialization mode */
         TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
 
-        val = ARM_DRIVER_ERROR;
-        if ((clock % (5U*(CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {          // If CAN base clock is divisible by 5 * nominal bitrate without remainder
-          val = drv->SetBitrate   (ARM_CAN_BITRATE_NOMINAL,                             // Set nominal bitrate
-                                   CAN_BR[bitrate]*1000U,                               // Set nominal bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (2U) |                         // Set propagation segment to 2 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-          if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,     // Set FD data phase bitrate
-                                   CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO,            // Set FD data phase bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (2U) |                         // Set propagation segment to 2 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-        }
-        if (val != ARM_DRIVER_OK) {                                                     // If previous SetBitrate failed try different bit settings
-          if ((clock % (6U*(CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {        // If CAN base clock is divisible by 6 * nominal bitrate without remainder
-            val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                             // Set nominal bitrate
-                                   CAN_BR[bitrate]*1000U,                               // Set nominal bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (3U) |                         // Set propagation segment to 3 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-            if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,   // Set FD data phase bitrate
-                                   CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO,            // Set FD data phase bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (3U) |                         // Set propagation segment to 3 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-          }
-        }
-        if (val != ARM_DRIVER_OK) {                                                     // If previous SetBitrate failed try different bit settings
-          if ((clock % (8U*(CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {        // If CAN base clock is divisible by 8 * nominal bitrate without remainder
-            val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                             // Set nominal bitrate
-                                   CAN_BR[bitrate]*1000U,                               // Set nominal bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (5U) |                         // Set propagation segment to 5 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-            if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,   // Set FD data phase bitrate
-                                   CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO,            // Set FD data phase bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (5U) |                         // Set propagation segment to 5 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(1U) |                         // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                                   ARM_CAN_BIT_SJW       (1U));                         // Resynchronization jump width is same as phase segment 2
-          }
-        }
-        if (val != ARM_DRIVER_OK) {                                                     // If previous SetBitrate failed try different bit settings
-          if ((clock % (10U*(CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {// If CAN base clock is divisible by 10 * nominal bitrate without remainder
-            val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                             // Set nominal bitrate
-                                   CAN_BR[bitrate]*1000U,                               // Set nominal bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (6U) |                         // Set propagation segment to 6 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(2U) |                         // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                                   ARM_CAN_BIT_SJW       (2U));                         // Resynchronization jump width is same as phase segment 2
-            if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,   // Set FD data phase bitrate
-                                   CAN_BR[bitrate]*1000U*CAN_DATA_ARB_RATIO,            // Set FD data phase bitrate to configured constant value
-                                   ARM_CAN_BIT_PROP_SEG  (6U) |                         // Set propagation segment to 6 time quanta
-                                   ARM_CAN_BIT_PHASE_SEG1(1U) |                         // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                                   ARM_CAN_BIT_PHASE_SEG2(2U) |                         // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                                   ARM_CAN_BIT_SJW       (2U));                         // Resynchronization jump width is same as phase segment 2
-          }
-        }
+        val = CAN_SetBitrates (CAN_BR[bitrate], CAN_DATA_ARB_RATIO);
         if (val != ARM_DRIVER_OK) {
           snprintf(str,sizeof(str),"[WARNING] Invalid FD bitrate: %dkbit/s, clock %dMHz", CAN_BR[bitrate]*CAN_DATA_ARB_RATIO, clock/1000000U);
           TEST_MESSAGE(str);
@@ -611,9 +813,8 @@ void CAN_Loopback_CheckBitrateFD (void) {
     }
   }
 
-  /* Power off and uninitialize*/
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
 }
 
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
@@ -621,16 +822,15 @@ void CAN_Loopback_CheckBitrateFD (void) {
 \brief  Function: CAN_Loopback_Transfer
 \details
 The test function \b CAN_Loopback_Transfer verifies the data transfers with the sequence:
- - Initialize
- - Power on
  - Set filter with standard ID
  - Transfer and check received data against sent data
  - Check filter with standard ID and remove it
  - Set filter with extended ID
  - Transfer and check received data against sent data
  - Check filter with extended ID and remove it
- - Power off
- - Uninitialize
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
 */
 void CAN_Loopback_Transfer (void) {
   int32_t val;
@@ -641,12 +841,6 @@ void CAN_Loopback_Transfer (void) {
   uint32_t tx_obj_idx = 0xFFFFFFFFU;
   uint32_t rx_obj_idx = 0xFFFFFFFFU;
 
-  /* Initialize with callback */
-  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
-
-  /* Power on */
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
-
   /* Check if loopback is available */
   capab = drv->GetCapabilities();
   if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
@@ -686,45 +880,7 @@ void CAN_Loopback_Transfer (void) {
     /* Get clock */
     clock = drv->GetClock();
 
-    val = ARM_DRIVER_ERROR;
-    if ((clock % (5U*(CAN_BR[0]*1000U))) == 0U) {                       // If CAN base clock is divisible by 5 * nominal bitrate without remainder
-      val = drv->SetBitrate   (ARM_CAN_BITRATE_NOMINAL,                 // Set nominal bitrate
-                               CAN_BR[0]*1000U,                         // Set nominal bitrate to configured constant value
-                               ARM_CAN_BIT_PROP_SEG  (2U) |             // Set propagation segment to 2 time quanta
-                               ARM_CAN_BIT_PHASE_SEG1(1U) |             // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                               ARM_CAN_BIT_PHASE_SEG2(1U) |             // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                               ARM_CAN_BIT_SJW       (1U));             // Resynchronization jump width is same as phase segment 2
-    }
-    if (val != ARM_DRIVER_OK) {                                         // If previous SetBitrate failed try different bit settings
-      if ((clock % (6U*(CAN_BR[0]*1000U))) == 0U) {                     // If CAN base clock is divisible by 6 * nominal bitrate without remainder
-        val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                 // Set nominal bitrate
-                               CAN_BR[0]*1000U,                         // Set nominal bitrate to configured constant value
-                               ARM_CAN_BIT_PROP_SEG  (3U) |             // Set propagation segment to 3 time quanta
-                               ARM_CAN_BIT_PHASE_SEG1(1U) |             // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                               ARM_CAN_BIT_PHASE_SEG2(1U) |             // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                               ARM_CAN_BIT_SJW       (1U));             // Resynchronization jump width is same as phase segment 2
-      }
-    }
-    if (val != ARM_DRIVER_OK) {                                         // If previous SetBitrate failed try different bit settings
-      if ((clock % (8U*(CAN_BR[0]*1000U))) == 0U) {                     // If CAN base clock is divisible by 8 * nominal bitrate without remainder
-        val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                 // Set nominal bitrate
-                               CAN_BR[0]*1000U,                         // Set nominal bitrate to configured constant value
-                               ARM_CAN_BIT_PROP_SEG  (5U) |             // Set propagation segment to 5 time quanta
-                               ARM_CAN_BIT_PHASE_SEG1(1U) |             // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                               ARM_CAN_BIT_PHASE_SEG2(1U) |             // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                               ARM_CAN_BIT_SJW       (1U));             // Resynchronization jump width is same as phase segment 2
-      }
-    }
-    if (val != ARM_DRIVER_OK) {                                         // If previous SetBitrate failed try different bit settings
-      if ((clock % (10U*(CAN_BR[0]*1000U))) == 0U) {                    // If CAN base clock is divisible by 10 * nominal bitrate without remainder
-        val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                 // Set nominal bitrate
-                               CAN_BR[0]*1000U,                         // Set nominal bitrate to configured constant value
-                               ARM_CAN_BIT_PROP_SEG  (6U) |             // Set propagation segment to 6 time quanta
-                               ARM_CAN_BIT_PHASE_SEG1(1U) |             // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                               ARM_CAN_BIT_PHASE_SEG2(2U) |             // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                               ARM_CAN_BIT_SJW       (2U));             // Resynchronization jump width is same as phase segment 2
-      }
-    }
+    val = CAN_SetBitrates (CAN_BR[0], 0U);
     if (val != ARM_DRIVER_OK) {
       snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[0], clock/1000000U);
       TEST_MESSAGE(str);
@@ -804,9 +960,8 @@ void CAN_Loopback_Transfer (void) {
     free(buffer_in);
   }
 
-  /* Power off and uninitialize*/
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
 }
 
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
@@ -814,16 +969,15 @@ void CAN_Loopback_Transfer (void) {
 \brief  Function: CAN_Loopback_TransferFD
 \details
 The test function \b CAN_Loopback_TransferFD verifies the data transfers with the sequence:
- - Initialize
- - Power on
  - Set filter with standard ID
  - Transfer and check received data against sent data
  - Check filter with standard ID and remove it
  - Set filter with extended ID
  - Transfer and check received data against sent data
  - Check filter with extended ID and remove it
- - Power off
- - Uninitialize
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
 */
 void CAN_Loopback_TransferFD (void) {
   int32_t val;
@@ -834,12 +988,6 @@ void CAN_Loopback_TransferFD (void) {
   uint32_t tx_obj_idx = 0xFFFFFFFFU;
   uint32_t rx_obj_idx = 0xFFFFFFFFU;
 
-  /* Initialize with callback */
-  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
-
-  /* Power on */
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
-
   /* Test FD mode */
   capab = drv->GetCapabilities();
   if (capab.fd_mode == 0U) {
@@ -884,69 +1032,7 @@ void CAN_Loopback_TransferFD (void) {
       /* Get clock */
       clock = drv->GetClock();
 
-      val = ARM_DRIVER_ERROR;
-      if ((clock % (5U*(CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {                  // If CAN base clock is divisible by 5 * nominal bitrate without remainder
-        val = drv->SetBitrate   (ARM_CAN_BITRATE_NOMINAL,                               // Set nominal bitrate
-                                 CAN_BR[0]*1000U,                                       // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (2U) |                           // Set propagation segment to 2 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-        if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,       // Set FD data phase bitrate
-                                 CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO,                    // Set FD data phase bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (2U) |                           // Set propagation segment to 2 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 80% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 5 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-      }
-      if (val != ARM_DRIVER_OK) {                                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (6U*(CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {                // If CAN base clock is divisible by 6 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                               // Set nominal bitrate
-                                 CAN_BR[0]*1000U,                                       // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (3U) |                           // Set propagation segment to 3 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-          if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,     // Set FD data phase bitrate
-                                 CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO,                    // Set FD data phase bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (3U) |                           // Set propagation segment to 3 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 83.3% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 6 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-        }
-      }
-      if (val != ARM_DRIVER_OK) {                                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (8U*(CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {                // If CAN base clock is divisible by 8 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                               // Set nominal bitrate
-                                 CAN_BR[0]*1000U,                                       // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (5U) |                           // Set propagation segment to 5 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-          if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,     // Set FD data phase bitrate
-                                 CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO,                    // Set FD data phase bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (5U) |                           // Set propagation segment to 5 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 87.5% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(1U) |                           // Set phase segment 2 to 1 time quantum (total bit is 8 time quanta long)
-                                 ARM_CAN_BIT_SJW       (1U));                           // Resynchronization jump width is same as phase segment 2
-        }
-      }
-      if (val != ARM_DRIVER_OK) {                                                       // If previous SetBitrate failed try different bit settings
-        if ((clock % (10U*(CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO))) == 0U) {               // If CAN base clock is divisible by 10 * nominal bitrate without remainder
-          val = drv->SetBitrate (ARM_CAN_BITRATE_NOMINAL,                               // Set nominal bitrate
-                                 CAN_BR[0]*1000U,                                       // Set nominal bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (6U) |                           // Set propagation segment to 6 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(2U) |                           // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                                 ARM_CAN_BIT_SJW       (2U));                           // Resynchronization jump width is same as phase segment 2
-          if (val == ARM_DRIVER_OK) val = drv->SetBitrate (ARM_CAN_BITRATE_FD_DATA,     // Set FD data phase bitrate
-                                 CAN_BR[0]*1000U*CAN_DATA_ARB_RATIO,                    // Set FD data phase bitrate to configured constant value
-                                 ARM_CAN_BIT_PROP_SEG  (6U) |                           // Set propagation segment to 6 time quanta
-                                 ARM_CAN_BIT_PHASE_SEG1(1U) |                           // Set phase segment 1 to 1 time quantum (sample point at 70% of bit time)
-                                 ARM_CAN_BIT_PHASE_SEG2(2U) |                           // Set phase segment 2 to 2 time quantum (total bit is 10 time quanta long)
-                                 ARM_CAN_BIT_SJW       (2U));                           // Resynchronization jump width is same as phase segment 2
-        }
-      }
+      val = CAN_SetBitrates (CAN_BR[0], CAN_DATA_ARB_RATIO);
       if (val != ARM_DRIVER_OK) {
         snprintf(str,sizeof(str),"[WARNING] Invalid FD bitrate: %dkbit/s, clock %dMHz", CAN_BR[0]*CAN_DATA_ARB_RATIO, clock/1000000U);
         TEST_MESSAGE(str);
@@ -1030,9 +1116,1542 @@ void CAN_Loopback_TransferFD (void) {
     }
   }
 
-  /* Power off and uninitialize*/
-  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+// Find object for receive and use all other transmit capable objects for transmit
+// filters: preferred receive object is 0 = receive only object, 1 = object supporting multiple filters
+// Returns number of transmit objects, rx_obj_idx is 0xFFFFFFFF if no object can receive
+static uint32_t CAN_FindObjects (uint32_t filters, uint32_t *rx_obj_idx, uint32_t *tx_obj_idx) {
+  uint32_t i, pref, tx_num;
+
+  *rx_obj_idx = 0xFFFFFFFFU;
+  for (i = 0U; i < capab.num_objects; i++) {
+    obj_capab = drv->ObjectGetCapabilities (i);
+    if (obj_capab.rx == 1U) {
+      pref = (filters != 0U) ? (obj_capab.multiple_filters != 0U) : (obj_capab.tx == 0U);
+      if ((*rx_obj_idx == 0xFFFFFFFFU) || (pref != 0U)) { *rx_obj_idx = i; }
+      if (pref != 0U) { break; }
+    }
+  }
+  tx_num = 0U;
+  for (i = 0U; (i < capab.num_objects) && (i < CAN_OBJ_MAX); i++) {
+    obj_capab = drv->ObjectGetCapabilities (i);
+    if ((obj_capab.tx == 1U) && (i != *rx_obj_idx)) { tx_obj_idx[tx_num++] = i; }
+  }
+  return tx_num;
+}
+
+// Send frames keeping all transmit objects busy until frames are received on the drained receive object
+// Returns number of received frames and elapsed time in ticks
+static uint32_t CAN_RunFlood (const uint32_t *tx_obj_idx, uint32_t tx_num, ARM_CAN_MSG_INFO *tx_msg_info, uint32_t size,
+                              uint32_t rx_obj_idx, uint32_t frames, uint32_t timeout_us, uint32_t *ticks) {
+  uint32_t i, sent, tick;
+
+  sent   = 0U;
+  Rx_cnt = 0U;
+  Obj_rx_drain[rx_obj_idx] = 1U;
+  tick = GET_SYSTICK();
+  while (Rx_cnt < frames) {
+    for (i = 0U; (i < tx_num) && (sent < frames); i++) {
+      if (Obj_tx_busy[tx_obj_idx[i]] == 0U) {
+        Obj_tx_busy[tx_obj_idx[i]] = 1U;
+        if (drv->MessageSend(tx_obj_idx[i], tx_msg_info, buffer_out, (uint8_t)size) == (int32_t)size) {
+          sent++;
+        } else {
+          Obj_tx_busy[tx_obj_idx[i]] = 0U;
+        }
+      }
+    }
+    if ((GET_SYSTICK() - tick) >= SYSTICK_MICROSEC(timeout_us)) {
+      break;
+    }
+  }
+  *ticks = GET_SYSTICK() - tick;
+  Obj_rx_drain[rx_obj_idx] = 0U;
+
+  return Rx_cnt;
+}
+
+// Wire time of an extended data frame including interframe space (stuff bits are not counted)
+// size:    data field size in bytes
+// bitrate: nominal bitrate in kbit/s
+// ratio:   data/arbitration bitrate ratio for CAN FD, 0 for classic CAN
+// Returns frame time in ns
+static uint32_t CAN_FrameTime (uint32_t size, uint32_t bitrate, uint32_t ratio) {
+
+  if (ratio == 0U) {
+    return (((size * 8U) + CAN_EXT_FRAME_BITS_CLASSIC + CAN_IFS_BITS) * 1000000U) / bitrate;
+  }
+  return ((((size * 8U) + CAN_FD_DATA_BITS_ISO + CAN_FD_CRC_BITS(size)) * 1000000U) / (bitrate * ratio)) +
+         ((( CAN_EXT_FRAME_BITS_NOMINAL + CAN_IFS_BITS)                  * 1000000U) /  bitrate         );
+}
+
+// CAN bus load benchmark
+// Saturates the loopback with frames from all available transmit objects at each configured bitrate
+// fd: 0 = classic CAN (8 byte payload), 1 = CAN FD (64 byte payload at CAN_DATA_ARB_RATIO)
+static void CAN_RunBusLoad (uint32_t fd) {
+  uint32_t i, bitrate, size, ratio, tx_num, load, rx_num;
+  uint32_t tx_obj_idx[CAN_OBJ_MAX];
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t frame_ns, timeout_us;
+  uint32_t ticks_measured, ticks_expected;
+  uint64_t frames_per_s;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+
+  size  = (fd != 0U) ? CAN_MSG_SIZE_FD    : CAN_MSG_SIZE;
+  ratio = (fd != 0U) ? CAN_DATA_ARB_RATIO : 0U;
+
+  /* Find object for receive (receive only object preferred), use all other transmit capable objects for transmit */
+  tx_num = CAN_FindObjects(0U, &rx_obj_idx, tx_obj_idx);
+  if ((rx_obj_idx == 0xFFFFFFFFU) || (tx_num == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit or receive object available");
+    return;
+  }
+  snprintf(str,sizeof(str),"[INFO] Using %d transmit object(s)", tx_num);
+  TEST_MESSAGE(str);
+
+  /* Set output buffer with all data = 0x55 to avoid CAN bit stuffing */
+  memset(buffer_out,0x55U,size);
+
+  for (bitrate=0; bitrate<CAN_BR_NUM; bitrate++) {
+
+    /* Activate initialization mode */
+    TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+    if (CAN_SetBitrates (CAN_BR[bitrate], ratio) != ARM_DRIVER_OK) {
+      snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[bitrate], drv->GetClock()/1000000U);
+      TEST_MESSAGE(str);
+      continue;
+    }
+
+    if (capab.external_loopback == 1U) {
+      // Activate loopback external mode
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+    } else if (capab.internal_loopback == 1U) {
+      // Activate loopback internal mode
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+    }
+
+    if (fd != 0U) {
+      /* Set FD mode */
+      TEST_ASSERT(drv->Control (ARM_CAN_SET_FD_MODE, 1) == ARM_DRIVER_OK);
+    }
+
+    /* ObjectSetFilter add extended exact ID 0x15555555 */
+    TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_ADD, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+
+    /* ObjectConfigure for tx and rx objects */
+    for (i = 0U; i < tx_num; i++) {
+      TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx[i], ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+      Obj_tx_busy[tx_obj_idx[i]] = 0U;
+    }
+    TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx, ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+
+    memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+    tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(0x15555555U);
+    if (fd != 0U) {
+      tx_data_msg_info.edl = 1U;
+      tx_data_msg_info.brs = 1U;
+    }
+
+    /* Frame time on the wire including interframe space (ns) */
+    frame_ns   = CAN_FrameTime (size, CAN_BR[bitrate], ratio);
+    timeout_us = (uint32_t)(((uint64_t)frame_ns * CAN_BUS_LOAD_FRAMES * 2U) / 1000U) + CAN_TRANSFER_TIMEOUT;
+
+    /* Keep all transmit objects busy until all frames are sent */
+    rx_num = CAN_RunFlood (tx_obj_idx, tx_num, &tx_data_msg_info, size, rx_obj_idx, CAN_BUS_LOAD_FRAMES, timeout_us, &ticks_measured);
+
+    if (rx_num < CAN_BUS_LOAD_FRAMES) {
+      snprintf(str,sizeof(str),"[FAILED] At %dkbit/s: received %d of %d frames", CAN_BR[bitrate], rx_num, CAN_BUS_LOAD_FRAMES);
+      TEST_FAIL_MESSAGE(str);
+    } else {
+      TEST_PASS();
+
+      ticks_expected   = SYSTICK_MICROSEC(((uint64_t)frame_ns * CAN_BUS_LOAD_FRAMES) / 1000U);
+      frames_per_s     = ((uint64_t)CAN_BUS_LOAD_FRAMES * SYSTICK_MICROSEC(1000000U)) / ticks_measured;
+      load             = (uint32_t)(((uint64_t)ticks_expected * 100U) / ticks_measured);
+
+      snprintf(str,sizeof(str),"frame_rate_%dkbit", CAN_BR[bitrate]);
+      TEST_METRIC_HIGHER(str, frames_per_s, "frames/s", METRIC_NO_THRESHOLD);
+      if (load > 100U) {
+        /* Measured time is shorter than the frames need on the wire: timer or bit timing is wrong */
+        snprintf(str,sizeof(str),"[WARNING] At %dkbit/s: bus load %d%% exceeds 100%%, not recorded", CAN_BR[bitrate], load);
+        TEST_MESSAGE(str);
+      } else {
+        snprintf(str,sizeof(str),"bus_load_%dkbit", CAN_BR[bitrate]);
+        TEST_METRIC_HIGHER(str, load, "%", METRIC_NO_THRESHOLD);
+      }
+      if (load < CAN_BUS_LOAD_MIN) {
+        snprintf(str,sizeof(str),"[WARNING] At %dkbit/s: bus load %d%% is below %d%%", CAN_BR[bitrate], load, CAN_BUS_LOAD_MIN);
+        TEST_MESSAGE(str);
+      }
+    }
+
+    /* ObjectSetFilter remove extended exact ID 0x15555555 */
+    TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_REMOVE, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+  }
+}
+
+// CAN latency measurement
+// Sends frames one at a time and timestamps the TX request, the send complete and receive events and the MessageRead return
+// fd: 0 = classic CAN (8 byte payload), 1 = CAN FD (64 byte payload at CAN_DATA_ARB_RATIO)
+static void CAN_RunLatency (uint32_t fd) {
+  // Histogram bucket upper limits in % of wire time (last bucket is open)
+  static const uint32_t hist_lim[] = { 100U, 105U, 110U, 125U, 150U, 200U, 400U };
+  uint32_t hist[ARRAY_SIZE(hist_lim) + 1U];
+  uint32_t i, n, bitrate, size, ratio, done, cnt, send_err, pct;
+  uint32_t tx_obj_idx = 0xFFFFFFFFU;
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t wire_ns, wire_ticks, tick_req, tick_tx, tick_rx, tick_read;
+  uint32_t *lat_tx, *lat_rx, *lat_read;
+  uint64_t ticks_per_s;
+  CAN_OBJ_EVENT    evt;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+  ARM_CAN_MSG_INFO rx_data_msg_info;
+
+  size  = (fd != 0U) ? CAN_MSG_SIZE_FD    : CAN_MSG_SIZE;
+  ratio = (fd != 0U) ? CAN_DATA_ARB_RATIO : 0U;
+
+  /* Find first available object for receive and transmit */
+  for (i = 0U; i < capab.num_objects; i++) {
+    obj_capab = drv->ObjectGetCapabilities (i);
+    if      ((tx_obj_idx == 0xFFFFFFFFU) && (obj_capab.tx == 1U)) { tx_obj_idx = i; }
+    else if ((rx_obj_idx == 0xFFFFFFFFU) && (obj_capab.rx == 1U)) { rx_obj_idx = i; }
+  }
+
+  /* Allocate sample buffers */
+  lat_tx   = (uint32_t*) malloc(CAN_LATENCY_FRAMES*sizeof(uint32_t));
+  lat_rx   = (uint32_t*) malloc(CAN_LATENCY_FRAMES*sizeof(uint32_t));
+  lat_read = (uint32_t*) malloc(CAN_LATENCY_FRAMES*sizeof(uint32_t));
+  TEST_ASSERT((lat_tx != NULL) && (lat_rx != NULL) && (lat_read != NULL));
+
+  if ((lat_tx != NULL) && (lat_rx != NULL) && (lat_read != NULL)) {
+
+    /* Set output buffer with all data = 0x55 to avoid CAN bit stuffing */
+    memset(buffer_out,0x55U,size);
+
+    ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+    for (bitrate=0; bitrate<CAN_BR_NUM; bitrate++) {
+
+      /* Activate initialization mode */
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+      if (CAN_SetBitrates (CAN_BR[bitrate], ratio) != ARM_DRIVER_OK) {
+        snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[bitrate], drv->GetClock()/1000000U);
+        TEST_MESSAGE(str);
+        continue;
+      }
+
+      if (capab.external_loopback == 1U) {
+        // Activate loopback external mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+      } else if (capab.internal_loopback == 1U) {
+        // Activate loopback internal mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+      }
+
+      if (fd != 0U) {
+        /* Set FD mode */
+        TEST_ASSERT(drv->Control (ARM_CAN_SET_FD_MODE, 1) == ARM_DRIVER_OK);
+      }
+
+      /* ObjectSetFilter add extended exact ID 0x15555555 */
+      TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_ADD, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+
+      /* ObjectConfigure for tx and rx objects */
+      TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx, ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+      TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx, ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+
+      memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+      tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(0x15555555U);
+      if (fd != 0U) {
+        tx_data_msg_info.edl = 1U;
+        tx_data_msg_info.brs = 1U;
+      }
+
+      /* Expected frame time on the wire including interframe space (ns) */
+      wire_ns    = CAN_FrameTime (size, CAN_BR[bitrate], ratio);
+      wire_ticks = (uint32_t)(((uint64_t)wire_ns * ticks_per_s) / 1000000000U);
+
+      /* Send frames one at a time and collect timestamps */
+      cnt      = 0U;
+      send_err = 0U;
+      for (n = 0U; n < CAN_LATENCY_FRAMES; n++) {
+        CAN_ObjEventFlush ();
+        done      = 0U;
+        tick_tx   = 0U;
+        tick_rx   = 0U;
+        tick_read = 0U;
+        tick_req  = GET_SYSTICK();
+        if (drv->MessageSend(tx_obj_idx, &tx_data_msg_info, buffer_out, (uint8_t)size) != (int32_t)size) {
+          send_err++;                   /* Frame rejected by driver, no latency sample */
+          continue;
+        }
+        do {
+          if (CAN_ObjEventGet (&evt) != 0U) {
+            if ((evt.obj_idx == tx_obj_idx) && ((evt.event & ARM_CAN_EVENT_SEND_COMPLETE) != 0U)) {
+              tick_tx = evt.tick;
+              done   |= 1U;
+            }
+            if ((evt.obj_idx == rx_obj_idx) && ((evt.event & ARM_CAN_EVENT_RECEIVE) != 0U)) {
+              drv->MessageRead(rx_obj_idx, &rx_data_msg_info, buffer_in, (uint8_t)size);
+              tick_read = GET_SYSTICK();
+              tick_rx   = evt.tick;
+              done     |= 2U;
+            }
+          }
+        } while ((done != 3U) && ((GET_SYSTICK() - tick_req) < SYSTICK_MICROSEC(CAN_TRANSFER_TIMEOUT)));
+
+        if (done == 3U) {
+          lat_tx  [cnt] = tick_tx   - tick_req;
+          lat_rx  [cnt] = tick_rx   - tick_req;
+          lat_read[cnt] = tick_read - tick_rx;
+          cnt++;
+        }
+      }
+
+      if (send_err != 0U) {
+        snprintf(str,sizeof(str),"[FAILED] At %dkbit/s: MessageSend failed for %d of %d frames", CAN_BR[bitrate], send_err, CAN_LATENCY_FRAMES);
+        TEST_FAIL_MESSAGE(str);
+      }
+      if ((cnt + send_err) < CAN_LATENCY_FRAMES) {
+        snprintf(str,sizeof(str),"[FAILED] At %dkbit/s: %d of %d frames not transferred", CAN_BR[bitrate], CAN_LATENCY_FRAMES - send_err - cnt, CAN_LATENCY_FRAMES);
+        TEST_FAIL_MESSAGE(str);
+      }
+      if (cnt == CAN_LATENCY_FRAMES) {
+        TEST_PASS();
+      }
+
+      if (cnt != 0U) {
+        /* Histogram of TX request to receive event latency in % of wire time */
+        memset(hist, 0, sizeof(hist));
+        for (i = 0U; i < cnt; i++) {
+          pct = (wire_ticks != 0U) ? (uint32_t)(((uint64_t)lat_rx[i] * 100U) / wire_ticks) : 0U;
+          hist[HISTOGRAM_BUCKET(hist_lim, pct)]++;
+        }
+
+        snprintf(str,sizeof(str),"[INFO] At %dkbit/s%s: %d frames, wire time %d us", CAN_BR[bitrate], (fd != 0U) ? " (FD)" : "", cnt, wire_ns / 1000U);
+        TEST_MESSAGE(str);
+        TEST_PERCENTILES("TX request to send complete",  lat_tx,   cnt, ticks_per_s);
+        TEST_PERCENTILES("TX request to receive event",  lat_rx,   cnt, ticks_per_s);
+        TEST_PERCENTILES("Receive event to read return", lat_read, cnt, ticks_per_s);
+        TEST_HISTOGRAM  ("Receive latency histogram (% of wire time)", hist, hist_lim);
+
+        /* lat_rx is sorted by TEST_PERCENTILES */
+        snprintf(str,sizeof(str),"rx_latency_p99_%dkbit", CAN_BR[bitrate]);
+        TEST_METRIC_LOWER(str, ((uint64_t)lat_rx[((cnt - 1U) * 99U) / 100U] * 1000000U) / ticks_per_s, "us", METRIC_NO_THRESHOLD);
+        pct = (wire_ticks != 0U) ? (uint32_t)(((uint64_t)lat_rx[((cnt - 1U) * 99U) / 100U] * 100U) / wire_ticks) : 0U;
+        if (pct > CAN_LATENCY_MAX) {
+          snprintf(str,sizeof(str),"[WARNING] At %dkbit/s: p99 receive latency is %d%% of wire time", CAN_BR[bitrate], pct);
+          TEST_MESSAGE(str);
+        }
+      }
+
+      /* ObjectSetFilter remove extended exact ID 0x15555555 */
+      TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_REMOVE, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+    }
+  }
+
+  /* Free sample buffers */
+  free(lat_tx);
+  free(lat_rx);
+  free(lat_read);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_BusLoad
+\details
+The test function \b CAN_Loopback_BusLoad measures the sustained transfer rate with the sequence:
+ - For each configured bitrate:
+   - Change bitrate
+   - Send the configured number of 8 byte frames, keeping all available transmit objects busy
+   - Record metrics \c frame_rate_<bitrate>kbit (frames/s) and \c bus_load_<bitrate>kbit (% of the theoretical maximum,
+     a load above 100% is reported as warning and not recorded)
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_BusLoad (void) {
+
+  /* Check if loopback is available */
+  capab = drv->GetCapabilities();
+  if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+
+    if (buffer_out != NULL) {
+      CAN_RunBusLoad (0U);
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_BusLoadFD
+\details
+The test function \b CAN_Loopback_BusLoadFD measures the sustained CAN FD transfer rate with the sequence:
+ - For each configured bitrate:
+   - Change nominal and data phase bitrate (data phase bitrate is ratio data/arbitration bitrate times the nominal bitrate)
+   - Send the configured number of 64 byte frames, keeping all available transmit objects busy
+   - Record metrics \c frame_rate_<bitrate>kbit (frames/s) and \c bus_load_<bitrate>kbit (% of the theoretical maximum,
+     a load above 100% is reported as warning and not recorded)
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_BusLoadFD (void) {
+
+  /* Test FD mode */
+  capab = drv->GetCapabilities();
+  if (capab.fd_mode == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support FD mode");
+  } else {
+
+    /* Check if loopback is available */
+    if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+    } else {
+
+      /* Allocate buffer */
+      buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE_FD*sizeof(uint8_t));
+      TEST_ASSERT(buffer_out != NULL);
+
+      if (buffer_out != NULL) {
+        CAN_RunBusLoad (1U);
+      }
+
+      /* Free buffer */
+      free(buffer_out);
+    }
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_MultiObject
+\details
+The test function \b CAN_Loopback_MultiObject verifies concurrent transfers over all available objects with the sequence:
+ - Split objects into transmit and receive objects
+ - Assign one stream (extended ID) per object, each receive object gets an exact, range or maskable filter per stream
+ - Stream numbered frames over all transmit objects concurrently
+ - Check that frames of each ID are received in order
+ - Report per object throughput and object event callback execution time
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_MultiObject (void) {
+  uint32_t i, j, k, tx_num, rx_num, streams, active, total, sent;
+  uint32_t tx_obj_idx[CAN_OBJ_MAX];
+  uint32_t rx_obj_idx[CAN_OBJ_MAX];
+  uint32_t tx_cursor [CAN_OBJ_MAX];
+  uint32_t tx_seq    [CAN_OBJ_MAX];
+  uint8_t  stream_flt[CAN_OBJ_MAX];
+  uint32_t id, tick, ticks_measured, timeout_us, seq_err;
+  int32_t  val;
+  uint64_t ticks_per_s;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+  ARM_CAN_OBJ_CAPABILITIES rx_capab;
+
+  /* Check if loopback is available */
+  capab = drv->GetCapabilities();
+  if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+
+    /* Split objects: transmit only and receive only objects are used as such, */
+    /* objects capable of both directions are used to balance both lists       */
+    tx_num = 0U;
+    rx_num = 0U;
+    for (i = 0U; (i < capab.num_objects) && (i < CAN_OBJ_MAX); i++) {
+      obj_capab = drv->ObjectGetCapabilities (i);
+      if ((obj_capab.tx == 1U) && (obj_capab.rx == 0U)) { tx_obj_idx[tx_num++] = i; }
+      if ((obj_capab.tx == 0U) && (obj_capab.rx == 1U)) { rx_obj_idx[rx_num++] = i; }
+    }
+    for (i = 0U; (i < capab.num_objects) && (i < CAN_OBJ_MAX); i++) {
+      obj_capab = drv->ObjectGetCapabilities (i);
+      if ((obj_capab.tx == 1U) && (obj_capab.rx == 1U)) {
+        if (rx_num <= tx_num) { rx_obj_idx[rx_num++] = i; }
+        else                  { tx_obj_idx[tx_num++] = i; }
+      }
+    }
+
+    if ((buffer_out != NULL) && ((tx_num == 0U) || (rx_num == 0U))) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit or receive object available");
+    } else if (buffer_out != NULL) {
+      snprintf(str,sizeof(str),"[INFO] Using %d transmit and %d receive objects", tx_num, rx_num);
+      TEST_MESSAGE(str);
+
+      /* Activate initialization mode */
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+      if (CAN_SetBitrates (CAN_BR[0], 0U) != ARM_DRIVER_OK) {
+        snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[0], drv->GetClock()/1000000U);
+        TEST_MESSAGE(str);
+      } else TEST_PASS();
+
+      if (capab.external_loopback != 0U) {
+        // Activate loopback external mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+      } else if (capab.internal_loopback == 1U) {
+        // Activate loopback internal mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+      }
+
+      /* Stream j is sent by transmit object (j % tx_num) and received by receive object (j % rx_num) */
+      streams = (tx_num > rx_num) ? tx_num : rx_num;
+      active  = 0U;
+      for (j = 0U; j < streams; j++) {
+        id       = CAN_MULTI_OBJ_ID + j;
+        k        = rx_obj_idx[j % rx_num];
+        rx_capab = drv->ObjectGetCapabilities (k);
+
+        /* Use a different filter type for consecutive streams, as supported by the receive object */
+        /* (stream filter: 0 = none, 1 = exact, 2 = range, 3 = maskable)                          */
+        stream_flt[j] = 0U;
+        val = ARM_DRIVER_ERROR;
+        if        (((j % 3U) == 1U) && (rx_capab.range_filtering != 0U)) {
+          val = drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_RANGE_ADD,    ARM_CAN_EXTENDED_ID(id), ARM_CAN_EXTENDED_ID(id));
+          if (val == ARM_DRIVER_OK) { stream_flt[j] = 2U; }
+        } else if (((j % 3U) == 2U) && (rx_capab.mask_filtering  != 0U)) {
+          val = drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_MASKABLE_ADD, ARM_CAN_EXTENDED_ID(id), 0x1FFFFFFFU);
+          if (val == ARM_DRIVER_OK) { stream_flt[j] = 3U; }
+        }
+        if (val != ARM_DRIVER_OK) {
+          val = drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_EXACT_ADD,    ARM_CAN_EXTENDED_ID(id), 0U);
+          if (val == ARM_DRIVER_OK) { stream_flt[j] = 1U; }
+        }
+        if (val != ARM_DRIVER_OK) {
+          snprintf(str,sizeof(str),"[WARNING] Object %d: unable to add filter for ID 0x%08X, stream not used", k, id);
+          TEST_MESSAGE(str);
+        } else {
+          active++;
+        }
+        tx_seq[j]        = 0U;
+        Id_rx_seq[j]     = 0U;
+        Id_rx_seq_err[j] = 0U;
+      }
+
+      /* ObjectConfigure for tx and rx objects */
+      for (i = 0U; i < tx_num; i++) {
+        TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx[i], ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+        Obj_tx_busy[tx_obj_idx[i]] = 0U;
+        tx_cursor[i] = i;
+      }
+      for (i = 0U; i < rx_num; i++) {
+        TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx[i], ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+        Obj_rx_cnt  [rx_obj_idx[i]] = 0U;
+        Obj_rx_drain[rx_obj_idx[i]] = 1U;
+      }
+
+      memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+      memset(buffer_out, 0x55U, CAN_MSG_SIZE);
+
+      total      = active * CAN_MULTI_OBJ_FRAMES;
+      timeout_us = CAN_TRANSFER_TIMEOUT + (uint32_t)(((uint64_t)total * 2U * CAN_FrameTime (CAN_MSG_SIZE, CAN_BR[0], 0U)) / 1000U);
+      sent       = 0U;
+      Rx_cnt     = 0U;
+      Cb_cnt     = 0U;
+      Cb_ticks   = 0U;
+
+      /* Each transmit object sends its streams round robin, a stream is only sent by one object so its order is defined */
+      tick = GET_SYSTICK();
+      while (Rx_cnt < total) {
+        for (i = 0U; (i < tx_num) && (sent < total); i++) {
+          if (Obj_tx_busy[tx_obj_idx[i]] != 0U) {
+            continue;
+          }
+          for (k = 0U; k < streams; k += tx_num) {
+            j = tx_cursor[i];
+            tx_cursor[i] = ((j + tx_num) < streams) ? (j + tx_num) : i;
+            if ((stream_flt[j] != 0U) && (tx_seq[j] < CAN_MULTI_OBJ_FRAMES)) {
+              break;
+            }
+            j = streams;
+          }
+          if (j >= streams) {
+            continue;
+          }
+          buffer_out[0] = (uint8_t)(tx_seq[j]);
+          buffer_out[1] = (uint8_t)(tx_seq[j] >>  8);
+          buffer_out[2] = (uint8_t)(tx_seq[j] >> 16);
+          buffer_out[3] = (uint8_t)(tx_seq[j] >> 24);
+          id = CAN_MULTI_OBJ_ID + j;
+          tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(id);
+          Obj_tx_busy[tx_obj_idx[i]] = 1U;
+          if (drv->MessageSend(tx_obj_idx[i], &tx_data_msg_info, buffer_out, CAN_MSG_SIZE) == (int32_t)CAN_MSG_SIZE) {
+            tx_seq[j]++;
+            sent++;
+          } else {
+            Obj_tx_busy[tx_obj_idx[i]] = 0U;
+          }
+        }
+        if ((GET_SYSTICK() - tick) >= SYSTICK_MICROSEC(timeout_us)) {
+          break;
+        }
+      }
+      ticks_measured = GET_SYSTICK() - tick;
+
+      for (i = 0U; i < rx_num; i++) {
+        Obj_rx_drain[rx_obj_idx[i]] = 0U;
+      }
+
+      if (Rx_cnt < total) {
+        snprintf(str,sizeof(str),"[FAILED] Received %d of %d frames (%d sent)", Rx_cnt, total, sent);
+        TEST_FAIL_MESSAGE(str);
+      } else TEST_PASS();
+
+      /* Check ordering per ID */
+      seq_err = 0U;
+      for (j = 0U; j < streams; j++) {
+        if (Id_rx_seq_err[j] != 0U) {
+          snprintf(str,sizeof(str),"[FAILED] ID 0x%08X: %d frame(s) received out of order", CAN_MULTI_OBJ_ID + j, Id_rx_seq_err[j]);
+          TEST_FAIL_MESSAGE(str);
+          seq_err++;
+        }
+      }
+      if (seq_err == 0U) { TEST_PASS(); }
+
+      /* Report per object throughput */
+      ticks_per_s = SYSTICK_MICROSEC(1000000U);
+      if (ticks_measured != 0U) {
+        for (i = 0U; i < rx_num; i++) {
+          snprintf(str,sizeof(str),"[INFO] Object %d: %d frames received, %d frames/s",
+                   rx_obj_idx[i], Obj_rx_cnt[rx_obj_idx[i]], (uint32_t)(((uint64_t)Obj_rx_cnt[rx_obj_idx[i]] * ticks_per_s) / ticks_measured));
+          TEST_MESSAGE(str);
+        }
+      }
+      if (Cb_cnt != 0U) {
+        snprintf(str,sizeof(str),"[INFO] Object event callback: %d events, average execution time %d ns",
+                 Cb_cnt, (uint32_t)(((uint64_t)Cb_ticks * 1000000000U) / ((uint64_t)Cb_cnt * ticks_per_s)));
+        TEST_MESSAGE(str);
+      }
+
+      /* Remove filters */
+      for (j = 0U; j < streams; j++) {
+        id = CAN_MULTI_OBJ_ID + j;
+        k  = rx_obj_idx[j % rx_num];
+        switch (stream_flt[j]) {
+          case 1U:
+            TEST_ASSERT(drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_EXACT_REMOVE,    ARM_CAN_EXTENDED_ID(id), 0U) == ARM_DRIVER_OK);
+            break;
+          case 2U:
+            TEST_ASSERT(drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_RANGE_REMOVE,    ARM_CAN_EXTENDED_ID(id), ARM_CAN_EXTENDED_ID(id)) == ARM_DRIVER_OK);
+            break;
+          case 3U:
+            TEST_ASSERT(drv->ObjectSetFilter(k, ARM_CAN_FILTER_ID_MASKABLE_REMOVE, ARM_CAN_EXTENDED_ID(id), 0x1FFFFFFFU) == ARM_DRIVER_OK);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_Burst
+\details
+The test function \b CAN_Loopback_Burst verifies reception of back-to-back frames with the sequence:
+ - For each configured bitrate:
+   - Change bitrate
+   - Send a burst of frames keeping all available transmit objects busy
+   - Read received frames in the test thread from the object event ring
+   - Report inter-frame arrival time (min/avg/max) against the frame time on the wire
+   - Check for lost frames, receive overruns and lost object events
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_Burst (void) {
+  uint32_t i, bitrate, tx_num, sent, received, overrun, lost;
+  uint32_t tx_obj_idx[CAN_OBJ_MAX];
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t tick, tick_last, delta, delta_min, delta_max;
+  uint32_t frame_ns, timeout_us;
+  uint64_t delta_sum, ticks_per_s;
+  CAN_OBJ_EVENT    evt;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+  ARM_CAN_MSG_INFO rx_data_msg_info;
+
+  /* Check if loopback is available */
+  capab = drv->GetCapabilities();
+  if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+    buffer_in = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_in != NULL);
+
+    /* Find object for receive (receive only object preferred), use all other transmit capable objects for transmit */
+    tx_num = CAN_FindObjects(0U, &rx_obj_idx, tx_obj_idx);
+
+    if ((rx_obj_idx == 0xFFFFFFFFU) || (tx_num == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit or receive object available");
+    } else if ((buffer_out != NULL) && (buffer_in != NULL)) {
+
+      obj_capab = drv->ObjectGetCapabilities (rx_obj_idx);
+      snprintf(str,sizeof(str),"[INFO] Using %d transmit object(s), receive object message depth %d", tx_num, obj_capab.message_depth);
+      TEST_MESSAGE(str);
+
+      /* Set output buffer with all data = 0x55 to avoid CAN bit stuffing */
+      memset(buffer_out,0x55U,CAN_MSG_SIZE);
+
+      memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+      tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(0x15555555U);
+
+      ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+      for (bitrate=0; bitrate<CAN_BR_NUM; bitrate++) {
+
+        /* Activate initialization mode */
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+        if (CAN_SetBitrates (CAN_BR[bitrate], 0U) != ARM_DRIVER_OK) {
+          snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[bitrate], drv->GetClock()/1000000U);
+          TEST_MESSAGE(str);
+          continue;
+        }
+
+        if (capab.external_loopback == 1U) {
+          // Activate loopback external mode
+          TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+        } else if (capab.internal_loopback == 1U) {
+          // Activate loopback internal mode
+          TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+        }
+
+        /* ObjectSetFilter add extended exact ID 0x15555555 */
+        TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_ADD, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+
+        /* ObjectConfigure for tx and rx objects */
+        for (i = 0U; i < tx_num; i++) {
+          TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx[i], ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+          Obj_tx_busy[tx_obj_idx[i]] = 0U;
+        }
+        TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx, ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+
+        frame_ns   = CAN_FrameTime (CAN_MSG_SIZE, CAN_BR[bitrate], 0U);
+        timeout_us = (uint32_t)(((uint64_t)frame_ns * CAN_BURST_FRAMES * 2U) / 1000U) + CAN_TRANSFER_TIMEOUT;
+
+        sent      = 0U;
+        received  = 0U;
+        overrun   = 0U;
+        tick_last = 0U;
+        delta_min = 0xFFFFFFFFU;
+        delta_max = 0U;
+        delta_sum = 0U;
+
+        CAN_ObjEventFlush ();
+        tick = GET_SYSTICK();
+        while (received < CAN_BURST_FRAMES) {
+          /* Refill free transmit objects */
+          for (i = 0U; (i < tx_num) && (sent < CAN_BURST_FRAMES); i++) {
+            if (Obj_tx_busy[tx_obj_idx[i]] == 0U) {
+              Obj_tx_busy[tx_obj_idx[i]] = 1U;
+              if (drv->MessageSend(tx_obj_idx[i], &tx_data_msg_info, buffer_out, CAN_MSG_SIZE) == (int32_t)CAN_MSG_SIZE) {
+                sent++;
+              } else {
+                Obj_tx_busy[tx_obj_idx[i]] = 0U;
+              }
+            }
+          }
+          /* Drain object events */
+          while (CAN_ObjEventGet (&evt) != 0U) {
+            if (evt.obj_idx != rx_obj_idx) {
+              continue;
+            }
+            if ((evt.event & ARM_CAN_EVENT_RECEIVE_OVERRUN) != 0U) {
+              overrun++;
+            }
+            if ((evt.event & ARM_CAN_EVENT_RECEIVE) != 0U) {
+              drv->MessageRead(rx_obj_idx, &rx_data_msg_info, buffer_in, CAN_MSG_SIZE);
+              if (received != 0U) {
+                delta = evt.tick - tick_last;
+                if (delta < delta_min) { delta_min = delta; }
+                if (delta > delta_max) { delta_max = delta; }
+                delta_sum += delta;
+              }
+              tick_last = evt.tick;
+              received++;
+            }
+          }
+          if ((sent == CAN_BURST_FRAMES) && ((received + overrun) >= CAN_BURST_FRAMES)) {
+            break;
+          }
+          if ((GET_SYSTICK() - tick) >= SYSTICK_MICROSEC(timeout_us)) {
+            break;
+          }
+        }
+
+        lost = CAN_ObjEventLost ();
+        if ((received < CAN_BURST_FRAMES) || (overrun != 0U) || (lost != 0U)) {
+          snprintf(str,sizeof(str),"[FAILED] At %dkbit/s: received %d of %d frames, %d overrun(s), %d lost event(s)",
+                   CAN_BR[bitrate], received, CAN_BURST_FRAMES, overrun, lost);
+          TEST_FAIL_MESSAGE(str);
+        } else TEST_PASS();
+
+        if (received > 1U) {
+          snprintf(str,sizeof(str),"[INFO] At %dkbit/s: inter-frame arrival min/avg/max %d/%d/%d us, frame time %d us",
+                   CAN_BR[bitrate],
+                   (uint32_t)(((uint64_t)delta_min * 1000000U) / ticks_per_s),
+                   (uint32_t)((delta_sum * 1000000U) / (ticks_per_s * (received - 1U))),
+                   (uint32_t)(((uint64_t)delta_max * 1000000U) / ticks_per_s),
+                   frame_ns / 1000U);
+          TEST_MESSAGE(str);
+        }
+
+        /* ObjectSetFilter remove extended exact ID 0x15555555 */
+        TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_REMOVE, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+      }
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+    free(buffer_in);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_Latency
+\details
+The test function \b CAN_Loopback_Latency measures transfer latency and jitter with the sequence:
+ - For each configured bitrate:
+   - Change bitrate
+   - Send frames of 8 bytes one at a time
+   - Timestamp TX request, send complete event, receive event and MessageRead return
+   - Report min/p50/p90/p99/max latencies and a receive latency histogram against the expected wire time
+   - Record metric \c rx_latency_p99_<bitrate>kbit (us)
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_Latency (void) {
+
+  /* Check if loopback is available */
+  capab = drv->GetCapabilities();
+  if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+    buffer_in = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_in != NULL);
+
+    if ((buffer_out != NULL) && (buffer_in != NULL)) {
+      CAN_RunLatency (0U);
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+    free(buffer_in);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_LatencyFD
+\details
+The test function \b CAN_Loopback_LatencyFD measures CAN FD transfer latency and jitter with the sequence:
+ - For each configured bitrate:
+   - Change nominal and data phase bitrate
+   - Send frames of 64 bytes one at a time
+   - Timestamp TX request, send complete event, receive event and MessageRead return
+   - Report min/p50/p90/p99/max latencies and a receive latency histogram against the expected wire time
+   - Record metric \c rx_latency_p99_<bitrate>kbit (us)
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_LatencyFD (void) {
+
+  /* Test FD mode */
+  capab = drv->GetCapabilities();
+  if (capab.fd_mode == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support FD mode");
+  } else {
+
+    /* Check if loopback is available */
+    if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+    } else {
+
+      /* Allocate buffer */
+      buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE_FD*sizeof(uint8_t));
+      TEST_ASSERT(buffer_out != NULL);
+      buffer_in = (uint8_t*) malloc(CAN_MSG_SIZE_FD*sizeof(uint8_t));
+      TEST_ASSERT(buffer_in != NULL);
+
+      if ((buffer_out != NULL) && (buffer_in != NULL)) {
+        CAN_RunLatency (1U);
+      }
+
+      /* Free buffer */
+      free(buffer_out);
+      free(buffer_in);
+    }
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+// Add or remove filter scaling test filter f on object obj_idx
+// type: 0 = exact, 1 = range, 2 = maskable
+static int32_t CAN_FilterSet (uint32_t obj_idx, uint32_t f, uint32_t type, uint32_t add) {
+  uint32_t id_min, id_max;
+
+  id_min = CAN_FILTER_ID + (f * CAN_FILTER_BLOCK);
+  id_max = id_min + 3U;
+  switch (type) {
+    case 1U:
+      return drv->ObjectSetFilter(obj_idx, (add != 0U) ? ARM_CAN_FILTER_ID_RANGE_ADD    : ARM_CAN_FILTER_ID_RANGE_REMOVE,
+                                  ARM_CAN_EXTENDED_ID(id_min), ARM_CAN_EXTENDED_ID(id_max));
+    case 2U:
+      return drv->ObjectSetFilter(obj_idx, (add != 0U) ? ARM_CAN_FILTER_ID_MASKABLE_ADD : ARM_CAN_FILTER_ID_MASKABLE_REMOVE,
+                                  ARM_CAN_EXTENDED_ID(id_min), 0x1FFFFFFCU);
+    default:
+      return drv->ObjectSetFilter(obj_idx, (add != 0U) ? ARM_CAN_FILTER_ID_EXACT_ADD    : ARM_CAN_FILTER_ID_EXACT_REMOVE,
+                                  ARM_CAN_EXTENDED_ID(id_min), 0U);
+  }
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_FilterScaling
+\details
+The test function \b CAN_Loopback_FilterScaling verifies acceptance filtering with many filters with the sequence:
+ - Set the highest configured bitrate
+ - Add exact, range and maskable filters (as supported) to the receive object until the driver refuses more
+ - For 1, 2, 4, ... up to all accepted filters:
+   - Send frames with IDs alternating between accepted and rejected IDs of the active filters
+   - Check that no rejected frame is received and no accepted frame is lost
+   - Report lost and leaked (rejected but received) frame counts and the object event callback execution time
+ - Remove filters
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_FilterScaling (void) {
+  uint32_t i, f, n, types, flt_num, bitrate, tx_num, sent, expected;
+  uint32_t tx_obj_idx[CAN_OBJ_MAX];
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t flt_type[3];
+  uint32_t flt_used[3];
+  uint32_t id, tick, timeout_us, lost, frame_ns;
+  uint64_t ticks_per_s;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+
+  /* Check if loopback is available */
+  capab = drv->GetCapabilities();
+  if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+
+    /* Find object for receive (object supporting multiple filters preferred), use all other transmit capable objects for transmit */
+    tx_num = CAN_FindObjects(1U, &rx_obj_idx, tx_obj_idx);
+
+    if ((rx_obj_idx == 0xFFFFFFFFU) || (tx_num == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit or receive object available");
+    } else if (buffer_out != NULL) {
+
+      /* Filter types supported by the receive object */
+      obj_capab = drv->ObjectGetCapabilities (rx_obj_idx);
+      types = 0U;
+      if (obj_capab.exact_filtering != 0U) { flt_type[types++] = 0U; }
+      if (obj_capab.range_filtering != 0U) { flt_type[types++] = 1U; }
+      if (obj_capab.mask_filtering  != 0U) { flt_type[types++] = 2U; }
+      if (types == 0U) {
+        /* No filter capability reported, try exact filters */
+        flt_type[types++] = 0U;
+      }
+
+      /* Use highest configured bitrate */
+      bitrate = CAN_BR[0];
+      for (i = 1U; i < CAN_BR_NUM; i++) {
+        if (CAN_BR[i] > bitrate) { bitrate = CAN_BR[i]; }
+      }
+
+      /* Activate initialization mode */
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+      if (CAN_SetBitrates (bitrate, 0U) != ARM_DRIVER_OK) {
+        snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", bitrate, drv->GetClock()/1000000U);
+        TEST_MESSAGE(str);
+      } else TEST_PASS();
+
+      if (capab.external_loopback != 0U) {
+        // Activate loopback external mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+      } else if (capab.internal_loopback == 1U) {
+        // Activate loopback internal mode
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+      }
+
+      /* Add filters until the driver refuses, cycling through supported filter types */
+      memset(flt_used, 0, sizeof(flt_used));
+      flt_num = 0U;
+      while (flt_num < CAN_FILTER_MAX) {
+        if (CAN_FilterSet (rx_obj_idx, flt_num, flt_type[flt_num % types], 1U) != ARM_DRIVER_OK) {
+          break;
+        }
+        flt_used[flt_type[flt_num % types]]++;
+        flt_num++;
+      }
+      snprintf(str,sizeof(str),"[INFO] Object %d accepted %d filters (exact/range/mask: %d/%d/%d)",
+               rx_obj_idx, flt_num, flt_used[0], flt_used[1], flt_used[2]);
+      TEST_MESSAGE(str);
+
+      if (flt_num == 0U) {
+        TEST_FAIL_MESSAGE("[FAILED] Unable to add any filter");
+      } else {
+
+        /* ObjectConfigure for tx and rx objects */
+        for (i = 0U; i < tx_num; i++) {
+          TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx[i], ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+          Obj_tx_busy[tx_obj_idx[i]] = 0U;
+        }
+        TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx, ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+
+        memset(buffer_out, 0x55U, CAN_MSG_SIZE);
+        memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+
+        ticks_per_s = SYSTICK_MICROSEC(1000000U);
+        frame_ns    = CAN_FrameTime (CAN_MSG_SIZE, bitrate, 0U);
+        timeout_us  = (uint32_t)(((uint64_t)frame_ns * CAN_FILTER_FRAMES * 2U) / 1000U) + CAN_TRANSFER_TIMEOUT;
+
+        /* Measure with 1, 2, 4, ... active filters, the last step uses all accepted filters */
+        for (n = 1U; n != 0U; n = (n == flt_num) ? 0U : (((n * 2U) < flt_num) ? (n * 2U) : flt_num)) {
+
+          /* Send frames alternating between accepted and rejected IDs of the first n filters */
+          sent        = 0U;
+          expected    = 0U;
+          Rx_cnt      = 0U;
+          Rx_leak_cnt = 0U;
+          Cb_cnt      = 0U;
+          Cb_ticks    = 0U;
+          Obj_rx_drain[rx_obj_idx] = 1U;
+          tick = GET_SYSTICK();
+          do {
+            for (i = 0U; (i < tx_num) && (sent < CAN_FILTER_FRAMES); i++) {
+              if (Obj_tx_busy[tx_obj_idx[i]] == 0U) {
+                f  = (sent / 2U) % n;
+                id = CAN_FILTER_ID + (f * CAN_FILTER_BLOCK);
+                if ((sent & 1U) != 0U) {
+                  id += 8U + ((sent / 2U) % 8U);                  // Rejected ID
+                } else if (flt_type[f % types] != 0U) {
+                  id += (sent / 2U) % 4U;                         // Accepted ID within range or mask
+                }
+                tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(id);
+                Obj_tx_busy[tx_obj_idx[i]] = 1U;
+                if (drv->MessageSend(tx_obj_idx[i], &tx_data_msg_info, buffer_out, CAN_MSG_SIZE) == (int32_t)CAN_MSG_SIZE) {
+                  if ((sent & 1U) == 0U) { expected++; }
+                  sent++;
+                } else {
+                  Obj_tx_busy[tx_obj_idx[i]] = 0U;
+                }
+              }
+            }
+            if ((sent == CAN_FILTER_FRAMES) && (Rx_cnt >= expected)) {
+              /* Wait for frames still on the bus, rejected frames produce no event */
+              if ((Obj_tx_busy[tx_obj_idx[0]] == 0U) && ((GET_SYSTICK() - tick) >= SYSTICK_MICROSEC((uint64_t)frame_ns * CAN_FILTER_FRAMES / 1000U))) {
+                break;
+              }
+            }
+          } while ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(timeout_us));
+          Obj_rx_drain[rx_obj_idx] = 0U;
+
+          lost = ((Rx_cnt - Rx_leak_cnt) < expected) ? (expected - (Rx_cnt - Rx_leak_cnt)) : 0U;
+
+          if (Rx_leak_cnt != 0U) {
+            snprintf(str,sizeof(str),"[FAILED] %d filters: %d rejected frame(s) received", n, Rx_leak_cnt);
+            TEST_FAIL_MESSAGE(str);
+          } else TEST_PASS();
+          if (lost != 0U) {
+            snprintf(str,sizeof(str),"[FAILED] %d filters: %d of %d accepted frame(s) lost", n, lost, expected);
+            TEST_FAIL_MESSAGE(str);
+          } else TEST_PASS();
+
+          /* Callback time is measured inside the object event callback, rejected frames produce no callback */
+          snprintf(str,sizeof(str),"[INFO] %d filters: %d frames sent, %d lost, %d leaked, callback %d ns/event", n, sent, lost, Rx_leak_cnt,
+                   (Cb_cnt != 0U) ? (uint32_t)(((uint64_t)Cb_ticks * 1000000000U) / ((uint64_t)Cb_cnt * ticks_per_s)) : 0U);
+          TEST_MESSAGE(str);
+        }
+      }
+
+      /* Remove filters */
+      for (f = 0U; f < flt_num; f++) {
+        TEST_ASSERT(CAN_FilterSet (rx_obj_idx, f, flt_type[f % types], 0U) == ARM_DRIVER_OK);
+      }
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
+}
+
+// Check if unit reached state (signaled by event after cnt events, or reported by GetStatus)
+// Returns 1 and the time the state was detected in tick, 0 if state was not reached
+static uint32_t CAN_UnitStateReached (uint32_t idx, uint32_t cnt, uint32_t *tick) {
+  ARM_CAN_STATUS status;
+  uint32_t reached;
+
+  if (Unit_evt_cnt[idx] != cnt) {
+    *tick = Unit_evt_tick[idx];
+    return 1U;
+  }
+
+  status  = drv->GetStatus();
+  switch (idx) {
+    case CAN_UNIT_EVT_ACTIVE:  reached = (status.unit_state == ARM_CAN_UNIT_STATE_ACTIVE);  break;
+    case CAN_UNIT_EVT_WARNING: reached = (status.tx_error_count >= 96U);                     break;
+    case CAN_UNIT_EVT_PASSIVE: reached = (status.unit_state == ARM_CAN_UNIT_STATE_PASSIVE) ||
+                                         (status.unit_state == ARM_CAN_UNIT_STATE_BUS_OFF); break;
+    default:                   reached = (status.unit_state == ARM_CAN_UNIT_STATE_BUS_OFF); break;
+  }
+  if (reached != 0U) {
+    *tick = GET_SYSTICK();
+  }
+  return reached;
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_ErrorRecovery
+\details
+The test function \b CAN_ErrorRecovery measures error state transitions and recovery with the sequence:
+ - Initialize
+ - Power on
+ - Repeat for configured number of cycles:
+   - Set normal mode at first configured bitrate
+   - Send a frame that no other node acknowledges (automatic retransmission drives the transmit error counter up)
+   - Record time to error warning, error passive and (if reached) bus off
+   - Abort transmission and record retry period (time to error passive / transmit error count increase * 8)
+   - Reinitialize in loopback mode (normal mode if loopback is not supported), send frames and record time until
+     error active state is reached
+ - Report unit event counts and time statistics
+ - Power off
+ - Uninitialize
+
+\note Bus off is only reached if the controller detects bit errors (for example when transmit and receive lines are not
+      connected through a transceiver). Unacknowledged frames alone stop increasing the transmit error counter in error
+      passive state. If another node acknowledges the frame the error states cannot be provoked and the test is skipped.
+*/
+void CAN_ErrorRecovery (void) {
+  uint32_t i, cycle, tec, tec_start, acked, wait_ticks;
+  uint32_t tx_obj_idx = 0xFFFFFFFFU;
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t unit_cnt[4];
+  uint32_t tick_start, tick_warning, tick_passive, tick_bus_off, tick_active, timeout_ticks;
+  uint32_t n_warning, n_passive, n_bus_off, n_active, retry_sum, retry_cnt;
+  uint32_t *t_warning, *t_passive, *t_bus_off, *t_active;
+  uint32_t reached_warning, reached_passive, reached_bus_off, reached_active;
+  uint64_t ticks_per_s;
+  ARM_CAN_STATUS   status;
+  CAN_OBJ_EVENT    evt;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+
+  /* Initialize with callback */
+  TEST_ASSERT(drv->Initialize(CAN_SignalUnitEvent, CAN_SignalObjectEvent) == ARM_DRIVER_OK);
+
+  /* Power on */
+  TEST_ASSERT(drv->PowerControl (ARM_POWER_FULL) == ARM_DRIVER_OK);
+
+  capab = drv->GetCapabilities();
+
+  /* Find first available object for receive and transmit */
+  for (i = 0U; i < capab.num_objects; i++) {
+    obj_capab = drv->ObjectGetCapabilities (i);
+    if      ((tx_obj_idx == 0xFFFFFFFFU) && (obj_capab.tx == 1U)) { tx_obj_idx = i; }
+    else if ((rx_obj_idx == 0xFFFFFFFFU) && (obj_capab.rx == 1U)) { rx_obj_idx = i; }
+  }
+
+  /* Allocate buffers */
+  buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE*sizeof(uint8_t));
+  t_warning  = (uint32_t*) malloc(CAN_ERROR_CYCLES*sizeof(uint32_t));
+  t_passive  = (uint32_t*) malloc(CAN_ERROR_CYCLES*sizeof(uint32_t));
+  t_bus_off  = (uint32_t*) malloc(CAN_ERROR_CYCLES*sizeof(uint32_t));
+  t_active   = (uint32_t*) malloc(CAN_ERROR_CYCLES*sizeof(uint32_t));
+  TEST_ASSERT((buffer_out != NULL) && (t_warning != NULL) && (t_passive != NULL) && (t_bus_off != NULL) && (t_active != NULL));
+
+  if (tx_obj_idx == 0xFFFFFFFFU) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit object available");
+  } else if ((buffer_out != NULL) && (t_warning != NULL) && (t_passive != NULL) && (t_bus_off != NULL) && (t_active != NULL)) {
+
+    /* Set output buffer with all data = 0x55 to avoid CAN bit stuffing */
+    memset(buffer_out,0x55U,CAN_MSG_SIZE);
+    memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+    tx_data_msg_info.id = ARM_CAN_EXTENDED_ID(0x15555555U);
+
+    ticks_per_s   = SYSTICK_MICROSEC(1000000U);
+    timeout_ticks = (uint32_t)SYSTICK_MICROSEC(CAN_ERROR_TIMEOUT);
+    n_warning = n_passive = n_bus_off = n_active = 0U;
+    retry_sum = retry_cnt = 0U;
+    acked = 0U;
+
+    for (cycle = 0U; (cycle < CAN_ERROR_CYCLES) && (acked == 0U); cycle++) {
+
+      /* Activate initialization mode */
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+      if (CAN_SetBitrates (CAN_BR[0], 0U) != ARM_DRIVER_OK) {
+        snprintf(str,sizeof(str),"[WARNING] Invalid bitrate: %dkbit/s, clock %dMHz", CAN_BR[0], drv->GetClock()/1000000U);
+        TEST_MESSAGE(str);
+        break;
+      }
+
+      /* Activate normal mode, frames are not acknowledged without another node on the bus */
+      if (drv->SetMode (ARM_CAN_MODE_NORMAL) != ARM_DRIVER_OK) {
+        TEST_MESSAGE("[WARNING] Normal mode not supported, error states cannot be provoked");
+        break;
+      }
+
+      /* ObjectConfigure for tx object */
+      TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx, ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+
+      for (i = 0U; i < 4U; i++) { unit_cnt[i] = Unit_evt_cnt[i]; }
+      CAN_ObjEventFlush ();
+
+      /* Send frame, controller retransmits until error passive or bus off */
+      reached_warning = reached_passive = reached_bus_off = 0U;
+      tick_warning = tick_passive = tick_bus_off = 0U;
+      tec = 0U;
+      wait_ticks = timeout_ticks;
+      status     = drv->GetStatus();
+      tec_start  = status.tx_error_count;
+      tick_start = GET_SYSTICK();
+      TEST_ASSERT(drv->MessageSend(tx_obj_idx, &tx_data_msg_info, buffer_out, CAN_MSG_SIZE) == (int32_t)CAN_MSG_SIZE);
+
+      /* Wait for bus off; after error passive wait up to 4 times the time needed to reach it, since bus off
+         is not reached if the transmit error counter stops increasing (unacknowledged frames in error passive state) */
+      while ((GET_SYSTICK() - tick_start) < wait_ticks) {
+        while (CAN_ObjEventGet (&evt) != 0U) {
+          if ((evt.obj_idx == tx_obj_idx) && ((evt.event & ARM_CAN_EVENT_SEND_COMPLETE) != 0U)) { acked = 1U; }
+        }
+        if (acked != 0U) { break; }
+        if (reached_warning == 0U) {
+          reached_warning = CAN_UnitStateReached (CAN_UNIT_EVT_WARNING, unit_cnt[CAN_UNIT_EVT_WARNING], &tick_warning);
+        }
+        if (reached_passive == 0U) {
+          reached_passive = CAN_UnitStateReached (CAN_UNIT_EVT_PASSIVE, unit_cnt[CAN_UNIT_EVT_PASSIVE], &tick_passive);
+          if (reached_passive != 0U) {
+            status = drv->GetStatus();
+            tec    = status.tx_error_count;
+            if ((4U * (tick_passive - tick_start)) < wait_ticks) {
+              wait_ticks = 4U * (tick_passive - tick_start);
+            }
+          }
+        }
+        reached_bus_off = CAN_UnitStateReached (CAN_UNIT_EVT_BUS_OFF, unit_cnt[CAN_UNIT_EVT_BUS_OFF], &tick_bus_off);
+        if (reached_bus_off != 0U) { break; }
+      }
+
+      /* Abort pending transmission */
+      (void)drv->Control (ARM_CAN_ABORT_MESSAGE_SEND, tx_obj_idx);
+
+      if (acked != 0U) {
+        TEST_MESSAGE("[WARNING] Frame acknowledged by another node, error states cannot be provoked");
+        break;
+      }
+
+      if (reached_warning != 0U) { t_warning[n_warning++] = tick_warning - tick_start; }
+      if (reached_passive != 0U) {
+        t_passive[n_passive++] = tick_passive - tick_start;
+        /* Each unacknowledged retransmission increases transmit error counter by 8 */
+        if (tec >= (tec_start + 8U)) {
+          retry_sum += (uint32_t)(((uint64_t)(tick_passive - tick_start) * 1000000U * 8U) / ((uint64_t)(tec - tec_start) * ticks_per_s));
+          retry_cnt++;
+        }
+      }
+      if (reached_bus_off != 0U) { t_bus_off[n_bus_off++] = tick_bus_off - tick_start; }
+
+      if ((reached_passive == 0U) && (reached_bus_off == 0U)) {
+        continue;
+      }
+
+      /* Recover: reinitialize and transmit frames (in loopback mode if supported) until error active state,
+         each successful transmission decrements transmit error counter by 1 */
+      for (i = 0U; i < 4U; i++) { unit_cnt[i] = Unit_evt_cnt[i]; }
+      tick_start = GET_SYSTICK();
+      TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+      if (capab.external_loopback == 1U) {
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+      } else if (capab.internal_loopback == 1U) {
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+      } else {
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_NORMAL) == ARM_DRIVER_OK );
+      }
+      if ((capab.external_loopback == 1U) || (capab.internal_loopback == 1U)) {
+        TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx, ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+        CAN_ObjEventFlush ();
+        (void)drv->MessageSend(tx_obj_idx, &tx_data_msg_info, buffer_out, CAN_MSG_SIZE);
+      }
+      reached_active = 0U;
+      tick_active    = 0U;
+      do {
+        reached_active = CAN_UnitStateReached (CAN_UNIT_EVT_ACTIVE, unit_cnt[CAN_UNIT_EVT_ACTIVE], &tick_active);
+        while (CAN_ObjEventGet (&evt) != 0U) {
+          if ((reached_active == 0U) && (evt.obj_idx == tx_obj_idx) && ((evt.event & ARM_CAN_EVENT_SEND_COMPLETE) != 0U)) {
+            (void)drv->MessageSend(tx_obj_idx, &tx_data_msg_info, buffer_out, CAN_MSG_SIZE);
+          }
+        }
+      } while ((reached_active == 0U) && ((GET_SYSTICK() - tick_start) < timeout_ticks));
+      (void)drv->Control (ARM_CAN_ABORT_MESSAGE_SEND, tx_obj_idx);
+
+      if (reached_active != 0U) {
+        t_active[n_active++] = tick_active - tick_start;
+      } else {
+        snprintf(str,sizeof(str),"[FAILED] Cycle %d: error active state not reached after recovery", cycle);
+        TEST_FAIL_MESSAGE(str);
+        break;
+      }
+    }
+
+    if (acked == 0U) {
+      snprintf(str,sizeof(str),"[INFO] Unit events: active %d, warning %d, passive %d, bus off %d",
+               Unit_evt_cnt[CAN_UNIT_EVT_ACTIVE], Unit_evt_cnt[CAN_UNIT_EVT_WARNING],
+               Unit_evt_cnt[CAN_UNIT_EVT_PASSIVE], Unit_evt_cnt[CAN_UNIT_EVT_BUS_OFF]);
+      TEST_MESSAGE(str);
+      snprintf(str,sizeof(str),"[INFO] %d cycles at %dkbit/s: error passive %d, bus off %d, recovered %d",
+               cycle, CAN_BR[0], n_passive, n_bus_off, n_active);
+      TEST_MESSAGE(str);
+      if (n_warning != 0U) { TEST_PERCENTILES("Time to error warning",    t_warning, n_warning, ticks_per_s); }
+      if (n_passive != 0U) { TEST_PERCENTILES("Time to error passive",    t_passive, n_passive, ticks_per_s); }
+      if (n_bus_off != 0U) { TEST_PERCENTILES("Time to bus off",          t_bus_off, n_bus_off, ticks_per_s); }
+      if (n_active  != 0U) { TEST_PERCENTILES("Recovery to error active", t_active,  n_active,  ticks_per_s); }
+      if (retry_cnt != 0U) {
+        snprintf(str,sizeof(str),"[INFO] Average retransmission period %d us", retry_sum / retry_cnt);
+        TEST_MESSAGE(str);
+      }
+      if ((cycle != 0U) && (n_passive == 0U) && (n_bus_off == 0U)) {
+        TEST_MESSAGE("[WARNING] Error passive state not reached");
+      } else TEST_PASS();
+    }
+
+    /* Activate initialization mode */
+    TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+  }
+
+  /* Free buffers */
+  free(buffer_out);
+  free(t_warning);
+  free(t_passive);
+  free(t_bus_off);
+  free(t_active);
+
+  /* Power off and uninitialize*/
+  TEST_ASSERT(drv->PowerControl (ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: CAN_Loopback_ThroughputFD
+\details
+The test function \b CAN_Loopback_ThroughputFD measures CAN FD payload throughput over all data sizes with the sequence:
+ - For bit rate switching off and for each configured data/arbitration bitrate ratio with bit rate switching on:
+   - Set nominal bitrate and data phase bitrate
+   - For each CAN FD data size (0..8, 12, 16, 20, 24, 32, 48 and 64 bytes):
+     - Send frames keeping all transmit objects busy and receive them
+     - Record payload throughput and efficiency (share of bus time used by payload bits)
+ - Report throughput and efficiency tables
+ - Record metrics \c payload_64B_brs_off and \c payload_64B_x<ratio> (kbit/s payload throughput of 64 byte frames)
+ - Stop transfers (initialization mode, objects inactive)
+
+The driver is initialized and powered on by the test group fixture (\b CAN_DV_Setup).
+*/
+void CAN_Loopback_ThroughputFD (void) {
+  static const uint8_t  fd_size[] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+  static const uint32_t ratio_cfg[] = { CAN_FD_SWEEP_RATIO_1, CAN_FD_SWEEP_RATIO_2, CAN_FD_SWEEP_RATIO_3, CAN_FD_SWEEP_RATIO_4 };
+  uint32_t i, j, col, col_num, n, len, tx_num, rx_num, ticks, size, ratio, bitrate_data, timeout_us, frame_ns;
+  uint32_t tx_obj_idx[CAN_OBJ_MAX];
+  uint32_t rx_obj_idx = 0xFFFFFFFFU;
+  uint32_t col_ratio[ARRAY_SIZE(ratio_cfg) + 1U];
+  uint32_t kbps[ARRAY_SIZE(fd_size)][ARRAY_SIZE(ratio_cfg) + 1U];
+  uint8_t  eff[ARRAY_SIZE(fd_size)][ARRAY_SIZE(ratio_cfg) + 1U];
+  uint64_t ticks_per_s, payload_ns;
+  ARM_CAN_MSG_INFO tx_data_msg_info;
+
+  /* Check if FD mode and loopback are available */
+  capab = drv->GetCapabilities();
+  if (capab.fd_mode == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support FD mode");
+  } else if ((capab.external_loopback == 0U) && (capab.internal_loopback == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Driver does not support loopback mode");
+  } else {
+
+    /* Allocate buffer */
+    buffer_out = (uint8_t*) malloc(CAN_MSG_SIZE_FD*sizeof(uint8_t));
+    TEST_ASSERT(buffer_out != NULL);
+
+    /* Find object for receive (receive only object preferred), use all other transmit capable objects for transmit */
+    tx_num = CAN_FindObjects(0U, &rx_obj_idx, tx_obj_idx);
+
+    if ((rx_obj_idx == 0xFFFFFFFFU) || (tx_num == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Driver has no transmit or receive object available");
+    } else if (buffer_out != NULL) {
+
+      /* Set output buffer with all data = 0x55 to avoid CAN bit stuffing */
+      memset(buffer_out,0x55U,CAN_MSG_SIZE_FD);
+
+      ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+      /* Column 0: bit rate switching off, other columns: configured ratios with bit rate switching on */
+      col_num = 0U;
+      col_ratio[col_num++] = 1U;
+      for (i = 0U; i < ARRAY_SIZE(ratio_cfg); i++) {
+        if (ratio_cfg[i] != 0U) { col_ratio[col_num++] = ratio_cfg[i]; }
+      }
+      memset(kbps, 0, sizeof(kbps));
+      memset(eff,  0, sizeof(eff));
+
+      for (col = 0U; col < col_num; col++) {
+        ratio        = col_ratio[col];
+        bitrate_data = CAN_FD_SWEEP_BITRATE * ratio;
+
+        /* Activate initialization mode */
+        TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_INITIALIZATION) == ARM_DRIVER_OK);
+
+        if (CAN_SetBitrates (CAN_FD_SWEEP_BITRATE, ratio) != ARM_DRIVER_OK) {
+          snprintf(str,sizeof(str),"[WARNING] Invalid FD bitrate: %dkbit/s, clock %dMHz", bitrate_data, drv->GetClock()/1000000U);
+          TEST_MESSAGE(str);
+          continue;
+        }
+
+        if (capab.external_loopback == 1U) {
+          // Activate loopback external mode
+          TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_EXTERNAL) == ARM_DRIVER_OK );
+        } else if (capab.internal_loopback == 1U) {
+          // Activate loopback internal mode
+          TEST_ASSERT(drv->SetMode (ARM_CAN_MODE_LOOPBACK_INTERNAL) == ARM_DRIVER_OK );
+        }
+
+        /* Set FD mode */
+        TEST_ASSERT(drv->Control (ARM_CAN_SET_FD_MODE, 1) == ARM_DRIVER_OK);
+
+        /* ObjectSetFilter add extended exact ID 0x15555555 */
+        TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_ADD, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+
+        /* ObjectConfigure for tx and rx objects */
+        for (i = 0U; i < tx_num; i++) {
+          TEST_ASSERT(drv->ObjectConfigure(tx_obj_idx[i], ARM_CAN_OBJ_TX) == ARM_DRIVER_OK );
+          Obj_tx_busy[tx_obj_idx[i]] = 0U;
+        }
+        TEST_ASSERT(drv->ObjectConfigure(rx_obj_idx, ARM_CAN_OBJ_RX) == ARM_DRIVER_OK );
+
+        memset(&tx_data_msg_info, 0U, sizeof(ARM_CAN_MSG_INFO));
+        tx_data_msg_info.id  = ARM_CAN_EXTENDED_ID(0x15555555U);
+        tx_data_msg_info.edl = 1U;
+        tx_data_msg_info.brs = (col != 0U) ? 1U : 0U;
+
+        for (j = 0U; j < ARRAY_SIZE(fd_size); j++) {
+          size = fd_size[j];
+
+          /* Expected frame time on the wire including interframe space (ns), used for timeout only */
+          frame_ns   = CAN_FrameTime (size, CAN_FD_SWEEP_BITRATE, ratio);
+          timeout_us = (uint32_t)(((uint64_t)frame_ns * CAN_FD_SWEEP_FRAMES * 2U) / 1000U) + CAN_TRANSFER_TIMEOUT;
+
+          rx_num = CAN_RunFlood (tx_obj_idx, tx_num, &tx_data_msg_info, size, rx_obj_idx, CAN_FD_SWEEP_FRAMES, timeout_us, &ticks);
+          if (rx_num < CAN_FD_SWEEP_FRAMES) {
+            snprintf(str,sizeof(str),"[FAILED] %d bytes, ratio %d%s: received %d of %d frames", size, ratio,
+                     (col != 0U) ? "" : " (BRS off)", rx_num, CAN_FD_SWEEP_FRAMES);
+            TEST_FAIL_MESSAGE(str);
+            continue;
+          }
+          if (ticks == 0U) { ticks = 1U; }
+
+          /* Payload throughput and share of bus time used by payload bits */
+          kbps[j][col] = (uint32_t)(((uint64_t)rx_num * size * 8U * ticks_per_s) / ((uint64_t)ticks * 1000U));
+          payload_ns   = ((uint64_t)rx_num * size * 8U * 1000000U) / bitrate_data;
+          n            = (uint32_t)((payload_ns * 100U * ticks_per_s) / ((uint64_t)ticks * 1000000000U));
+          eff[j][col]  = (uint8_t)((n > 100U) ? 100U : n);
+        }
+
+        /* ObjectSetFilter remove extended exact ID 0x15555555 */
+        TEST_ASSERT(drv->ObjectSetFilter(rx_obj_idx, ARM_CAN_FILTER_ID_EXACT_REMOVE, ARM_CAN_EXTENDED_ID(0x15555555U), 0U) == ARM_DRIVER_OK );
+      }
+
+      /* Report tables: one row per data size, one column per ratio */
+      len = (uint32_t)snprintf(str,sizeof(str),"[INFO] Nominal %dkbit/s, payload kbit/s (efficiency %%) for BRS off", CAN_FD_SWEEP_BITRATE);
+      for (col = 1U; (col < col_num) && (len < sizeof(str)); col++) {
+        len += (uint32_t)snprintf(&str[len],sizeof(str)-len,", x%d", col_ratio[col]);
+      }
+      TEST_MESSAGE(str);
+      for (j = 0U; j < ARRAY_SIZE(fd_size); j++) {
+        len = (uint32_t)snprintf(str,sizeof(str),"[INFO] %2d bytes:", fd_size[j]);
+        for (col = 0U; (col < col_num) && (len < sizeof(str)); col++) {
+          len += (uint32_t)snprintf(&str[len],sizeof(str)-len," %6d (%3d%%)", kbps[j][col], eff[j][col]);
+        }
+        TEST_MESSAGE(str);
+      }
+
+      /* Metrics: payload throughput of the largest data size */
+      j = ARRAY_SIZE(fd_size) - 1U;
+      for (col = 0U; col < col_num; col++) {
+        if (kbps[j][col] != 0U) {
+          if (col == 0U) {
+            snprintf(str,sizeof(str),"payload_%dB_brs_off", fd_size[j]);
+          } else {
+            snprintf(str,sizeof(str),"payload_%dB_x%d", fd_size[j], col_ratio[col]);
+          }
+          TEST_METRIC_HIGHER(str, kbps[j][col], "kbit/s", METRIC_NO_THRESHOLD);
+        }
+      }
+    }
+
+    /* Free buffer */
+    free(buffer_out);
+  }
+
+  /* Stop transfers, driver stays powered for next test */
+  CAN_StopTransfer();
 }
 
 /**
@@ -195,6 +195,41 @@ void ETH_DV_Uninitialize (void) {
   cb_event = NULL;
 }
 
+/* Helper function that initializes and powers on MAC and PHY for data tests */
+void ETH_DV_Setup (void) {
+  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+  osDelay (100);
+  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
+}
+
+/* Helper function that powers off and uninitializes MAC and PHY after data tests */
+void ETH_DV_Teardown (void) {
+  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+}
+
+// Enable MAC receiver and transmitter and discard frames left from previous test
+static void ETH_StartTransfer (void) {
+  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  while (eth_mac->GetRxFrameSize() > 0) {
+    eth_mac->ReadFrame(NULL, 0);
+  }
+  Event &= ~ARM_ETH_MAC_EVENT_RX_FRAME;
+}
+
+// Disable MAC receiver and transmitter, driver stays powered for next test
+static void ETH_StopTransfer (void) {
+  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 0) == ARM_DRIVER_OK);
+  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 0) == ARM_DRIVER_OK);
+}
+
 /*-----------------------------------------------------------------------------
  *      Tests
  *----------------------------------------------------------------------------*/
@@ -495,18 +530,17 @@ void ETH_MAC_Config_CommonParams (void) {
 \details
 The function \b ETH_MAC_Control_Filtering verifies the Ethernet MAC \b Control function with the following sequence:
   - Buffer allocation
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Broadcast receive
   - Receive with broadcast disabled
   - Multicast receive
   - Receive with multicast disabled
   - Unicast receive
   - Promiscuous mode receive
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 The internal Ethernet MAC loopback is used for the test.
 */
 void ETH_MAC_Control_Filtering (void) {
@@ -520,19 +554,11 @@ void ETH_MAC_Control_Filtering (void) {
   TEST_ASSERT(buffer_in != NULL);
   if (buffer_in == NULL) { free(buffer_out); return; }
 
-  /* Initialize, power on and configure MAC and PHY */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M |
     ARM_ETH_MAC_DUPLEX_FULL | ARM_ETH_MAC_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_AUTO_NEGOTIATE) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Set Ethernet header */
   memcpy(&buffer_out[6], &mac_addr, 6);
@@ -601,11 +627,8 @@ void ETH_MAC_Control_Filtering (void) {
     TEST_FAIL_MESSAGE("[FAILED] Receive unicast in promiscuous mode");
   } else TEST_PASS();
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
 
   /* Free buffers */
   free(buffer_out);
@@ -618,17 +641,16 @@ void ETH_MAC_Control_Filtering (void) {
 \details
 The function \b ETH_MAC_SetAddressFilter verifies the Ethernet MAC \b SetAddressFilter function with the following sequence:
   - Buffer allocation
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Receive one multicast address
   - Receive two multicast addresses
   - Receive three multicast addresses
   - Receive four multicast addresses
   - Receive six multicast addresses
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 The internal Ethernet MAC loopback is used for the test.
 */
 void ETH_MAC_SetAddressFilter (void) {
@@ -642,19 +664,11 @@ void ETH_MAC_SetAddressFilter (void) {
   TEST_ASSERT(buffer_in != NULL);
   if (buffer_in == NULL) { free(buffer_out); return; }
 
-  /* Initialize, power on and configure MAC and PHY */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M |
     ARM_ETH_MAC_DUPLEX_FULL | ARM_ETH_MAC_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_AUTO_NEGOTIATE) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Set Ethernet header */
   memcpy(&buffer_out[6], &mac_addr, 6);
@@ -758,11 +772,8 @@ void ETH_MAC_SetAddressFilter (void) {
     } else TEST_PASS();
   }
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
 
   /* Free buffers */
   free(buffer_out);
@@ -774,16 +785,15 @@ void ETH_MAC_SetAddressFilter (void) {
 \brief Function: ETH_MAC_SignalEvent
 \details
 The function \b ETH_MAC_SignalEvent verifies the Ethernet MAC interrupt operation with the sequence:
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Configure receiver
   - Configure transmitter
   - Set output buffer pattern
   - Send data and check receive interrupts
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 The internal Ethernet MAC loopback is used for the test.
 */
 void ETH_MAC_SignalEvent (void) {
@@ -799,19 +809,11 @@ void ETH_MAC_SignalEvent (void) {
   TEST_ASSERT(buffer_out != NULL);
   if (buffer_out == NULL) return;
 
-  /* Initialize, power on and configure MAC */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M | ARM_ETH_MAC_DUPLEX_FULL |
     ARM_ETH_MAC_ADDRESS_BROADCAST | ARM_ETH_MAC_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_AUTO_NEGOTIATE) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Set Ethernet header */
   memcpy(&buffer_out[0], &mac_bcast, 6);
@@ -839,11 +841,8 @@ void ETH_MAC_SignalEvent (void) {
     TEST_FAIL_MESSAGE("[FAILED] Interrupt mode not working");
   } else TEST_PASS();
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
 }
 
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
@@ -1023,17 +1022,16 @@ void ETH_PHY_Config (void) {
 \details
 The function \b ETH_Loopback_Transfer verifies data transfer via Ethernet with the following sequence:
   - Buffer allocation
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Set output buffer pattern
   - Transfer data chunks
   - Set output buffer with random data
   - Transfer data chunks
   - Transfer data by sending in two fragments
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 The internal Ethernet MAC loopback is used as a data loopback, so there is no need to use an external loopback cable.
 */
 void ETH_Loopback_Transfer (void) {
@@ -1054,19 +1052,11 @@ void ETH_Loopback_Transfer (void) {
   TEST_ASSERT(buffer_in != NULL);
   if (buffer_in == NULL) { free(buffer_out); return; }
 
-  /* Initialize, power on and configure MAC */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M | ARM_ETH_MAC_DUPLEX_FULL |
     ARM_ETH_MAC_ADDRESS_BROADCAST | ARM_ETH_MAC_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_AUTO_NEGOTIATE) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Set output buffer pattern */
   for (i = 0; i < ETH_MTU; i+=2) {
@@ -1132,11 +1122,8 @@ void ETH_Loopback_Transfer (void) {
     } else TEST_PASS();
   }
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
 
   /* Free buffers */
   free(buffer_out);
@@ -1149,16 +1136,15 @@ void ETH_Loopback_Transfer (void) {
 \details
 The function \b ETH_Loopback_External verifies data transfer via Ethernet with the following sequence:
   - Buffer allocation
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Set output buffer pattern
   - Transfer data on PHY internal loopback
   - Ethernet connection
   - Transfer data on external cable loopback
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 An external loopback cable is required for this test.
 */
 void ETH_Loopback_External (void) {
@@ -1173,20 +1159,12 @@ void ETH_Loopback_External (void) {
   TEST_ASSERT(buffer_in != NULL);
   if (buffer_in == NULL) { free(buffer_out); return; }
 
-  /* Initialize, power on and configure MAC and PHY */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->SetMacAddress(&mac_addr) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M | ARM_ETH_MAC_DUPLEX_FULL |
     ARM_ETH_MAC_ADDRESS_BROADCAST) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_SPEED_100M |
    ARM_ETH_PHY_DUPLEX_FULL | ARM_ETH_PHY_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Fill output buffer */
   for (cnt = 0; cnt < ETH_MTU; cnt++) {
@@ -1240,12 +1218,9 @@ void ETH_Loopback_External (void) {
     TEST_FAIL_MESSAGE("[FAILED] Verify received data");
   } else TEST_PASS();
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
 end:
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
   /* Free buffers */
   free(buffer_out);
   free(buffer_in);
@@ -1401,16 +1376,15 @@ void ETH_MAC_PTP_ControlTimer (void) {
 \details
 The function \b ETH_Loopback_PTP verifies the Precision Time Protocol functions \b ControlTimer, \b GetRxFrameTime and
 \b GetTxFrameTime with the sequence:
-  - Initialize
-  - Power on
+  - Configure MAC and PHY
   - Set Control Timer
   - Transfer a frame
   - Get TX frame time
   - Get RX frame time
-  - Power off
-  - Uninitialize
+  - Stop transfer
 
 \note
+The driver is initialized and powered on by the test group fixture (\b ETH_DV_Setup).
 The internal Ethernet MAC loopback is used as the data loopback.
 */
 void ETH_Loopback_PTP (void) {
@@ -1444,18 +1418,11 @@ void ETH_Loopback_PTP (void) {
   TEST_ASSERT(buffer_in != NULL);
   if (buffer_in == NULL) return;
 
-  /* Initialize, power on and configure MAC and PHY */
-  TEST_ASSERT(eth_mac->Initialize(cb_event) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+  /* Configure MAC and PHY (initialized and powered by fixture) */
   TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONFIGURE, ARM_ETH_MAC_SPEED_100M | ARM_ETH_MAC_DUPLEX_FULL |
     ARM_ETH_MAC_ADDRESS_BROADCAST | ARM_ETH_MAC_ADDRESS_ALL | ARM_ETH_MAC_LOOPBACK) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_RX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Control(ARM_ETH_MAC_CONTROL_TX, 1) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Initialize(eth_mac->PHY_Read, eth_mac->PHY_Write) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
-  osDelay (100);
-  TEST_ASSERT(eth_phy->SetInterface(capab.media_interface) == ARM_DRIVER_OK);
   TEST_ASSERT(eth_phy->SetMode(ARM_ETH_PHY_AUTO_NEGOTIATE) == ARM_DRIVER_OK);
+  ETH_StartTransfer();
 
   /* Set Time */
   time1.sec = 0U;
@@ -1490,11 +1457,8 @@ void ETH_Loopback_PTP (void) {
   eth_mac->ReadFrame(buffer_in, PTP_frame_len);
   TEST_ASSERT(memcmp(buffer_in, PTP_frame, PTP_frame_len) == 0);
 
-  /* Power off and uninitialize */
-  TEST_ASSERT(eth_phy->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_phy->Uninitialize() == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
-  TEST_ASSERT(eth_mac->Uninitialize() == ARM_DRIVER_OK);
+  /* Stop transfer (fixture powers off) */
+  ETH_StopTransfer();
 
   /* Free buffer */
   free(buffer_in);
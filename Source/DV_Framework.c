@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020 Arm Limited. All rights reserved.
+ * Copyright (c) 2015-2026 Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -25,8 +25,74 @@
 
 
 #include "cmsis_dv.h" 
+#include "DV_Config.h"
 #include "DV_Framework.h"
 
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef DV_KEEP_POWERED
+#define DV_KEEP_POWERED         1
+#endif
+#ifndef DV_TEST_TIMEOUT
+#define DV_TEST_TIMEOUT         300
+#endif
+
+/* Test case supervision requires CMSIS-RTOS2 */
+#if defined(RTE_CMSIS_RTOS2) && (DV_TEST_TIMEOUT != 0)
+#define TC_WATCHDOG             1
+#else
+#define TC_WATCHDOG             0
+#endif
+
+#define TC_FLAG_DONE            0x00008000U     /* Supervised function done   */
+#define TC_RECOVERY_TIMEOUT     10000U          /* Recovery step timeout (ms) */
+
+#ifndef DV_CHECKPOINT
+#define DV_CHECKPOINT           0
+#endif
+#ifndef DV_CHECKPOINT_TESTS
+#define DV_CHECKPOINT_TESTS     512
+#endif
+#ifndef DV_CHECKPOINT_SECTION
+#define DV_CHECKPOINT_SECTION   ".noinit"
+#endif
+
+#ifndef DV_SHARD_INDEX
+#define DV_SHARD_INDEX          0
+#endif
+#ifndef DV_SHARD_COUNT
+#define DV_SHARD_COUNT          1
+#endif
+#ifndef DV_SHARD_DURATION
+#define DV_SHARD_DURATION       1000
+#endif
+
+#ifndef DV_REPEAT_COUNT
+#define DV_REPEAT_COUNT         1
+#endif
+#ifndef DV_REPEAT_STOP
+#define DV_REPEAT_STOP          0
+#endif
+
+#define CP_MAGIC                0x43504456U     /* Valid checkpoint marker    */
+#define CP_RES_NONE             0x00U           /* No result (else TC_RES+1)  */
+#define CP_RES_RUNNING          0xFFU           /* Test case was started      */
+
+#define SH_COUNT_MAX            255U            /* Maximum number of shards   */
+#define SH_NONE                 0xFFU           /* Test case not assigned yet */
+
+/* Checkpoint data */
+typedef struct {
+  uint32_t magic;                       /* Valid checkpoint marker            */
+  uint32_t check;                       /* Checksum of following members      */
+  uint32_t id;                          /* Test list identification           */
+  uint32_t next;                        /* Index of first test without result */
+  uint8_t  res[DV_CHECKPOINT_TESTS];    /* Test case results                  */
+} TEST_CHECKPOINT;
+
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
 /**
 \defgroup dv_framework Framework
@@ -54,68 +120,536 @@ void __attribute__((noinline)) closeDebug(void){
 }
 #endif
 
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief Save checkpoint data.
+\param[in]   data    pointer to checkpoint data
+\param[in]   size    size of checkpoint data in bytes
+\return      0 on success, -1 on error
+\details
+Stores the test run progress, called by \ref cmsis_dv after each test case when \b DV_CHECKPOINT is enabled.
+The default (weak) implementation copies the data to a retained RAM section (\b DV_CHECKPOINT_SECTION).
+The function can be reimplemented to store the data in non-volatile memory.
+*/
+int32_t cmsis_dv_checkpoint_save (const void *data, uint32_t size);
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief Load checkpoint data.
+\param[out]  data    pointer to checkpoint data
+\param[in]   size    size of checkpoint data in bytes
+\return      0 on success, -1 if no data is available
+\details
+Reads the test run progress stored by \ref cmsis_dv_checkpoint_save, called by \ref cmsis_dv at the start of the run.
+*/
+int32_t cmsis_dv_checkpoint_load (void *data, uint32_t size);
+
+#ifndef __DOXYGEN__                     // Exclude form the documentation
+#if (DV_CHECKPOINT != 0)
+static TEST_CHECKPOINT cp_retained __attribute__((section(DV_CHECKPOINT_SECTION)));
+
+__WEAK int32_t cmsis_dv_checkpoint_save (const void *data, uint32_t size) {
+  if (size > sizeof(cp_retained)) {
+    return -1;
+  }
+  memcpy(&cp_retained, data, size);
+  return 0;
+}
+
+__WEAK int32_t cmsis_dv_checkpoint_load (void *data, uint32_t size) {
+  if (size > sizeof(cp_retained)) {
+    return -1;
+  }
+  memcpy(data, &cp_retained, size);
+  return 0;
+}
+#endif
+#endif
+
+#if (DV_CHECKPOINT != 0)
+static TEST_CHECKPOINT cp;                /* Checkpoint of the test run         */
+static uint32_t      cp_active;         /* Checkpoint is saved                */
+static uint32_t      cp_total;          /* Number of test cases in the run    */
+
+/* Hash data (FNV-1a) */
+static uint32_t cp_Hash (uint32_t hash, const void *data, uint32_t size) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  while (size != 0U) {
+    hash = (hash ^ *p++) * 16777619U;
+    size--;
+  }
+  return hash;
+}
+
+/* Identify test list, checkpoint of a different build is not resumed */
+static uint32_t cp_Id (void) {
+  uint32_t i, tc, id, en;
+
+  id = 2166136261U;
+  for (i = 0U; i < tg_cnt; i++) {
+    id = cp_Hash(id, ts[i].Date, strlen(ts[i].Date));
+    id = cp_Hash(id, ts[i].Time, strlen(ts[i].Time));
+    for (tc = 0U; tc < ts[i].NumOfTC; tc++) {
+      en = (ts[i].TC[tc].TestFunc != NULL);
+      id = cp_Hash(id, ts[i].TC[tc].TFName, strlen(ts[i].TC[tc].TFName));
+      id = cp_Hash(id, &en, sizeof(en));
+    }
+  }
+  return id;
+}
+
+/* Save checkpoint */
+static void cp_Save (void) {
+  if (cp_active != 0U) {
+    cp.check = cp_Hash(2166136261U, &cp.id, sizeof(cp) - offsetof(TEST_CHECKPOINT, id));
+    (void)cmsis_dv_checkpoint_save(&cp, sizeof(cp));
+  }
+}
+#endif
+
+/* Load checkpoint, return number of test results restored from checkpoint */
+static uint32_t cp_Load (void) {
+  uint32_t restore = 0U;
+#if (DV_CHECKPOINT != 0)
+  uint32_t i, id, total;
+
+  for (i = 0U, total = 0U; i < tg_cnt; i++) {
+    total += ts[i].NumOfTC;
+  }
+  cp_total  = total;
+  cp_active = (total <= DV_CHECKPOINT_TESTS);
+  id = cp_Id();
+
+  if ((cp_active != 0U)                                     &&
+      (cmsis_dv_checkpoint_load(&cp, sizeof(cp)) == 0)      &&
+      (cp.magic == CP_MAGIC) && (cp.id == id)               &&
+      (cp.check == cp_Hash(2166136261U, &cp.id, sizeof(cp) - offsetof(TEST_CHECKPOINT, id))) &&
+      (cp.next < total)) {
+    restore = cp.next;
+    if (cp.res[restore] == CP_RES_RUNNING) {
+      restore++;                        /* Test case did not complete         */
+    }
+  } else {
+    memset(&cp, 0, sizeof(cp));
+    cp.magic = CP_MAGIC;
+    cp.id    = id;
+  }
+#endif
+  return restore;
+}
+
+/* Save test case state to checkpoint (CP_RES_RUNNING or TC_RES + 1) */
+static void cp_Result (uint32_t k, uint8_t res) {
+#if (DV_CHECKPOINT != 0)
+  if ((cp_active != 0U) && (cp.res[k] != res)) {
+    cp.res[k] = res;
+    cp.next   = (res == CP_RES_RUNNING) ? k : (k + 1U);
+    cp_Save();
+  }
+#else
+  (void)k;
+  (void)res;
+#endif
+}
+
+/* Test run completed, invalidate checkpoint */
+static void cp_Done (void) {
+#if (DV_CHECKPOINT != 0)
+  cp.magic = 0U;
+  cp_Save();
+#endif
+}
+
+/* Report test case result restored from checkpoint */
+static void tc_Restore (uint32_t k) {
+#if (DV_CHECKPOINT != 0)
+  switch (cp.res[k]) {
+    case CP_RES_RUNNING:
+      __set_result(__FILE__, __LINE__, "[FAILED] Reset during test execution", FAILED);
+      break;
+    case (uint8_t)PASSED + 1U:
+      ritf.as_Result(PASSED);
+      break;
+    case (uint8_t)FAILED + 1U:
+      __set_result(__FILE__, __LINE__, "[FAILED] Result restored from checkpoint (details not available)", FAILED);
+      break;
+    default:
+      break;
+  }
+#else
+  (void)k;
+#endif
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief Get recorded test case duration.
+\param[in]   name    test function name
+\return      duration in ms, 0 if duration is not recorded
+\details
+Provides the duration of test cases, which is used to balance the test cases between shards.
+The default (weak) implementation returns 0 and test cases are assumed to take \b DV_SHARD_DURATION.
+The \b Report_Merge tool generates an implementation from JSON Lines reports of an earlier run.
+*/
+uint32_t cmsis_dv_test_duration (const char *name);
+
+#ifndef __DOXYGEN__                     // Exclude form the documentation
+__WEAK uint32_t cmsis_dv_test_duration (const char *name) {
+  (void)name;
+  return 0U;
+}
+#endif
+
+static uint8_t  *sh_shard;              /* Shard of test cases (NULL = modulo)*/
+static uint32_t  sh_index;              /* Shard index of this board          */
+static uint32_t  sh_count;              /* Number of shards                   */
+
+/* Distribute test cases to shards (longest test case to least loaded shard) */
+static void sh_Init (const DV_SHARD *shard) {
+  uint32_t *dur, *load;
+  uint32_t  i, tc, k, n, total, max, min;
+
+  sh_index = DV_SHARD_INDEX;
+  sh_count = DV_SHARD_COUNT;
+  if (shard != NULL) {
+    sh_index = shard->index;
+    sh_count = shard->count;
+  }
+  if ((sh_count < 2U) || (sh_count > SH_COUNT_MAX) || (sh_index >= sh_count)) {
+    sh_count = 1U;                      /* Execute all test cases             */
+    sh_index = 0U;
+    return;
+  }
+
+  for (i = 0U, total = 0U; i < tg_cnt; i++) {
+    total += ts[i].NumOfTC;
+  }
+  sh_shard = malloc(total);
+  dur      = malloc(total * sizeof(uint32_t));
+  load     = calloc(sh_count, sizeof(uint32_t));
+  if ((sh_shard == NULL) || (dur == NULL) || (load == NULL)) {
+    free(sh_shard);                     /* Distribute by test case index      */
+    sh_shard = NULL;
+  } else {
+    for (i = 0U, k = 0U; i < tg_cnt; i++) {
+      for (tc = 0U; tc < ts[i].NumOfTC; tc++, k++) {
+        dur[k] = 0U;
+        if (ts[i].TC[tc].TestFunc != NULL) {
+          dur[k] = cmsis_dv_test_duration(ts[i].TC[tc].TFName);
+          if (dur[k] == 0U) {
+            dur[k] = DV_SHARD_DURATION;
+          }
+        }
+        sh_shard[k] = SH_NONE;
+      }
+    }
+    /* Same distribution is calculated on every board */
+    for (n = 0U; n < total; n++) {
+      max = total;
+      for (k = 0U; k < total; k++) {
+        if ((sh_shard[k] == SH_NONE) && ((max == total) || (dur[k] > dur[max]))) {
+          max = k;
+        }
+      }
+      min = 0U;
+      for (i = 1U; i < sh_count; i++) {
+        if (load[i] < load[min]) {
+          min = i;
+        }
+      }
+      sh_shard[max] = (uint8_t)min;
+      load[min]    += dur[max];
+    }
+  }
+  free(dur);
+  free(load);
+}
+
+/* Check if test case is executed on this board */
+static uint32_t sh_Assigned (uint32_t k) {
+  if (sh_count < 2U) {
+    return 1U;
+  }
+  if (sh_shard == NULL) {
+    return ((k % sh_count) == sh_index);
+  }
+  return (sh_shard[k] == sh_index);
+}
+
+/* Check if test case is enabled and runs on the test group fixture */
+static uint32_t tc_Fixture (TEST_GROUP *tg, uint32_t tc) {
+  return ((tg->TC[tc].TestFunc != NULL) && (tg->TC[tc].Fixture == TC_FIXTURE_POWERED));
+}
+
+/* Check if test group fixture can stay powered after test case (k = index within the run) */
+static uint32_t tc_KeepPowered (TEST_GROUP *tg, uint32_t tc, uint32_t k) {
+#if (DV_KEEP_POWERED != 0)
+  /* Skip disabled test cases and test cases of other shards, they do not change driver state */
+  for (tc++, k++; tc < tg->NumOfTC; tc++, k++) {
+    if ((tg->TC[tc].TestFunc != NULL) && sh_Assigned(k)) {
+      return (tg->TC[tc].Fixture == TC_FIXTURE_POWERED);
+    }
+  }
+#else
+  (void)tg;
+  (void)tc;
+  (void)k;
+#endif
+  return 0U;
+}
+
+static uint32_t     tc_unsupervised;    /* Function run without supervision   */
+
+#if (TC_WATCHDOG != 0)
+static osThreadId_t tc_supervisor;      /* Thread running cmsis_dv            */
+static void       (*tc_func)(void);     /* Function run by supervised thread  */
+
+/* Supervised thread: execute function and inform supervisor */
+static void tc_Thread (void *argument) {
+  (void)argument;
+
+  tc_func();
+  (void)osThreadFlagsSet(tc_supervisor, TC_FLAG_DONE);
+}
+#endif
+
+/* Execute function within remaining time budget (in ms), return 1 on timeout */
+static uint32_t tc_Exec (void (*func)(void), uint32_t budget, uint32_t *used) {
+#if (TC_WATCHDOG != 0)
+  osThreadAttr_t attr;
+  osThreadId_t   tid;
+  osPriority_t   prio;
+  uint32_t       freq, start, ticks, flags;
+
+  freq  = osKernelGetTickFreq();
+  ticks = 0U;
+  if (budget > *used) {
+    ticks = (uint32_t)(((uint64_t)(budget - *used) * freq) / 1000U);
+  }
+
+  /* Test thread uses stack size and priority of the cmsis_dv thread */
+  tc_supervisor = osThreadGetId();
+  memset(&attr, 0, sizeof(attr));
+  attr.name       = "cmsis_dv_tc";
+  attr.stack_size = osThreadGetStackSize(tc_supervisor);
+  prio            = osThreadGetPriority(tc_supervisor);
+  attr.priority   = prio;
+
+  tc_func = func;
+  (void)osThreadFlagsClear(TC_FLAG_DONE);
+  start = osKernelGetTickCount();
+  tid   = osThreadNew(tc_Thread, NULL, &attr);
+  if (tid == NULL) {
+    tc_unsupervised = 1U;
+    func();                             /* Run unsupervised if no resources   */
+    flags = TC_FLAG_DONE;
+  } else {
+    /* Supervisor waits above test thread priority, so a test busy looping
+       without blocking cannot prevent the timeout */
+    if (prio < osPriorityRealtime7) {
+      (void)osThreadSetPriority(tc_supervisor, (osPriority_t)(prio + 1));
+    }
+    flags = osThreadFlagsWait(TC_FLAG_DONE, osFlagsWaitAny, ticks);
+    if ((flags & osFlagsError) != 0U) {
+      (void)osThreadTerminate(tid);     /* Budget expired, kill test thread   */
+    }
+    (void)osThreadSetPriority(tc_supervisor, prio);
+  }
+  *used += (uint32_t)(((uint64_t)(osKernelGetTickCount() - start) * 1000U) / freq);
+
+  if ((flags & osFlagsError) != 0U) {
+    return 1U;
+  }
+#else
+  (void)budget;
+  (void)used;
+  func();
+#endif
+  return 0U;
+}
+
 
 /*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
 /**
 \brief This is the entry point of the test framework.
 \details
+\param[in]   argument  pointer to \ref DV_SHARD selecting the test shard of this board, or NULL (configuration)
+
 Program flow:
   -# Test report is initialized
-  -# For each test group following steps are executed:
+  -# Test cases are distributed to shards and checkpoint of an interrupted run is loaded
+  -# For each test group with test cases of this shard following steps are executed:
     -# Test group initialization is called (custom test group initialization)
     -# Test group header is written to standard output 
-    -# All tests in a group are executed as follows:
+    -# All tests of this shard in a group are executed as follows (results restored from checkpoint are only reported):
         - Test statistics are initialized
         - Test report header is written to the standard output
-        - Test function is executed
+        - Test group fixture setup is called if test uses the fixture and fixture is not active
+        - Test function is executed (\b DV_REPEAT_COUNT times, fixture steps apply to each run)
+        - Test group fixture teardown is called if next enabled test does not use the fixture
+          (or after each fixture test run if \b DV_KEEP_POWERED is disabled)
         - Test results are written to the standard output
         - Test report footer is written to the standard output
+        - If test exceeded its timeout, fixture teardown and test group uninitialization and
+          initialization are called to recover before the next test
     -# Test group footer is written to standard output 
     -# Test group uninitialization is called (custom test group uninitialization)
   -# Debug session ends when closeDebug function is reached
 */
 void cmsis_dv (void *argument) {
   const char *fn;
-  uint32_t    i, tc, no;
-
-  (void)argument;
+  uint32_t    i, tc, no, k, restore, run;
+  uint32_t    powered, budget, used, timeout;
+  uint32_t    run_no, runs, run_used, keep;
+  char        msg[80];
 
   if (tg_cnt != 0U) {                   /* If at least 1 test is enabled      */
 
     ritf.tr_Init ();                    /* Init test report                   */
 
+    sh_Init((const DV_SHARD *)argument);/* Select test cases of this shard    */
+    restore = cp_Load();                /* Tests restored from checkpoint     */
+    k       = 0U;                       /* Test index within the run          */
+
     for (i = 0U; i < tg_cnt; i++) {
 
+      for (tc = 0U, run = 0U; tc < ts[i].NumOfTC; tc++) {
+        run |= sh_Assigned(k + tc);
+      }
+      if (run == 0U) {                  /* Skip group without tests to run    */
+        k += ts[i].NumOfTC;
+        continue;
+      }
+
                                         /* Init test group report             */
       ritf.tg_Init(ts[i].ReportTitle,   /* Write test group title             */
                    ts[i].Date,          /* Write test group compilation date  */
                    ts[i].Time,          /* Write test group compilation time  */
                    ts[i].FileName);     /* Write test group module file name  */
 
-      if (ts[i].Init != NULL) {
-        ts[i].Init();                   /* Init test group (group setup)      */
+      if (sh_count > 1U) {
+        (void)snprintf(msg, sizeof(msg), "Test shard %d of %d", sh_index + 1U, sh_count);
+        ritf.tg_Info(msg);
+      }
+      if (k < restore) {
+        (void)snprintf(msg, sizeof(msg), "Run resumed after reset, results of %d tests restored from checkpoint", restore);
+        ritf.tg_Info(msg);
+      }
+#if (DV_CHECKPOINT != 0)
+      if (cp_active == 0U) {
+        (void)snprintf(msg, sizeof(msg), "Checkpoint disabled, %d test cases exceed capacity of %d", cp_total, DV_CHECKPOINT_TESTS);
+        ritf.tg_Info(msg);
+      }
+#endif
+
+      if ((k + ts[i].NumOfTC) > restore) {
+        cp_Result((k > restore) ? k : restore, CP_RES_RUNNING);
+        if (ts[i].Init != NULL) {
+          ts[i].Init();                 /* Init test group (group setup)      */
+        }
       }
 
       ritf.tg_InfoDone();               /* Test group info done               */
 
       /* Execute all tests in a group */
+      powered = 0U;
       for (tc = 0U; tc < ts[i].NumOfTC; tc++) {
+        if (!sh_Assigned(k)) {          /* Test case runs on other shard      */
+          k++;
+          continue;
+        }
         no = tc + 1U;                   /* Test number                        */
         fn = ts[i].TC[tc].TFName;       /* Test function name string          */
         ritf.tc_Init (no, fn);          /* Init test report #(Base + TC)      */
-        if (ts[i].TC[tc].TestFunc != NULL) {
-          ts[i].TC[tc].TestFunc();      /* Execute test func if enabled       */
+        if (k < restore) {
+          tc_Restore(k);                /* Report result from checkpoint      */
+          ritf.tc_Uninit ();
+          k++;
+          continue;
+        }
+        cp_Result(k, CP_RES_RUNNING);   /* Save test start to checkpoint      */
+        budget  = (ts[i].TC[tc].Timeout != 0U) ? ts[i].TC[tc].Timeout : DV_TEST_TIMEOUT;
+        budget *= 1000U;                /* Time budget in ms (of each run)    */
+        runs    = (ts[i].TC[tc].TestFunc != NULL) ? DV_REPEAT_COUNT : 1U;
+        used    = 0U;
+        timeout = 0U;
+        tc_unsupervised = 0U;
+        for (run_no = 1U; run_no <= runs; run_no++) {
+          if (runs > 1U) {
+            ritf.tc_Repeat();           /* Start next run of repeated test    */
+          }
+          run_used = 0U;
+          if (tc_Fixture(&ts[i], tc) && (powered == 0U)) {
+            powered = 1U;
+            if (ts[i].Setup != NULL) {  /* Setup fixture (init and power on)  */
+              timeout = tc_Exec(ts[i].Setup, budget, &run_used);
+            }
+          }
+          if ((timeout == 0U) && (ts[i].TC[tc].TestFunc != NULL)) {
+                                        /* Execute test func if enabled       */
+            timeout = tc_Exec(ts[i].TC[tc].TestFunc, budget, &run_used);
+          }
+          if (run_no < runs) {          /* Fixture test repeats on same setup */
+            keep = (DV_KEEP_POWERED != 0) ? 1U : 0U;
+          } else {
+            keep = tc_KeepPowered(&ts[i], tc, k) ? 1U : 0U;
+          }
+          if ((timeout == 0U) && (powered != 0U) && (keep == 0U)) {
+            powered = 0U;
+            if (ts[i].Teardown != NULL) { /* Teardown fixture (power off)     */
+              timeout = tc_Exec(ts[i].Teardown, budget, &run_used);
+            }
+          }
+          if (run_used > used) {        /* Report longest run                 */
+            used = run_used;
+          }
+          if ((timeout != 0U) || ((DV_REPEAT_STOP != 0) && (ritf.tc_Result() == FAILED))) {
+            break;                      /* Stop repeating test                */
+          }
+        }
+        if (timeout != 0U) {
+          (void)snprintf(msg, sizeof(msg), "[FAILED] Test timeout (%d s) expired", budget / 1000U);
+          __set_result(__FILE__, __LINE__, msg, FAILED);
+        }
+        if (tc_unsupervised != 0U) {
+          __set_message(__FILE__, __LINE__, "[WARNING] Test thread could not be created, test timeout not supervised");
         }
+        if ((TC_WATCHDOG != 0) && (ts[i].TC[tc].TestFunc != NULL)) {
+          ritf.tc_Budget(used, budget); /* Report time budget used            */
+        }
+        cp_Result(k, (uint8_t)ritf.tc_Result() + 1U);
+        k++;
         ritf.tc_Uninit ();              /* Uninit test report                 */
+
+        if (timeout != 0U) {            /* Recover from terminated test       */
+          used = 0U;
+          if ((powered != 0U) && (ts[i].Teardown != NULL)) {
+            (void)tc_Exec(ts[i].Teardown, TC_RECOVERY_TIMEOUT, &used);
+          }
+          powered = 0U;
+          if (ts[i].Uninit != NULL) {   /* Restart test group                 */
+            used = 0U;
+            (void)tc_Exec(ts[i].Uninit, TC_RECOVERY_TIMEOUT, &used);
+          }
+          if (ts[i].Init != NULL) {
+            used = 0U;
+            (void)tc_Exec(ts[i].Init, TC_RECOVERY_TIMEOUT, &used);
+          }
+        }
       }
 
       ritf.tg_Uninit ();                /* Uninit test group report           */
 
-      if (ts[i].Uninit != NULL) {
+      if ((ts[i].Uninit != NULL) && (k > restore)) {
         ts[i].Uninit();                 /* Uninit test group (group teardown) */
       }
     }
 
+    cp_Done();                          /* Run completed, clear checkpoint    */
+    free(sh_shard);
+    sh_shard = NULL;
+
     ritf.tr_Uninit();                   /* Uninit test report                 */
   }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020 Arm Limited. All rights reserved.
+ * Copyright (c) 2015-2026 Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -32,19 +32,766 @@
 #include <stdlib.h> 
 #include <string.h> 
 
+#define CMD_LEN                   32UL  // Length of command to I2C Server
+#define RESP_GET_VER_LEN          16UL  // Length of response from I2C Server to GET VER command
+#define RESP_GET_CAP_LEN          32UL  // Length of response from I2C Server to GET CAP command
+#define RESP_GET_CNT_LEN          16UL  // Length of response from I2C Server to GET CNT command
+
+#define OP_MASTER_TRANSMIT        0UL   // Master transmit to I2C Server
+#define OP_MASTER_RECEIVE         1UL   // Master receive from I2C Server
+#define OP_MASTER_REPEATED_START  2UL   // Master transmit followed by repeated start and receive
+#define OP_SLAVE_TRANSMIT         3UL   // Slave transmit to I2C Server (I2C Server is Master)
+#define OP_SLAVE_RECEIVE          4UL   // Slave receive from I2C Server (I2C Server is Master)
+
+#define SLAVE_XFER_DELAY          20UL  // Delay of I2C Server Master transfer (ms), allows Slave preparation
+
+#define I2C_EVENTS_ERROR_MASK    (ARM_I2C_EVENT_TRANSFER_INCOMPLETE | \
+                                  ARM_I2C_EVENT_ADDRESS_NACK        | \
+                                  ARM_I2C_EVENT_ARBITRATION_LOST    | \
+                                  ARM_I2C_EVENT_BUS_ERROR)
+
+// Buffer size (covers commands, data exchange and throughput transfers)
+#define I2C_BUF_MAX             ((I2C_CFG_NUM > I2C_CFG_THROUGHPUT_NUM) ? (I2C_CFG_NUM + CMD_LEN) : (I2C_CFG_THROUGHPUT_NUM + CMD_LEN))
+
+typedef struct {                // I2C Server version structure
+  uint8_t  major;               // Version major number
+  uint8_t  minor;               // Version minor number
+  uint16_t patch;               // Version patch (revision) number
+} I2C_SERV_VER_t;
+
+typedef struct {                // I2C Server capabilities structure
+  uint32_t bs_mask;             // Bus speed mask (bit 0 = Standard .. bit 3 = High speed)
+  uint32_t addr_10bit;          // 10-bit addressing support
+} I2C_SERV_CAP_t;
+
 // Register Driver_I2C#
 extern ARM_DRIVER_I2C CREATE_SYMBOL(Driver_I2C, DRV_I2C);
 static ARM_DRIVER_I2C *drv = &CREATE_SYMBOL(Driver_I2C, DRV_I2C);
 static ARM_I2C_CAPABILITIES capab;  
 
 // Event flags
-static uint8_t volatile Event;    
+static uint32_t volatile Event;    
+
+// Global variables (used in this module only)
+static int8_t                   server_ok;
+static I2C_SERV_VER_t           i2c_serv_ver;
+static I2C_SERV_CAP_t           i2c_serv_cap;
+static uint32_t                 xfer_count;
+static char                     msg_buf[256];
+static uint8_t                 *ptr_tx_buf;
+static uint8_t                 *ptr_rx_buf;
+static uint8_t                 *ptr_cmp_buf;
+
+// Bus speed names and nominal bus speeds (bps) indexed by ARM_I2C_BUS_SPEED_x
+static const char    *str_bus_speed[] = { "", "Standard", "Fast", "Fast+", "High speed" };
+static const uint32_t bus_speed_bps[] = { 0U, 100000U, 400000U, 1000000U, 3400000U };
+static const char    *metric_tx[]     = { "", "tx_standard", "tx_fast", "tx_fast_plus", "tx_high_speed" };
+static const char    *metric_rx[]     = { "", "rx_standard", "rx_fast", "rx_fast_plus", "rx_high_speed" };
 
 // I2C event
 static void I2C_DrvEvent (uint32_t event) {
   Event |= event;
 }
 
+#ifndef __DOXYGEN__                     // Exclude form the documentation
+
+/*
+  \fn            static uint32_t WaitEvent (uint32_t timeout)
+  \brief         Wait for the end of transfer (transfer done or error event).
+  \param[in]     timeout        Timeout (in ms)
+  \return        events signaled
+*/
+static uint32_t WaitEvent (uint32_t timeout) {
+  uint32_t tick;
+
+  tick = GET_SYSTICK();
+  do {
+    if ((Event & (ARM_I2C_EVENT_TRANSFER_DONE | I2C_EVENTS_ERROR_MASK)) != 0U) {
+      break;
+    }
+  } while ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(timeout * 1000U));
+
+  return Event;
+}
+
+/*
+  \fn            static int32_t IsTransferDone (uint32_t timeout)
+  \brief         Wait for the end of transfer and check that it finished without errors.
+  \param[in]     timeout        Timeout (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Transfer finished successfully
+                   - EXIT_FAILURE: Transfer failed or timeout expired (transfer is aborted)
+*/
+static int32_t IsTransferDone (uint32_t timeout) {
+  uint32_t evt;
+
+  evt = WaitEvent(timeout);
+  if ((evt & (ARM_I2C_EVENT_TRANSFER_DONE | I2C_EVENTS_ERROR_MASK)) == ARM_I2C_EVENT_TRANSFER_DONE) {
+    return EXIT_SUCCESS;
+  }
+
+  (void)drv->Control(ARM_I2C_ABORT_TRANSFER, 0U);
+
+  return EXIT_FAILURE;
+}
+
+/*
+  \fn            static int32_t ComSendCommand (const void *data_out, uint32_t len)
+  \brief         Send command (or data phase of command) to I2C Server.
+  \param[in]     data_out       Pointer to memory containing data to be sent
+  \param[in]     len            Number of bytes to be sent
+  \return        execution status
+                   - EXIT_SUCCESS: Command sent successfully
+                   - EXIT_FAILURE: Command send failed
+*/
+static int32_t ComSendCommand (const void *data_out, uint32_t len) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drv->Control(ARM_I2C_BUS_SPEED, I2C_CFG_SRV_BUS_SPEED) == ARM_DRIVER_OK) {
+    Event = 0U;
+    if (drv->MasterTransmit(I2C_CFG_SRV_ADDR, (const uint8_t *)data_out, len, false) == ARM_DRIVER_OK) {
+      ret = IsTransferDone(I2C_CFG_SRV_CMD_TOUT);
+    }
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t ComReceiveResponse (void *data_in, uint32_t len)
+  \brief         Receive response from I2C Server.
+  \param[out]    data_in        Pointer to memory where data will be received
+  \param[in]     len            Number of bytes to be received
+  \return        execution status
+                   - EXIT_SUCCESS: Response received successfully
+                   - EXIT_FAILURE: Response reception failed
+*/
+static int32_t ComReceiveResponse (void *data_in, uint32_t len) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drv->Control(ARM_I2C_BUS_SPEED, I2C_CFG_SRV_BUS_SPEED) == ARM_DRIVER_OK) {
+    Event = 0U;
+    if (drv->MasterReceive(I2C_CFG_SRV_ADDR, (uint8_t *)data_in, len, false) == ARM_DRIVER_OK) {
+      ret = IsTransferDone(I2C_CFG_SRV_CMD_TOUT);
+    }
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdGetVer (void)
+  \brief         Get version from I2C Server.
+  \return        execution status
+                   - EXIT_SUCCESS: Version retrieved successfully
+                   - EXIT_FAILURE: Version retrieval failed
+*/
+static int32_t CmdGetVer (void) {
+  int32_t  ret;
+  uint32_t major, minor, patch;
+
+  memset(&i2c_serv_ver, 0, sizeof(i2c_serv_ver));
+
+  // Send "GET VER" command to I2C Server
+  memset(ptr_tx_buf, 0, CMD_LEN);
+  memcpy(ptr_tx_buf, "GET VER", 7);
+  ret = ComSendCommand(ptr_tx_buf, CMD_LEN);
+  (void)osDelay(10U);
+
+  if (ret == EXIT_SUCCESS) {
+    // Receive response to "GET VER" command from I2C Server
+    memset(ptr_rx_buf, (int32_t)'?', RESP_GET_VER_LEN);
+    ret = ComReceiveResponse(ptr_rx_buf, RESP_GET_VER_LEN);
+    (void)osDelay(10U);
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Parse version (major.minor.patch)
+    ptr_rx_buf[RESP_GET_VER_LEN - 1U] = 0U;
+    if (sscanf((const char *)ptr_rx_buf, "%u.%u.%u", &major, &minor, &patch) == 3) {
+      i2c_serv_ver.major = (uint8_t)major;
+      i2c_serv_ver.minor = (uint8_t)minor;
+      i2c_serv_ver.patch = (uint16_t)patch;
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdGetCap (void)
+  \brief         Get capabilities from I2C Server.
+  \return        execution status
+                   - EXIT_SUCCESS: Capabilities retrieved successfully
+                   - EXIT_FAILURE: Capabilities retrieval failed
+*/
+static int32_t CmdGetCap (void) {
+  int32_t  ret;
+  uint32_t bs_mask, addr_10bit;
+
+  memset(&i2c_serv_cap, 0, sizeof(i2c_serv_cap));
+
+  // Send "GET CAP" command to I2C Server
+  memset(ptr_tx_buf, 0, CMD_LEN);
+  memcpy(ptr_tx_buf, "GET CAP", 7);
+  ret = ComSendCommand(ptr_tx_buf, CMD_LEN);
+  (void)osDelay(20U);                   // Server auto-detects capabilities
+
+  if (ret == EXIT_SUCCESS) {
+    // Receive response to "GET CAP" command from I2C Server
+    memset(ptr_rx_buf, (int32_t)'?', RESP_GET_CAP_LEN);
+    ret = ComReceiveResponse(ptr_rx_buf, RESP_GET_CAP_LEN);
+    (void)osDelay(10U);
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Parse bus speed mask and 10-bit addressing support
+    ptr_rx_buf[RESP_GET_CAP_LEN - 1U] = 0U;
+    if (sscanf((const char *)ptr_rx_buf, "%x,%u", &bs_mask, &addr_10bit) == 2) {
+      i2c_serv_cap.bs_mask    = bs_mask;
+      i2c_serv_cap.addr_10bit = addr_10bit;
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdSetBufRx (char pattern)
+  \brief         Set Rx buffer of I2C Server to pattern.
+  \param[in]     pattern        Pattern to fill the buffer with
+  \return        execution status
+                   - EXIT_SUCCESS: Command sent successfully
+                   - EXIT_FAILURE: Command send failed
+*/
+static int32_t CmdSetBufRx (char pattern) {
+  int32_t ret;
+
+  // Send "SET BUF RX" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  (void)snprintf((char *)ptr_cmp_buf, CMD_LEN, "SET BUF RX,0,%02X", (int32_t)pattern);
+  ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+  (void)osDelay(10U);
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Set Rx buffer on I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdSetBufTx (const uint8_t *data, uint32_t len)
+  \brief         Load Tx buffer of I2C Server with data.
+  \param[in]     data           Pointer to data to load into the buffer
+  \param[in]     len            Number of bytes to load
+  \return        execution status
+                   - EXIT_SUCCESS: Command and data sent successfully
+                   - EXIT_FAILURE: Command or data send failed
+*/
+static int32_t CmdSetBufTx (const uint8_t *data, uint32_t len) {
+  int32_t ret;
+
+  // Send "SET BUF TX" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  (void)snprintf((char *)ptr_cmp_buf, CMD_LEN, "SET BUF TX,%i", len);
+  ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+  (void)osDelay(10U);
+
+  if (ret == EXIT_SUCCESS) {
+    // Send data phase of "SET BUF TX" command
+    ret = ComSendCommand(data, len);
+    (void)osDelay(10U);
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Set Tx buffer on I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdGetBufRx (uint32_t len)
+  \brief         Get Rx buffer from I2C Server (into global array pointed to by ptr_cmp_buf).
+  \param[in]     len            Number of bytes to read from Rx buffer
+  \return        execution status
+                   - EXIT_SUCCESS: Command sent and response received successfully
+                   - EXIT_FAILURE: Command send or response reception failed
+*/
+static int32_t CmdGetBufRx (uint32_t len) {
+  int32_t ret;
+
+  // Send "GET BUF RX" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  (void)snprintf((char *)ptr_cmp_buf, CMD_LEN, "GET BUF RX,%i", len);
+  ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+  (void)osDelay(10U);
+
+  if (ret == EXIT_SUCCESS) {
+    // Receive response to "GET BUF RX" command from I2C Server
+    memset(ptr_cmp_buf, (int32_t)'?', len);
+    ret = ComReceiveResponse(ptr_cmp_buf, len);
+    (void)osDelay(10U);
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Get Rx buffer from I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdSetCom (uint32_t mode, uint32_t addr, uint32_t addr_10bit, uint32_t bus_speed)
+  \brief         Set communication parameters on I2C Server for next XFER command.
+  \param[in]     mode           mode (0 = Slave, 1 = Master)
+  \param[in]     addr           I2C Server own address (Slave mode) or Slave address (Master mode)
+  \param[in]     addr_10bit     0 = 7-bit address, 1 = 10-bit address
+  \param[in]     bus_speed      bus speed (ARM_I2C_BUS_SPEED_x)
+  \return        execution status
+                   - EXIT_SUCCESS: Command sent successfully
+                   - EXIT_FAILURE: Command send failed
+*/
+static int32_t CmdSetCom (uint32_t mode, uint32_t addr, uint32_t addr_10bit, uint32_t bus_speed) {
+  int32_t ret, stat;
+
+  // Send "SET COM" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  stat = snprintf((char *)ptr_cmp_buf, CMD_LEN, "SET COM %i,%X,%i,%i", mode, addr, addr_10bit, bus_speed);
+  if ((stat > 0) && (stat < (int32_t)CMD_LEN)) {
+    ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+    (void)osDelay(10U);
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Set communication settings on I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdXfer (uint32_t dir, uint32_t num, uint32_t delay, uint32_t timeout)
+  \brief         Activate transfer on I2C Server.
+  \param[in]     dir            direction (0 = Server receives, 1 = Server transmits, 2 = write, repeated start, read)
+  \param[in]     num            number of bytes
+  \param[in]     delay          delay before transfer is started, in milliseconds
+  \param[in]     timeout        timeout in milliseconds
+  \return        execution status
+                   - EXIT_SUCCESS: Command sent successfully
+                   - EXIT_FAILURE: Command send failed
+*/
+static int32_t CmdXfer (uint32_t dir, uint32_t num, uint32_t delay, uint32_t timeout) {
+  int32_t ret;
+
+  // Send "XFER" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  (void)snprintf((char *)ptr_cmp_buf, CMD_LEN, "XFER %i,%i,%i,%i", dir, num, delay, timeout);
+  ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Activate transfer on I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t CmdGetCnt (void)
+  \brief         Get XFER command Tx/Rx count from I2C Server.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t CmdGetCnt (void) {
+  int32_t  ret;
+  uint32_t val32;
+
+  xfer_count = 0U;
+
+  // Send "GET CNT" command to I2C Server
+  memset(ptr_cmp_buf, 0, CMD_LEN);
+  memcpy(ptr_cmp_buf, "GET CNT", 7);
+  ret = ComSendCommand(ptr_cmp_buf, CMD_LEN);
+  (void)osDelay(10U);
+
+  if (ret == EXIT_SUCCESS) {
+    // Receive response to "GET CNT" command from I2C Server
+    memset(ptr_cmp_buf, (int32_t)'?', RESP_GET_CNT_LEN);
+    ret = ComReceiveResponse(ptr_cmp_buf, RESP_GET_CNT_LEN);
+    (void)osDelay(10U);
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Parse count
+    ptr_cmp_buf[RESP_GET_CNT_LEN - 1U] = 0U;
+    if (sscanf((const char *)ptr_cmp_buf, "%u", &val32) == 1) {
+      xfer_count = val32;
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE("[FAILED] Get count from I2C Server. Check I2C Server! Test aborted!");
+  }
+
+  return ret;
+}
+
+/*
+  \fn            static int32_t ServerInit (void)
+  \brief         Initialize communication with I2C Server, get version and capabilities.
+  \return        execution status
+                   - EXIT_SUCCESS: I2C Server initialized successfully
+                   - EXIT_FAILURE: I2C Server initialization failed
+*/
+static int32_t ServerInit (void) {
+
+  if (server_ok == -1) {                // If -1, means it was not yet checked
+    server_ok = 1;
+
+    if (CmdGetVer() != EXIT_SUCCESS) {
+      TEST_GROUP_INFO("Failed to Get version from I2C Server.\nCheck I2C Server!\n");
+      server_ok = 0;
+    }
+
+    if (server_ok == 1) {
+      if (CmdGetCap() != EXIT_SUCCESS) {
+        TEST_GROUP_INFO("Failed to Get capabilities from I2C Server.\nCheck I2C Server!\n");
+        server_ok = 0;
+      }
+    }
+  }
+
+  if (server_ok == 1) {
+    return EXIT_SUCCESS;
+  }
+
+  return EXIT_FAILURE;
+}
+
+/*
+  \fn            static int32_t ServerCheck (void)
+  \brief         Check if communication with I2C Server is working.
+  \return        execution status
+                   - EXIT_SUCCESS: If I2C Server status is ok
+                   - EXIT_FAILURE: If I2C Server status is fail
+*/
+static int32_t ServerCheck (void) {
+
+  if ((server_ok == 1) && (ptr_tx_buf != NULL) && (ptr_rx_buf != NULL) && (ptr_cmp_buf != NULL)) {
+    return EXIT_SUCCESS;
+  }
+
+  TEST_FAIL_MESSAGE("[FAILED] I2C Server status. Check I2C Server! Test aborted!");
+  return EXIT_FAILURE;
+}
+
+/*
+  \fn            static int32_t I2C_DataExchange_Operation (uint32_t operation, uint32_t addr_10bit, uint32_t bus_speed, uint32_t num, uint32_t *ticks)
+  \brief         Execute data exchange with the I2C Server and check transferred data.
+  \param[in]     operation      operation (OP_MASTER_TRANSMIT .. OP_SLAVE_RECEIVE)
+  \param[in]     addr_10bit     0 = 7-bit address, 1 = 10-bit address
+  \param[in]     bus_speed      bus speed (ARM_I2C_BUS_SPEED_x)
+  \param[in]     num            number of bytes
+  \param[out]    ticks          duration of the transfer on the driver side (in system timer ticks), can be NULL
+  \return        execution status
+                   - EXIT_SUCCESS: Data exchanged and verified successfully
+                   - EXIT_FAILURE: Data exchange or verification failed, or operation is not supported
+*/
+static int32_t I2C_DataExchange_Operation (uint32_t operation, uint32_t addr_10bit, uint32_t bus_speed, uint32_t num, uint32_t *ticks) {
+  uint32_t addr, drv_addr, srv_mode, srv_dir, srv_delay, exp_cnt, drv_cnt, start, i;
+  int32_t  ret;
+
+  addr     = (addr_10bit != 0U) ? I2C_CFG_ADDR_10BIT : I2C_CFG_ADDR_7BIT;
+  drv_addr = (addr_10bit != 0U) ? (addr | ARM_I2C_ADDRESS_10BIT) : addr;
+
+  // Check that I2C Server and driver support requested settings
+  if (ServerCheck() != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+  if ((i2c_serv_cap.bs_mask & (1UL << (bus_speed - ARM_I2C_BUS_SPEED_STANDARD))) == 0U) {
+    (void)snprintf(msg_buf, sizeof(msg_buf), "[FAILED] I2C Server does not support %s bus speed! Test aborted!", str_bus_speed[bus_speed]);
+    TEST_FAIL_MESSAGE(msg_buf);
+    return EXIT_FAILURE;
+  }
+  if ((addr_10bit != 0U) && (i2c_serv_cap.addr_10bit == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] I2C Server does not support 10-bit addressing! Test aborted!");
+    return EXIT_FAILURE;
+  }
+  capab = drv->GetCapabilities();
+  if ((addr_10bit != 0U) && (capab.address_10_bit == 0U)) {
+    TEST_MESSAGE("[WARNING] Driver does not support 10-bit addressing! Test not executed!");
+    return EXIT_FAILURE;
+  }
+  if (drv->Control(ARM_I2C_BUS_SPEED, bus_speed) != ARM_DRIVER_OK) {
+    (void)snprintf(msg_buf, sizeof(msg_buf), "[WARNING] Driver does not support %s bus speed! Test not executed!", str_bus_speed[bus_speed]);
+    TEST_MESSAGE(msg_buf);
+    return EXIT_FAILURE;
+  }
+
+  // Prepare data with content depending on position (detects lost or repeated bytes)
+  for (i = 0U; i < num; i++) {
+    ptr_tx_buf[i] = (uint8_t)((i * 7U) + (i >> 8) + 1U);
+  }
+  memset(ptr_rx_buf, (int32_t)'?', num);
+
+  // Select I2C Server operation
+  srv_mode  = 0U;
+  srv_dir   = 0U;
+  srv_delay = 0U;
+  exp_cnt   = num;
+  switch (operation) {
+    case OP_MASTER_TRANSMIT:
+      break;
+    case OP_MASTER_RECEIVE:
+      srv_dir   = 1U;
+      break;
+    case OP_MASTER_REPEATED_START:
+      srv_dir   = 2U;
+      exp_cnt   = num * 2U;
+      break;
+    case OP_SLAVE_TRANSMIT:
+      srv_mode  = 1U;
+      srv_delay = SLAVE_XFER_DELAY;
+      break;
+    case OP_SLAVE_RECEIVE:
+      srv_mode  = 1U;
+      srv_dir   = 1U;
+      srv_delay = SLAVE_XFER_DELAY;
+      break;
+    default:
+      return EXIT_FAILURE;
+  }
+
+  // Prepare I2C Server buffers, communication settings and start the transfer on the I2C Server
+  ret = CmdSetBufRx('?');
+  if ((ret == EXIT_SUCCESS) && (srv_dir != 0U)) {
+    ret = CmdSetBufTx(ptr_tx_buf, num);
+  }
+  if (ret == EXIT_SUCCESS) {
+    ret = CmdSetCom(srv_mode, addr, addr_10bit, bus_speed);
+  }
+  if (ret == EXIT_SUCCESS) {
+    ret = CmdXfer(srv_dir, num, srv_delay, I2C_CFG_XFER_TOUT);
+  }
+  if (ret != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  if (srv_mode == 0U) {
+    // Allow I2C Server to prepare Slave operation
+    (void)osDelay(10U);
+  }
+
+  // Execute the transfer on the driver side
+  ret = EXIT_FAILURE;
+  (void)drv->Control(ARM_I2C_BUS_SPEED, bus_speed);
+  Event = 0U;
+  start = GET_SYSTICK();
+  switch (operation) {
+    case OP_MASTER_TRANSMIT:
+      if (drv->MasterTransmit(drv_addr, ptr_tx_buf, num, false) == ARM_DRIVER_OK) {
+        ret = IsTransferDone(I2C_CFG_XFER_TOUT);
+      }
+      break;
+    case OP_MASTER_RECEIVE:
+      if (drv->MasterReceive(drv_addr, ptr_rx_buf, num, false) == ARM_DRIVER_OK) {
+        ret = IsTransferDone(I2C_CFG_XFER_TOUT);
+      }
+      break;
+    case OP_MASTER_REPEATED_START:
+      if (drv->MasterTransmit(drv_addr, ptr_tx_buf, num, true) == ARM_DRIVER_OK) {
+        ret = IsTransferDone(I2C_CFG_XFER_TOUT);
+      }
+      if (ret == EXIT_SUCCESS) {
+        ret   = EXIT_FAILURE;
+        Event = 0U;
+        if (drv->MasterReceive(drv_addr, ptr_rx_buf, num, false) == ARM_DRIVER_OK) {
+          ret = IsTransferDone(I2C_CFG_XFER_TOUT);
+        }
+      }
+      break;
+    case OP_SLAVE_TRANSMIT:
+      if (drv->Control(ARM_I2C_OWN_ADDRESS, drv_addr) == ARM_DRIVER_OK) {
+        if (drv->SlaveTransmit(ptr_tx_buf, num) == ARM_DRIVER_OK) {
+          ret = IsTransferDone(I2C_CFG_XFER_TOUT + SLAVE_XFER_DELAY);
+        }
+      }
+      break;
+    case OP_SLAVE_RECEIVE:
+      if (drv->Control(ARM_I2C_OWN_ADDRESS, drv_addr) == ARM_DRIVER_OK) {
+        if (drv->SlaveReceive(ptr_rx_buf, num) == ARM_DRIVER_OK) {
+          ret = IsTransferDone(I2C_CFG_XFER_TOUT + SLAVE_XFER_DELAY);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  if (ticks != NULL) {
+    *ticks = GET_SYSTICK() - start;
+  }
+  drv_cnt = (uint32_t)drv->GetDataCount();
+  if (ret != EXIT_SUCCESS) {
+    // Abort transfer still in progress, driver stays powered for next test
+    (void)drv->Control(ARM_I2C_ABORT_TRANSFER, 0U);
+  }
+  if (srv_mode != 0U) {
+    (void)drv->Control(ARM_I2C_OWN_ADDRESS, 0U);
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    (void)snprintf(msg_buf, sizeof(msg_buf), "[FAILED] Transfer at %s bus speed did not finish (events 0x%X, count %i of %i)! Test aborted!",
+                   str_bus_speed[bus_speed], Event, drv_cnt, num);
+    TEST_FAIL_MESSAGE(msg_buf);
+    // Wait for I2C Server to time out and revert to command reception
+    (void)osDelay(I2C_CFG_XFER_TOUT + SLAVE_XFER_DELAY);
+    return EXIT_FAILURE;
+  }
+  (void)osDelay(10U);
+
+  // Check number of bytes transferred by the I2C Server
+  if (CmdGetCnt() != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+  if (xfer_count != exp_cnt) {
+    (void)snprintf(msg_buf, sizeof(msg_buf), "[FAILED] I2C Server transferred %i bytes, expected %i!", xfer_count, exp_cnt);
+    TEST_FAIL_MESSAGE(msg_buf);
+    return EXIT_FAILURE;
+  }
+
+  // Check data received by the driver
+  if ((operation == OP_MASTER_RECEIVE) || (operation == OP_MASTER_REPEATED_START) || (operation == OP_SLAVE_RECEIVE)) {
+    if (memcmp(ptr_rx_buf, ptr_tx_buf, num) != 0) {
+      TEST_FAIL_MESSAGE("[FAILED] Data received by the driver does not match data sent by I2C Server!");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Check data received by the I2C Server
+  if ((operation == OP_MASTER_TRANSMIT) || (operation == OP_MASTER_REPEATED_START) || (operation == OP_SLAVE_TRANSMIT)) {
+    if (CmdGetBufRx(num) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+    if (memcmp(ptr_cmp_buf, ptr_tx_buf, num) != 0) {
+      TEST_FAIL_MESSAGE("[FAILED] Data received by I2C Server does not match data sent by the driver!");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*
+  \fn            static void I2C_DataExchange (uint32_t operation, uint32_t addr_10bit, uint32_t bus_speed)
+  \brief         Execute data exchange with the I2C Server (driver is powered by the test group fixture).
+  \param[in]     operation      operation (OP_MASTER_TRANSMIT .. OP_SLAVE_RECEIVE)
+  \param[in]     addr_10bit     0 = 7-bit address, 1 = 10-bit address
+  \param[in]     bus_speed      bus speed (ARM_I2C_BUS_SPEED_x)
+  \return        none
+*/
+static void I2C_DataExchange (uint32_t operation, uint32_t addr_10bit, uint32_t bus_speed) {
+
+  if (I2C_DataExchange_Operation(operation, addr_10bit, bus_speed, I2C_CFG_NUM, NULL) == EXIT_SUCCESS) {
+    TEST_PASS();
+  }
+}
+
+/*
+  \fn            void I2C_DV_Initialize (void)
+  \brief         Initialize testing environment for I2C testing.
+  \detail        This function is called by the driver validation framework before I2C testing begins.
+                 It allocates memory buffers and checks communication with the I2C Server.
+  \return        none
+*/
+void I2C_DV_Initialize (void) {
+
+  server_ok  = -1;
+  xfer_count = 0U;
+  memset(&i2c_serv_cap, 0, sizeof(i2c_serv_cap));
+  memset(&msg_buf,      0, sizeof(msg_buf));
+
+  ptr_tx_buf  = (uint8_t *)malloc(I2C_BUF_MAX);
+  ptr_rx_buf  = (uint8_t *)malloc(I2C_BUF_MAX);
+  ptr_cmp_buf = (uint8_t *)malloc(I2C_BUF_MAX);
+
+  if ((ptr_tx_buf != NULL) && (ptr_rx_buf != NULL) && (ptr_cmp_buf != NULL)) {
+    // Test communication with I2C Server
+    if (drv->Initialize    (I2C_DrvEvent)   == ARM_DRIVER_OK) {
+      if (drv->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK) {
+        if (ServerInit() == EXIT_SUCCESS) {
+          (void)snprintf(msg_buf, sizeof(msg_buf), "I2C Server v%i.%i.%i, bus speed mask 0x%X, 10-bit addressing %s",
+                         i2c_serv_ver.major, i2c_serv_ver.minor, i2c_serv_ver.patch,
+                         i2c_serv_cap.bs_mask, (i2c_serv_cap.addr_10bit != 0U) ? "supported" : "not supported");
+          TEST_GROUP_INFO(msg_buf);
+        }
+      }
+    }
+    (void)drv->PowerControl(ARM_POWER_OFF);
+    (void)drv->Uninitialize();
+  }
+}
+
+/*
+  \fn            void I2C_DV_Setup (void)
+  \brief         Initialize and power on the driver for data exchange tests.
+  \detail        This function is called by the driver validation framework before the first data exchange test.
+  \return        none
+*/
+void I2C_DV_Setup (void) {
+  TEST_ASSERT(drv->Initialize(I2C_DrvEvent) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+}
+
+/*
+  \fn            void I2C_DV_Teardown (void)
+  \brief         Power off and uninitialize the driver after data exchange tests.
+  \detail        This function is called by the driver validation framework after the last data exchange test.
+  \return        none
+*/
+void I2C_DV_Teardown (void) {
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+/*
+  \fn            void I2C_DV_Uninitialize (void)
+  \brief         De-initialize testing environment after I2C testing.
+  \detail        This function is called by the driver validation framework after I2C testing is finished.
+                 It frees memory buffers used for the I2C testing.
+  \return        none
+*/
+void I2C_DV_Uninitialize (void) {
+
+  if (ptr_tx_buf != NULL) {
+    free(ptr_tx_buf);
+    ptr_tx_buf  = NULL;
+  }
+  if (ptr_rx_buf != NULL) {
+    free(ptr_rx_buf);
+    ptr_rx_buf  = NULL;
+  }
+  if (ptr_cmp_buf != NULL) {
+    free(ptr_cmp_buf);
+    ptr_cmp_buf = NULL;
+  }
+}
+
+#endif                                  // End of exclude form the documentation
+
 /*-----------------------------------------------------------------------------
  *      Tests
  *----------------------------------------------------------------------------*/
@@ -54,7 +801,11 @@ static void I2C_DrvEvent (uint32_t event) {
 \defgroup dv_i2c I2C Validation
 \brief I2C driver validation
 \details
-The I2C validation test checks the API interface compliance only.
+The I2C validation performs the following tests:
+- API interface compliance
+- Data exchange with the \ref i2c_server "I2C Server" in Master and Slave mode, with 7-bit and 10-bit addressing,
+  repeated start and at all bus speeds
+- Throughput at all bus speeds
 
 \defgroup i2c_tests Tests
 \ingroup dv_i2c
@@ -295,6 +1046,207 @@ void I2C_AbortTransfer (void) {
   TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK); 
 }
 
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_MasterTransmit_7Bit
+\details
+The test function \b I2C_MasterTransmit_7Bit verifies the \b MasterTransmit function with the sequence:
+ - I2C Server: Slave receive at the configured 7-bit address
+ - Driver: Master transmit to the configured 7-bit address and wait for the transfer done event
+ - Check number of bytes received and data received by the I2C Server
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+*/
+void I2C_MasterTransmit_7Bit (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 0U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_MasterReceive_7Bit
+\details
+The test function \b I2C_MasterReceive_7Bit verifies the \b MasterReceive function with the sequence:
+ - I2C Server: Slave transmit at the configured 7-bit address
+ - Driver: Master receive from the configured 7-bit address and wait for the transfer done event
+ - Check number of bytes transmitted by the I2C Server and data received by the driver
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+*/
+void I2C_MasterReceive_7Bit (void) {
+  I2C_DataExchange(OP_MASTER_RECEIVE, 0U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_MasterTransmit_10Bit
+\details
+The test function \b I2C_MasterTransmit_10Bit verifies the \b MasterTransmit function with 10-bit addressing
+with the same sequence as \ref I2C_MasterTransmit_7Bit using the configured 10-bit address.
+*/
+void I2C_MasterTransmit_10Bit (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 1U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_MasterReceive_10Bit
+\details
+The test function \b I2C_MasterReceive_10Bit verifies the \b MasterReceive function with 10-bit addressing
+with the same sequence as \ref I2C_MasterReceive_7Bit using the configured 10-bit address.
+*/
+void I2C_MasterReceive_10Bit (void) {
+  I2C_DataExchange(OP_MASTER_RECEIVE, 1U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_MasterRepeatedStart
+\details
+The test function \b I2C_MasterRepeatedStart verifies a combined transfer with the sequence:
+ - I2C Server: Slave receive followed by Slave transmit at the configured 7-bit address
+ - Driver: Master transmit with transfer pending (no Stop condition), then Master receive
+   (issued with repeated Start condition)
+ - Check number of bytes transferred, data received by the I2C Server and data received by the driver
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+*/
+void I2C_MasterRepeatedStart (void) {
+  I2C_DataExchange(OP_MASTER_REPEATED_START, 0U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_SlaveTransmit
+\details
+The test function \b I2C_SlaveTransmit verifies the \b SlaveTransmit function with the sequence:
+ - I2C Server: Master receive from the configured 7-bit address (delayed)
+ - Driver: set own address to the configured 7-bit address, Slave transmit and wait for the transfer done event
+ - Check number of bytes and data received by the I2C Server
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+*/
+void I2C_SlaveTransmit (void) {
+  I2C_DataExchange(OP_SLAVE_TRANSMIT, 0U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_SlaveReceive
+\details
+The test function \b I2C_SlaveReceive verifies the \b SlaveReceive function with the sequence:
+ - I2C Server: Master transmit to the configured 7-bit address (delayed)
+ - Driver: set own address to the configured 7-bit address, Slave receive and wait for the transfer done event
+ - Check number of bytes transmitted by the I2C Server and data received by the driver
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+*/
+void I2C_SlaveReceive (void) {
+  I2C_DataExchange(OP_SLAVE_RECEIVE, 0U, I2C_CFG_BUS_SPEED);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_BusSpeed_Standard
+\details
+The test function \b I2C_BusSpeed_Standard verifies Master transmit and Master receive data exchange
+with the I2C Server at Standard bus speed (100 kbit/s).
+*/
+void I2C_BusSpeed_Standard (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 0U, ARM_I2C_BUS_SPEED_STANDARD);
+  I2C_DataExchange(OP_MASTER_RECEIVE,  0U, ARM_I2C_BUS_SPEED_STANDARD);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_BusSpeed_Fast
+\details
+The test function \b I2C_BusSpeed_Fast verifies Master transmit and Master receive data exchange
+with the I2C Server at Fast bus speed (400 kbit/s).
+*/
+void I2C_BusSpeed_Fast (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 0U, ARM_I2C_BUS_SPEED_FAST);
+  I2C_DataExchange(OP_MASTER_RECEIVE,  0U, ARM_I2C_BUS_SPEED_FAST);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_BusSpeed_FastPlus
+\details
+The test function \b I2C_BusSpeed_FastPlus verifies Master transmit and Master receive data exchange
+with the I2C Server at Fast+ bus speed (1 Mbit/s).
+*/
+void I2C_BusSpeed_FastPlus (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 0U, ARM_I2C_BUS_SPEED_FAST_PLUS);
+  I2C_DataExchange(OP_MASTER_RECEIVE,  0U, ARM_I2C_BUS_SPEED_FAST_PLUS);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_BusSpeed_High
+\details
+The test function \b I2C_BusSpeed_High verifies Master transmit and Master receive data exchange
+with the I2C Server at High bus speed (3.4 Mbit/s).
+*/
+void I2C_BusSpeed_High (void) {
+  I2C_DataExchange(OP_MASTER_TRANSMIT, 0U, ARM_I2C_BUS_SPEED_HIGH);
+  I2C_DataExchange(OP_MASTER_RECEIVE,  0U, ARM_I2C_BUS_SPEED_HIGH);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: I2C_Throughput
+\details
+The test function \b I2C_Throughput measures data throughput of the driver in Master mode with the sequence:
+ - For each bus speed supported by the driver and the I2C Server (Standard, Fast, Fast+ and High speed):
+   - Master transmit of the configured number of bytes to the I2C Server and check data
+   - Master receive of the configured number of bytes from the I2C Server and check data
+   - Report ratio of achieved to theoretical throughput (bus speed / 9 bits per byte, including acknowledge bit)
+   - Record metrics \c tx_<speed> and \c rx_<speed> (bytes/s), for example \c tx_fast
+
+The driver is initialized and powered on by the test group fixture (\b I2C_DV_Setup).
+
+Transfer time is measured on the driver side from the start of the transfer until the transfer done event,
+so addressing, clock stretching by the Slave and interrupt handling overhead lower the achieved throughput.
+*/
+void I2C_Throughput (void) {
+  uint32_t speed, ticks_tx, ticks_rx, bps_tx, bps_rx, bps_max, freq, speed_cnt;
+
+  if (ServerCheck() == EXIT_SUCCESS) {
+    freq      = (uint32_t)SYSTICK_MICROSEC(1000000U);
+    speed_cnt = 0U;
+    for (speed = ARM_I2C_BUS_SPEED_STANDARD; speed <= ARM_I2C_BUS_SPEED_HIGH; speed++) {
+      if ((i2c_serv_cap.bs_mask & (1UL << (speed - ARM_I2C_BUS_SPEED_STANDARD))) == 0U) {
+        continue;
+      }
+      if (drv->Control(ARM_I2C_BUS_SPEED, speed) != ARM_DRIVER_OK) {
+        continue;
+      }
+      if (I2C_DataExchange_Operation(OP_MASTER_TRANSMIT, 0U, speed, I2C_CFG_THROUGHPUT_NUM, &ticks_tx) != EXIT_SUCCESS) {
+        continue;
+      }
+      if (I2C_DataExchange_Operation(OP_MASTER_RECEIVE,  0U, speed, I2C_CFG_THROUGHPUT_NUM, &ticks_rx) != EXIT_SUCCESS) {
+        continue;
+      }
+      if (ticks_tx == 0U) { ticks_tx = 1U; }
+      if (ticks_rx == 0U) { ticks_rx = 1U; }
+      bps_tx  = (uint32_t)(((uint64_t)I2C_CFG_THROUGHPUT_NUM * freq) / ticks_tx);
+      bps_rx  = (uint32_t)(((uint64_t)I2C_CFG_THROUGHPUT_NUM * freq) / ticks_rx);
+      bps_max = bus_speed_bps[speed] / 9U;
+      (void)snprintf(msg_buf, sizeof(msg_buf), "[INFO] %s: transmit %i%%, receive %i%% of %i bytes/s",
+                     str_bus_speed[speed], (bps_tx * 100U) / bps_max, (bps_rx * 100U) / bps_max, bps_max);
+      TEST_MESSAGE(msg_buf);
+      TEST_METRIC_HIGHER(metric_tx[speed], bps_tx, "bytes/s", METRIC_NO_THRESHOLD);
+      TEST_METRIC_HIGHER(metric_rx[speed], bps_rx, "bytes/s", METRIC_NO_THRESHOLD);
+      speed_cnt++;
+    }
+    if (speed_cnt == 0U) {
+      TEST_FAIL_MESSAGE("[FAILED] No bus speed supported by both the driver and I2C Server!");
+    } else {
+      TEST_PASS();
+    }
+  }
+}
+
 /**
 @}
 */ 
@@ -38,13 +38,758 @@ static ARM_DRIVER_MCI *drv = &CREATE_SYMBOL(Driver_MCI, DRV_MCI);
 static ARM_MCI_CAPABILITIES capab;  
 
 // Event flags
-static uint8_t volatile Event;    
+static uint32_t volatile Event;    
+
+// Event timestamps
+static uint32_t volatile TickCmdDone;   // Last ARM_MCI_EVENT_COMMAND_COMPLETE
+static uint32_t volatile TickXferDone;  // Last ARM_MCI_EVENT_TRANSFER_COMPLETE
 
 // MCI event
 static void MCI_DrvEvent (uint32_t event) {
+  if ((event & ARM_MCI_EVENT_COMMAND_COMPLETE) != 0U) {
+    TickCmdDone = GET_SYSTICK();
+  }
+  if ((event & ARM_MCI_EVENT_TRANSFER_COMPLETE) != 0U) {
+    TickXferDone = GET_SYSTICK();
+  }
   Event |= event;
 }
 
+/*-----------------------------------------------------------------------------
+ *      Card access
+ *----------------------------------------------------------------------------*/
+
+#define MCI_BLOCK_SIZE          512U            // Data block size (in bytes)
+#define MCI_CMD_TIMEOUT         100U            // Command timeout (in ms)
+#define MCI_INIT_TIMEOUT        1000U           // Card initialization (ACMD41/CMD1) timeout (in ms)
+
+// Command response types
+#define MCI_R1                  (ARM_MCI_RESPONSE_SHORT      | ARM_MCI_RESPONSE_INDEX | ARM_MCI_RESPONSE_CRC)
+#define MCI_R1b                 (ARM_MCI_RESPONSE_SHORT_BUSY | ARM_MCI_RESPONSE_INDEX | ARM_MCI_RESPONSE_CRC)
+#define MCI_R2                  (ARM_MCI_RESPONSE_LONG       | ARM_MCI_RESPONSE_CRC)
+#define MCI_R3                  (ARM_MCI_RESPONSE_SHORT)
+#define MCI_R6                  (MCI_R1)
+#define MCI_R7                  (MCI_R1)
+
+// Card status (R1) fields
+#define MCI_R1_READY_FOR_DATA   (1UL << 8)
+#define MCI_R1_STATE(r1)        (((r1) >> 9) & 0x0FU)
+#define MCI_R1_STATE_TRAN       4U
+
+// OCR fields
+#define MCI_OCR_BUSY            (1UL << 31)
+#define MCI_OCR_CCS             (1UL << 30)
+#define MCI_OCR_S18             (1UL << 24)
+
+#define MCI_EVENT_CMD_MASK      (ARM_MCI_EVENT_COMMAND_COMPLETE  | ARM_MCI_EVENT_COMMAND_TIMEOUT  | ARM_MCI_EVENT_COMMAND_ERROR)
+#define MCI_EVENT_XFER_MASK     (ARM_MCI_EVENT_TRANSFER_COMPLETE | ARM_MCI_EVENT_TRANSFER_TIMEOUT | ARM_MCI_EVENT_TRANSFER_ERROR)
+
+// Bus configuration
+typedef struct {
+  uint32_t    mode;                     // Bus speed mode (ARM_MCI_BUS_xxx)
+  uint32_t    width;                    // Bus data width (ARM_MCI_BUS_DATA_WIDTH_xxx)
+  uint32_t    clock;                    // Bus clock (in Hz)
+  const char *name;
+  const char *metric;                   // Metric name prefix
+} MCI_BUS_CFG;
+
+#if (MCI_CARD_TYPE == 0)
+static const MCI_BUS_CFG bus_cfg[] = {
+  { ARM_MCI_BUS_DEFAULT_SPEED, ARM_MCI_BUS_DATA_WIDTH_1,      25000000U, "Default speed, 1-bit",  "default_1bit"        },
+  { ARM_MCI_BUS_DEFAULT_SPEED, ARM_MCI_BUS_DATA_WIDTH_4,      25000000U, "Default speed, 4-bit",  "default_4bit"        },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_1,      50000000U, "High speed, 1-bit",     "high_speed_1bit"     },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_4,      50000000U, "High speed, 4-bit",     "high_speed_4bit"     },
+  { ARM_MCI_BUS_UHS_SDR12,     ARM_MCI_BUS_DATA_WIDTH_4,      25000000U, "SDR12, 4-bit",          "sdr12_4bit"          },
+  { ARM_MCI_BUS_UHS_SDR25,     ARM_MCI_BUS_DATA_WIDTH_4,      50000000U, "SDR25, 4-bit",          "sdr25_4bit"          },
+  { ARM_MCI_BUS_UHS_SDR50,     ARM_MCI_BUS_DATA_WIDTH_4,     100000000U, "SDR50, 4-bit",          "sdr50_4bit"          },
+  { ARM_MCI_BUS_UHS_SDR104,    ARM_MCI_BUS_DATA_WIDTH_4,     208000000U, "SDR104, 4-bit",         "sdr104_4bit"         },
+  { ARM_MCI_BUS_UHS_DDR50,     ARM_MCI_BUS_DATA_WIDTH_4_DDR,  50000000U, "DDR50, 4-bit DDR",      "ddr50_4bit_ddr"      }
+};
+#else
+static const MCI_BUS_CFG bus_cfg[] = {
+  { ARM_MCI_BUS_DEFAULT_SPEED, ARM_MCI_BUS_DATA_WIDTH_1,      26000000U, "Default speed, 1-bit",   "default_1bit"        },
+  { ARM_MCI_BUS_DEFAULT_SPEED, ARM_MCI_BUS_DATA_WIDTH_4,      26000000U, "Default speed, 4-bit",   "default_4bit"        },
+  { ARM_MCI_BUS_DEFAULT_SPEED, ARM_MCI_BUS_DATA_WIDTH_8,      26000000U, "Default speed, 8-bit",   "default_8bit"        },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_1,      52000000U, "High speed, 1-bit",      "high_speed_1bit"     },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_4,      52000000U, "High speed, 4-bit",      "high_speed_4bit"     },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_8,      52000000U, "High speed, 8-bit",      "high_speed_8bit"     },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_4_DDR,  52000000U, "High speed, 4-bit DDR",  "high_speed_4bit_ddr" },
+  { ARM_MCI_BUS_HIGH_SPEED,    ARM_MCI_BUS_DATA_WIDTH_8_DDR,  52000000U, "High speed, 8-bit DDR",  "high_speed_8bit_ddr" }
+};
+#endif
+
+// Card state
+static uint32_t card_rca;               // Relative card address
+static uint8_t  card_hc;                // High capacity card (block addressing)
+static uint8_t  card_1v8;               // Card switched to 1.8V signaling
+static uint8_t *buf_out;                // Data buffer for write
+static uint8_t *buf_in;                 // Data buffer for read
+
+// Latency profile sample classes
+enum {
+  MCI_PROF_CMD13 = 0,                   // Command turnaround: SendCommand to COMMAND_COMPLETE
+  MCI_PROF_CMD17,
+  MCI_PROF_CMD18,
+  MCI_PROF_CMD24,
+  MCI_PROF_CMD25,
+  MCI_PROF_CMD12,
+  MCI_PROF_READ_1,                      // Data phase: COMMAND_COMPLETE to TRANSFER_COMPLETE
+  MCI_PROF_READ_N,
+  MCI_PROF_WRITE_1,
+  MCI_PROF_WRITE_N,
+  MCI_PROF_BUSY_1,                      // Card busy: TRANSFER_COMPLETE to CMD13 reporting ready
+  MCI_PROF_BUSY_N,
+  MCI_PROF_NUM
+};
+
+// Latency profile samples (in ticks)
+static uint8_t   prof_active;           // Collect samples
+static uint32_t *prof_buf;
+static uint32_t  prof_cap;              // Samples per class
+static uint32_t  prof_cnt[MCI_PROF_NUM];
+static uint32_t  prof_order_err;        // Samples excluded because events were signaled out of order
+
+// Message buffer
+static char     str[128];
+
+/*
+  \fn            static void MCI_ProfAdd (uint32_t idx, uint32_t ticks)
+  \brief         Store latency sample if profiling is active.
+  \param[in]     idx            Sample class (MCI_PROF_xxx)
+  \param[in]     ticks          Latency (in ticks)
+*/
+static void MCI_ProfAdd (uint32_t idx, uint32_t ticks) {
+
+  if ((prof_active != 0U) && (idx < MCI_PROF_NUM) && (prof_cnt[idx] < prof_cap)) {
+    if ((int32_t)ticks < 0) {
+      /* Events signaled out of order (for example read data before the response) are not a valid sample */
+      prof_order_err++;
+      return;
+    }
+    prof_buf[(idx * prof_cap) + prof_cnt[idx]] = ticks;
+    prof_cnt[idx]++;
+  }
+}
+
+/*
+  \fn            static uint32_t MCI_ProfCmd (uint32_t cmd)
+  \brief         Get latency profile sample class of a command.
+  \return        sample class (MCI_PROF_NUM for commands which are not profiled)
+*/
+static uint32_t MCI_ProfCmd (uint32_t cmd) {
+
+  switch (cmd) {
+    case 13U: return MCI_PROF_CMD13;
+    case 17U: return MCI_PROF_CMD17;
+    case 18U: return MCI_PROF_CMD18;
+    case 24U: return MCI_PROF_CMD24;
+    case 25U: return MCI_PROF_CMD25;
+    case 12U: return MCI_PROF_CMD12;
+    default:  return MCI_PROF_NUM;
+  }
+}
+
+/*
+  \fn            static uint32_t MCI_WaitEvent (uint32_t mask, uint32_t timeout)
+  \brief         Wait for one of the specified events.
+  \param[in]     mask           Events to wait for
+  \param[in]     timeout        Timeout (in ms)
+  \return        events signaled
+*/
+static uint32_t MCI_WaitEvent (uint32_t mask, uint32_t timeout) {
+  uint32_t tick;
+
+  tick = GET_SYSTICK();
+  do {
+    if ((Event & mask) != 0U) {
+      break;
+    }
+  } while ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(timeout * 1000U));
+
+  return Event;
+}
+
+/*
+  \fn            static int32_t MCI_Cmd (uint32_t cmd, uint32_t arg, uint32_t flags, uint32_t *response)
+  \brief         Send command to the card and wait until command completes.
+  \param[in]     cmd            Command index
+  \param[in]     arg            Command argument
+  \param[in]     flags          Command flags (ARM_MCI_xxx)
+  \param[out]    response       Pointer to response
+  \return        execution status
+                   - EXIT_SUCCESS: Command completed successfully
+                   - EXIT_FAILURE: Command failed or timeout expired
+*/
+static int32_t MCI_Cmd (uint32_t cmd, uint32_t arg, uint32_t flags, uint32_t *response) {
+  uint32_t evt, tick;
+
+  Event = 0U;
+  tick  = GET_SYSTICK();
+  if (drv->SendCommand(cmd, arg, flags, response) != ARM_DRIVER_OK) {
+    return EXIT_FAILURE;
+  }
+  evt = MCI_WaitEvent(MCI_EVENT_CMD_MASK, MCI_CMD_TIMEOUT);
+  if ((evt & MCI_EVENT_CMD_MASK) != ARM_MCI_EVENT_COMMAND_COMPLETE) {
+    return EXIT_FAILURE;
+  }
+  MCI_ProfAdd(MCI_ProfCmd(cmd), TickCmdDone - tick);
+
+  return EXIT_SUCCESS;
+}
+
+/*
+  \fn            static int32_t MCI_ACmd (uint32_t cmd, uint32_t arg, uint32_t flags, uint32_t *response)
+  \brief         Send application specific command (CMD55 followed by command) to the card.
+  \return        execution status
+                   - EXIT_SUCCESS: Command completed successfully
+                   - EXIT_FAILURE: Command failed or timeout expired
+*/
+static int32_t MCI_ACmd (uint32_t cmd, uint32_t arg, uint32_t flags, uint32_t *response) {
+  uint32_t r1;
+
+  if (MCI_Cmd(55U, card_rca << 16, MCI_R1, &r1) != EXIT_SUCCESS) {
+    return EXIT_FAILURE;
+  }
+
+  return MCI_Cmd(cmd, arg, flags, response);
+}
+
+/*
+  \fn            static int32_t MCI_WaitReady (uint32_t timeout)
+  \brief         Poll card status (CMD13) until the card is ready for data in transfer state.
+  \param[in]     timeout        Timeout (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Card is ready
+                   - EXIT_FAILURE: Status command failed or timeout expired
+*/
+static int32_t MCI_WaitReady (uint32_t timeout) {
+  uint32_t tick, r1;
+
+  tick = GET_SYSTICK();
+  do {
+    if (MCI_Cmd(13U, card_rca << 16, MCI_R1, &r1) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+    if (((r1 & MCI_R1_READY_FOR_DATA) != 0U) && (MCI_R1_STATE(r1) == MCI_R1_STATE_TRAN)) {
+      return EXIT_SUCCESS;
+    }
+  } while ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(timeout * 1000U));
+
+  return EXIT_FAILURE;
+}
+
+/*
+  \fn            static int32_t MCI_Transfer (uint8_t *data, uint32_t mode, uint32_t block, uint32_t count)
+  \brief         Read or write blocks (single block command for one block, multiple block command otherwise).
+  \param[in]     data           Pointer to data buffer
+  \param[in]     mode           ARM_MCI_TRANSFER_READ or ARM_MCI_TRANSFER_WRITE
+  \param[in]     block          Start block number
+  \param[in]     count          Number of blocks
+  \return        execution status
+                   - EXIT_SUCCESS: Blocks transferred and (for write) programmed
+                   - EXIT_FAILURE: Transfer failed or timeout expired
+*/
+static int32_t MCI_Transfer (uint8_t *data, uint32_t mode, uint32_t block, uint32_t count) {
+  uint32_t cmd, addr, evt, r1, tick_xfer;
+
+  addr = (card_hc != 0U) ? block : (block * MCI_BLOCK_SIZE);
+  if (mode == ARM_MCI_TRANSFER_WRITE) {
+    cmd = (count > 1U) ? 25U : 24U;
+  } else {
+    cmd = (count > 1U) ? 18U : 17U;
+  }
+
+  if (drv->SetupTransfer(data, count, MCI_BLOCK_SIZE, mode | ARM_MCI_TRANSFER_BLOCK) != ARM_DRIVER_OK) {
+    return EXIT_FAILURE;
+  }
+  if (MCI_Cmd(cmd, addr, MCI_R1 | ARM_MCI_TRANSFER_DATA, &r1) != EXIT_SUCCESS) {
+    (void)drv->AbortTransfer();
+    return EXIT_FAILURE;
+  }
+  evt = MCI_WaitEvent(MCI_EVENT_XFER_MASK, MCI_XFER_TIMEOUT);
+  if ((evt & MCI_EVENT_XFER_MASK) != ARM_MCI_EVENT_TRANSFER_COMPLETE) {
+    (void)drv->AbortTransfer();
+    if (count > 1U) {
+      (void)MCI_Cmd(12U, 0U, MCI_R1b, &r1);
+    }
+    return EXIT_FAILURE;
+  }
+  tick_xfer = TickXferDone;
+  if (mode == ARM_MCI_TRANSFER_WRITE) {
+    MCI_ProfAdd((count > 1U) ? MCI_PROF_WRITE_N : MCI_PROF_WRITE_1, tick_xfer - TickCmdDone);
+  } else {
+    MCI_ProfAdd((count > 1U) ? MCI_PROF_READ_N  : MCI_PROF_READ_1,  tick_xfer - TickCmdDone);
+  }
+  if (count > 1U) {
+    /* Stop transmission */
+    if (MCI_Cmd(12U, 0U, MCI_R1b, &r1) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+  if (mode == ARM_MCI_TRANSFER_WRITE) {
+    /* Wait until the card finished programming (busy release is the CMD13 response reporting ready) */
+    if (MCI_WaitReady(MCI_XFER_TIMEOUT) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+    MCI_ProfAdd((count > 1U) ? MCI_PROF_BUSY_N : MCI_PROF_BUSY_1, TickCmdDone - tick_xfer);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* Helper function that initializes and powers on the driver for data tests */
+void MCI_DV_Setup (void) {
+  TEST_ASSERT(drv->Initialize(MCI_DrvEvent) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+}
+
+/* Helper function that powers off and uninitializes the driver after data tests */
+void MCI_DV_Teardown (void) {
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+/*
+  \fn            static int32_t MCI_CardInit (void)
+  \brief         Power on the card, identify it and select it (transfer state, default speed, 1-bit data width).
+                 The driver is initialized and powered on by the test group fixture.
+  \return        execution status
+                   - EXIT_SUCCESS: Card is ready for data transfer
+                   - EXIT_FAILURE: Card initialization failed (reason is stored in str)
+*/
+static int32_t MCI_CardInit (void) {
+  uint32_t r[4], ocr, arg, tick, voltage;
+
+  card_rca = 0U;
+  card_hc  = 0U;
+  card_1v8 = 0U;
+
+  capab = drv->GetCapabilities();
+
+  if (capab.vdd != 0U) {
+    voltage = ARM_MCI_POWER_VDD_3V3;
+    if (capab.vccq != 0U) {
+      voltage |= ARM_MCI_POWER_VCCQ_3V3;
+    }
+    (void)drv->CardPower(voltage);
+  }
+  if ((capab.cd_state != 0U) && (drv->ReadCD() == 0)) {
+    (void)snprintf(str, sizeof(str), "[FAILED] No card detected");
+    return EXIT_FAILURE;
+  }
+
+  /* Identification at 400kHz, 1-bit, default speed */
+  (void)drv->Control(ARM_MCI_BUS_CMD_MODE,   (MCI_CARD_TYPE == 0) ? ARM_MCI_BUS_CMD_PUSH_PULL : ARM_MCI_BUS_CMD_OPEN_DRAIN);
+  (void)drv->Control(ARM_MCI_BUS_DATA_WIDTH, ARM_MCI_BUS_DATA_WIDTH_1);
+  (void)drv->Control(ARM_MCI_BUS_SPEED_MODE, ARM_MCI_BUS_DEFAULT_SPEED);
+  (void)drv->Control(ARM_MCI_BUS_SPEED,      400000U);
+
+  /* CMD0: GO_IDLE_STATE */
+  if (MCI_Cmd(0U, 0U, ARM_MCI_CARD_INITIALIZE | ARM_MCI_RESPONSE_NONE, NULL) != EXIT_SUCCESS) {
+    (void)snprintf(str, sizeof(str), "[FAILED] CMD0 (GO_IDLE_STATE)");
+    return EXIT_FAILURE;
+  }
+
+  tick = GET_SYSTICK();
+  ocr  = 0U;
+#if (MCI_CARD_TYPE == 0)
+  /* CMD8: SEND_IF_COND (2.7-3.6V, check pattern 0xAA), no response from Version 1.x cards */
+  arg = 0x00FF8000U;
+  if ((MCI_Cmd(8U, 0x1AAU, MCI_R7, r) == EXIT_SUCCESS) && ((r[0] & 0xFFFU) == 0x1AAU)) {
+    arg |= MCI_OCR_CCS;
+#if (MCI_UHS_1V8 != 0)
+    if ((capab.uhs_signaling != 0U) && (capab.vccq_1v8 != 0U)) {
+      arg |= MCI_OCR_S18;
+    }
+#endif
+  }
+  /* ACMD41: SD_SEND_OP_COND until card is no longer busy */
+  do {
+    if (MCI_ACmd(41U, arg, MCI_R3, &ocr) != EXIT_SUCCESS) {
+      (void)snprintf(str, sizeof(str), "[FAILED] ACMD41 (SD_SEND_OP_COND)");
+      return EXIT_FAILURE;
+    }
+  } while (((ocr & MCI_OCR_BUSY) == 0U) && ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(MCI_INIT_TIMEOUT * 1000U)));
+#else
+  /* CMD1: SEND_OP_COND (sector mode) until card is no longer busy */
+  arg = 0x40FF8080U;
+  do {
+    if (MCI_Cmd(1U, arg, MCI_R3, &ocr) != EXIT_SUCCESS) {
+      (void)snprintf(str, sizeof(str), "[FAILED] CMD1 (SEND_OP_COND)");
+      return EXIT_FAILURE;
+    }
+  } while (((ocr & MCI_OCR_BUSY) == 0U) && ((GET_SYSTICK() - tick) < SYSTICK_MICROSEC(MCI_INIT_TIMEOUT * 1000U)));
+#endif
+  if ((ocr & MCI_OCR_BUSY) == 0U) {
+    (void)snprintf(str, sizeof(str), "[FAILED] Card initialization timeout (OCR = 0x%08X)", ocr);
+    return EXIT_FAILURE;
+  }
+#if (MCI_CARD_TYPE == 0)
+  card_hc = ((ocr & MCI_OCR_CCS) != 0U) ? 1U : 0U;
+  if (((arg & MCI_OCR_S18) != 0U) && ((ocr & MCI_OCR_S18) != 0U)) {
+    /* CMD11: VOLTAGE_SWITCH to 1.8V signaling */
+    if ((MCI_Cmd(11U, 0U, MCI_R1, r) == EXIT_SUCCESS) &&
+        (drv->CardPower(ARM_MCI_POWER_VDD_3V3 | ARM_MCI_POWER_VCCQ_1V8) == ARM_DRIVER_OK)) {
+      card_1v8 = 1U;
+    }
+  }
+#else
+  card_hc = (((ocr >> 29) & 3U) == 2U) ? 1U : 0U;
+#endif
+
+  /* CMD2: ALL_SEND_CID */
+  if (MCI_Cmd(2U, 0U, MCI_R2, r) != EXIT_SUCCESS) {
+    (void)snprintf(str, sizeof(str), "[FAILED] CMD2 (ALL_SEND_CID)");
+    return EXIT_FAILURE;
+  }
+
+#if (MCI_CARD_TYPE == 0)
+  /* CMD3: SEND_RELATIVE_ADDR (card publishes RCA) */
+  if (MCI_Cmd(3U, 0U, MCI_R6, r) != EXIT_SUCCESS) {
+    (void)snprintf(str, sizeof(str), "[FAILED] CMD3 (SEND_RELATIVE_ADDR)");
+    return EXIT_FAILURE;
+  }
+  card_rca = r[0] >> 16;
+#else
+  /* CMD3: SET_RELATIVE_ADDR (host assigns RCA) */
+  card_rca = 1U;
+  if (MCI_Cmd(3U, card_rca << 16, MCI_R1, r) != EXIT_SUCCESS) {
+    (void)snprintf(str, sizeof(str), "[FAILED] CMD3 (SET_RELATIVE_ADDR)");
+    return EXIT_FAILURE;
+  }
+  (void)drv->Control(ARM_MCI_BUS_CMD_MODE, ARM_MCI_BUS_CMD_PUSH_PULL);
+#endif
+
+  /* CMD7: SELECT_CARD */
+  if (MCI_Cmd(7U, card_rca << 16, MCI_R1b, r) != EXIT_SUCCESS) {
+    (void)snprintf(str, sizeof(str), "[FAILED] CMD7 (SELECT_CARD)");
+    return EXIT_FAILURE;
+  }
+
+  if (card_hc == 0U) {
+    /* CMD16: SET_BLOCKLEN (byte addressed cards) */
+    if (MCI_Cmd(16U, MCI_BLOCK_SIZE, MCI_R1, r) != EXIT_SUCCESS) {
+      (void)snprintf(str, sizeof(str), "[FAILED] CMD16 (SET_BLOCKLEN)");
+      return EXIT_FAILURE;
+    }
+  }
+
+  (void)drv->Control(ARM_MCI_BUS_SPEED, bus_cfg[0].clock);
+
+  return EXIT_SUCCESS;
+}
+
+/*
+  \fn            static void MCI_CardUninit (void)
+  \brief         Power off the card, the driver stays powered for the next test.
+*/
+static void MCI_CardUninit (void) {
+
+  (void)drv->AbortTransfer();
+  if (capab.vdd != 0U) {
+    (void)drv->CardPower(ARM_MCI_POWER_VDD_OFF);
+  }
+}
+
+/*
+  \fn            static uint32_t MCI_BusSupported (const MCI_BUS_CFG *cfg)
+  \brief         Check if bus configuration is supported by the driver and the card signaling.
+  \return        1 if supported, 0 otherwise
+*/
+static uint32_t MCI_BusSupported (const MCI_BUS_CFG *cfg) {
+  uint32_t ok;
+
+  switch (cfg->width) {
+    case ARM_MCI_BUS_DATA_WIDTH_4:     ok = capab.data_width_4;     break;
+    case ARM_MCI_BUS_DATA_WIDTH_8:     ok = capab.data_width_8;     break;
+    case ARM_MCI_BUS_DATA_WIDTH_4_DDR: ok = capab.data_width_4_ddr; break;
+    case ARM_MCI_BUS_DATA_WIDTH_8_DDR: ok = capab.data_width_8_ddr; break;
+    default:                           ok = 1U;                     break;
+  }
+  switch (cfg->mode) {
+    case ARM_MCI_BUS_HIGH_SPEED:  ok &= capab.high_speed;                   break;
+    case ARM_MCI_BUS_UHS_SDR12:
+    case ARM_MCI_BUS_UHS_SDR25:   ok &= capab.uhs_signaling & card_1v8;     break;
+    case ARM_MCI_BUS_UHS_SDR50:   ok &= capab.uhs_sdr50     & card_1v8;     break;
+    case ARM_MCI_BUS_UHS_SDR104:  ok &= capab.uhs_sdr104    & card_1v8;     break;
+    case ARM_MCI_BUS_UHS_DDR50:   ok &= capab.uhs_ddr50     & card_1v8;     break;
+    default:                                                                break;
+  }
+
+  return ok;
+}
+
+#if (MCI_CARD_TYPE == 0)
+/*
+  \fn            static int32_t MCI_Tuning (void)
+  \brief         Execute sampling clock tuning (CMD19: SEND_TUNING_BLOCK) for SDR50 and SDR104.
+  \return        execution status
+                   - EXIT_SUCCESS: Tuning completed
+                   - EXIT_FAILURE: Tuning failed
+*/
+static int32_t MCI_Tuning (void) {
+  uint32_t i, r1;
+  int32_t  val;
+
+  if (drv->Control(ARM_MCI_UHS_TUNING_OPERATION, 1U) != ARM_DRIVER_OK) {
+    return EXIT_FAILURE;
+  }
+  for (i = 0U; i < 40U; i++) {
+    if (drv->SetupTransfer(buf_in, 1U, 64U, ARM_MCI_TRANSFER_READ) != ARM_DRIVER_OK) {
+      break;
+    }
+    if (MCI_Cmd(19U, 0U, MCI_R1 | ARM_MCI_TRANSFER_DATA, &r1) != EXIT_SUCCESS) {
+      break;
+    }
+    (void)MCI_WaitEvent(MCI_EVENT_XFER_MASK, MCI_CMD_TIMEOUT);
+    val = drv->Control(ARM_MCI_UHS_TUNING_RESULT, 0U);
+    if (val == 0) {
+      return EXIT_SUCCESS;
+    }
+    if (val < 0) {
+      break;
+    }
+  }
+
+  return EXIT_FAILURE;
+}
+#endif
+
+/*
+  \fn            static int32_t MCI_SetBus (const MCI_BUS_CFG *cfg)
+  \brief         Switch card and driver to the bus speed mode and data width.
+  \return        ARM_DRIVER_OK, ARM_DRIVER_ERROR_UNSUPPORTED (rejected by the driver or the card) or ARM_DRIVER_ERROR
+*/
+static int32_t MCI_SetBus (const MCI_BUS_CFG *cfg) {
+  uint32_t r1, val;
+  int32_t  ret;
+#if (MCI_CARD_TYPE == 0)
+  static const uint8_t sd_func[] = { 0U, 1U, 0U, 1U, 2U, 3U, 4U };
+
+  /* ACMD6: SET_BUS_WIDTH */
+  val = (cfg->width == ARM_MCI_BUS_DATA_WIDTH_1) ? 0U : 2U;
+  if (MCI_ACmd(6U, val, MCI_R1, &r1) != EXIT_SUCCESS) {
+    return ARM_DRIVER_ERROR;
+  }
+  /* Double data rate is enabled after the card switched to DDR50 */
+  ret = drv->Control(ARM_MCI_BUS_DATA_WIDTH, (val == 0U) ? ARM_MCI_BUS_DATA_WIDTH_1 : ARM_MCI_BUS_DATA_WIDTH_4);
+  if (ret != ARM_DRIVER_OK) {
+    return ret;
+  }
+
+  /* CMD6: SWITCH_FUNC (set access mode in function group 1), returns 512-bit status */
+  val = sd_func[cfg->mode];
+  if (drv->SetupTransfer(buf_in, 1U, 64U, ARM_MCI_TRANSFER_READ) != ARM_DRIVER_OK) {
+    return ARM_DRIVER_ERROR;
+  }
+  if ((MCI_Cmd(6U, 0x80FFFFF0U | val, MCI_R1 | ARM_MCI_TRANSFER_DATA, &r1) != EXIT_SUCCESS) ||
+      ((MCI_WaitEvent(MCI_EVENT_XFER_MASK, MCI_CMD_TIMEOUT) & MCI_EVENT_XFER_MASK) != ARM_MCI_EVENT_TRANSFER_COMPLETE)) {
+    (void)drv->AbortTransfer();
+    return ARM_DRIVER_ERROR;
+  }
+  if ((buf_in[16] & 0x0FU) != val) {
+    /* Card does not support the access mode */
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+#else
+  static const uint8_t mmc_width[] = { 0U, 1U, 2U, 5U, 6U };
+
+  /* CMD6: SWITCH (write EXT_CSD HS_TIMING) */
+  val = (cfg->mode == ARM_MCI_BUS_DEFAULT_SPEED) ? 0U : 1U;
+  if ((MCI_Cmd(6U, (3UL << 24) | (185UL << 16) | (val << 8), MCI_R1b, &r1) != EXIT_SUCCESS) ||
+      (MCI_WaitReady(MCI_CMD_TIMEOUT) != EXIT_SUCCESS)) {
+    return ARM_DRIVER_ERROR;
+  }
+#endif
+
+  ret = drv->Control(ARM_MCI_BUS_SPEED_MODE, cfg->mode);
+  if (ret != ARM_DRIVER_OK) {
+    return ret;
+  }
+  if (drv->Control(ARM_MCI_BUS_SPEED, cfg->clock) <= 0) {
+    return ARM_DRIVER_ERROR;
+  }
+
+#if (MCI_CARD_TYPE == 0)
+  if (cfg->width == ARM_MCI_BUS_DATA_WIDTH_4_DDR) {
+    ret = drv->Control(ARM_MCI_BUS_DATA_WIDTH, cfg->width);
+    if (ret != ARM_DRIVER_OK) {
+      return ret;
+    }
+  }
+  if (((cfg->mode == ARM_MCI_BUS_UHS_SDR50) || (cfg->mode == ARM_MCI_BUS_UHS_SDR104)) && (capab.uhs_tuning != 0U)) {
+    if (MCI_Tuning() != EXIT_SUCCESS) {
+      return ARM_DRIVER_ERROR;
+    }
+  }
+#else
+  /* CMD6: SWITCH (write EXT_CSD BUS_WIDTH) */
+  val = mmc_width[cfg->width];
+  if ((MCI_Cmd(6U, (3UL << 24) | (183UL << 16) | (val << 8), MCI_R1b, &r1) != EXIT_SUCCESS) ||
+      (MCI_WaitReady(MCI_CMD_TIMEOUT) != EXIT_SUCCESS)) {
+    return ARM_DRIVER_ERROR;
+  }
+  ret = drv->Control(ARM_MCI_BUS_DATA_WIDTH, cfg->width);
+  if (ret != ARM_DRIVER_OK) {
+    return ret;
+  }
+#endif
+
+  return ARM_DRIVER_OK;
+}
+
+/*
+  \fn            static int32_t MCI_Measure (uint32_t mode, uint32_t count, uint32_t *kbps, uint32_t *iops)
+  \brief         Transfer MCI_XFER_NUM consecutive chunks of count blocks in the test area and measure the rate.
+  \param[in]     mode           ARM_MCI_TRANSFER_READ or ARM_MCI_TRANSFER_WRITE
+  \param[in]     count          Number of blocks per transfer (1 = single block commands)
+  \param[out]    kbps           Throughput (in kB/s)
+  \param[out]    iops           Transfers (commands) per second
+  \return        execution status
+                   - EXIT_SUCCESS: All transfers succeeded
+                   - EXIT_FAILURE: Transfer failed
+*/
+static int32_t MCI_Measure (uint32_t mode, uint32_t count, uint32_t *kbps, uint32_t *iops) {
+  uint32_t i, tick, ticks;
+  uint64_t freq;
+  uint8_t *data;
+
+  data = (mode == ARM_MCI_TRANSFER_WRITE) ? buf_out : buf_in;
+  freq = SYSTICK_MICROSEC(1000000U);
+
+  tick = GET_SYSTICK();
+  for (i = 0U; i < MCI_XFER_NUM; i++) {
+    if (MCI_Transfer(data, mode, MCI_TEST_BLOCK + (i * count), count) != EXIT_SUCCESS) {
+      return EXIT_FAILURE;
+    }
+  }
+  ticks = GET_SYSTICK() - tick;
+  if (ticks == 0U) { ticks = 1U; }
+
+  *kbps = (uint32_t)(((uint64_t)MCI_XFER_NUM * count * MCI_BLOCK_SIZE * freq) / ((uint64_t)ticks * 1000U));
+  *iops = (uint32_t)(((uint64_t)MCI_XFER_NUM * freq) / ticks);
+
+  return EXIT_SUCCESS;
+}
+
+/*
+  \fn            static void MCI_Throughput (uint32_t mode)
+  \brief         Measure single and multiple block throughput for all bus configurations.
+  \param[in]     mode           ARM_MCI_TRANSFER_READ or ARM_MCI_TRANSFER_WRITE
+*/
+static void MCI_Throughput (uint32_t mode) {
+  const char *dir;
+  uint32_t    i, cnt, kbps_s, iops_s, kbps_m, iops_m;
+  int32_t     ret;
+
+  dir     = (mode == ARM_MCI_TRANSFER_WRITE) ? "write" : "read";
+  buf_out = (uint8_t *)malloc(MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE);
+  buf_in  = (uint8_t *)malloc(MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE);
+
+  if ((buf_out == NULL) || (buf_in == NULL)) {
+    TEST_FAIL_MESSAGE("[FAILED] Buffer allocation failed");
+  } else if (MCI_CardInit() != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    for (i = 0U; i < (MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE); i++) {
+      buf_out[i] = (uint8_t)i;
+    }
+    cnt = 0U;
+    for (i = 0U; i < ARRAY_SIZE(bus_cfg); i++) {
+      if (MCI_BusSupported(&bus_cfg[i]) == 0U) {
+        (void)snprintf(str, sizeof(str), "[INFO] %s: not supported", bus_cfg[i].name);
+        TEST_MESSAGE(str);
+        continue;
+      }
+      ret = MCI_SetBus(&bus_cfg[i]);
+      if (ret == ARM_DRIVER_OK) {
+        if ((MCI_Measure(mode, 1U,                  &kbps_s, &iops_s) == EXIT_SUCCESS) &&
+            (MCI_Measure(mode, MCI_MULTI_BLOCK_NUM, &kbps_m, &iops_m) == EXIT_SUCCESS)) {
+          (void)snprintf(str, sizeof(str), "[INFO] %s: single block %d IOPS, %d blocks %d IOPS",
+                         bus_cfg[i].name, iops_s, MCI_MULTI_BLOCK_NUM, iops_m);
+          TEST_MESSAGE(str);
+          (void)snprintf(str, sizeof(str), "%s_single", bus_cfg[i].metric);
+          TEST_METRIC_HIGHER(str, kbps_s, "kB/s", METRIC_NO_THRESHOLD);
+          (void)snprintf(str, sizeof(str), "%s_multi", bus_cfg[i].metric);
+          TEST_METRIC_HIGHER(str, kbps_m, "kB/s", METRIC_NO_THRESHOLD);
+          cnt++;
+          continue;
+        }
+        (void)snprintf(str, sizeof(str), "[FAILED] %s: block %s failed", bus_cfg[i].name, dir);
+        TEST_FAIL_MESSAGE(str);
+      } else if (ret == ARM_DRIVER_ERROR_UNSUPPORTED) {
+        (void)snprintf(str, sizeof(str), "[WARNING] %s: rejected by driver or card", bus_cfg[i].name);
+        TEST_MESSAGE(str);
+      } else {
+        (void)snprintf(str, sizeof(str), "[WARNING] %s: bus switch failed", bus_cfg[i].name);
+        TEST_MESSAGE(str);
+      }
+      /* Start next configuration from a freshly initialized card */
+      MCI_CardUninit();
+      if (MCI_CardInit() != EXIT_SUCCESS) {
+        TEST_FAIL_MESSAGE(str);
+        break;
+      }
+    }
+    if (cnt == 0U) {
+      TEST_FAIL_MESSAGE("[FAILED] No bus configuration could be measured");
+    } else {
+      TEST_PASS();
+    }
+  }
+
+  MCI_CardUninit();
+  free(buf_out);
+  free(buf_in);
+  buf_out = NULL;
+  buf_in  = NULL;
+}
+
+/*
+  \fn            static uint32_t MCI_TicksToNs (uint32_t ticks, uint64_t ticks_per_s)
+  \brief         Convert ticks to nanoseconds.
+*/
+static uint32_t MCI_TicksToNs (uint32_t ticks, uint64_t ticks_per_s) {
+  return (uint32_t)(((uint64_t)ticks * 1000000000U) / ticks_per_s);
+}
+
+/*
+  \fn            static void MCI_ReportBusy (const char *name, uint32_t idx, uint64_t ticks_per_s)
+  \brief         Report card busy time distribution of a sample class as histogram (in us).
+  \param[in]     name           Sample class description
+  \param[in]     idx            Sample class (MCI_PROF_BUSY_x)
+  \param[in]     ticks_per_s    Timer frequency
+*/
+static void MCI_ReportBusy (const char *name, uint32_t idx, uint64_t ticks_per_s) {
+  // Histogram bucket upper limits in us (last bucket is open)
+  static const uint32_t hist_lim[] = { 250U, 500U, 1000U, 2500U, 5000U, 10000U, 25000U, 100000U };
+  uint32_t hist[ARRAY_SIZE(hist_lim) + 1U];
+  uint32_t i;
+
+  memset(hist, 0, sizeof(hist));
+  for (i = 0U; i < prof_cnt[idx]; i++) {
+    hist[HISTOGRAM_BUCKET(hist_lim, MCI_TicksToNs(prof_buf[(idx * prof_cap) + i], ticks_per_s) / 1000U)]++;
+  }
+  TEST_HISTOGRAM(name, hist, hist_lim);
+}
+
+/*
+  \fn            static void MCI_MetricP99 (const char *name, uint32_t idx, uint64_t ticks_per_s)
+  \brief         Record 99th percentile of a sample class (sorted by TEST_PERCENTILES) as metric (in us).
+  \param[in]     name           Metric name
+  \param[in]     idx            Sample class (MCI_PROF_x)
+  \param[in]     ticks_per_s    Timer frequency
+*/
+static void MCI_MetricP99 (const char *name, uint32_t idx, uint64_t ticks_per_s) {
+  uint32_t cnt = prof_cnt[idx];
+  uint32_t ns;
+
+  if (cnt != 0U) {
+    ns = MCI_TicksToNs(prof_buf[(idx * prof_cap) + (((cnt - 1U) * 99U) / 100U)], ticks_per_s);
+    TEST_METRIC_LOWER(name, (double)ns / 1000.0, "us", METRIC_NO_THRESHOLD);
+  }
+}
+
 /*-----------------------------------------------------------------------------
  *      Tests
  *----------------------------------------------------------------------------*/
@@ -54,7 +799,8 @@ static void MCI_DrvEvent (uint32_t event) {
 \defgroup dv_mci MCI Validation
 \brief MCI driver validation
 \details
-The MCI validation test checks the API interface compliance only.
+The MCI validation test checks the API interface compliance and, with a card inserted, card identification,
+data integrity, block read/write throughput for each bus speed mode and data width, and command and card busy latency.
 
 \defgroup mci_tests Tests
 \ingroup dv_mci
@@ -350,6 +1096,287 @@ void MCI_Config_DriverStrength (void) {
   TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
 }
 
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: MCI_Card_Initialize
+\details
+The test function \b MCI_Card_Initialize verifies the \b SendCommand function by identifying the inserted card with the sequence:
+ - Card power on (if supported) and check card detect (if supported)
+ - Card identification (SD: CMD0, CMD8, ACMD41, CMD2, CMD3; MMC: CMD0, CMD1, CMD2, CMD3)
+ - Select card (CMD7) and set block length (CMD16, byte addressed cards only)
+ - Report card addressing, relative card address and signaling voltage
+ - Card power off (if supported)
+
+The driver is initialized and powered on by the test group fixture (\b MCI_DV_Setup).
+*/
+void MCI_Card_Initialize (void) {
+
+  if (MCI_CardInit() != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    (void)snprintf(str, sizeof(str), "[INFO] %s card, %s addressing, RCA 0x%04X, %s signaling",
+                   (MCI_CARD_TYPE == 0) ? "SD" : "MMC",
+                   (card_hc != 0U) ? "block" : "byte",
+                   card_rca,
+                   (card_1v8 != 0U) ? "1.8V" : "3.3V");
+    TEST_MESSAGE(str);
+    TEST_PASS();
+  }
+
+  MCI_CardUninit();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: MCI_ReadWrite_Verify
+\details
+The test function \b MCI_ReadWrite_Verify verifies the \b SetupTransfer function and data integrity with the sequence:
+ - Card initialize (see \ref MCI_Card_Initialize)
+ - Switch to 4-bit data width (if supported)
+ - Write single block (CMD24) and read it back (CMD17), compare data
+ - Write multiple blocks (CMD25, CMD12) and read them back (CMD18, CMD12), compare data
+ - Card power off (if supported)
+
+The driver is initialized and powered on by the test group fixture (\b MCI_DV_Setup).
+
+\note The test overwrites the card contents in the configured test area.
+*/
+void MCI_ReadWrite_Verify (void) {
+  uint32_t i, size;
+
+  size    = MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE;
+  buf_out = (uint8_t *)malloc(size);
+  buf_in  = (uint8_t *)malloc(size);
+
+  if ((buf_out == NULL) || (buf_in == NULL)) {
+    TEST_FAIL_MESSAGE("[FAILED] Buffer allocation failed");
+  } else if (MCI_CardInit() != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    if (MCI_BusSupported(&bus_cfg[1]) != 0U) {
+      TEST_ASSERT(MCI_SetBus(&bus_cfg[1]) == ARM_DRIVER_OK);
+    }
+    for (i = 0U; i < size; i++) {
+      buf_out[i] = (uint8_t)((i * 7U) + (i >> 9));
+    }
+
+    /* Single block */
+    memset(buf_in, 0, size);
+    TEST_ASSERT(MCI_Transfer(buf_out, ARM_MCI_TRANSFER_WRITE, MCI_TEST_BLOCK, 1U) == EXIT_SUCCESS);
+    TEST_ASSERT(MCI_Transfer(buf_in,  ARM_MCI_TRANSFER_READ,  MCI_TEST_BLOCK, 1U) == EXIT_SUCCESS);
+    if (memcmp(buf_in, buf_out, MCI_BLOCK_SIZE) != 0) {
+      TEST_FAIL_MESSAGE("[FAILED] Single block data mismatch");
+    }
+
+    /* Multiple blocks */
+    memset(buf_in, 0, size);
+    TEST_ASSERT(MCI_Transfer(buf_out, ARM_MCI_TRANSFER_WRITE, MCI_TEST_BLOCK + 1U, MCI_MULTI_BLOCK_NUM) == EXIT_SUCCESS);
+    TEST_ASSERT(MCI_Transfer(buf_in,  ARM_MCI_TRANSFER_READ,  MCI_TEST_BLOCK + 1U, MCI_MULTI_BLOCK_NUM) == EXIT_SUCCESS);
+    if (memcmp(buf_in, buf_out, size) != 0) {
+      TEST_FAIL_MESSAGE("[FAILED] Multiple block data mismatch");
+    }
+  }
+
+  MCI_CardUninit();
+  free(buf_out);
+  free(buf_in);
+  buf_out = NULL;
+  buf_in  = NULL;
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: MCI_Throughput_Read
+\details
+The test function \b MCI_Throughput_Read measures block read throughput with the sequence:
+ - Card initialize (see \ref MCI_Card_Initialize)
+ - For each bus speed mode and data width supported by the driver and the card
+   (SD: Default, High speed, SDR12, SDR25, SDR50, SDR104 and DDR50; MMC: Default and High speed with 1/4/8-bit and DDR):
+   - Switch card and driver to the bus configuration (ACMD6/CMD6 and \b Control)
+   - Read the test area with single block commands (CMD17)
+   - Read the test area with multiple block commands (CMD18, CMD12)
+   - Report commands per second (IOPS) for both
+   - Record metrics \c <mode>_single and \c <mode>_multi (kB/s), for example \c high_speed_4bit_multi
+ - Card power off (if supported)
+
+The driver is initialized and powered on by the test group fixture (\b MCI_DV_Setup).
+
+Time is measured from the first command until the last transfer completes, so command and interrupt overhead
+lower the achieved throughput, as it does for a file system.
+*/
+void MCI_Throughput_Read (void) {
+  MCI_Throughput(ARM_MCI_TRANSFER_READ);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: MCI_Throughput_Write
+\details
+The test function \b MCI_Throughput_Write measures sustained block write throughput with the sequence:
+ - Card initialize (see \ref MCI_Card_Initialize)
+ - For each bus speed mode and data width supported by the driver and the card:
+   - Switch card and driver to the bus configuration
+   - Write the test area with single block commands (CMD24)
+   - Write the test area with multiple block commands (CMD25, CMD12)
+   - Report commands per second (IOPS) for both
+   - Record metrics \c <mode>_single and \c <mode>_multi (kB/s), for example \c high_speed_4bit_multi
+ - Card power off (if supported)
+
+The driver is initialized and powered on by the test group fixture (\b MCI_DV_Setup).
+
+Each write waits until the card finished programming (CMD13 reports ready for data), so the result is
+the sustained write rate including card busy time.
+
+\note The test overwrites the card contents in the configured test area.
+*/
+void MCI_Throughput_Write (void) {
+  MCI_Throughput(ARM_MCI_TRANSFER_WRITE);
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: MCI_Latency_Profile
+\details
+The test function \b MCI_Latency_Profile profiles command latency and card busy time with the sequence:
+ - Card initialize (see \ref MCI_Card_Initialize)
+ - Switch to the fastest bus configuration supported by the driver and the card
+ - Repeat the configured number of iterations:
+   - Write and read one block (CMD24, CMD17)
+   - Write and read multiple blocks (CMD25, CMD18, CMD12)
+ - Report latency percentiles (min/p50/p90/p99/max) and histograms of the card busy time
+ - Record metrics \c read_1_block_p99, \c read_n_blocks_p99, \c write_1_block_p99 and \c write_n_blocks_p99
+   (99th percentile of the data phase in us)
+ - Card power off (if supported)
+
+The driver is initialized and powered on by the test group fixture (\b MCI_DV_Setup).
+
+Each transfer is timestamped when \b SendCommand is called, when \b ARM_MCI_EVENT_COMMAND_COMPLETE and
+\b ARM_MCI_EVENT_TRANSFER_COMPLETE are signaled and when the card status (CMD13) reports the end of programming:
+ - <b>Command turnaround</b> (\b SendCommand to \b ARM_MCI_EVENT_COMMAND_COMPLETE) per command index.
+   Compared to the reported command bus time it shows the driver and interrupt overhead.
+   For CMD12 (R1b response) it includes the busy time signaled on DAT0.
+ - <b>Data phase</b> (\b ARM_MCI_EVENT_COMMAND_COMPLETE to \b ARM_MCI_EVENT_TRANSFER_COMPLETE) for single and
+   multiple block reads and writes. Compared to the reported block data time it shows the card read access time
+   and the data path (DMA, FIFO) overhead.
+   Samples with \b ARM_MCI_EVENT_TRANSFER_COMPLETE signaled before \b ARM_MCI_EVENT_COMMAND_COMPLETE are excluded and
+   their number is reported as warning.
+ - <b>Card busy</b> (\b ARM_MCI_EVENT_TRANSFER_COMPLETE until the card is ready for data) after single and multiple
+   block writes. This is card behavior; the resolution is the CMD13 polling period.
+
+\note The test overwrites the card contents in the configured test area.
+*/
+void MCI_Latency_Profile (void) {
+  const MCI_BUS_CFG *cfg;
+  uint32_t i, n, blk, bits, clk_ps;
+  uint64_t ticks_per_s;
+  int32_t  ret;
+
+  buf_out  = (uint8_t *)malloc(MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE);
+  buf_in   = (uint8_t *)malloc(MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE);
+  prof_cap = MCI_LATENCY_NUM * 2U;
+  prof_buf = (uint32_t *)malloc(MCI_PROF_NUM * prof_cap * sizeof(uint32_t));
+  ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+  if ((buf_out == NULL) || (buf_in == NULL) || (prof_buf == NULL)) {
+    TEST_FAIL_MESSAGE("[FAILED] Buffer allocation failed");
+  } else if (MCI_CardInit() != EXIT_SUCCESS) {
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    for (i = 0U; i < (MCI_MULTI_BLOCK_NUM * MCI_BLOCK_SIZE); i++) {
+      buf_out[i] = (uint8_t)(i ^ 0x5AU);
+    }
+
+    /* Select fastest supported bus configuration */
+    cfg = NULL;
+    for (i = ARRAY_SIZE(bus_cfg); i > 0U; i--) {
+      if (MCI_BusSupported(&bus_cfg[i - 1U]) == 0U) {
+        continue;
+      }
+      ret = MCI_SetBus(&bus_cfg[i - 1U]);
+      if (ret == ARM_DRIVER_OK) {
+        cfg = &bus_cfg[i - 1U];
+        break;
+      }
+      (void)snprintf(str, sizeof(str), "[WARNING] %s: bus switch failed", bus_cfg[i - 1U].name);
+      TEST_MESSAGE(str);
+      MCI_CardUninit();
+      if (MCI_CardInit() != EXIT_SUCCESS) {
+        break;
+      }
+    }
+
+    if (cfg == NULL) {
+      TEST_FAIL_MESSAGE("[FAILED] No bus configuration could be set");
+    } else {
+      memset(prof_cnt, 0, sizeof(prof_cnt));
+      prof_order_err = 0U;
+      prof_active    = 1U;
+      for (blk = 0U; blk < MCI_LATENCY_NUM; blk++) {
+        n = MCI_TEST_BLOCK + ((blk % MCI_XFER_NUM) * MCI_MULTI_BLOCK_NUM);
+        if ((MCI_Transfer(buf_out, ARM_MCI_TRANSFER_WRITE, n, 1U)                  != EXIT_SUCCESS) ||
+            (MCI_Transfer(buf_in,  ARM_MCI_TRANSFER_READ,  n, 1U)                  != EXIT_SUCCESS) ||
+            (MCI_Transfer(buf_out, ARM_MCI_TRANSFER_WRITE, n, MCI_MULTI_BLOCK_NUM) != EXIT_SUCCESS) ||
+            (MCI_Transfer(buf_in,  ARM_MCI_TRANSFER_READ,  n, MCI_MULTI_BLOCK_NUM) != EXIT_SUCCESS)) {
+          break;
+        }
+      }
+      prof_active = 0U;
+
+      if (blk < MCI_LATENCY_NUM) {
+        (void)snprintf(str, sizeof(str), "[FAILED] %s: transfer failed in iteration %d", cfg->name, blk);
+        TEST_FAIL_MESSAGE(str);
+      } else {
+        /* Bus time of a command with response (48 + Ncr + 48 clocks) and of one data block with CRC */
+        switch (cfg->width) {
+          case ARM_MCI_BUS_DATA_WIDTH_4:     bits =  4U; break;
+          case ARM_MCI_BUS_DATA_WIDTH_8:     bits =  8U; break;
+          case ARM_MCI_BUS_DATA_WIDTH_4_DDR: bits =  8U; break;
+          case ARM_MCI_BUS_DATA_WIDTH_8_DDR: bits = 16U; break;
+          default:                           bits =  1U; break;
+        }
+        clk_ps = 1000000000U / (cfg->clock / 1000U);
+        i = ( 98U                                       * clk_ps) / 1000U;
+        n = ((((MCI_BLOCK_SIZE * 8U) / bits) + 18U)     * clk_ps) / 1000U;
+        (void)snprintf(str, sizeof(str), "[INFO] %s: %d iterations, bus time command %d.%d us, data block %d.%d us",
+                       cfg->name, blk, i / 1000U, (i / 100U) % 10U, n / 1000U, (n / 100U) % 10U);
+        TEST_MESSAGE(str);
+        if (prof_order_err != 0U) {
+          (void)snprintf(str, sizeof(str), "[WARNING] %d samples excluded, events signaled out of order", prof_order_err);
+          TEST_MESSAGE(str);
+        }
+
+        TEST_PERCENTILES("CMD17 turnaround",       &prof_buf[MCI_PROF_CMD17 * prof_cap],   prof_cnt[MCI_PROF_CMD17],   ticks_per_s);
+        TEST_PERCENTILES("CMD18 turnaround",       &prof_buf[MCI_PROF_CMD18 * prof_cap],   prof_cnt[MCI_PROF_CMD18],   ticks_per_s);
+        TEST_PERCENTILES("CMD24 turnaround",       &prof_buf[MCI_PROF_CMD24 * prof_cap],   prof_cnt[MCI_PROF_CMD24],   ticks_per_s);
+        TEST_PERCENTILES("CMD25 turnaround",       &prof_buf[MCI_PROF_CMD25 * prof_cap],   prof_cnt[MCI_PROF_CMD25],   ticks_per_s);
+        TEST_PERCENTILES("CMD12 turnaround (R1b)", &prof_buf[MCI_PROF_CMD12 * prof_cap],   prof_cnt[MCI_PROF_CMD12],   ticks_per_s);
+        TEST_PERCENTILES("CMD13 turnaround",       &prof_buf[MCI_PROF_CMD13 * prof_cap],   prof_cnt[MCI_PROF_CMD13],   ticks_per_s);
+        TEST_PERCENTILES("Read data, 1 block",     &prof_buf[MCI_PROF_READ_1 * prof_cap],  prof_cnt[MCI_PROF_READ_1],  ticks_per_s);
+        TEST_PERCENTILES("Read data, n blocks",    &prof_buf[MCI_PROF_READ_N * prof_cap],  prof_cnt[MCI_PROF_READ_N],  ticks_per_s);
+        TEST_PERCENTILES("Write data, 1 block",    &prof_buf[MCI_PROF_WRITE_1 * prof_cap], prof_cnt[MCI_PROF_WRITE_1], ticks_per_s);
+        TEST_PERCENTILES("Write data, n blocks",   &prof_buf[MCI_PROF_WRITE_N * prof_cap], prof_cnt[MCI_PROF_WRITE_N], ticks_per_s);
+        TEST_PERCENTILES("Write busy, 1 block",    &prof_buf[MCI_PROF_BUSY_1 * prof_cap],  prof_cnt[MCI_PROF_BUSY_1],  ticks_per_s);
+        TEST_PERCENTILES("Write busy, n blocks",   &prof_buf[MCI_PROF_BUSY_N * prof_cap],  prof_cnt[MCI_PROF_BUSY_N],  ticks_per_s);
+        MCI_ReportBusy  ("Busy histogram, 1 block (us)",  MCI_PROF_BUSY_1, ticks_per_s);
+        MCI_ReportBusy  ("Busy histogram, n blocks (us)", MCI_PROF_BUSY_N, ticks_per_s);
+        MCI_MetricP99   ("read_1_block_p99",   MCI_PROF_READ_1,  ticks_per_s);
+        MCI_MetricP99   ("read_n_blocks_p99",  MCI_PROF_READ_N,  ticks_per_s);
+        MCI_MetricP99   ("write_1_block_p99",  MCI_PROF_WRITE_1, ticks_per_s);
+        MCI_MetricP99   ("write_n_blocks_p99", MCI_PROF_WRITE_N, ticks_per_s);
+        TEST_PASS();
+      }
+    }
+  }
+
+  MCI_CardUninit();
+  free(prof_buf);
+  free(buf_out);
+  free(buf_in);
+  prof_buf = NULL;
+  buf_out  = NULL;
+  buf_in   = NULL;
+}
+
 /**
 @}
 */ 
@@ -24,13 +24,33 @@
  */
 
 
+#include "cmsis_dv.h"
+#include "DV_Config.h"
 #include "DV_Report.h"
 
+#include <math.h>
+#include <stdlib.h>
+
+#ifndef PRINT_XML_REPORT
+#define PRINT_XML_REPORT        0
+#endif
 
 /* Local macros */
 #define PRINT(x) MsgPrint x
 #define FLUSH()  MsgFlush()
 
+/* Maximum number of metrics per test case kept for JSON Lines report */
+#define TC_METRIC_MAX           32U
+
+/* Maximum length of metric name kept for JSON Lines report (including terminating null) */
+#define TC_METRIC_NAME_LEN      48U
+
+/* Maximum number of metric thresholds set at runtime */
+#define METRIC_THRESHOLD_MAX    8U
+
+/* Maximum number of failed run numbers reported per repeated test case */
+#define TC_REPEAT_FAIL_MAX      16U
+
 /* Local functions */
 static void tr_Init    (void);
 static void tr_Uninit  (void);
@@ -42,9 +62,17 @@ static void tc_Init    (uint32_t num, const char *fn);
 static void tc_Detail  (const char *module, uint32_t line, const char *message);
 static void tc_Uninit  (void);
 static void as_Result  (TC_RES res);
+static void tc_Budget  (uint32_t used, uint32_t budget);
+static TC_RES tc_Result(void);
+static void tc_Repeat  (void);
+static void rp_Close   (void);
+static void rp_Report  (void);
 
 static void MsgPrint (const char *msg, ...);
 static void MsgFlush (void);
+#if (PRINT_XML_REPORT==2)
+static void JsonString (const char *str);
+#endif
 
 /* Global variables */
 REPORT_ITF ritf = {                     /* Structure for report interface     */
@@ -58,6 +86,9 @@ REPORT_ITF ritf = {                     /* Structure for report interface     */
   tc_Detail,
   tc_Uninit,
   as_Result,
+  tc_Budget,
+  tc_Result,
+  tc_Repeat,
 };
 
 /* Local variables */
@@ -70,6 +101,56 @@ static const char Passed[] = "PASSED";
 static const char Failed[] = "FAILED";
 static const char NotExe[] = "NOT EXECUTED";
 
+/* Metric threshold set at runtime */
+typedef struct {
+  char        name[TC_METRIC_NAME_LEN]; /* Metric name (copy)                 */
+  double      threshold;                /* Threshold (NaN = disabled)         */
+} METRIC_THRESHOLD;
+
+static METRIC_THRESHOLD metric_threshold[METRIC_THRESHOLD_MAX];
+static uint32_t   metric_threshold_cnt; /* Number of runtime thresholds       */
+
+/* Test case repetition statistics */
+static uint32_t   rp_runs;              /* Runs started (0 = not repeated)    */
+static uint32_t   rp_failed;            /* Runs failed                        */
+static uint32_t   rp_fail_no[TC_REPEAT_FAIL_MAX]; /* Numbers of failed runs   */
+static uint32_t   rp_as_failed;         /* Assertions failed before run       */
+static uint32_t   rp_open;              /* Run in progress                    */
+#ifdef GET_SYSTICK
+static uint32_t   rp_start;             /* Run start time (systick)           */
+static uint32_t   rp_min;               /* Minimum run duration (us)          */
+static uint32_t   rp_max;               /* Maximum run duration (us)          */
+static double     rp_sum;               /* Sum of run durations               */
+static double     rp_sum2;              /* Sum of squared run durations       */
+#endif
+#if (PRINT_XML_REPORT!=2)
+static char       rp_msg[256];          /* Repetition statistics detail       */
+#endif
+
+#if (PRINT_XML_REPORT==2)
+/* Test case metric */
+typedef struct {
+  char        name[TC_METRIC_NAME_LEN]; /* Metric name (copy)                 */
+  const char *unit;                     /* Metric unit                        */
+  double      sum;                      /* Sum of recorded values             */
+  double      min;                      /* Minimum recorded value             */
+  double      max;                      /* Maximum recorded value             */
+  uint32_t    cnt;                      /* Number of recorded values          */
+  double      threshold;                /* Threshold (NaN = not checked)      */
+  METRIC_DIR  dir;                      /* Direction (higher/lower is better) */
+  TC_RES      res;                      /* Threshold check result             */
+} TC_METRIC;
+
+static TC_METRIC  tc_metric[TC_METRIC_MAX];     /* Test case metrics          */
+static uint32_t   tc_metric_cnt;        /* Number of metrics recorded         */
+static uint32_t   tc_metric_lost;       /* Number of metrics not recorded     */
+static uint32_t   tc_budget;            /* Test case time budget (ms)         */
+static uint32_t   tc_budget_used;       /* Test case time budget used (ms)    */
+#ifdef GET_SYSTICK
+static uint32_t   tc_start;             /* Test case start time (systick)     */
+#endif
+#endif
+
 
 /*-----------------------------------------------------------------------------
  * No path - helper function
@@ -100,6 +181,8 @@ static void tr_Init (void) {
   PRINT(("<?xml version=\"1.0\"?>\n"));
   PRINT(("<?xml-stylesheet href=\"TR_Style.xsl\" type=\"text/xsl\" ?>\n"));
   PRINT(("<report>\n"));
+#elif (PRINT_XML_REPORT==2)
+  PRINT(("\n"));
 #else
   PRINT(("                                \n\n"));
 #endif  
@@ -132,6 +215,16 @@ static void tg_Init (const char *title, const char *date, const char *time, cons
   PRINT(("<file>%s</file>\n",   fn));
   PRINT(("<group>%i</group>\n", test_group_result.idx));
   PRINT(("<info>\n"));
+#elif (PRINT_XML_REPORT==2)
+  PRINT(("{\"type\":\"group\",\"group\":%d,\"title\":", test_group_result.idx));
+  JsonString(title);
+  PRINT((",\"date\":"));
+  JsonString(date);
+  PRINT((",\"time\":"));
+  JsonString(time);
+  PRINT((",\"file\":"));
+  JsonString(no_path(fn));
+  PRINT(("}\n"));
 #else
   (void) fn;
   PRINT(("%s   %s   %s \n\n", title, date, time));
@@ -143,11 +236,17 @@ static void tg_Init (const char *title, const char *date, const char *time, cons
  *----------------------------------------------------------------------------*/
 static void tg_Info (const char *info) {
 
+#if (PRINT_XML_REPORT==2)
+  PRINT(("{\"type\":\"info\",\"group\":%d,\"text\":", test_group_result.idx));
+  JsonString(info);
+  PRINT(("}\n"));
+#else
   PRINT(("%s", info));
   PRINT(("\n"));
 #if (PRINT_XML_REPORT==0)
   PRINT(("\n"));
 #endif
+#endif
 }
 
 /*-----------------------------------------------------------------------------
@@ -184,6 +283,13 @@ static void tg_Uninit (void) {
   PRINT(("<tres>%s</tres>\n", tres));
   PRINT(("</summary>\n"));
   PRINT(("</test>\n"));
+#elif (PRINT_XML_REPORT==2)
+  PRINT(("{\"type\":\"summary\",\"group\":%d,\"tests\":%d,\"passed\":%d,\"failed\":%d,\"result\":\"%s\"}\n",
+         test_group_result.idx,
+         test_group_result.tests,
+         test_group_result.passed,
+         test_group_result.failed,
+         tres));
 #else
   PRINT(("\nTest Summary: %d Tests, %d Passed, %d Failed.\n", 
          test_group_result.tests, 
@@ -202,12 +308,25 @@ static void tc_Init (uint32_t num, const char *fn) {
   as_passed = 0U;
   as_failed = 0U;
   as_detail = 0U;
+  rp_runs   = 0U;
+  rp_failed = 0U;
+  rp_open   = 0U;
 
 #if (PRINT_XML_REPORT==1)   
   PRINT(("<tc>\n"));
   PRINT(("<no>%d</no>\n",     num));
   PRINT(("<func>%s</func>\n", fn));
   PRINT(("<dbgi>\n"));
+#elif (PRINT_XML_REPORT==2)
+  tc_metric_cnt  = 0U;
+  tc_metric_lost = 0U;
+  tc_budget      = 0U;
+  PRINT(("{\"type\":\"test\",\"group\":%d,\"no\":%d,\"func\":", test_group_result.idx, num));
+  JsonString(fn);
+  PRINT((",\"details\":["));
+#ifdef GET_SYSTICK
+  tc_start = GET_SYSTICK();
+#endif
 #else
   PRINT(("TEST %02d: %-32s ", num, fn));
 #endif 
@@ -221,6 +340,13 @@ static void tc_Detail (const char *module, uint32_t line, const char *message) {
 
   module_no_path = no_path (module);
 
+#if (PRINT_XML_REPORT==2)
+  /* Details are elements of the test case object array */
+  if (as_detail != 0U) {
+    PRINT((","));
+  }
+#endif
+
   as_detail = 1U;
 
 #if (PRINT_XML_REPORT==1) 
@@ -231,6 +357,15 @@ static void tc_Detail (const char *module, uint32_t line, const char *message) {
     PRINT(("<message>%s</message>\n", message));
   }
   PRINT(("</detail>\n"));
+#elif (PRINT_XML_REPORT==2)
+  PRINT(("{\"module\":"));
+  JsonString(module_no_path);
+  PRINT((",\"line\":%d", line));
+  if (message != NULL) {
+    PRINT((",\"message\":"));
+    JsonString(message);
+  }
+  PRINT(("}"));
 #else
   PRINT(("\n  %s (%d)", module_no_path, line));
   if (message != NULL) {
@@ -244,6 +379,15 @@ static void tc_Detail (const char *module, uint32_t line, const char *message) {
  *----------------------------------------------------------------------------*/
 static void tc_Uninit (void) {
   const char *res;
+#if (PRINT_XML_REPORT==2)
+  uint32_t    i;
+  double      val;
+#endif
+
+  rp_Close();
+#if (PRINT_XML_REPORT!=2)
+  rp_Report();
+#endif
 
   test_group_result.tests++;
 
@@ -262,6 +406,45 @@ static void tc_Uninit (void) {
   PRINT(("<res>%s</res>\n", res));
   PRINT(("</tc>\n"));
   (void)as_detail;
+#elif (PRINT_XML_REPORT==2)
+  PRINT(("],\"metrics\":["));
+  for (i = 0U; i < tc_metric_cnt; i++) {
+    PRINT(("%s{\"name\":", (i != 0U) ? "," : ""));
+    JsonString(tc_metric[i].name);
+    val = tc_metric[i].sum / (double)tc_metric[i].cnt;
+    if ((val != val) || ((val - val) != 0.0)) {
+      /* NaN and infinity are not valid JSON numbers */
+      PRINT((",\"value\":null"));
+    } else {
+      PRINT((",\"value\":%.10g", val));
+    }
+    if ((tc_metric[i].cnt > 1U) && (val == val) && ((val - val) == 0.0)) {
+      PRINT((",\"count\":%u,\"min\":%.10g,\"max\":%.10g", tc_metric[i].cnt, tc_metric[i].min, tc_metric[i].max));
+    }
+    PRINT((",\"unit\":"));
+    JsonString(tc_metric[i].unit);
+    if (tc_metric[i].dir != METRIC_INFO) {
+      PRINT((",\"direction\":\"%s\"", (tc_metric[i].dir == METRIC_HIGHER) ? "higher" : "lower"));
+    }
+    if (tc_metric[i].res != NOT_EXECUTED) {
+      PRINT((",\"threshold\":%.10g,\"result\":\"%s\"", tc_metric[i].threshold,
+             (tc_metric[i].res == PASSED) ? Passed : Failed));
+    }
+    PRINT(("}"));
+  }
+  PRINT(("]"));
+  if (tc_metric_lost != 0U) {
+    PRINT((",\"metrics_lost\":%d", tc_metric_lost));
+  }
+  PRINT((",\"result\":\"%s\",\"passed\":%d,\"failed\":%d", res, as_passed, as_failed));
+  if (tc_budget != 0U) {
+    PRINT((",\"budget_ms\":%u,\"budget_used_ms\":%u", tc_budget, tc_budget_used));
+  }
+  rp_Report();
+#ifdef GET_SYSTICK
+  PRINT((",\"duration_us\":%u", (uint32_t)(((uint64_t)(GET_SYSTICK() - tc_start) * 1000000U) / SYSTICK_MICROSEC(1000000U))));
+#endif
+  PRINT(("}\n"));
 #else
   if (as_detail != 0U) {
     PRINT(("\n                                          "));
@@ -284,6 +467,133 @@ static void as_Result (TC_RES res) {
   }
 }
 
+/*-----------------------------------------------------------------------------
+ * Test case time budget registering
+ *----------------------------------------------------------------------------*/
+static void tc_Budget (uint32_t used, uint32_t budget) {
+#if (PRINT_XML_REPORT==2)
+  tc_budget      = budget;
+  tc_budget_used = used;
+#else
+  /* Plain text and XML report show only an expired budget (test timeout) */
+  (void)used;
+  (void)budget;
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+ * Get result of running test
+ *----------------------------------------------------------------------------*/
+static TC_RES tc_Result (void) {
+  TC_RES res;
+
+  if (as_failed > 0U) {
+    res = FAILED;
+  } else if (as_passed > 0U) {
+    res = PASSED;
+  } else {
+    res = NOT_EXECUTED;
+  }
+  return res;
+}
+
+/*-----------------------------------------------------------------------------
+ * Start next run of repeated test
+ *----------------------------------------------------------------------------*/
+static void tc_Repeat (void) {
+
+  rp_Close();
+#ifdef GET_SYSTICK
+  if (rp_runs == 0U) {
+    rp_min  = UINT32_MAX;
+    rp_max  = 0U;
+    rp_sum  = 0.0;
+    rp_sum2 = 0.0;
+  }
+  rp_start = GET_SYSTICK();
+#endif
+  rp_runs++;
+  rp_as_failed = as_failed;
+  rp_open      = 1U;
+}
+
+/*-----------------------------------------------------------------------------
+ * Register result and duration of finished run - helper function
+ *----------------------------------------------------------------------------*/
+static void rp_Close (void) {
+#ifdef GET_SYSTICK
+  uint32_t us;
+
+  if (rp_open != 0U) {
+    us = (uint32_t)(((uint64_t)(GET_SYSTICK() - rp_start) * 1000000U) / SYSTICK_MICROSEC(1000000U));
+    if (us < rp_min) { rp_min = us; }
+    if (us > rp_max) { rp_max = us; }
+    rp_sum  += (double)us;
+    rp_sum2 += (double)us * (double)us;
+  }
+#endif
+  if ((rp_open != 0U) && (as_failed != rp_as_failed)) {
+    if (rp_failed < TC_REPEAT_FAIL_MAX) {
+      rp_fail_no[rp_failed] = rp_runs;
+    }
+    rp_failed++;
+  }
+  rp_open = 0U;
+}
+
+/*-----------------------------------------------------------------------------
+ * Write repetition statistics - helper function
+ *----------------------------------------------------------------------------*/
+static void rp_Report (void) {
+  double   rate;
+  uint32_t i, n;
+#ifdef GET_SYSTICK
+  double   avg, dev;
+#endif
+
+  if (rp_runs == 0U) {                  /* Test case was not repeated         */
+    return;
+  }
+#ifdef GET_SYSTICK
+  avg = rp_sum / (double)rp_runs;
+  dev = (rp_sum2 / (double)rp_runs) - (avg * avg);
+  dev = (dev > 0.0) ? sqrt(dev) : 0.0;
+#endif
+  rate = (100.0 * (double)(rp_runs - rp_failed)) / (double)rp_runs;
+  n    = (rp_failed < TC_REPEAT_FAIL_MAX) ? rp_failed : TC_REPEAT_FAIL_MAX;
+
+#if (PRINT_XML_REPORT==2)
+  PRINT((",\"repeat\":{\"runs\":%d,\"passed\":%d,\"failed\":%d,\"pass_rate\":%.2f,\"failures\":[",
+         rp_runs, rp_runs - rp_failed, rp_failed, rate));
+  for (i = 0U; i < n; i++) {
+    PRINT(("%s%d", (i != 0U) ? "," : "", rp_fail_no[i]));
+  }
+  PRINT(("]"));
+#ifdef GET_SYSTICK
+  PRINT((",\"duration_us\":{\"min\":%u,\"avg\":%.0f,\"max\":%u,\"stdev\":%.0f}", rp_min, avg, rp_max, dev));
+#endif
+  PRINT(("}"));
+#else
+  /* Plain text and XML report show statistics as test detail */
+  (void)snprintf(rp_msg, sizeof(rp_msg), "[REPEAT] %d runs, %d failed (pass rate %.2f%%)",
+                 rp_runs, rp_failed, rate);
+  if (n != 0U) {
+    (void)strcat(rp_msg, ", failed runs:");
+    for (i = 0U; i < n; i++) {
+      (void)snprintf(&rp_msg[strlen(rp_msg)], sizeof(rp_msg) - strlen(rp_msg), " %d", rp_fail_no[i]);
+    }
+    if (rp_failed > n) {
+      (void)strcat(rp_msg, " ...");
+    }
+  }
+#ifdef GET_SYSTICK
+  (void)snprintf(&rp_msg[strlen(rp_msg)], sizeof(rp_msg) - strlen(rp_msg),
+                 ", duration min %u avg %.0f max %u stdev %.0f us", rp_min, avg, rp_max, dev);
+#endif
+  tc_Detail(__FILE__, __LINE__, rp_msg);
+#endif
+}
+
 /*-----------------------------------------------------------------------------
  * Add info line to group info
  *----------------------------------------------------------------------------*/
@@ -317,6 +627,167 @@ void __set_message (const char *module, uint32_t line, const char *message) {
   }
 }
 
+/*-----------------------------------------------------------------------------
+ * Set metric
+ *----------------------------------------------------------------------------*/
+void __set_metric (const char *module, uint32_t line, const char *name, double value, const char *unit, METRIC_DIR dir, double threshold) {
+  char     buf[128];
+  TC_RES   res;
+  uint32_t i;
+
+  /* Threshold set at runtime overrides compile-time threshold */
+  for (i = 0U; i < metric_threshold_cnt; i++) {
+    if (strcmp(metric_threshold[i].name, name) == 0) {
+      threshold = metric_threshold[i].threshold;
+      break;
+    }
+  }
+
+  /* Check threshold */
+  res = NOT_EXECUTED;
+  if ((dir != METRIC_INFO) && (isnan(threshold) == 0)) {
+    if ((dir == METRIC_HIGHER) ? (value < threshold) : (value > threshold)) {
+      res = FAILED;
+      (void)snprintf(buf, sizeof(buf), "[FAILED] Metric %s %.10g %s %s threshold %.10g", name, value, unit,
+                     (dir == METRIC_HIGHER) ? "below" : "above", threshold);
+      tc_Detail(module, line, buf);
+    } else {
+      res = PASSED;
+    }
+    as_Result(res);
+  }
+
+#if (PRINT_XML_REPORT==2)
+  /* Metric recorded again (for example by each run of a repeated test) is aggregated */
+  for (i = 0U; i < tc_metric_cnt; i++) {
+    if (strncmp(tc_metric[i].name, name, TC_METRIC_NAME_LEN - 1U) == 0) {
+      break;
+    }
+  }
+  if (i < tc_metric_cnt) {
+    tc_metric[i].sum += value;
+    if (value < tc_metric[i].min) { tc_metric[i].min = value; }
+    if (value > tc_metric[i].max) { tc_metric[i].max = value; }
+    tc_metric[i].cnt++;
+    if ((res == FAILED) || (tc_metric[i].res == NOT_EXECUTED)) {
+      tc_metric[i].threshold = threshold;
+      tc_metric[i].res       = res;
+    }
+  } else if (tc_metric_cnt < TC_METRIC_MAX) {
+    (void)snprintf(tc_metric[tc_metric_cnt].name, TC_METRIC_NAME_LEN, "%s", name);
+    tc_metric[tc_metric_cnt].unit      = unit;
+    tc_metric[tc_metric_cnt].sum       = value;
+    tc_metric[tc_metric_cnt].min       = value;
+    tc_metric[tc_metric_cnt].max       = value;
+    tc_metric[tc_metric_cnt].cnt       = 1U;
+    tc_metric[tc_metric_cnt].threshold = threshold;
+    tc_metric[tc_metric_cnt].dir       = dir;
+    tc_metric[tc_metric_cnt].res       = res;
+    tc_metric_cnt++;
+  } else {
+    tc_metric_lost++;
+  }
+#else
+  /* Plain text and XML report show metric as test detail */
+  if (res != NOT_EXECUTED) {
+    (void)snprintf(buf, sizeof(buf), "[METRIC] %s %.10g %s (%s %.10g)", name, value, unit,
+                   (dir == METRIC_HIGHER) ? "min" : "max", threshold);
+  } else {
+    (void)snprintf(buf, sizeof(buf), "[METRIC] %s %.10g %s", name, value, unit);
+  }
+  tc_Detail(module, line, buf);
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+ * Set metric threshold at runtime
+ *----------------------------------------------------------------------------*/
+void __set_metric_threshold (const char *name, double threshold) {
+  uint32_t i;
+
+  for (i = 0U; i < metric_threshold_cnt; i++) {
+    if (strcmp(metric_threshold[i].name, name) == 0) {
+      break;
+    }
+  }
+  if (i < METRIC_THRESHOLD_MAX) {
+    (void)snprintf(metric_threshold[i].name, TC_METRIC_NAME_LEN, "%s", name);
+    metric_threshold[i].threshold = threshold;
+    if (i == metric_threshold_cnt) {
+      metric_threshold_cnt++;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+ * Compare function for sorting samples
+ *----------------------------------------------------------------------------*/
+static int sample_Compare (const void *a, const void *b) {
+  uint32_t va = *(const uint32_t *)a;
+  uint32_t vb = *(const uint32_t *)b;
+
+  return (int)(va > vb) - (int)(va < vb);
+}
+
+/*-----------------------------------------------------------------------------
+ * Set percentiles (min/p50/p90/p99/max in us) of samples in timer ticks,
+ * samples are sorted in place
+ *----------------------------------------------------------------------------*/
+void __set_percentiles (const char *module, uint32_t line, const char *name, uint32_t *samples, uint32_t cnt, uint64_t ticks_per_s) {
+  static const uint8_t pct[] = { 0U, 50U, 90U, 99U, 100U };
+  char     buf[160];
+  uint64_t ns;
+  uint32_t n, len;
+
+  if (cnt == 0U) {
+    (void)snprintf(buf, sizeof(buf), "[INFO]   %-28s no samples", name);
+    tc_Detail(module, line, buf);
+    return;
+  }
+  qsort(samples, cnt, sizeof(uint32_t), sample_Compare);
+
+  len = (uint32_t)snprintf(buf, sizeof(buf), "[INFO]   %-28s min/p50/p90/p99/max", name);
+  for (n = 0U; (n < ARRAY_SIZE(pct)) && (len < sizeof(buf)); n++) {
+    ns   = ((uint64_t)samples[((cnt - 1U) * pct[n]) / 100U] * 1000000000U) / ticks_per_s;
+    len += (uint32_t)snprintf(&buf[len], sizeof(buf) - len, "%c%d.%d", (n == 0U) ? ' ' : '/',
+                              (uint32_t)(ns / 1000U), (uint32_t)((ns / 100U) % 10U));
+  }
+  if (len < sizeof(buf)) {
+    (void)snprintf(&buf[len], sizeof(buf) - len, " us (%d samples)", cnt);
+  }
+  tc_Detail(module, line, buf);
+}
+
+/*-----------------------------------------------------------------------------
+ * Histogram bucket of a value (lim: ascending bucket upper limits, last bucket is open)
+ *----------------------------------------------------------------------------*/
+uint32_t __hist_bucket (const uint32_t *lim, uint32_t lim_num, uint32_t value) {
+  uint32_t n = 0U;
+
+  while ((n < lim_num) && (value >= lim[n])) {
+    n++;
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------
+ * Set histogram (hist: lim_num + 1 bucket counts)
+ *----------------------------------------------------------------------------*/
+void __set_histogram (const char *module, uint32_t line, const char *name, const uint32_t *hist, const uint32_t *lim, uint32_t lim_num) {
+  char     buf[160];
+  uint32_t n, len;
+
+  len = (uint32_t)snprintf(buf, sizeof(buf), "[INFO]   %s:", name);
+  for (n = 0U; (n <= lim_num) && (len < sizeof(buf)); n++) {
+    if (n < lim_num) {
+      len += (uint32_t)snprintf(&buf[len], sizeof(buf) - len, " <%d:%d",  lim[n], hist[n]);
+    } else {
+      len += (uint32_t)snprintf(&buf[len], sizeof(buf) - len, " >=%d:%d", lim[n - 1U], hist[n]);
+    }
+  }
+  tc_Detail(module, line, buf);
+}
+
 
 #if defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050)
 #pragma clang diagnostic push
@@ -342,6 +813,42 @@ static void MsgFlush(void) {
   (void)fflush(stdout);
 }
 
+#if (PRINT_XML_REPORT==2)
+/*-----------------------------------------------------------------------------
+ *       JsonString:  Print a quoted and escaped JSON string
+ *----------------------------------------------------------------------------*/
+static void JsonString (const char *str) {
+  uint32_t n;
+  char     ch;
+
+  PRINT(("\""));
+  if (str != NULL) {
+    while (*str != '\0') {
+      /* Print run of characters that need no escaping */
+      n = 0U;
+      while ((str[n] != '\0') && (str[n] != '\"') && (str[n] != '\\') && ((uint8_t)str[n] >= 0x20U)) {
+        n++;
+      }
+      if (n != 0U) {
+        PRINT(("%.*s", (int)n, str));
+        str += n;
+        continue;
+      }
+      ch = *str++;
+      switch (ch) {
+        case '\"':  PRINT(("\\\"")); break;
+        case '\\':  PRINT(("\\\\")); break;
+        case '\n':  PRINT(("\\n"));  break;
+        case '\r':  PRINT(("\\r"));  break;
+        case '\t':  PRINT(("\\t"));  break;
+        default:    PRINT(("\\u%04x", (uint8_t)ch)); break;
+      }
+    }
+  }
+  PRINT(("\""));
+}
+#endif
+
 /*-----------------------------------------------------------------------------
  * End of file
  *----------------------------------------------------------------------------*/
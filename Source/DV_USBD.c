@@ -41,17 +41,1190 @@ static ARM_USBD_CAPABILITIES capab;
 static uint8_t volatile DeviceEvent;  
 static uint8_t volatile EndpointEvent; 
 
+// Endpoint index (0..15: OUT endpoints, 16..31: IN endpoints)
+#define USBD_EP_INDEX(ep)       (((ep) & ARM_USB_ENDPOINT_NUMBER_MASK) | (((ep) & ARM_USB_ENDPOINT_DIRECTION_MASK) >> 3))
+
+static uint32_t volatile ResetCnt;      // Number of bus resets
+
+// Endpoint event
+typedef struct {
+  uint32_t tick;                        // Timestamp
+  uint8_t  ep_addr;                     // Endpoint address
+  uint8_t  event;                       // ARM_USBD_EVENT_SETUP/OUT/IN
+  uint16_t reserved;
+} USBD_EP_EVT;
+
+// Endpoint statistics
+typedef struct {
+  uint32_t events;                      // Signaled events
+  uint32_t transfers;                   // Started transfers
+  uint32_t bytes;                       // Transferred bytes
+  uint32_t stalls;                      // Stall requests
+  uint32_t rejected;                    // Transfers rejected by the driver
+} USBD_EP_STAT;
+
+// Endpoint event queue (written by USB_EndpointEvent, read by the test thread)
+static USBD_EP_EVT volatile EvtQueue[USBD_EVENT_QUEUE_LEN];
+static uint32_t    volatile EvtHead;    // Number of queued events
+static uint32_t    volatile EvtTail;    // Number of processed events
+static uint32_t    volatile EvtOverflow;// Number of events lost (queue full)
+static uint32_t             EvtMaxUsed; // Queue high-water mark
+
+// Endpoint state (updated by USBD_EventProcess)
+static USBD_EP_STAT EpStat[32];         // Endpoint statistics
+static uint8_t      EpFlags[32];        // Endpoint IN/OUT events not yet handled
+static uint32_t     EpTick[32];         // Timestamp of last endpoint IN/OUT event
+static uint8_t      SetupPending;       // SETUP packet received on endpoint 0
+
 // USB Device event
 static void USB_DeviceEvent (uint32_t event) {
+  if ((event & ARM_USBD_EVENT_RESET) != 0U) {
+    ResetCnt++;
+  }
   DeviceEvent |= event;
 }
 
 // USB Endpoint event
 static void USB_EndpointEvent (uint8_t endpoint, uint32_t event) {
-  (void) endpoint;
+  uint32_t head = EvtHead;
+
+  if ((head - EvtTail) < USBD_EVENT_QUEUE_LEN) {
+    EvtQueue[head % USBD_EVENT_QUEUE_LEN].tick    = GET_SYSTICK();
+    EvtQueue[head % USBD_EVENT_QUEUE_LEN].ep_addr = endpoint;
+    EvtQueue[head % USBD_EVENT_QUEUE_LEN].event   = (uint8_t)event;
+    EvtHead = head + 1U;
+  } else {
+    EvtOverflow++;
+  }
   EndpointEvent |= event;
 }
 
+// Clear event queue and endpoint statistics
+static void USBD_EventReset (void) {
+
+  EvtHead     = 0U;
+  EvtTail     = 0U;
+  EvtOverflow = 0U;
+  EvtMaxUsed  = 0U;
+  memset(EpStat,  0, sizeof(EpStat));
+  memset(EpFlags, 0, sizeof(EpFlags));
+  SetupPending = 0U;
+}
+
+// Take queued endpoint events, update endpoint flags and statistics
+static void USBD_EventProcess (void) {
+  uint32_t tail, used, idx;
+  uint8_t  event;
+
+  tail = EvtTail;
+  used = EvtHead - tail;
+  if (used > EvtMaxUsed) {
+    EvtMaxUsed = used;
+  }
+  while (tail != EvtHead) {
+    idx   = USBD_EP_INDEX(EvtQueue[tail % USBD_EVENT_QUEUE_LEN].ep_addr);
+    event = EvtQueue[tail % USBD_EVENT_QUEUE_LEN].event;
+    if ((event & ARM_USBD_EVENT_SETUP) != 0U) {
+      SetupPending = 1U;
+    }
+    if ((event & (ARM_USBD_EVENT_OUT | ARM_USBD_EVENT_IN)) != 0U) {
+      EpFlags[idx] |= event & (ARM_USBD_EVENT_OUT | ARM_USBD_EVENT_IN);
+      EpTick[idx]   = EvtQueue[tail % USBD_EVENT_QUEUE_LEN].tick;
+    }
+    EpStat[idx].events++;
+    tail++;
+  }
+  EvtTail = tail;
+}
+
+// Start endpoint transfer (clears pending endpoint events)
+static int32_t USBD_Transfer (uint8_t ep, uint8_t *data, uint32_t num) {
+  uint32_t idx = USBD_EP_INDEX(ep);
+  int32_t  ret;
+
+  EpFlags[idx] = 0U;
+  ret = drv->EndpointTransfer(ep, data, num);
+  if (ret == ARM_DRIVER_OK) {
+    EpStat[idx].transfers++;
+  } else {
+    EpStat[idx].rejected++;
+  }
+  return ret;
+}
+
+// Get number of bytes transferred by the completed endpoint transfer
+static uint32_t USBD_TransferResult (uint8_t ep) {
+  uint32_t num = drv->EndpointTransferGetResult(ep);
+
+  EpStat[USBD_EP_INDEX(ep)].bytes += num;
+  return num;
+}
+
+// Set or clear endpoint stall
+static void USBD_Stall (uint8_t ep, bool stall) {
+
+  if (stall) {
+    EpStat[USBD_EP_INDEX(ep)].stalls++;
+  }
+  (void)drv->EndpointStall(ep, stall);
+}
+
+/*-----------------------------------------------------------------------------
+ *      Vendor class test device
+ *----------------------------------------------------------------------------*/
+
+#define USBD_EP0_MPS            64U             // Control endpoint maximum packet size
+#define USBD_EP_BULK_OUT        0x01U           // Bulk OUT endpoint address
+#define USBD_EP_BULK_IN         0x81U           // Bulk IN endpoint address
+#define USBD_EP_INT_IN          0x82U           // Interrupt IN endpoint address
+#define USBD_EP_ISO_IN          0x83U           // Isochronous IN endpoint address (alternate setting 1)
+#define USBD_EP_ISO_OUT         0x03U           // Isochronous OUT endpoint address (alternate setting 1)
+#define USBD_INT_MPS            64U             // Interrupt endpoint maximum packet size
+#define USBD_ISO_MPS            512U            // Isochronous endpoint maximum packet size
+
+// Standard requests (bRequest)
+#define USBD_REQ_GET_STATUS         0U
+#define USBD_REQ_CLEAR_FEATURE      1U
+#define USBD_REQ_SET_FEATURE        3U
+#define USBD_REQ_SET_ADDRESS        5U
+#define USBD_REQ_GET_DESCRIPTOR     6U
+#define USBD_REQ_GET_CONFIGURATION  8U
+#define USBD_REQ_SET_CONFIGURATION  9U
+#define USBD_REQ_GET_INTERFACE      10U
+#define USBD_REQ_SET_INTERFACE      11U
+
+// Vendor requests (protocol of the USBD_Host tool)
+#define USBD_VREQ_START         1U              // Start phase (wValue: phase, data: total bytes and bytes per transfer)
+#define USBD_VREQ_RESULT        2U              // Get result of last phase (errors, bytes, time in us)
+#define USBD_VREQ_DONE          3U              // All phases done
+
+// Phases
+#define USBD_PHASE_OUT          1U              // Host sends total bytes in transfers of given size
+#define USBD_PHASE_IN           2U              // Device sends total bytes in transfers of given size
+#define USBD_PHASE_ZLP_OUT      3U              // Host sends transfers (multiple of max packet size) terminated by ZLP
+#define USBD_PHASE_ZLP_IN       4U              // Device sends transfers (multiple of max packet size) terminated by ZLP
+#define USBD_PHASE_MULTI        5U              // Concurrent transfers on multiple endpoints (data: duration in ms and endpoint mask)
+#define USBD_PHASE_ISO          6U              // Isochronous IN and OUT streams (data: duration in ms and bytes per packet)
+
+// Endpoint streams of the multiple endpoint phase (bit in endpoint mask)
+#define USBD_STREAM_BULK_OUT    0U
+#define USBD_STREAM_BULK_IN     1U
+#define USBD_STREAM_INT_IN      2U
+#define USBD_STREAM_ISO_IN      3U
+#define USBD_STREAM_NUM         4U
+
+// Isochronous streams of the isochronous phase
+#define USBD_ISO_STREAM_IN      0U
+#define USBD_ISO_STREAM_OUT     1U
+#define USBD_ISO_STREAM_NUM     2U
+
+// Bulk transfer size of the multiple endpoint phase (multiple of 512 bytes)
+#define USBD_MULTI_BULK_SIZE    (((USBD_XFER_SIZE_MAX / 1024U) != 0U) ? ((USBD_XFER_SIZE_MAX / 1024U) * 512U) : 512U)
+
+// Data buffer size (largest bulk transfer with ZLP or all streams of the multiple endpoint phase)
+#define USBD_XFER_BUF_SIZE      (USBD_XFER_SIZE_MAX + 1536U)
+
+// Control transfer stages
+#define USBD_CTRL_IDLE          0U
+#define USBD_CTRL_DATA_IN       1U
+#define USBD_CTRL_DATA_OUT      2U
+#define USBD_CTRL_STATUS_IN     3U
+#define USBD_CTRL_STATUS_OUT    4U
+
+static const uint8_t dev_desc[18] = {
+  18U, 1U,                              // bLength, bDescriptorType (Device)
+  0x00U, 0x02U,                         // bcdUSB 2.00
+  0U, 0U, 0U,                           // bDeviceClass, bDeviceSubClass, bDeviceProtocol (per interface)
+  USBD_EP0_MPS,                         // bMaxPacketSize0
+  (uint8_t)USBD_VID, (uint8_t)(USBD_VID >> 8),
+  (uint8_t)USBD_PID, (uint8_t)(USBD_PID >> 8),
+  0x00U, 0x01U,                         // bcdDevice 1.00
+  1U, 2U, 0U,                           // iManufacturer, iProduct, iSerialNumber
+  1U                                    // bNumConfigurations
+};
+
+static const char *const dev_str[] = { "ARM", "CMSIS-Driver Validation" };
+
+// Control endpoint state
+static uint8_t  ctrl_setup[8];
+static uint8_t  ctrl_buf[2U * USBD_EP0_MPS];
+static uint8_t  ctrl_stage;
+static uint8_t  ctrl_zlp;               // Send ZLP to terminate IN data stage
+static uint8_t  ctrl_addr;              // Address to set after status stage
+static uint8_t  ctrl_addr_set;
+static uint8_t  ctrl_vreq;              // Vendor request to execute after status stage
+
+// Device state
+static uint8_t  dev_config;
+static uint8_t  dev_alt;                // Alternate setting of interface 0
+static uint8_t  dev_halt;               // Halted endpoints (bit 0: bulk OUT, bit 1: bulk IN, bit 2: interrupt IN)
+static uint8_t  host_done;
+static uint32_t host_tick;              // Time of last host activity (kernel ticks)
+
+// Bulk phase state
+static uint8_t  *xfer_buf;
+static uint32_t *lat_buf;
+static uint32_t  lat_cnt;
+static uint8_t   ph_type;               // Active phase (0 = none)
+static uint8_t   ph_zlp;                // ZLP IN transfer pending
+static uint32_t  ph_total;
+static uint32_t  ph_size;
+static uint32_t  ph_bytes;
+static uint32_t  ph_errors;
+static uint32_t  ph_tick_start;
+static uint32_t  ph_tick_xfer;
+static uint32_t  ph_time_us;            // Duration of last phase
+static uint32_t  ph_num;                // Number of completed phases
+static uint32_t  ph_num_multi;          // Number of completed multiple endpoint phases
+static uint32_t  ph_num_iso;            // Number of completed isochronous phases
+static uint32_t  ph_err_total;          // Errors in all phases
+
+// Endpoint stream of the multiple endpoint phase
+typedef struct {
+  const char *name;
+  const char *metric;                   // Metric name
+  uint8_t     ep;                       // Endpoint address
+  uint8_t     active;                   // Transfer in progress
+  uint16_t    size;                     // Bytes per transfer
+  uint8_t    *buf;
+  uint32_t    tick_xfer;                // Start of current transfer
+  uint32_t    bytes;
+  USBD_EP_STAT start;                   // Endpoint statistics at phase start
+  uint32_t    lat_cnt;
+  uint32_t   *lat;                      // Transfer latency samples
+} USBD_STREAM;
+
+static USBD_STREAM stream[USBD_STREAM_NUM];
+static uint32_t    ph_mask;             // Active streams
+static uint32_t    ph_duration;         // Phase duration (in ms)
+static uint32_t    ph_kernel_start;     // Phase start (kernel ticks)
+static uint32_t    ph_events;           // Queued events at phase start
+static uint32_t    ph_overflow;         // Event queue overflows at phase start
+
+// Upper limits of the isochronous period jitter histogram (deviation from the (micro)frame period in us)
+static const uint32_t iso_hist_lim[] = { 10U, 25U, 50U, 125U, 250U, 500U, 1000U };
+
+// Isochronous stream of the isochronous phase
+typedef struct {
+  const char *name;
+  const char *metric;                   // Metric name prefix
+  uint8_t     ep;                       // Endpoint address
+  uint8_t     active;                   // Transfer in progress
+  uint8_t    *buf;
+  uint32_t    seq;                      // Sequence number of next packet (IN) or expected packet (OUT)
+  uint32_t    packets;
+  uint32_t    bytes;
+  uint32_t    missed;                   // IN: (micro)frames without packet (underruns), OUT: lost packets (overruns)
+  uint32_t    tick_last;                // Timestamp of last packet
+  uint32_t    period_min;               // Shortest and longest period between packets (ticks)
+  uint32_t    period_max;
+  uint32_t    gap_frame;                // SOF number and packet index at the longest period
+  uint32_t    gap_packet;
+  uint32_t    hist[ARRAY_SIZE(iso_hist_lim) + 1U];
+} USBD_ISO_STREAM;
+
+static USBD_ISO_STREAM iso[USBD_ISO_STREAM_NUM];
+static uint32_t    iso_period;          // Nominal period between packets (ticks)
+static uint16_t    iso_frame_last;      // SOF number at last check
+static uint32_t    iso_frames;          // Elapsed (micro)frames
+
+// Message buffer
+static char      str[128];
+
+// Bulk endpoint maximum packet size for the current bus speed
+static uint16_t USBD_BulkMaxPacketSize (void) {
+  return (drv->DeviceGetState().speed == ARM_USB_SPEED_HIGH) ? 512U : 64U;
+}
+
+// Store 16-bit and 32-bit values in little-endian byte order
+static void USBD_PutU16 (uint8_t *buf, uint32_t val) {
+  buf[0] = (uint8_t)val;
+  buf[1] = (uint8_t)(val >> 8);
+}
+static void USBD_PutU32 (uint8_t *buf, uint32_t val) {
+  USBD_PutU16(&buf[0], val);
+  USBD_PutU16(&buf[2], val >> 16);
+}
+static uint32_t USBD_GetU32 (const uint8_t *buf) {
+  return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+// Build endpoint descriptor, returns descriptor length
+static uint32_t USBD_EpDesc (uint8_t *d, uint8_t ep, uint8_t attr, uint16_t mps, uint8_t interval) {
+  d[0] = 7U; d[1] = 5U; d[2] = ep; d[3] = attr;
+  USBD_PutU16(&d[4], mps);
+  d[6] = interval;
+  return 7U;
+}
+
+/*
+  \fn            static uint32_t USBD_GetDescriptor (uint8_t type, uint8_t index)
+  \brief         Build requested descriptor in control buffer.
+  \return        descriptor length (0 = descriptor not available)
+*/
+static uint32_t USBD_GetDescriptor (uint8_t type, uint8_t index) {
+  uint8_t    *d = ctrl_buf;
+  const char *s;
+  uint16_t    mps;
+  uint32_t    i, len, hs;
+
+  switch (type) {
+    case 1U:                            // Device
+      memcpy(d, dev_desc, sizeof(dev_desc));
+      return sizeof(dev_desc);
+
+    case 2U:                            // Configuration
+      mps = USBD_BulkMaxPacketSize();
+      hs  = (drv->DeviceGetState().speed == ARM_USB_SPEED_HIGH) ? 1U : 0U;
+      /* Configuration: 1 interface, bus powered, 100mA */
+      d[0] = 9U; d[1] = 2U; d[4] = 1U; d[5] = 1U; d[6] = 0U; d[7] = 0x80U; d[8] = 50U;
+      len = 9U;
+      for (i = 0U; i < 2U; i++) {
+        /* Interface 0, alternate setting 0: bulk OUT, bulk IN, interrupt IN; alternate setting 1: additional isochronous IN and OUT */
+        d[len] = 9U; d[len + 1U] = 4U; d[len + 2U] = 0U; d[len + 3U] = (uint8_t)i; d[len + 4U] = (uint8_t)(3U + (2U * i));
+        d[len + 5U] = 0xFFU; d[len + 6U] = 0U; d[len + 7U] = 0U; d[len + 8U] = 0U;
+        len += 9U;
+        len += USBD_EpDesc(&d[len], USBD_EP_BULK_OUT, ARM_USB_ENDPOINT_BULK,      mps,           0U);
+        len += USBD_EpDesc(&d[len], USBD_EP_BULK_IN,  ARM_USB_ENDPOINT_BULK,      mps,           0U);
+        len += USBD_EpDesc(&d[len], USBD_EP_INT_IN,   ARM_USB_ENDPOINT_INTERRUPT, USBD_INT_MPS, (hs != 0U) ? 4U : 1U);
+        if (i != 0U) {
+          /* Asynchronous data endpoints, one packet every (micro)frame */
+          len += USBD_EpDesc(&d[len], USBD_EP_ISO_IN,  ARM_USB_ENDPOINT_ISOCHRONOUS | 0x04U, USBD_ISO_MPS, 1U);
+          len += USBD_EpDesc(&d[len], USBD_EP_ISO_OUT, ARM_USB_ENDPOINT_ISOCHRONOUS | 0x04U, USBD_ISO_MPS, 1U);
+        }
+      }
+      USBD_PutU16(&d[2], len);
+      return len;
+
+    case 3U:                            // String
+      if (index == 0U) {
+        d[0] = 4U; d[1] = 3U; USBD_PutU16(&d[2], 0x0409U);
+        return 4U;
+      }
+      if (index > ARRAY_SIZE(dev_str)) {
+        return 0U;
+      }
+      s = dev_str[index - 1U];
+      for (i = 0U; (s[i] != '\0') && (((i + 2U) * 2U) <= sizeof(ctrl_buf)); i++) {
+        USBD_PutU16(&d[(i + 1U) * 2U], (uint8_t)s[i]);
+      }
+      d[0] = (uint8_t)((i + 1U) * 2U); d[1] = 3U;
+      return d[0];
+
+    case 6U:                            // Device qualifier (high-speed only)
+      if (drv->DeviceGetState().speed != ARM_USB_SPEED_HIGH) {
+        return 0U;
+      }
+      d[0] = 10U; d[1] = 6U; USBD_PutU16(&d[2], 0x0200U); d[4] = 0U; d[5] = 0U; d[6] = 0U; d[7] = USBD_EP0_MPS; d[8] = 1U; d[9] = 0U;
+      return 10U;
+
+    default:
+      return 0U;
+  }
+}
+
+// Stall control endpoint (request not supported)
+static void USBD_CtrlStall (void) {
+  USBD_Stall(0x00U, true);
+  USBD_Stall(0x80U, true);
+  ctrl_stage = USBD_CTRL_IDLE;
+}
+
+// Start control IN data stage
+static void USBD_CtrlDataIn (uint32_t len) {
+  uint32_t req_len = ctrl_setup[6] | ((uint32_t)ctrl_setup[7] << 8);
+
+  if (len > req_len) { len = req_len; }
+  ctrl_zlp   = ((len != 0U) && (len < req_len) && ((len % USBD_EP0_MPS) == 0U)) ? 1U : 0U;
+  ctrl_stage = USBD_CTRL_DATA_IN;
+  (void)USBD_Transfer(0x80U, ctrl_buf, len);
+}
+
+// Start control status IN stage (zero length packet)
+static void USBD_CtrlStatusIn (void) {
+  ctrl_stage = USBD_CTRL_STATUS_IN;
+  (void)USBD_Transfer(0x80U, ctrl_buf, 0U);
+}
+
+// Select alternate setting of interface 0 (alternate setting 1 adds the isochronous IN and OUT endpoints)
+static void USBD_SetAlt (uint8_t alt) {
+
+  if (dev_alt != 0U) {
+    (void)drv->EndpointTransferAbort(USBD_EP_ISO_IN);
+    (void)drv->EndpointTransferAbort(USBD_EP_ISO_OUT);
+    (void)drv->EndpointUnconfigure(USBD_EP_ISO_IN);
+    (void)drv->EndpointUnconfigure(USBD_EP_ISO_OUT);
+  }
+  dev_alt = alt;
+  if (alt != 0U) {
+    (void)drv->EndpointConfigure(USBD_EP_ISO_IN,  ARM_USB_ENDPOINT_ISOCHRONOUS, USBD_ISO_MPS);
+    (void)drv->EndpointConfigure(USBD_EP_ISO_OUT, ARM_USB_ENDPOINT_ISOCHRONOUS, USBD_ISO_MPS);
+  }
+}
+
+// Configure (config = 1) or unconfigure (config = 0) data endpoints
+static void USBD_SetConfig (uint8_t config) {
+  uint16_t mps;
+
+  if (dev_config != 0U) {
+    USBD_SetAlt(0U);
+    (void)drv->EndpointTransferAbort(USBD_EP_BULK_OUT);
+    (void)drv->EndpointTransferAbort(USBD_EP_BULK_IN);
+    (void)drv->EndpointTransferAbort(USBD_EP_INT_IN);
+    (void)drv->EndpointUnconfigure(USBD_EP_BULK_OUT);
+    (void)drv->EndpointUnconfigure(USBD_EP_BULK_IN);
+    (void)drv->EndpointUnconfigure(USBD_EP_INT_IN);
+    ph_type = 0U;
+  }
+  dev_config = config;
+  dev_alt    = 0U;
+  dev_halt   = 0U;
+  if (config != 0U) {
+    mps = USBD_BulkMaxPacketSize();
+    (void)drv->EndpointConfigure(USBD_EP_BULK_OUT, ARM_USB_ENDPOINT_BULK,      mps);
+    (void)drv->EndpointConfigure(USBD_EP_BULK_IN,  ARM_USB_ENDPOINT_BULK,      mps);
+    (void)drv->EndpointConfigure(USBD_EP_INT_IN,   ARM_USB_ENDPOINT_INTERRUPT, USBD_INT_MPS);
+  }
+}
+
+// Handle standard request, returns 0 if request is not supported
+static uint32_t USBD_StdRequest (void) {
+  uint8_t  req   = ctrl_setup[1];
+  uint8_t  rcpt  = ctrl_setup[0] & 0x1FU;
+  uint16_t value = ctrl_setup[2] | ((uint16_t)ctrl_setup[3] << 8);
+  uint8_t  ep    = ctrl_setup[4] & 0x8FU;
+  uint32_t len, bit;
+
+  switch (ep) {
+    case USBD_EP_BULK_OUT: bit = 1U; break;
+    case USBD_EP_BULK_IN:  bit = 2U; break;
+    case USBD_EP_INT_IN:   bit = 4U; break;
+    default:               bit = 0U; break;
+  }
+
+  switch (req) {
+    case USBD_REQ_GET_STATUS:
+      ctrl_buf[0] = 0U; ctrl_buf[1] = 0U;
+      if (rcpt == 2U) {
+        if (((ep & ARM_USB_ENDPOINT_NUMBER_MASK) != 0U) && ((bit == 0U) || (dev_config == 0U))) { return 0U; }
+        ctrl_buf[0] = ((dev_halt & bit) != 0U) ? 1U : 0U;
+      }
+      USBD_CtrlDataIn(2U);
+      return 1U;
+
+    case USBD_REQ_CLEAR_FEATURE:
+    case USBD_REQ_SET_FEATURE:
+      if ((rcpt == 2U) && (value == 0U)) {            // ENDPOINT_HALT
+        if ((bit == 0U) || (dev_config == 0U)) { return 0U; }
+        USBD_Stall(ep, (req == USBD_REQ_SET_FEATURE));
+        if (req == USBD_REQ_SET_FEATURE) { dev_halt |= bit; } else { dev_halt &= ~bit; }
+      } else if (!((rcpt == 0U) && (value == 1U))) {  // DEVICE_REMOTE_WAKEUP is accepted and ignored
+        return 0U;
+      }
+      USBD_CtrlStatusIn();
+      return 1U;
+
+    case USBD_REQ_SET_ADDRESS:
+      ctrl_addr     = (uint8_t)(value & 0x7FU);
+      ctrl_addr_set = 1U;
+      USBD_CtrlStatusIn();
+      return 1U;
+
+    case USBD_REQ_GET_DESCRIPTOR:
+      len = USBD_GetDescriptor((uint8_t)(value >> 8), (uint8_t)value);
+      if (len == 0U) { return 0U; }
+      USBD_CtrlDataIn(len);
+      return 1U;
+
+    case USBD_REQ_GET_CONFIGURATION:
+      ctrl_buf[0] = dev_config;
+      USBD_CtrlDataIn(1U);
+      return 1U;
+
+    case USBD_REQ_SET_CONFIGURATION:
+      if (value > 1U) { return 0U; }
+      USBD_SetConfig((uint8_t)value);
+      USBD_CtrlStatusIn();
+      return 1U;
+
+    case USBD_REQ_GET_INTERFACE:
+      if ((dev_config == 0U) || (ctrl_setup[4] != 0U)) { return 0U; }
+      ctrl_buf[0] = dev_alt;
+      USBD_CtrlDataIn(1U);
+      return 1U;
+
+    case USBD_REQ_SET_INTERFACE:
+      if ((dev_config == 0U) || (ctrl_setup[4] != 0U) || (value > 1U) || (ph_type != 0U)) { return 0U; }
+      USBD_SetAlt((uint8_t)value);
+      USBD_CtrlStatusIn();
+      return 1U;
+
+    default:
+      return 0U;
+  }
+}
+
+// Handle vendor request, returns 0 if request is not supported
+static uint32_t USBD_VendorRequest (void) {
+  uint32_t len = ctrl_setup[6] | ((uint32_t)ctrl_setup[7] << 8);
+
+  switch (ctrl_setup[1]) {
+    case USBD_VREQ_START:
+      if ((dev_config == 0U) || (ph_type != 0U) || (len != 8U)) { return 0U; }
+      ctrl_stage = USBD_CTRL_DATA_OUT;
+      (void)USBD_Transfer(0x00U, ctrl_buf, 8U);
+      return 1U;
+
+    case USBD_VREQ_RESULT:
+      if (ph_type != 0U) { return 0U; }
+      USBD_PutU32(&ctrl_buf[0], ph_errors);
+      USBD_PutU32(&ctrl_buf[4], ph_bytes);
+      USBD_PutU32(&ctrl_buf[8], ph_time_us);
+      USBD_CtrlDataIn(12U);
+      return 1U;
+
+    case USBD_VREQ_DONE:
+      ctrl_vreq = USBD_VREQ_DONE;
+      USBD_CtrlStatusIn();
+      return 1U;
+
+    default:
+      return 0U;
+  }
+}
+
+// Check START request parameters received in the data stage, returns 0 if invalid
+static uint32_t USBD_PhaseCheck (void) {
+  uint8_t  type  = ctrl_setup[2];
+  uint32_t total = USBD_GetU32(&ctrl_buf[0]);
+  uint32_t size  = USBD_GetU32(&ctrl_buf[4]);
+
+  if (type == USBD_PHASE_MULTI) {
+    /* Duration (ms) and endpoint mask, isochronous endpoint requires alternate setting 1 */
+    if ((total == 0U) || (total > (USBD_HOST_TIMEOUT * 1000U)) || (size == 0U) || (size >= (1U << USBD_STREAM_NUM)) ||
+        (((size & (1U << USBD_STREAM_ISO_IN)) != 0U) && (dev_alt == 0U))) {
+      return 0U;
+    }
+    ph_duration = total;
+    ph_mask     = size;
+    return 1U;
+  }
+  if (type == USBD_PHASE_ISO) {
+    /* Duration (ms) and bytes per packet (sequence number in the first 4 bytes), requires alternate setting 1 */
+    if ((total == 0U) || (total > (uint32_t)USBD_ISO_DURATION_MAX) || (size < 4U) || (size > USBD_ISO_MPS) || (dev_alt == 0U)) {
+      return 0U;
+    }
+    ph_duration = total;
+    ph_size     = size;
+    return 1U;
+  }
+  if ((type < USBD_PHASE_OUT) || (type > USBD_PHASE_ZLP_IN) || (size == 0U) || (size > USBD_XFER_SIZE_MAX) || (total < size)) {
+    return 0U;
+  }
+  if ((type >= USBD_PHASE_ZLP_OUT) && (((size % USBD_BulkMaxPacketSize()) != 0U) || ((total % size) != 0U))) {
+    return 0U;
+  }
+  ph_total = total;
+  ph_size  = size;
+  return 1U;
+}
+
+// Start next transfer of the active phase
+static void USBD_PhaseXfer (void) {
+  uint32_t len;
+  uint8_t  ep;
+
+  len = ph_total - ph_bytes;
+  if (len > ph_size) { len = ph_size; }
+  ep  = ((ph_type == USBD_PHASE_IN) || (ph_type == USBD_PHASE_ZLP_IN)) ? USBD_EP_BULK_IN : USBD_EP_BULK_OUT;
+  if (ph_type == USBD_PHASE_ZLP_OUT) {
+    /* Request more than the host sends: the ZLP terminates the transfer */
+    len = ph_size + USBD_BulkMaxPacketSize();
+  }
+
+  ph_tick_xfer = GET_SYSTICK();
+  if (USBD_Transfer(ep, xfer_buf, len) != ARM_DRIVER_OK) {
+    ph_errors++;
+    ph_type = 0U;
+  }
+}
+
+// Start transfer of an endpoint stream of the multiple endpoint phase
+static void USBD_StreamXfer (USBD_STREAM *st) {
+
+  st->tick_xfer = GET_SYSTICK();
+  if (USBD_Transfer(st->ep, st->buf, st->size) == ARM_DRIVER_OK) {
+    st->active = 1U;
+  } else {
+    st->active = 0U;
+    ph_errors++;
+  }
+}
+
+// Start multiple endpoint phase: transfers on all requested endpoints run concurrently
+static void USBD_MultiStart (void) {
+  static const char *const st_name[] = { "Bulk OUT", "Bulk IN", "Interrupt IN", "Isochronous IN" };
+  static const char *const st_met[]  = { "bulk_out", "bulk_in", "int_in", "iso_in" };
+  static const uint8_t     st_ep[]   = { USBD_EP_BULK_OUT, USBD_EP_BULK_IN, USBD_EP_INT_IN, USBD_EP_ISO_IN };
+  static const uint16_t    st_size[] = { USBD_MULTI_BULK_SIZE, USBD_MULTI_BULK_SIZE, USBD_INT_MPS, USBD_ISO_MPS };
+  static const uint32_t    st_offs[] = { 0U, USBD_MULTI_BULK_SIZE, (2U * USBD_MULTI_BULK_SIZE) + USBD_ISO_MPS, 2U * USBD_MULTI_BULK_SIZE };
+  USBD_STREAM *st;
+  uint32_t     i, n;
+
+  ph_events       = EvtHead;
+  ph_overflow     = EvtOverflow;
+  EvtMaxUsed      = 0U;
+  ph_kernel_start = osKernelGetTickCount();
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    st          = &stream[n];
+    st->name    = st_name[n];
+    st->metric  = st_met[n];
+    st->ep      = st_ep[n];
+    st->size    = st_size[n];
+    st->buf     = &xfer_buf[st_offs[n]];
+    st->active  = 0U;
+    st->bytes   = 0U;
+    st->start   = EpStat[USBD_EP_INDEX(st->ep)];
+    st->lat_cnt = 0U;
+    st->lat     = &lat_buf[n * USBD_LATENCY_NUM];
+    for (i = 0U; i < st->size; i++) {
+      st->buf[i] = (uint8_t)i;
+    }
+  }
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    if ((ph_mask & (1U << n)) != 0U) {
+      USBD_StreamXfer(&stream[n]);
+    }
+  }
+}
+
+// Process completed transfers of the multiple endpoint phase, stop the phase when its duration expired
+static void USBD_MultiProcess (void) {
+  USBD_STREAM *st;
+  USBD_EP_STAT stat;
+  uint64_t     ticks_per_s;
+  uint32_t     n, idx, num, done;
+
+  done = ((osKernelGetTickCount() - ph_kernel_start) >= (uint32_t)(((uint64_t)ph_duration * osKernelGetTickFreq()) / 1000U)) ? 1U : 0U;
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    st  = &stream[n];
+    idx = USBD_EP_INDEX(st->ep);
+    if ((st->active == 0U) || (EpFlags[idx] == 0U)) {
+      continue;
+    }
+    EpFlags[idx] = 0U;
+    st->active   = 0U;
+    num          = USBD_TransferResult(st->ep);
+    st->bytes   += num;
+    if (st->lat_cnt < USBD_LATENCY_NUM) {
+      st->lat[st->lat_cnt++] = EpTick[idx] - st->tick_xfer;
+    }
+    host_tick = osKernelGetTickCount();
+    if (done == 0U) {
+      USBD_StreamXfer(st);
+    }
+  }
+  if (done == 0U) {
+    return;
+  }
+
+  /* Phase completed: abort transfers still in progress */
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    if (stream[n].active != 0U) {
+      (void)drv->EndpointTransferAbort(stream[n].ep);
+      stream[n].active = 0U;
+    }
+  }
+  ph_time_us = (uint32_t)(((uint64_t)(osKernelGetTickCount() - ph_kernel_start) * 1000000U) / osKernelGetTickFreq());
+  ph_bytes   = 0U;
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    ph_bytes += stream[n].bytes;
+  }
+  ph_err_total += ph_errors;
+  ph_num_multi++;
+
+  (void)snprintf(str, sizeof(str), "[INFO] Multiple endpoints, %d ms: %d events/s, event queue max %d of %d, %d overflows, %d errors",
+                 ph_time_us / 1000U,
+                 (ph_time_us != 0U) ? (uint32_t)(((uint64_t)(EvtHead - ph_events) * 1000000U) / ph_time_us) : 0U,
+                 EvtMaxUsed, USBD_EVENT_QUEUE_LEN, EvtOverflow - ph_overflow, ph_errors);
+  TEST_MESSAGE(str);
+  ticks_per_s = SYSTICK_MICROSEC(1000000U);
+  for (n = 0U; n < USBD_STREAM_NUM; n++) {
+    st = &stream[n];
+    if ((ph_mask & (1U << n)) == 0U) {
+      continue;
+    }
+    stat = EpStat[USBD_EP_INDEX(st->ep)];
+    (void)snprintf(str, sizeof(str), "[INFO]   %s (0x%02X): %d transfers, %d events, %d rejected",
+                   st->name, st->ep,
+                   stat.transfers - st->start.transfers, stat.events - st->start.events, stat.rejected - st->start.rejected);
+    TEST_MESSAGE(str);
+    (void)snprintf(str, sizeof(str), "multi_%X_%s", ph_mask, st->metric);
+    TEST_METRIC_HIGHER(str, (ph_time_us != 0U) ? (((uint64_t)st->bytes * 1000U) / ph_time_us) : 0U, "kB/s", METRIC_NO_THRESHOLD);
+    TEST_PERCENTILES("Transfer latency", st->lat, st->lat_cnt, ticks_per_s);
+  }
+  ph_type = 0U;
+}
+
+// Start transfer of one packet on an isochronous stream (IN packets carry the sequence number in the first 4 bytes)
+static void USBD_IsoXfer (USBD_ISO_STREAM *st) {
+  uint32_t num;
+
+  if (st->ep == USBD_EP_ISO_IN) {
+    USBD_PutU32(st->buf, st->seq);
+    num = ph_size;
+  } else {
+    num = USBD_ISO_MPS;
+  }
+  if (USBD_Transfer(st->ep, st->buf, num) == ARM_DRIVER_OK) {
+    st->active = 1U;
+  } else {
+    st->active = 0U;
+    ph_errors++;
+  }
+}
+
+// Start isochronous phase: one packet every (micro)frame on the isochronous IN and OUT endpoints
+static void USBD_IsoStart (void) {
+  static const char *const iso_name[] = { "Isochronous IN", "Isochronous OUT" };
+  static const char *const iso_met[]  = { "iso_in", "iso_out" };
+  static const uint8_t     iso_ep[]   = { USBD_EP_ISO_IN, USBD_EP_ISO_OUT };
+  USBD_ISO_STREAM *st;
+  uint32_t         i, n;
+
+  iso_period      = (uint32_t)SYSTICK_MICROSEC((drv->DeviceGetState().speed == ARM_USB_SPEED_HIGH) ? 125U : 1000U);
+  iso_frame_last  = drv->GetFrameNumber();
+  iso_frames      = 0U;
+  ph_events       = EvtHead;
+  ph_overflow     = EvtOverflow;
+  EvtMaxUsed      = 0U;
+  ph_kernel_start = osKernelGetTickCount();
+  for (n = 0U; n < USBD_ISO_STREAM_NUM; n++) {
+    st = &iso[n];
+    memset(st, 0, sizeof(USBD_ISO_STREAM));
+    st->name       = iso_name[n];
+    st->metric     = iso_met[n];
+    st->ep         = iso_ep[n];
+    st->buf        = &xfer_buf[n * USBD_ISO_MPS];
+    st->period_min = 0xFFFFFFFFU;
+  }
+  for (i = 0U; i < ph_size; i++) {
+    iso[USBD_ISO_STREAM_IN].buf[i] = (uint8_t)i;
+  }
+  for (n = 0U; n < USBD_ISO_STREAM_NUM; n++) {
+    USBD_IsoXfer(&iso[n]);
+  }
+}
+
+// Update isochronous stream statistics with a completed packet (timestamp, SOF number, size and sequence number)
+static void USBD_IsoPacket (USBD_ISO_STREAM *st, uint32_t tick, uint16_t frame, uint32_t num, uint32_t seq) {
+  uint32_t period, dev_us;
+
+  st->packets++;
+  st->bytes += num;
+  if (st->ep == USBD_EP_ISO_OUT) {
+    /* Gaps in the sequence numbers of the host are packets lost for lack of a queued transfer */
+    if (num < 4U) {
+      st->missed++;
+    } else {
+      if ((st->packets > 1U) && (seq > st->seq)) {
+        st->missed += seq - st->seq;
+      }
+      st->seq = seq + 1U;
+    }
+  }
+  if (st->packets > 1U) {
+    period = tick - st->tick_last;
+    if (period < st->period_min) {
+      st->period_min = period;
+    }
+    if (period > st->period_max) {
+      st->period_max = period;
+      st->gap_frame  = frame;
+      st->gap_packet = st->packets - 1U;
+    }
+    if ((st->ep == USBD_EP_ISO_IN) && (period > ((3U * iso_period) / 2U))) {
+      /* (Micro)frames without a queued IN packet */
+      st->missed += ((period + (iso_period / 2U)) / iso_period) - 1U;
+    }
+    dev_us = (period > iso_period) ? (period - iso_period) : (iso_period - period);
+    dev_us = (uint32_t)(((uint64_t)dev_us * 1000000U) / SYSTICK_MICROSEC(1000000U));
+    st->hist[HISTOGRAM_BUCKET(iso_hist_lim, dev_us)]++;
+  }
+  st->tick_last = tick;
+}
+
+// Process completed packets of the isochronous phase, stop the phase when its duration expired
+static void USBD_IsoProcess (void) {
+  USBD_ISO_STREAM *st;
+  uint64_t         ticks_per_s;
+  uint32_t         n, idx, num, seq, tick, done, missed;
+  uint16_t         frame;
+
+  frame          = drv->GetFrameNumber();
+  iso_frames    += ((uint32_t)frame - iso_frame_last) & 0x7FFU;
+  iso_frame_last = frame;
+  done = ((osKernelGetTickCount() - ph_kernel_start) >= (uint32_t)(((uint64_t)ph_duration * osKernelGetTickFreq()) / 1000U)) ? 1U : 0U;
+  for (n = 0U; n < USBD_ISO_STREAM_NUM; n++) {
+    st  = &iso[n];
+    idx = USBD_EP_INDEX(st->ep);
+    if ((st->active == 0U) || (EpFlags[idx] == 0U)) {
+      continue;
+    }
+    EpFlags[idx] = 0U;
+    st->active   = 0U;
+    tick         = EpTick[idx];
+    num          = USBD_TransferResult(st->ep);
+    seq          = ((st->ep == USBD_EP_ISO_OUT) && (num >= 4U)) ? USBD_GetU32(st->buf) : 0U;
+    host_tick    = osKernelGetTickCount();
+    if (done == 0U) {
+      /* Queue the next packet first, statistics are updated while it is in progress */
+      if (st->ep == USBD_EP_ISO_IN) {
+        st->seq++;
+      }
+      USBD_IsoXfer(st);
+    }
+    USBD_IsoPacket(st, tick, frame, num, seq);
+  }
+  if (done == 0U) {
+    return;
+  }
+
+  /* Phase completed: abort transfers still in progress */
+  for (n = 0U; n < USBD_ISO_STREAM_NUM; n++) {
+    if (iso[n].active != 0U) {
+      (void)drv->EndpointTransferAbort(iso[n].ep);
+      iso[n].active = 0U;
+    }
+  }
+  ph_time_us = (uint32_t)(((uint64_t)(osKernelGetTickCount() - ph_kernel_start) * 1000000U) / osKernelGetTickFreq());
+  ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+  (void)snprintf(str, sizeof(str), "[INFO] Isochronous, %d bytes/packet, %d ms: %d frames, event queue max %d of %d, %d overflows, %d rejected",
+                 ph_size, ph_time_us / 1000U, iso_frames, EvtMaxUsed, USBD_EVENT_QUEUE_LEN, EvtOverflow - ph_overflow, ph_errors);
+  TEST_MESSAGE(str);
+  missed   = 0U;
+  ph_bytes = 0U;
+  for (n = 0U; n < USBD_ISO_STREAM_NUM; n++) {
+    st = &iso[n];
+    (void)snprintf(str, sizeof(str), "[INFO]   %s (0x%02X): %d packets, %d kB/s, %d %s",
+                   st->name, st->ep, st->packets,
+                   (ph_time_us != 0U) ? (uint32_t)(((uint64_t)st->bytes * 1000U) / ph_time_us) : 0U, st->missed,
+                   (st->ep == USBD_EP_ISO_IN) ? "missed (micro)frames (underruns)" : "lost packets (overruns)");
+    TEST_MESSAGE(str);
+    (void)snprintf(str, sizeof(str), "%s_missed", st->metric);
+    TEST_METRIC_LOWER(str, st->missed, (st->ep == USBD_EP_ISO_IN) ? "frames" : "packets", METRIC_NO_THRESHOLD);
+    if (st->packets > 1U) {
+      (void)snprintf(str, sizeof(str), "[INFO]   Packet period min/max %d/%d us, longest at frame %d (packet %d)",
+                     (uint32_t)(((uint64_t)st->period_min * 1000000U) / ticks_per_s),
+                     (uint32_t)(((uint64_t)st->period_max * 1000000U) / ticks_per_s), st->gap_frame, st->gap_packet);
+      TEST_MESSAGE(str);
+      TEST_HISTOGRAM("Period jitter histogram (us)", st->hist, iso_hist_lim);
+      (void)snprintf(str, sizeof(str), "%s_period_max", st->metric);
+      TEST_METRIC_LOWER(str, ((uint64_t)st->period_max * 1000000U) / ticks_per_s, "us", METRIC_NO_THRESHOLD);
+    }
+    missed   += st->missed;
+    ph_bytes += st->bytes;
+  }
+  if ((iso[USBD_ISO_STREAM_IN].packets == 0U) || (iso[USBD_ISO_STREAM_OUT].packets == 0U)) {
+    ph_errors++;
+  }
+  ph_errors    += missed;
+  ph_err_total += ph_errors;
+  ph_num_iso++;
+  ph_type = 0U;
+}
+
+// Start phase requested by the host
+static void USBD_PhaseStart (void) {
+  uint32_t i;
+
+  ph_type   = ctrl_setup[2];
+  ph_bytes  = 0U;
+  ph_errors = 0U;
+  ph_zlp    = 0U;
+  lat_cnt   = 0U;
+  if (ph_type == USBD_PHASE_MULTI) {
+    USBD_MultiStart();
+    return;
+  }
+  if (ph_type == USBD_PHASE_ISO) {
+    USBD_IsoStart();
+    return;
+  }
+  if ((ph_type == USBD_PHASE_IN) || (ph_type == USBD_PHASE_ZLP_IN)) {
+    for (i = 0U; i < ph_size; i++) {
+      xfer_buf[i] = (uint8_t)i;
+    }
+  }
+  ph_tick_start = GET_SYSTICK();
+  USBD_PhaseXfer();
+}
+
+// Process completed transfer of the active phase
+static void USBD_PhaseProcess (void) {
+  static const char *const ph_name[] = { "", "Bulk OUT", "Bulk IN", "Bulk OUT with ZLP", "Bulk IN with ZLP" };
+  static const char *const ph_met[]  = { "", "bulk_out", "bulk_in", "bulk_out_zlp", "bulk_in_zlp" };
+  uint64_t ticks_per_s;
+  uint32_t num, exp, tick;
+  uint8_t  ep;
+
+  if (ph_type == 0U) {
+    return;
+  }
+  if (ph_type == USBD_PHASE_MULTI) {
+    USBD_MultiProcess();
+    return;
+  }
+  if (ph_type == USBD_PHASE_ISO) {
+    USBD_IsoProcess();
+    return;
+  }
+  ep = ((ph_type == USBD_PHASE_IN) || (ph_type == USBD_PHASE_ZLP_IN)) ? USBD_EP_BULK_IN : USBD_EP_BULK_OUT;
+  if (EpFlags[USBD_EP_INDEX(ep)] == 0U) {
+    return;
+  }
+  EpFlags[USBD_EP_INDEX(ep)] = 0U;
+  tick      = EpTick[USBD_EP_INDEX(ep)];
+  host_tick = osKernelGetTickCount();
+
+  if (ph_zlp != 0U) {
+    /* ZLP after IN transfer sent */
+    ph_zlp = 0U;
+  } else {
+    num = USBD_TransferResult(ep);
+    exp = ph_total - ph_bytes;
+    if (exp > ph_size) { exp = ph_size; }
+    if (num != exp) {
+      ph_errors++;
+    }
+    ph_bytes += num;
+    if (lat_cnt < USBD_LATENCY_NUM) {
+      lat_buf[lat_cnt++] = tick - ph_tick_xfer;
+    }
+    if ((ph_type == USBD_PHASE_ZLP_OUT) && (num != 0U) && (xfer_buf[num - 1U] != (uint8_t)(num - 1U))) {
+      ph_errors++;
+    }
+    if (ph_type == USBD_PHASE_ZLP_IN) {
+      /* Terminate transfer with zero length packet */
+      ph_zlp = 1U;
+      if (USBD_Transfer(ep, xfer_buf, 0U) != ARM_DRIVER_OK) {
+        ph_errors++;
+        ph_zlp = 0U;
+      }
+      if (ph_zlp != 0U) {
+        return;
+      }
+    }
+  }
+
+  if ((ph_bytes < ph_total) && (ph_errors == 0U)) {
+    USBD_PhaseXfer();
+    return;
+  }
+
+  /* Phase completed */
+  ticks_per_s = SYSTICK_MICROSEC(1000000U);
+  ph_time_us  = (uint32_t)(((uint64_t)(tick - ph_tick_start) * 1000000U) / ticks_per_s);
+  ph_err_total += ph_errors;
+  ph_num++;
+
+  (void)snprintf(str, sizeof(str), "[INFO] %s, %d bytes/transfer: %d bytes, %d errors",
+                 ph_name[ph_type], ph_size, ph_bytes, ph_errors);
+  TEST_MESSAGE(str);
+  (void)snprintf(str, sizeof(str), "%s_%d", ph_met[ph_type], ph_size);
+  TEST_METRIC_HIGHER(str, (ph_time_us != 0U) ? (((uint64_t)ph_bytes * 1000U) / ph_time_us) : 0U, "kB/s", METRIC_NO_THRESHOLD);
+  TEST_PERCENTILES("Transfer latency", lat_buf, lat_cnt, ticks_per_s);
+  ph_type = 0U;
+}
+
+// Bus reset: configure control endpoint, device is in default state
+static void USBD_DevReset (void) {
+
+  USBD_SetConfig(0U);
+  ctrl_stage    = USBD_CTRL_IDLE;
+  ctrl_addr_set = 0U;
+  ctrl_vreq     = 0U;
+  (void)drv->EndpointConfigure(0x00U, ARM_USB_ENDPOINT_CONTROL, USBD_EP0_MPS);
+  (void)drv->EndpointConfigure(0x80U, ARM_USB_ENDPOINT_CONTROL, USBD_EP0_MPS);
+}
+
+// Process control endpoint events
+static void USBD_CtrlProcess (void) {
+  uint32_t ok;
+
+  if (SetupPending != 0U) {
+    SetupPending = 0U;
+    host_tick    = osKernelGetTickCount();
+    (void)drv->ReadSetupPacket(ctrl_setup);
+    ctrl_stage = USBD_CTRL_IDLE;
+    ctrl_vreq  = 0U;
+    switch (ctrl_setup[0] & 0x60U) {
+      case 0x00U: ok = USBD_StdRequest();    break;
+      case 0x40U: ok = USBD_VendorRequest(); break;
+      default:    ok = 0U;                   break;
+    }
+    if (ok == 0U) {
+      USBD_CtrlStall();
+    }
+    return;
+  }
+
+  switch (ctrl_stage) {
+    case USBD_CTRL_DATA_IN:
+      if (EpFlags[USBD_EP_INDEX(0x80U)] != 0U) {
+        (void)USBD_TransferResult(0x80U);
+        if (ctrl_zlp != 0U) {
+          ctrl_zlp = 0U;
+          (void)USBD_Transfer(0x80U, ctrl_buf, 0U);
+        } else {
+          ctrl_stage = USBD_CTRL_STATUS_OUT;
+          EpFlags[USBD_EP_INDEX(0x80U)] = 0U;
+          (void)USBD_Transfer(0x00U, ctrl_buf, 0U);
+        }
+      }
+      break;
+
+    case USBD_CTRL_DATA_OUT:
+      if (EpFlags[USBD_EP_INDEX(0x00U)] != 0U) {
+        EpFlags[USBD_EP_INDEX(0x00U)] = 0U;
+        if ((USBD_TransferResult(0x00U) == 8U) && (USBD_PhaseCheck() != 0U)) {
+          ctrl_vreq = USBD_VREQ_START;
+          USBD_CtrlStatusIn();
+        } else {
+          USBD_CtrlStall();
+        }
+      }
+      break;
+
+    case USBD_CTRL_STATUS_IN:
+      if (EpFlags[USBD_EP_INDEX(0x80U)] != 0U) {
+        EpFlags[USBD_EP_INDEX(0x80U)] = 0U;
+        ctrl_stage = USBD_CTRL_IDLE;
+        if (ctrl_addr_set != 0U) {
+          /* Address is set after the status stage of SET_ADDRESS */
+          ctrl_addr_set = 0U;
+          (void)drv->DeviceSetAddress(ctrl_addr);
+        }
+        if (ctrl_vreq == USBD_VREQ_START) {
+          USBD_PhaseStart();
+        } else if (ctrl_vreq == USBD_VREQ_DONE) {
+          host_done = 1U;
+        }
+        ctrl_vreq = 0U;
+      }
+      break;
+
+    case USBD_CTRL_STATUS_OUT:
+      if (EpFlags[USBD_EP_INDEX(0x00U)] != 0U) {
+        EpFlags[USBD_EP_INDEX(0x00U)] = 0U;
+        ctrl_stage = USBD_CTRL_IDLE;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+// Report statistics of all endpoints used by the host tool
+static void USBD_ReportEndpoints (void) {
+  uint32_t idx;
+  uint8_t  ep;
+
+  (void)snprintf(str, sizeof(str), "[INFO] Endpoint events: %d, event queue max %d of %d, %d overflows",
+                 EvtHead, EvtMaxUsed, USBD_EVENT_QUEUE_LEN, EvtOverflow);
+  TEST_MESSAGE(str);
+  for (idx = 0U; idx < 32U; idx++) {
+    if ((EpStat[idx].events == 0U) && (EpStat[idx].transfers == 0U) && (EpStat[idx].stalls == 0U) && (EpStat[idx].rejected == 0U)) {
+      continue;
+    }
+    ep = (uint8_t)((idx & 0x0FU) | ((idx & 0x10U) << 3));
+    (void)snprintf(str, sizeof(str), "[INFO]   Endpoint 0x%02X: %d events, %d transfers, %d bytes, %d stalls, %d rejected",
+                   ep, EpStat[idx].events, EpStat[idx].transfers, EpStat[idx].bytes, EpStat[idx].stalls, EpStat[idx].rejected);
+    TEST_MESSAGE(str);
+  }
+}
+
+/* Helper function that initializes and powers on the driver for data transfer tests */
+void USBD_DV_Setup (void) {
+  TEST_ASSERT(drv->Initialize(USB_DeviceEvent, USB_EndpointEvent) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+}
+
+/* Helper function that powers off and uninitializes the driver after data transfer tests */
+void USBD_DV_Teardown (void) {
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+/*
+  \fn            static uint32_t USBD_HostServe (void)
+  \brief         Connect, enumerate as vendor test device and execute the phases requested by the USBD_Host tool.
+  \return        execution status
+                   - 1: host tool completed the sequence
+                   - 0: resource or driver failure, host tool inactive for the timeout
+*/
+static uint32_t USBD_HostServe (void) {
+  uint32_t reset_cnt, timeout, ok;
+
+  xfer_buf = (uint8_t *)malloc(USBD_XFER_BUF_SIZE);
+  lat_buf  = (uint32_t *)malloc(USBD_STREAM_NUM * USBD_LATENCY_NUM * sizeof(uint32_t));
+  if ((xfer_buf == NULL) || (lat_buf == NULL)) {
+    free(xfer_buf);
+    free(lat_buf);
+    xfer_buf = NULL;
+    lat_buf  = NULL;
+    TEST_FAIL_MESSAGE("[FAILED] Buffer allocation failed");
+    return 0U;
+  }
+
+  ResetCnt     = 0U;
+  USBD_EventReset();
+  dev_config   = 0U;
+  dev_alt      = 0U;
+  host_done    = 0U;
+  ph_type      = 0U;
+  ph_num       = 0U;
+  ph_num_multi = 0U;
+  ph_num_iso   = 0U;
+  ph_err_total = 0U;
+  reset_cnt    = 0U;
+
+  TEST_ASSERT(drv->DeviceConnect() == ARM_DRIVER_OK);
+
+  /* Serve the host tool until it is done or inactive for the timeout */
+  timeout   = USBD_HOST_TIMEOUT * osKernelGetTickFreq();
+  host_tick = osKernelGetTickCount();
+  while ((host_done == 0U) && ((osKernelGetTickCount() - host_tick) < timeout)) {
+    if (ResetCnt != reset_cnt) {
+      reset_cnt = ResetCnt;
+      USBD_DevReset();
+    }
+    USBD_EventProcess();
+    USBD_CtrlProcess();
+    USBD_PhaseProcess();
+  }
+
+  ok = 1U;
+  if (host_done == 0U) {
+    (void)snprintf(str, sizeof(str), "[FAILED] USB host tool inactive for %d s (%d phases completed)", USBD_HOST_TIMEOUT, ph_num + ph_num_multi + ph_num_iso);
+    TEST_FAIL_MESSAGE(str);
+    ok = 0U;
+  }
+
+  USBD_SetConfig(0U);
+  USBD_EventProcess();
+  USBD_ReportEndpoints();
+  TEST_ASSERT(drv->DeviceDisconnect() == ARM_DRIVER_OK);
+
+  free(xfer_buf);
+  free(lat_buf);
+  xfer_buf = NULL;
+  lat_buf  = NULL;
+  return ok;
+}
+
 
 /*-----------------------------------------------------------------------------
  *      Tests
@@ -62,7 +1235,9 @@ static void USB_EndpointEvent (uint8_t endpoint, uint32_t event) {
 \defgroup dv_usbd USB Device Validation
 \brief USB Device driver validation
 \details
-The USB Device validation test checks the API interface compliance only.<br>
+The USB Device validation test checks the API interface compliance and, with the \ref usbd_host "USBD_Host" tool
+running on the USB host, bulk data transfer throughput and latency, concurrent bulk, interrupt and isochronous
+transfers and the timing of isochronous streams.<br>
 The section \ref usbd_comp_test explains how to run the USB compliance tests.<br>
 These tests check USB device for conformance to the USB specification which is required in order to gain USB certification.
 
@@ -170,6 +1345,125 @@ void USBD_PowerControl (void) {
   TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK); 
 }
 
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBD_Bulk_Throughput
+\details
+The test function \b USBD_Bulk_Throughput measures bulk endpoint throughput and transfer latency together with the
+\ref usbd_host "USBD_Host" tool on the USB host. The sequence is:
+ - \b DeviceConnect
+ - Enumerate as vendor specific device (\ref usbd_config "Vendor ID/Product ID") with one bulk OUT (0x01) and one bulk IN (0x81)
+   endpoint (64 bytes maximum packet size at full-speed, 512 bytes at high-speed)
+ - Execute the phases requested by the host tool with vendor requests:
+   - Bulk OUT: receive data in transfers of requested size (\b EndpointTransfer)
+   - Bulk IN: send data in transfers of requested size
+   - Bulk OUT with ZLP: receive transfers (multiple of maximum packet size) terminated by a zero-length packet
+   - Bulk IN with ZLP: send transfers (multiple of maximum packet size) followed by a zero-length packet
+ - Report per-transfer latency (\b EndpointTransfer call to \b ARM_USBD_EVENT_OUT/IN) of each phase
+ - Record throughput metric of each phase (kB/s): \c bulk_out_<size>, \c bulk_in_<size>, \c bulk_out_zlp_<size> and
+   \c bulk_in_zlp_<size>
+ - Report events, transfers, bytes, stalls and rejected transfers of each used endpoint
+ - \b DeviceDisconnect
+
+The driver is initialized and powered on by the test group fixture (\b USBD_DV_Setup).
+
+The test fails if the host tool does not complete the sequence within the \ref usbd_config "Host timeout"
+or if a transfer size or ZLP check fails. The host tool reports the throughput in MB/s measured on the host.
+*/
+void USBD_Bulk_Throughput (void) {
+
+  if (USBD_HostServe() == 0U) {
+    return;
+  }
+  if (ph_num == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] USB host tool requested no bulk transfers");
+  } else {
+    TEST_ASSERT_MESSAGE(ph_err_total == 0U, "[FAILED] Transfer size or data errors");
+  }
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBD_Multi_Endpoint
+\details
+The test function \b USBD_Multi_Endpoint verifies concurrent transfers on bulk, interrupt and isochronous endpoints
+together with the \ref usbd_host "USBD_Host" tool started with option \b -m on the USB host. The sequence is:
+ - \b DeviceConnect
+ - Enumerate as vendor specific device with bulk OUT (0x01), bulk IN (0x81) and interrupt IN (0x82, 64 bytes) endpoints;
+   alternate setting 1 of the interface adds an isochronous IN endpoint (0x83, 512 bytes, one packet per (micro)frame)
+ - For each endpoint combination requested by the host tool, keep transfers active on all selected endpoints
+   for the requested duration (\b EndpointTransfer restarted from the endpoint events)
+ - Report per endpoint transfer and event counts and transfer latency, the endpoint event rate and
+   the event queue usage
+ - Record per endpoint throughput metric \c multi_<mask>_<endpoint> (kB/s, mask of the endpoint combination in hex,
+   endpoint \c bulk_out, \c bulk_in, \c int_in or \c iso_in)
+ - \b DeviceDisconnect
+
+The driver is initialized and powered on by the test group fixture (\b USBD_DV_Setup).
+
+Endpoint events are queued by the \b ARM_USBD_SignalEndpointEvent callback and processed by the test thread.
+The test fails if the host tool does not complete the sequence within the \ref usbd_config "Host timeout",
+if it requested no multiple endpoint phase, if the driver rejected a transfer or if the
+\ref usbd_config "event queue" overflowed.
+\note The CMSIS USB Device driver does not signal NAK handshakes; endpoints not serviced by the host are reported
+with a low transfer count.
+*/
+void USBD_Multi_Endpoint (void) {
+
+  if (USBD_HostServe() == 0U) {
+    return;
+  }
+  if (ph_num_multi == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] USB host tool requested no multiple endpoint transfers");
+  } else if (EvtOverflow != 0U) {
+    (void)snprintf(str, sizeof(str), "[FAILED] Endpoint event queue overflow (%d events lost)", EvtOverflow);
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    TEST_ASSERT_MESSAGE(ph_err_total == 0U, "[FAILED] Endpoint transfer rejected by the driver");
+  }
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBD_Isochronous
+\details
+The test function \b USBD_Isochronous verifies the timing of isochronous streams, as used by audio class workloads,
+together with the \ref usbd_host "USBD_Host" tool started with option \b -i (or the \ref USBH_Isochronous test of the
+USB Host validation) on the USB host. The sequence is:
+ - \b DeviceConnect
+ - Enumerate as vendor specific device; alternate setting 1 of the interface provides an isochronous IN (0x83) and an
+   isochronous OUT (0x03) endpoint with one packet every (micro)frame
+ - Stream fixed-size packets in both directions for the duration requested by the host (typically several minutes),
+   one \b EndpointTransfer per packet restarted from the endpoint events; IN packets carry a sequence number,
+   the sequence numbers of OUT packets are checked
+ - Record the timestamp and SOF number (\b GetFrameNumber) of every packet and report per stream the packet count,
+   throughput, missed (micro)frames of the IN stream (underruns), lost packets of the OUT stream (overruns),
+   the shortest and longest packet period with its SOF number and a histogram of the period jitter
+ - Record metrics \c iso_in_missed (missed (micro)frames), \c iso_out_missed (lost packets) and
+   \c iso_in_period_max and \c iso_out_period_max (longest packet period in us)
+ - \b DeviceDisconnect
+
+The driver is initialized and powered on by the test group fixture (\b USBD_DV_Setup).
+
+The test fails if the host does not complete the sequence within the \ref usbd_config "Host timeout",
+if it requested no isochronous phase, if a stream missed or lost a packet, if the driver rejected a transfer or if the
+\ref usbd_config "event queue" overflowed.
+*/
+void USBD_Isochronous (void) {
+
+  if (USBD_HostServe() == 0U) {
+    return;
+  }
+  if (ph_num_iso == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] USB host requested no isochronous transfers");
+  } else if (EvtOverflow != 0U) {
+    (void)snprintf(str, sizeof(str), "[FAILED] Endpoint event queue overflow (%d events lost)", EvtOverflow);
+    TEST_FAIL_MESSAGE(str);
+  } else {
+    TEST_ASSERT_MESSAGE(ph_err_total == 0U, "[FAILED] Isochronous underruns, overruns or rejected transfers");
+  }
+}
+
 /**
 @}
 */ 
@@ -41,6 +41,19 @@ static ARM_USBH_CAPABILITIES capab;
 static uint8_t volatile PortEvent;  
 static uint8_t volatile PipeEvent; 
 
+// Pipes of the data transfer tests
+#define USBH_PIPE_CTRL          0U
+#define USBH_PIPE_BULK_OUT      1U
+#define USBH_PIPE_BULK_IN       2U
+#define USBH_PIPE_INT_IN        3U
+#define USBH_PIPE_ISO_IN        4U              // Alternate setting 1 only
+#define USBH_PIPE_ISO_OUT       5U              // Alternate setting 1 only
+#define USBH_PIPE_NUM           6U
+
+static ARM_USBH_PIPE_HANDLE         PipeHndl[USBH_PIPE_NUM];
+static uint32_t    volatile         PipeEvt[USBH_PIPE_NUM];     // Pipe events not yet handled
+static uint32_t    volatile         PipeTick[USBH_PIPE_NUM];    // Timestamp of last pipe event
+
 // USB Port event
 static void USB_PortEvent (uint8_t port, uint32_t event) {
   PortEvent |= event;
@@ -48,9 +61,832 @@ static void USB_PortEvent (uint8_t port, uint32_t event) {
 
 // USB Pipe event
 static void USB_PipeEvent (ARM_USBH_PIPE_HANDLE pipe_hndl, uint32_t event) {
+  uint32_t i;
+
+  for (i = 0U; i < USBH_PIPE_NUM; i++) {
+    if ((pipe_hndl != 0U) && (pipe_hndl == PipeHndl[i])) {
+      PipeTick[i] = GET_SYSTICK();
+      PipeEvt[i] |= event;
+    }
+  }
   PipeEvent |= event;
 }
 
+/*-----------------------------------------------------------------------------
+ *      Test device
+ *----------------------------------------------------------------------------*/
+
+// The data transfer tests drive the vendor test device of the USB Device validation
+// (USBD_Bulk_Throughput and USBD_Multi_Endpoint) with the protocol of the USBD_Host tool.
+
+#define USBH_DEV_ADDR           1U              // Address assigned to the test device
+
+// Vendor requests
+#define USBH_VREQ_START         1U              // Start phase (wValue: phase, data: two 32-bit parameters)
+#define USBH_VREQ_RESULT        2U              // Get result of last phase (errors, bytes, time in us)
+#define USBH_VREQ_DONE          3U              // All phases done
+
+// Phases
+#define USBH_PHASE_OUT          1U              // Host sends total bytes in transfers of given size
+#define USBH_PHASE_IN           2U              // Device sends total bytes in transfers of given size
+#define USBH_PHASE_MULTI        5U              // Concurrent transfers on multiple endpoints (duration in ms, endpoint mask)
+#define USBH_PHASE_ISO          6U              // Isochronous IN and OUT streams (duration in ms, bytes per packet)
+
+// Endpoint mask bits of the multiple endpoint phase
+#define USBH_MASK_BULK_OUT      (1U << 0)
+#define USBH_MASK_BULK_IN       (1U << 1)
+#define USBH_MASK_INT_IN        (1U << 2)
+
+// Pipe transfer results
+#define USBH_RES_OK             0
+#define USBH_RES_TIMEOUT       -1
+#define USBH_RES_STALL         -2
+#define USBH_RES_ERROR         -3
+
+// Phase not supported by the test device
+#define USBH_PHASE_SKIPPED      0xFFFFFFFFU
+
+// Bulk transfer size of the multiple pipe phase (multiple of the maximum packet size)
+#define USBH_MULTI_BULK_SIZE    4096U
+
+// Isochronous streams of the isochronous phase
+#define USBH_ISO_STREAM_IN      0U
+#define USBH_ISO_STREAM_OUT     1U
+#define USBH_ISO_STREAM_NUM     2U
+
+// Offset of the isochronous OUT packet in the data buffer (behind the largest isochronous IN packet)
+#define USBH_ISO_BUF_OFFS       1024U
+
+// Data buffer size (largest bulk transfer or all pipes of the multiple pipe phase)
+#define USBH_XFER_BUF_SIZE      ((USBH_XFER_SIZE_MAX > ((2U * USBH_MULTI_BULK_SIZE) + 1024U)) ? USBH_XFER_SIZE_MAX : ((2U * USBH_MULTI_BULK_SIZE) + 1024U))
+
+// Test device endpoints (from the configuration descriptor)
+typedef struct {
+  uint8_t  addr;
+  uint8_t  interval;
+  uint16_t mps;
+} USBH_EP_INFO;
+
+static uint8_t       dev_speed;
+static uint8_t       dev_mps0;
+static USBH_EP_INFO  ep_info[USBH_PIPE_NUM];
+static uint8_t       ctrl_buf[256];
+static uint8_t      *xfer_buf;
+static uint32_t     *lat_buf;
+static uint32_t      nak_cnt[USBH_PIPE_NUM];  // NAK handshakes signaled by the driver
+static uint16_t      frame_last;
+static uint32_t      frame_cnt;
+
+// Upper limits of the isochronous period jitter histogram (deviation from the (micro)frame period in us)
+static const uint32_t iso_hist_lim[] = { 10U, 25U, 50U, 125U, 250U, 500U, 1000U };
+
+// Isochronous stream statistics
+typedef struct {
+  uint32_t seq;                         // Sequence number of next packet (OUT) or expected packet (IN)
+  uint32_t packets;
+  uint32_t bytes;
+  uint32_t missed;                      // (Micro)frames without a queued transfer
+  uint32_t empty;                       // IN packets without data between sequenced packets (device underruns)
+  uint32_t empty_pend;                  // IN packets without data since the last sequenced packet
+  uint32_t synced;                      // First sequenced IN packet received
+  uint32_t lost;                        // IN packets lost by the host (sequence number gaps)
+  uint32_t errors;                      // Transfers terminated with an error
+  uint32_t tick_last;                   // Timestamp of last packet
+  uint32_t period_min;                  // Shortest and longest period between packets (ticks)
+  uint32_t period_max;
+  uint32_t gap_frame;                   // SOF number and packet index at the longest period
+  uint32_t gap_packet;
+  uint32_t hist[ARRAY_SIZE(iso_hist_lim) + 1U];
+} USBH_ISO_STREAM;
+
+static USBH_ISO_STREAM iso[USBH_ISO_STREAM_NUM];
+static uint32_t      iso_period;        // Nominal period between packets (ticks)
+
+// Message buffer
+static char          str[128];
+
+// Transfer sizes of the bulk throughput test
+static const uint32_t xfer_size[] = { 64U, 512U, 4096U, 16384U, 65536U };
+
+// Store and get 32-bit values in little-endian byte order
+static void USBH_PutU32 (uint8_t *buf, uint32_t val) {
+  buf[0] = (uint8_t)val;         buf[1] = (uint8_t)(val >> 8);
+  buf[2] = (uint8_t)(val >> 16); buf[3] = (uint8_t)(val >> 24);
+}
+static uint32_t USBH_GetU32 (const uint8_t *buf) {
+  return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+// Start counting USB frames (1 ms)
+static void USBH_FrameStart (void) {
+  frame_last = drv->GetFrameNumber();
+  frame_cnt  = 0U;
+}
+
+// Add USB frames elapsed since the last call (11-bit frame counter, called at least every 2 s)
+static uint32_t USBH_FrameCount (void) {
+  uint16_t frame = drv->GetFrameNumber();
+
+  frame_cnt += ((uint32_t)frame - frame_last) & 0x7FFU;
+  frame_last = frame;
+  return frame_cnt;
+}
+
+// Polling interval of the interrupt IN endpoint in us
+static uint32_t USBH_IntervalUs (void) {
+  uint32_t interval = ep_info[USBH_PIPE_INT_IN].interval;
+
+  if (dev_speed == ARM_USB_SPEED_HIGH) {
+    return 125U << (((interval >= 1U) && (interval <= 16U)) ? (interval - 1U) : 0U);
+  }
+  return ((interval != 0U) ? interval : 1U) * 1000U;
+}
+
+// Maximum bulk payload per frame (1 ms) of the bus: 13 packets per microframe at high-speed, 19 packets per frame at full-speed
+static uint32_t USBH_BulkMaxPerFrame (void) {
+  return (dev_speed == ARM_USB_SPEED_HIGH) ? (8U * 13U * 512U) : (19U * 64U);
+}
+
+// Start pipe transfer (clears pending pipe events)
+static int32_t USBH_XferStart (uint32_t pipe, uint32_t packet, uint8_t *data, uint32_t num) {
+  PipeEvt[pipe] = 0U;
+  return drv->PipeTransfer(PipeHndl[pipe], packet, data, num);
+}
+
+/*
+  \fn            static int32_t USBH_XferWait (uint32_t pipe, uint32_t packet, uint8_t *data, uint32_t num, uint32_t *done)
+  \brief         Wait for completion of pipe transfer started with USBH_XferStart.
+  \detail        Transfers terminated with a NAK handshake are continued with the remaining data.
+  \return        USBH_RES_OK, USBH_RES_TIMEOUT, USBH_RES_STALL or USBH_RES_ERROR
+*/
+static int32_t USBH_XferWait (uint32_t pipe, uint32_t packet, uint8_t *data, uint32_t num, uint32_t *done) {
+  uint32_t evt, tick, cnt;
+
+  cnt  = 0U;
+  tick = GET_SYSTICK();
+  for (;;) {
+    evt = PipeEvt[pipe];
+    if ((evt & ARM_USBH_EVENT_TRANSFER_COMPLETE) != 0U) {
+      cnt += drv->PipeTransferGetResult(PipeHndl[pipe]);
+      break;
+    }
+    if ((evt & ARM_USBH_EVENT_HANDSHAKE_STALL) != 0U) {
+      *done = cnt;
+      return USBH_RES_STALL;
+    }
+    if ((evt & (ARM_USBH_EVENT_HANDSHAKE_ERR | ARM_USBH_EVENT_BUS_ERROR)) != 0U) {
+      *done = cnt;
+      return USBH_RES_ERROR;
+    }
+    if ((evt & ARM_USBH_EVENT_HANDSHAKE_NAK) != 0U) {
+      /* Continue with the remaining data, data toggle is kept by the driver */
+      nak_cnt[pipe]++;
+      cnt += drv->PipeTransferGetResult(PipeHndl[pipe]);
+      if (USBH_XferStart(pipe, packet & ARM_USBH_PACKET_TOKEN_Msk, &data[cnt], num - cnt) != ARM_DRIVER_OK) {
+        *done = cnt;
+        return USBH_RES_ERROR;
+      }
+      continue;
+    }
+    if ((GET_SYSTICK() - tick) >= SYSTICK_MICROSEC(USBH_XFER_TIMEOUT * 1000U)) {
+      (void)drv->PipeTransferAbort(PipeHndl[pipe]);
+      *done = cnt;
+      return USBH_RES_TIMEOUT;
+    }
+  }
+  *done = cnt;
+  return USBH_RES_OK;
+}
+
+// Execute pipe transfer and wait for completion
+static int32_t USBH_Xfer (uint32_t pipe, uint32_t packet, uint8_t *data, uint32_t num, uint32_t *done) {
+
+  if (USBH_XferStart(pipe, packet, data, num) != ARM_DRIVER_OK) {
+    *done = 0U;
+    return USBH_RES_ERROR;
+  }
+  return USBH_XferWait(pipe, packet, data, num, done);
+}
+
+/*
+  \fn            static int32_t USBH_Control (uint8_t req_type, uint8_t req, uint16_t value, uint16_t index, uint8_t *data, uint16_t len)
+  \brief         Execute control transfer on the default pipe (setup, optional data and status stage).
+  \return        number of data bytes transferred or negative pipe transfer result
+*/
+static int32_t USBH_Control (uint8_t req_type, uint8_t req, uint16_t value, uint16_t index, uint8_t *data, uint16_t len) {
+  uint8_t  setup[8];
+  uint32_t num, tmp;
+  int32_t  ret;
+
+  setup[0] = req_type;        setup[1] = req;
+  setup[2] = (uint8_t)value;  setup[3] = (uint8_t)(value >> 8);
+  setup[4] = (uint8_t)index;  setup[5] = (uint8_t)(index >> 8);
+  setup[6] = (uint8_t)len;    setup[7] = (uint8_t)(len   >> 8);
+
+  ret = USBH_Xfer(USBH_PIPE_CTRL, ARM_USBH_PACKET_SETUP | ARM_USBH_PACKET_DATA0, setup, 8U, &tmp);
+  if (ret != USBH_RES_OK) {
+    return ret;
+  }
+  num = 0U;
+  if (len != 0U) {
+    ret = USBH_Xfer(USBH_PIPE_CTRL, (((req_type & 0x80U) != 0U) ? ARM_USBH_PACKET_IN : ARM_USBH_PACKET_OUT) | ARM_USBH_PACKET_DATA1,
+                    data, len, &num);
+    if (ret != USBH_RES_OK) {
+      return ret;
+    }
+  }
+  /* Status stage in opposite direction (IN if there is no data stage) */
+  ret = USBH_Xfer(USBH_PIPE_CTRL, ((((req_type & 0x80U) != 0U) && (len != 0U)) ? ARM_USBH_PACKET_OUT : ARM_USBH_PACKET_IN) | ARM_USBH_PACKET_DATA1,
+                  ctrl_buf, 0U, &tmp);
+  if (ret != USBH_RES_OK) {
+    return ret;
+  }
+  return (int32_t)num;
+}
+
+// Parse configuration descriptor for the test device endpoints (isochronous endpoints from alternate setting 1),
+// returns 0 if a bulk or interrupt endpoint is missing
+static uint32_t USBH_ParseConfig (const uint8_t *d, uint32_t len) {
+  uint32_t i, alt, pipe;
+
+  memset(&ep_info[USBH_PIPE_BULK_OUT], 0, sizeof(USBH_EP_INFO) * (USBH_PIPE_NUM - 1U));
+  alt = 0U;
+  for (i = 0U; ((i + 2U) <= len) && (d[i] != 0U); i += d[i]) {
+    if ((d[i + 1U] == 4U) && ((i + 4U) < len)) {
+      alt = d[i + 3U];                  // Interface descriptor
+    }
+    if ((d[i + 1U] != 5U) || (alt > 1U) || ((i + 7U) > len)) {
+      continue;
+    }
+    switch (d[i + 3U] & 3U) {           // Endpoint descriptor: transfer type
+      case ARM_USB_ENDPOINT_BULK:         pipe = ((d[i + 2U] & 0x80U) != 0U) ? USBH_PIPE_BULK_IN : USBH_PIPE_BULK_OUT; break;
+      case ARM_USB_ENDPOINT_INTERRUPT:    pipe = ((d[i + 2U] & 0x80U) != 0U) ? USBH_PIPE_INT_IN  : 0U;                 break;
+      case ARM_USB_ENDPOINT_ISOCHRONOUS:  pipe = ((d[i + 2U] & 0x80U) != 0U) ? USBH_PIPE_ISO_IN  : USBH_PIPE_ISO_OUT;  break;
+      default:                            pipe = 0U;                                                                    break;
+    }
+    if ((alt != 0U) != (pipe >= USBH_PIPE_ISO_IN)) {
+      continue;
+    }
+    if (pipe != 0U) {
+      ep_info[pipe].addr     = d[i + 2U];
+      ep_info[pipe].mps      = (uint16_t)(d[i + 4U] | (d[i + 5U] << 8)) & ARM_USB_ENDPOINT_MAX_PACKET_SIZE_MASK;
+      ep_info[pipe].interval = d[i + 6U];
+    }
+  }
+  return ((ep_info[USBH_PIPE_BULK_OUT].mps != 0U) && (ep_info[USBH_PIPE_BULK_IN].mps != 0U) && (ep_info[USBH_PIPE_INT_IN].mps != 0U)) ? 1U : 0U;
+}
+
+/* Helper function that initializes and powers on the driver for data transfer tests */
+void USBH_DV_Setup (void) {
+  TEST_ASSERT(drv->Initialize(USB_PortEvent, USB_PipeEvent) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK);
+}
+
+/* Helper function that powers off and uninitializes the driver after data transfer tests */
+void USBH_DV_Teardown (void) {
+  TEST_ASSERT(drv->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK);
+  TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK);
+}
+
+/*
+  \fn            static uint32_t USBH_DeviceAttach (void)
+  \brief         Switch on VBUS, wait for the test device, enumerate it and create the data pipes.
+  \return        1 = test device configured, 0 = failed (test failure reported)
+*/
+static uint32_t USBH_DeviceAttach (void) {
+  ARM_USBH_PORT_STATE state;
+  uint32_t i, len, tick, timeout;
+  int32_t  ret;
+
+  memset(PipeHndl, 0, sizeof(PipeHndl));
+  memset(nak_cnt,  0, sizeof(nak_cnt));
+  TEST_ASSERT(drv->PortVbusOnOff(USBH_PORT, true) == ARM_DRIVER_OK);
+
+  /* Wait for the test device */
+  timeout = USBH_DEVICE_TIMEOUT * osKernelGetTickFreq();
+  tick    = osKernelGetTickCount();
+  do {
+    state = drv->PortGetState(USBH_PORT);
+    if (state.connected != 0U) {
+      break;
+    }
+    (void)osDelay(10U);
+  } while ((osKernelGetTickCount() - tick) < timeout);
+  if (state.connected == 0U) {
+    (void)snprintf(str, sizeof(str), "[FAILED] No device connected to port %d within %d s", USBH_PORT, USBH_DEVICE_TIMEOUT);
+    TEST_FAIL_MESSAGE(str);
+    return 0U;
+  }
+
+  /* Connect debounce and bus reset */
+  (void)osDelay(100U);
+  TEST_ASSERT(drv->PortReset(USBH_PORT) == ARM_DRIVER_OK);
+  (void)osDelay(20U);
+  dev_speed = (uint8_t)drv->PortGetState(USBH_PORT).speed;
+  dev_mps0  = (dev_speed == ARM_USB_SPEED_HIGH) ? 64U : 8U;
+
+  /* Default control pipe, maximum packet size of endpoint 0 from the first 8 bytes of the device descriptor */
+  PipeHndl[USBH_PIPE_CTRL] = drv->PipeCreate(0U, dev_speed, 0U, 0U, 0U, ARM_USB_ENDPOINT_CONTROL, dev_mps0, 0U);
+  if (PipeHndl[USBH_PIPE_CTRL] == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] PipeCreate of default control pipe failed");
+    return 0U;
+  }
+  if (USBH_Control(0x80U, 6U, 0x0100U, 0U, ctrl_buf, 8U) != 8) {
+    TEST_FAIL_MESSAGE("[FAILED] GET_DESCRIPTOR (device) failed");
+    return 0U;
+  }
+  dev_mps0 = ctrl_buf[7];
+  TEST_ASSERT(drv->PipeModify(PipeHndl[USBH_PIPE_CTRL], 0U, dev_speed, 0U, 0U, dev_mps0) == ARM_DRIVER_OK);
+  if (USBH_Control(0x00U, 5U, USBH_DEV_ADDR, 0U, NULL, 0U) != 0) {
+    TEST_FAIL_MESSAGE("[FAILED] SET_ADDRESS failed");
+    return 0U;
+  }
+  (void)osDelay(2U);
+  TEST_ASSERT(drv->PipeModify(PipeHndl[USBH_PIPE_CTRL], USBH_DEV_ADDR, dev_speed, 0U, 0U, dev_mps0) == ARM_DRIVER_OK);
+
+  if (USBH_Control(0x80U, 6U, 0x0100U, 0U, ctrl_buf, 18U) != 18) {
+    TEST_FAIL_MESSAGE("[FAILED] GET_DESCRIPTOR (device) at new address failed");
+    return 0U;
+  }
+  if (((ctrl_buf[8] | (ctrl_buf[9] << 8)) != USBH_VID) || ((ctrl_buf[10] | (ctrl_buf[11] << 8)) != USBH_PID)) {
+    (void)snprintf(str, sizeof(str), "[FAILED] Device %04X:%04X is not the test device", ctrl_buf[8] | (ctrl_buf[9] << 8), ctrl_buf[10] | (ctrl_buf[11] << 8));
+    TEST_FAIL_MESSAGE(str);
+    return 0U;
+  }
+  ret = USBH_Control(0x80U, 6U, 0x0200U, 0U, ctrl_buf, 9U);
+  if (ret == 9) {
+    /* Complete configuration descriptor (wTotalLength) */
+    len = ctrl_buf[2] | ((uint32_t)ctrl_buf[3] << 8);
+    if (len > sizeof(ctrl_buf)) { len = sizeof(ctrl_buf); }
+    ret = USBH_Control(0x80U, 6U, 0x0200U, 0U, ctrl_buf, (uint16_t)len);
+  }
+  if ((ret <= 0) || (USBH_ParseConfig(ctrl_buf, (uint32_t)ret) == 0U)) {
+    TEST_FAIL_MESSAGE("[FAILED] Configuration descriptor of the test device not valid");
+    return 0U;
+  }
+  if (USBH_Control(0x00U, 9U, 1U, 0U, NULL, 0U) != 0) {
+    TEST_FAIL_MESSAGE("[FAILED] SET_CONFIGURATION failed");
+    return 0U;
+  }
+
+  for (i = USBH_PIPE_BULK_OUT; i < USBH_PIPE_ISO_IN; i++) {
+    PipeHndl[i] = drv->PipeCreate(USBH_DEV_ADDR, dev_speed, 0U, 0U, ep_info[i].addr,
+                                  (i == USBH_PIPE_INT_IN) ? ARM_USB_ENDPOINT_INTERRUPT : ARM_USB_ENDPOINT_BULK,
+                                  ep_info[i].mps, ep_info[i].interval);
+    if (PipeHndl[i] == 0U) {
+      (void)snprintf(str, sizeof(str), "[FAILED] PipeCreate for endpoint 0x%02X failed", ep_info[i].addr);
+      TEST_FAIL_MESSAGE(str);
+      return 0U;
+    }
+  }
+  (void)snprintf(str, sizeof(str), "[INFO] Test device at %s speed, bulk %d bytes, interrupt %d bytes every %d us",
+                 (dev_speed == ARM_USB_SPEED_HIGH) ? "high" : "full", ep_info[USBH_PIPE_BULK_IN].mps, ep_info[USBH_PIPE_INT_IN].mps,
+                 USBH_IntervalUs());
+  TEST_MESSAGE(str);
+  return 1U;
+}
+
+// End test device sequence, delete pipes and switch off VBUS (the test device disconnects before the next test)
+static void USBH_DeviceDetach (uint32_t done) {
+  uint32_t i, tick;
+
+  if ((done != 0U) && (PipeHndl[USBH_PIPE_CTRL] != 0U)) {
+    (void)USBH_Control(0x40U, USBH_VREQ_DONE, 0U, 0U, NULL, 0U);
+  }
+  for (i = 0U; i < USBH_PIPE_NUM; i++) {
+    if (PipeHndl[i] != 0U) {
+      (void)drv->PipeTransferAbort(PipeHndl[i]);
+      TEST_ASSERT(drv->PipeDelete(PipeHndl[i]) == ARM_DRIVER_OK);
+      PipeHndl[i] = 0U;
+    }
+  }
+  TEST_ASSERT(drv->PortVbusOnOff(USBH_PORT, false) == ARM_DRIVER_OK);
+
+  /* Wait until the test device disconnected, so the next test does not enumerate it again */
+  tick = osKernelGetTickCount();
+  while ((drv->PortGetState(USBH_PORT).connected != 0U) && ((osKernelGetTickCount() - tick) < osKernelGetTickFreq())) {
+    (void)osDelay(10U);
+  }
+}
+
+// Send START request, returns 0 if the device does not accept the phase
+static uint32_t USBH_PhaseStart (uint32_t phase, uint32_t param1, uint32_t param2) {
+  uint8_t d[8];
+
+  USBH_PutU32(&d[0], param1);
+  USBH_PutU32(&d[4], param2);
+  return (USBH_Control(0x40U, USBH_VREQ_START, (uint16_t)phase, 0U, d, 8U) == 8) ? 1U : 0U;
+}
+
+// Get device side result of the last phase, returns 0 if the device did not answer
+static uint32_t USBH_PhaseResult (uint32_t *errors, uint32_t *bytes) {
+  uint32_t retry;
+
+  /* Device answers (does not stall) after it processed the last transfer of the phase */
+  for (retry = 0U; retry < 100U; retry++) {
+    if (USBH_Control(0xC0U, USBH_VREQ_RESULT, 0U, 0U, ctrl_buf, 12U) == 12) {
+      *errors = USBH_GetU32(&ctrl_buf[0]);
+      *bytes  = USBH_GetU32(&ctrl_buf[4]);
+      return 1U;
+    }
+    (void)osDelay(10U);
+  }
+  return 0U;
+}
+
+// Allocate data and latency buffers, returns 0 if allocation failed (test failure reported)
+static uint32_t USBH_BufAlloc (void) {
+
+  xfer_buf = (uint8_t *)malloc(USBH_XFER_BUF_SIZE);
+  lat_buf  = (uint32_t *)malloc(USBH_PIPE_ISO_IN * USBH_LATENCY_NUM * sizeof(uint32_t));
+  if ((xfer_buf == NULL) || (lat_buf == NULL)) {
+    free(xfer_buf);
+    free(lat_buf);
+    xfer_buf = NULL;
+    lat_buf  = NULL;
+    TEST_FAIL_MESSAGE("[FAILED] Buffer allocation failed");
+    return 0U;
+  }
+  return 1U;
+}
+
+// Free data and latency buffers
+static void USBH_BufFree (void) {
+  free(xfer_buf);
+  free(lat_buf);
+  xfer_buf = NULL;
+  lat_buf  = NULL;
+}
+
+/*
+  \fn            static uint32_t USBH_BulkPhase (uint32_t phase, uint32_t size)
+  \brief         Execute bulk OUT or bulk IN phase of the test device in transfers of given size and report the results.
+  \return        number of host and device side errors, USBH_PHASE_SKIPPED if the test device does not support the size
+*/
+static uint32_t USBH_BulkPhase (uint32_t phase, uint32_t size) {
+  uint32_t pipe, packet, total, bytes, len, num, errors, lat_cnt, naks, frames, time_us, i;
+  uint32_t tick, tick_start, tick_end, dev_errors, dev_bytes;
+  int32_t  ret;
+
+  pipe   = (phase == USBH_PHASE_IN) ? USBH_PIPE_BULK_IN  : USBH_PIPE_BULK_OUT;
+  packet = (phase == USBH_PHASE_IN) ? ARM_USBH_PACKET_IN : ARM_USBH_PACKET_OUT;
+  total  = (size > USBH_BULK_TOTAL) ? size : USBH_BULK_TOTAL;
+  if (phase == USBH_PHASE_OUT) {
+    for (i = 0U; i < size; i++) {
+      xfer_buf[i] = (uint8_t)i;
+    }
+  }
+  if (USBH_PhaseStart(phase, total, size) == 0U) {
+    return USBH_PHASE_SKIPPED;
+  }
+
+  bytes   = 0U;
+  errors  = 0U;
+  lat_cnt = 0U;
+  naks    = nak_cnt[pipe];
+  USBH_FrameStart();
+  tick_start = GET_SYSTICK();
+  tick_end   = tick_start;
+  while (bytes < total) {
+    len = total - bytes;
+    if (len > size) { len = size; }
+    if (phase == USBH_PHASE_IN) {
+      /* Device sends the same pattern in every transfer: invalidate the last byte */
+      xfer_buf[len - 1U] = (uint8_t)~(len - 1U);
+    }
+    tick = GET_SYSTICK();
+    ret  = USBH_Xfer(pipe, packet, xfer_buf, len, &num);
+    if (ret != USBH_RES_OK) {
+      (void)snprintf(str, sizeof(str), "[FAILED] Bulk %s transfer %s after %d bytes", (phase == USBH_PHASE_IN) ? "IN" : "OUT",
+                     (ret == USBH_RES_TIMEOUT) ? "timeout" : ((ret == USBH_RES_STALL) ? "stalled" : "error"), bytes + num);
+      TEST_FAIL_MESSAGE(str);
+      return errors + 1U;
+    }
+    if (lat_cnt < USBH_LATENCY_NUM) {
+      lat_buf[lat_cnt++] = PipeTick[pipe] - tick;
+    }
+    if ((num != len) || ((phase == USBH_PHASE_IN) && (xfer_buf[len - 1U] != (uint8_t)(len - 1U)))) {
+      errors++;
+    }
+    bytes   += num;
+    tick_end = PipeTick[pipe];
+    (void)USBH_FrameCount();
+  }
+  frames  = USBH_FrameCount();
+  time_us = (uint32_t)(((uint64_t)(tick_end - tick_start) * 1000000U) / SYSTICK_MICROSEC(1000000U));
+
+  if (USBH_PhaseResult(&dev_errors, &dev_bytes) == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Test device did not report the phase result");
+    return errors + 1U;
+  }
+  if ((dev_errors != 0U) || (dev_bytes != bytes)) {
+    errors++;
+  }
+
+  (void)snprintf(str, sizeof(str), "[INFO] Bulk %s, %d bytes/transfer: %d frames, %d%% bus efficiency, %d NAK, %d errors",
+                 (phase == USBH_PHASE_IN) ? "IN" : "OUT", size, frames,
+                 (frames  != 0U) ? (uint32_t)(((uint64_t)bytes * 100U) / ((uint64_t)frames * USBH_BulkMaxPerFrame())) : 0U,
+                 nak_cnt[pipe] - naks, errors);
+  TEST_MESSAGE(str);
+  (void)snprintf(str, sizeof(str), "bulk_%s_%d", (phase == USBH_PHASE_IN) ? "in" : "out", size);
+  TEST_METRIC_HIGHER(str, (time_us != 0U) ? (((uint64_t)bytes * 1000U) / time_us) : 0U, "kB/s", METRIC_NO_THRESHOLD);
+  TEST_PERCENTILES("Transfer latency", lat_buf, lat_cnt, SYSTICK_MICROSEC(1000000U));
+  return errors;
+}
+
+/*
+  \fn            static uint32_t USBH_MultiPhase (void)
+  \brief         Keep transfers active on the bulk OUT, bulk IN and interrupt IN pipes concurrently and report the results.
+  \return        number of host and device side errors, USBH_PHASE_SKIPPED if the test device does not support the phase
+*/
+static uint32_t USBH_MultiPhase (void) {
+  static const char *const pipe_name[USBH_PIPE_NUM] = { "", "Bulk OUT", "Bulk IN", "Interrupt IN" };
+  static const char *const pipe_met[USBH_PIPE_NUM]  = { "", "bulk_out", "bulk_in", "int_in" };
+  uint8_t  *buf[USBH_PIPE_NUM];
+  uint32_t  len[USBH_PIPE_NUM], off[USBH_PIPE_NUM], bytes[USBH_PIPE_NUM], xfers[USBH_PIPE_NUM];
+  uint32_t  tick_xfer[USBH_PIPE_NUM], lat_cnt[USBH_PIPE_NUM], naks[USBH_PIPE_NUM];
+  uint32_t  p, i, evt, active, errors, frames, time_us, late, interval, start, duration, dev_errors, dev_bytes;
+
+  buf[USBH_PIPE_BULK_OUT] = &xfer_buf[0];
+  buf[USBH_PIPE_BULK_IN]  = &xfer_buf[USBH_MULTI_BULK_SIZE];
+  buf[USBH_PIPE_INT_IN]   = &xfer_buf[2U * USBH_MULTI_BULK_SIZE];
+  len[USBH_PIPE_BULK_OUT] = USBH_MULTI_BULK_SIZE;
+  len[USBH_PIPE_BULK_IN]  = USBH_MULTI_BULK_SIZE;
+  len[USBH_PIPE_INT_IN]   = ep_info[USBH_PIPE_INT_IN].mps;
+  for (i = 0U; i < USBH_MULTI_BULK_SIZE; i++) {
+    xfer_buf[i] = (uint8_t)i;
+  }
+  if (USBH_PhaseStart(USBH_PHASE_MULTI, USBH_MULTI_DURATION, USBH_MASK_BULK_OUT | USBH_MASK_BULK_IN | USBH_MASK_INT_IN) == 0U) {
+    return USBH_PHASE_SKIPPED;
+  }
+
+  errors = 0U;
+  late   = 0U;
+  active = 0U;
+  for (p = USBH_PIPE_BULK_OUT; p < USBH_PIPE_ISO_IN; p++) {
+    off[p]     = 0U;
+    bytes[p]   = 0U;
+    xfers[p]   = 0U;
+    lat_cnt[p] = 0U;
+    naks[p]    = nak_cnt[p];
+  }
+  interval = USBH_IntervalUs();
+  USBH_FrameStart();
+  duration = (uint32_t)(((uint64_t)USBH_MULTI_DURATION * osKernelGetTickFreq()) / 1000U);
+  start    = osKernelGetTickCount();
+  for (p = USBH_PIPE_BULK_OUT; p < USBH_PIPE_ISO_IN; p++) {
+    tick_xfer[p] = GET_SYSTICK();
+    if (USBH_XferStart(p, (p == USBH_PIPE_BULK_OUT) ? ARM_USBH_PACKET_OUT : ARM_USBH_PACKET_IN, buf[p], len[p]) == ARM_DRIVER_OK) {
+      active |= 1U << p;
+    } else {
+      errors++;
+    }
+  }
+
+  while ((active != 0U) && ((osKernelGetTickCount() - start) < duration)) {
+    for (p = USBH_PIPE_BULK_OUT; p < USBH_PIPE_ISO_IN; p++) {
+      evt = PipeEvt[p];
+      if (((active & (1U << p)) == 0U) || (evt == 0U)) {
+        continue;
+      }
+      if ((evt & ARM_USBH_EVENT_TRANSFER_COMPLETE) != 0U) {
+        bytes[p] += drv->PipeTransferGetResult(PipeHndl[p]);
+        xfers[p]++;
+        if (lat_cnt[p] < USBH_LATENCY_NUM) {
+          /* Interrupt pipe: period between transfers, bulk pipes: transfer latency */
+          if ((p != USBH_PIPE_INT_IN) || (xfers[p] > 1U)) {
+            lat_buf[(p * USBH_LATENCY_NUM) + lat_cnt[p]++] = PipeTick[p] - tick_xfer[p];
+          }
+        }
+        if ((p == USBH_PIPE_INT_IN) && (xfers[p] > 1U) &&
+            ((PipeTick[p] - tick_xfer[p]) > SYSTICK_MICROSEC((3U * interval) / 2U))) {
+          late++;
+        }
+        off[p]       = 0U;
+        tick_xfer[p] = (p == USBH_PIPE_INT_IN) ? PipeTick[p] : GET_SYSTICK();
+      } else if ((evt & ARM_USBH_EVENT_HANDSHAKE_NAK) != 0U) {
+        /* Continue with the remaining data */
+        nak_cnt[p]++;
+        i         = drv->PipeTransferGetResult(PipeHndl[p]);
+        off[p]   += i;
+        bytes[p] += i;
+      } else {
+        errors++;
+        active &= ~(1U << p);
+        continue;
+      }
+      if (USBH_XferStart(p, (p == USBH_PIPE_BULK_OUT) ? ARM_USBH_PACKET_OUT : ARM_USBH_PACKET_IN, &buf[p][off[p]], len[p] - off[p]) != ARM_DRIVER_OK) {
+        errors++;
+        active &= ~(1U << p);
+      }
+    }
+    (void)USBH_FrameCount();
+  }
+  time_us = (uint32_t)(((uint64_t)(osKernelGetTickCount() - start) * 1000000U) / osKernelGetTickFreq());
+  frames  = USBH_FrameCount();
+
+  /* Duration expired: abort transfers still in progress */
+  for (p = USBH_PIPE_BULK_OUT; p < USBH_PIPE_ISO_IN; p++) {
+    if ((active & (1U << p)) != 0U) {
+      (void)drv->PipeTransferAbort(PipeHndl[p]);
+    }
+  }
+  if (USBH_PhaseResult(&dev_errors, &dev_bytes) == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Test device did not report the phase result");
+    return errors + 1U;
+  }
+  errors += dev_errors;
+
+  (void)snprintf(str, sizeof(str), "[INFO] Multiple pipes, %d ms: %d frames, %d%% bus efficiency (bulk), %d errors",
+                 time_us / 1000U, frames,
+                 (frames != 0U) ? (uint32_t)(((uint64_t)(bytes[USBH_PIPE_BULK_OUT] + bytes[USBH_PIPE_BULK_IN]) * 100U) /
+                                             ((uint64_t)frames * USBH_BulkMaxPerFrame())) : 0U,
+                 errors);
+  TEST_MESSAGE(str);
+  for (p = USBH_PIPE_BULK_OUT; p < USBH_PIPE_ISO_IN; p++) {
+    (void)snprintf(str, sizeof(str), "[INFO]   %s (0x%02X): %d transfers, %d NAK",
+                   pipe_name[p], ep_info[p].addr, xfers[p], nak_cnt[p] - naks[p]);
+    TEST_MESSAGE(str);
+    TEST_METRIC_HIGHER(pipe_met[p], (time_us != 0U) ? (((uint64_t)bytes[p] * 1000U) / time_us) : 0U, "kB/s", METRIC_NO_THRESHOLD);
+    if (p == USBH_PIPE_INT_IN) {
+      (void)snprintf(str, sizeof(str), "[INFO]   %d%% of %d us polling intervals served, %d late",
+                     (time_us != 0U) ? (uint32_t)(((uint64_t)xfers[p] * interval * 100U) / time_us) : 0U, interval, late);
+      TEST_MESSAGE(str);
+      TEST_PERCENTILES("Polling period",   &lat_buf[p * USBH_LATENCY_NUM], lat_cnt[p], SYSTICK_MICROSEC(1000000U));
+    } else {
+      TEST_PERCENTILES("Transfer latency", &lat_buf[p * USBH_LATENCY_NUM], lat_cnt[p], SYSTICK_MICROSEC(1000000U));
+    }
+  }
+  if (xfers[USBH_PIPE_INT_IN] == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] No interrupt IN transfer completed");
+    errors++;
+  }
+  return errors;
+}
+
+
+// Start transfer of one packet on isochronous stream n (OUT packets carry the sequence number in the first 4 bytes)
+static int32_t USBH_IsoXfer (uint32_t n) {
+
+  if (n == USBH_ISO_STREAM_OUT) {
+    USBH_PutU32(&xfer_buf[USBH_ISO_BUF_OFFS], iso[n].seq);
+    return USBH_XferStart(USBH_PIPE_ISO_OUT, ARM_USBH_PACKET_OUT, &xfer_buf[USBH_ISO_BUF_OFFS], USBH_ISO_PACKET_SIZE);
+  }
+  return USBH_XferStart(USBH_PIPE_ISO_IN, ARM_USBH_PACKET_IN, &xfer_buf[0], ep_info[USBH_PIPE_ISO_IN].mps);
+}
+
+// Update isochronous stream statistics with a completed packet (timestamp, SOF number, size and sequence number)
+static void USBH_IsoPacket (USBH_ISO_STREAM *st, uint32_t in, uint32_t tick, uint16_t frame, uint32_t num, uint32_t seq) {
+  uint32_t period, dev_us;
+
+  st->packets++;
+  st->bytes += num;
+  if (in != 0U) {
+    /* Empty IN packets are device underruns, sequence number gaps are packets lost by the host.
+       Empty packets before the first and after the last sequenced packet are outside the device phase. */
+    if (num < 4U) {
+      st->empty_pend += st->synced;
+    } else {
+      if ((st->synced != 0U) && (seq > st->seq)) {
+        st->lost += seq - st->seq;
+      }
+      st->seq         = seq + 1U;
+      st->empty      += st->empty_pend;
+      st->empty_pend  = 0U;
+      st->synced      = 1U;
+    }
+  }
+  if (st->packets > 1U) {
+    period = tick - st->tick_last;
+    if (period < st->period_min) {
+      st->period_min = period;
+    }
+    if (period > st->period_max) {
+      st->period_max = period;
+      st->gap_frame  = frame;
+      st->gap_packet = st->packets - 1U;
+    }
+    if (period > ((3U * iso_period) / 2U)) {
+      /* (Micro)frames without a queued transfer */
+      st->missed += ((period + (iso_period / 2U)) / iso_period) - 1U;
+    }
+    dev_us = (period > iso_period) ? (period - iso_period) : (iso_period - period);
+    dev_us = (uint32_t)(((uint64_t)dev_us * 1000000U) / SYSTICK_MICROSEC(1000000U));
+    st->hist[HISTOGRAM_BUCKET(iso_hist_lim, dev_us)]++;
+  }
+  st->tick_last = tick;
+}
+
+// Report statistics of an isochronous stream
+static void USBH_IsoReport (const USBH_ISO_STREAM *st, const char *name, const char *metric, uint8_t ep, uint32_t time_us) {
+  uint64_t ticks_per_s = SYSTICK_MICROSEC(1000000U);
+
+  (void)snprintf(str, sizeof(str), "[INFO]   %s (0x%02X): %d packets, %d kB/s, %d missed (micro)frames, %d empty, %d lost, %d errors",
+                 name, ep, st->packets, (time_us != 0U) ? (uint32_t)(((uint64_t)st->bytes * 1000U) / time_us) : 0U,
+                 st->missed, st->empty, st->lost, st->errors);
+  TEST_MESSAGE(str);
+  (void)snprintf(str, sizeof(str), "%s_missed", metric);
+  TEST_METRIC_LOWER(str, st->missed, "frames", METRIC_NO_THRESHOLD);
+  if (st->packets < 2U) {
+    return;
+  }
+  (void)snprintf(str, sizeof(str), "[INFO]   Packet period min/max %d/%d us, longest at frame %d (packet %d)",
+                 (uint32_t)(((uint64_t)st->period_min * 1000000U) / ticks_per_s),
+                 (uint32_t)(((uint64_t)st->period_max * 1000000U) / ticks_per_s), st->gap_frame, st->gap_packet);
+  TEST_MESSAGE(str);
+  TEST_HISTOGRAM("Period jitter histogram (us)", st->hist, iso_hist_lim);
+  (void)snprintf(str, sizeof(str), "%s_period_max", metric);
+  TEST_METRIC_LOWER(str, ((uint64_t)st->period_max * 1000000U) / ticks_per_s, "us", METRIC_NO_THRESHOLD);
+}
+
+/*
+  \fn            static uint32_t USBH_IsoPhase (void)
+  \brief         Stream one packet every (micro)frame on the isochronous IN and OUT pipes and report the timing.
+  \return        number of host and device side errors, USBH_PHASE_SKIPPED if the test device does not support the phase
+*/
+static uint32_t USBH_IsoPhase (void) {
+  USBH_ISO_STREAM *st;
+  uint32_t n, i, pipe, evt, num, seq, tick, active, errors, start, duration, time_us, dev_errors, dev_bytes;
+
+  for (i = 4U; i < USBH_ISO_PACKET_SIZE; i++) {
+    xfer_buf[USBH_ISO_BUF_OFFS + i] = (uint8_t)i;
+  }
+  memset(iso, 0, sizeof(iso));
+  for (n = 0U; n < USBH_ISO_STREAM_NUM; n++) {
+    iso[n].period_min = 0xFFFFFFFFU;
+  }
+  if (USBH_PhaseStart(USBH_PHASE_ISO, USBH_ISO_DURATION, USBH_ISO_PACKET_SIZE) == 0U) {
+    return USBH_PHASE_SKIPPED;
+  }
+
+  errors     = 0U;
+  active     = 0U;
+  iso_period = (uint32_t)SYSTICK_MICROSEC((dev_speed == ARM_USB_SPEED_HIGH) ? 125U : 1000U);
+  USBH_FrameStart();
+  duration = (uint32_t)(((uint64_t)USBH_ISO_DURATION * osKernelGetTickFreq()) / 1000U);
+  start    = osKernelGetTickCount();
+  for (n = 0U; n < USBH_ISO_STREAM_NUM; n++) {
+    if (USBH_IsoXfer(n) == ARM_DRIVER_OK) {
+      active |= 1U << n;
+    } else {
+      errors++;
+    }
+  }
+
+  while ((active != 0U) && ((osKernelGetTickCount() - start) < duration)) {
+    (void)USBH_FrameCount();
+    for (n = 0U; n < USBH_ISO_STREAM_NUM; n++) {
+      st   = &iso[n];
+      pipe = (n == USBH_ISO_STREAM_IN) ? USBH_PIPE_ISO_IN : USBH_PIPE_ISO_OUT;
+      evt  = PipeEvt[pipe];
+      if (((active & (1U << n)) == 0U) || (evt == 0U)) {
+        continue;
+      }
+      tick = PipeTick[pipe];
+      num  = ((evt & ARM_USBH_EVENT_TRANSFER_COMPLETE) != 0U) ? drv->PipeTransferGetResult(PipeHndl[pipe]) : 0U;
+      seq  = ((n == USBH_ISO_STREAM_IN) && (num >= 4U)) ? USBH_GetU32(&xfer_buf[0]) : 0U;
+      if ((evt & ARM_USBH_EVENT_TRANSFER_COMPLETE) == 0U) {
+        st->errors++;
+      }
+      /* Queue the next packet first, statistics are updated while it is in progress */
+      if (n == USBH_ISO_STREAM_OUT) {
+        st->seq++;
+      }
+      if (USBH_IsoXfer(n) != ARM_DRIVER_OK) {
+        errors++;
+        active &= ~(1U << n);
+      }
+      USBH_IsoPacket(st, (n == USBH_ISO_STREAM_IN) ? 1U : 0U, tick, frame_last, num, seq);
+    }
+  }
+  time_us = (uint32_t)(((uint64_t)(osKernelGetTickCount() - start) * 1000000U) / osKernelGetTickFreq());
+
+  /* Duration expired: abort transfers still in progress */
+  if ((active & (1U << USBH_ISO_STREAM_IN)) != 0U) {
+    (void)drv->PipeTransferAbort(PipeHndl[USBH_PIPE_ISO_IN]);
+  }
+  if ((active & (1U << USBH_ISO_STREAM_OUT)) != 0U) {
+    (void)drv->PipeTransferAbort(PipeHndl[USBH_PIPE_ISO_OUT]);
+  }
+  if (USBH_PhaseResult(&dev_errors, &dev_bytes) == 0U) {
+    TEST_FAIL_MESSAGE("[FAILED] Test device did not report the phase result");
+    return errors + 1U;
+  }
+
+  (void)snprintf(str, sizeof(str), "[INFO] Isochronous, %d bytes/packet, %d ms: %d frames, %d device errors (underruns, overruns)",
+                 USBH_ISO_PACKET_SIZE, time_us / 1000U, USBH_FrameCount(), dev_errors);
+  TEST_MESSAGE(str);
+  USBH_IsoReport(&iso[USBH_ISO_STREAM_IN],  "Isochronous IN",  "iso_in",  ep_info[USBH_PIPE_ISO_IN].addr,  time_us);
+  USBH_IsoReport(&iso[USBH_ISO_STREAM_OUT], "Isochronous OUT", "iso_out", ep_info[USBH_PIPE_ISO_OUT].addr, time_us);
+  /* Underruns (empty IN packets) are counted in the device errors */
+  for (n = 0U; n < USBH_ISO_STREAM_NUM; n++) {
+    errors += iso[n].missed + iso[n].lost + iso[n].errors;
+    if (iso[n].packets == 0U) {
+      errors++;
+    }
+  }
+  return errors + dev_errors;
+}
 
 /*-----------------------------------------------------------------------------
  *      Tests
@@ -61,7 +897,9 @@ static void USB_PipeEvent (ARM_USBH_PIPE_HANDLE pipe_hndl, uint32_t event) {
 \defgroup dv_usbh USB Host Validation
 \brief USB Host driver validation
 \details
-The USB Host validation test checks the API interface compliance only.
+The USB Host validation test checks the API interface compliance and, with the vendor test device of the
+\ref dv_usbd "USB Device validation" connected to the port, pipe data transfer throughput, transfer latency and
+frame scheduling efficiency of bulk and interrupt pipes and the timing of isochronous pipes.
 
 \defgroup usbh_tests Tests
 \ingroup dv_usbh
@@ -167,6 +1005,160 @@ void USBH_PowerControl (void) {
   TEST_ASSERT(drv->Uninitialize() == ARM_DRIVER_OK); 
 }
 
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBH_Bulk_Throughput
+\details
+The test function \b USBH_Bulk_Throughput measures bulk pipe throughput and transfer latency with the test device
+(\ref USBD_Bulk_Throughput test running on a second board). The sequence is:
+ - \b PortVbusOnOff (VBUS on)
+ - Wait for the device, \b PortReset and enumerate it on the default control pipe (\b PipeCreate, \b PipeModify)
+ - Create bulk OUT and bulk IN pipes for the endpoints of the test device
+ - For each transfer size (64, 512, 4096, 16384 and 65536 bytes) up to the \ref usbh_config "Maximum transfer size"
+   execute a bulk OUT and a bulk IN phase of \ref usbh_config "Bytes per phase" with \b PipeTransfer
+ - Report used frames, bus efficiency (bulk payload relative to the maximum bulk payload of the used frames),
+   NAK handshakes and per-transfer latency (\b PipeTransfer call to \b ARM_USBH_EVENT_TRANSFER_COMPLETE) of each phase
+ - Record throughput metric of each phase (kB/s): \c bulk_out_<size> and \c bulk_in_<size>
+ - \b PipeDelete, \b PortVbusOnOff (VBUS off)
+
+The driver is initialized and powered on by the test group fixture (\b USBH_DV_Setup).
+
+Transfer sizes not accepted by the test device are skipped.
+The test fails if no device is connected within the \ref usbh_config "Device timeout", if the device is not the test
+device, if a transfer stalls, fails or times out, or if host and device do not agree on the transferred data.
+*/
+void USBH_Bulk_Throughput (void) {
+  uint32_t i, phase, ret, phases, errors;
+
+  if (USBH_BufAlloc() == 0U) {
+    return;
+  }
+  if (USBH_DeviceAttach() != 0U) {
+    phases = 0U;
+    errors = 0U;
+    for (i = 0U; (i < ARRAY_SIZE(xfer_size)) && (xfer_size[i] <= USBH_XFER_SIZE_MAX) && (errors == 0U); i++) {
+      for (phase = USBH_PHASE_OUT; (phase <= USBH_PHASE_IN) && (errors == 0U); phase++) {
+        ret = USBH_BulkPhase(phase, xfer_size[i]);
+        if (ret == USBH_PHASE_SKIPPED) {
+          (void)snprintf(str, sizeof(str), "[WARNING] Transfer size %d not supported by the test device", xfer_size[i]);
+          TEST_MESSAGE(str);
+          break;
+        }
+        phases++;
+        errors += ret;
+      }
+    }
+    if (phases == 0U) {
+      TEST_FAIL_MESSAGE("[FAILED] Test device accepted no bulk phase");
+    } else {
+      TEST_ASSERT_MESSAGE(errors == 0U, "[FAILED] Bulk transfer size or data errors");
+    }
+  }
+  USBH_DeviceDetach(1U);
+  USBH_BufFree();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBH_Multi_Pipe
+\details
+The test function \b USBH_Multi_Pipe verifies concurrent bulk and interrupt pipe transfers, as used by communication
+device class (CDC) workloads, with the test device (\ref USBD_Multi_Endpoint test running on a second board).
+The sequence is:
+ - Switch on VBUS, enumerate the test device and create bulk OUT, bulk IN and interrupt IN pipes
+   (as in \ref USBH_Bulk_Throughput)
+ - Keep transfers active on all three pipes for the \ref usbh_config "Multiple pipe duration"
+   (\b PipeTransfer restarted from the pipe events)
+ - Report used frames and bus efficiency of the bulk pipes, per pipe transfer count and NAK handshakes,
+   the bulk transfer latency and, for the interrupt pipe, the share of served polling intervals, late transfers
+   (period above 1.5 intervals) and the polling period
+ - Record per pipe throughput metric (kB/s): \c bulk_out, \c bulk_in and \c int_in
+ - \b PipeDelete, \b PortVbusOnOff (VBUS off)
+
+The driver is initialized and powered on by the test group fixture (\b USBH_DV_Setup).
+
+The test fails if the test device is not available, if a transfer stalls or fails, if the device reports errors
+or if no interrupt transfer completed.
+*/
+void USBH_Multi_Pipe (void) {
+  uint32_t ret;
+
+  if (USBH_BufAlloc() == 0U) {
+    return;
+  }
+  if (USBH_DeviceAttach() != 0U) {
+    ret = USBH_MultiPhase();
+    if (ret == USBH_PHASE_SKIPPED) {
+      TEST_FAIL_MESSAGE("[FAILED] Test device does not support concurrent transfers");
+    } else {
+      TEST_ASSERT_MESSAGE(ret == 0U, "[FAILED] Pipe transfer errors");
+    }
+  }
+  USBH_DeviceDetach(1U);
+  USBH_BufFree();
+}
+
+/*=======0=========1=========2=========3=========4=========5=========6=========7=========8=========9=========0=========1====*/
+/**
+\brief  Function: USBH_Isochronous
+\details
+The test function \b USBH_Isochronous verifies the timing of isochronous pipes, as used by audio class workloads,
+with the test device (\ref USBD_Isochronous test running on a second board). The sequence is:
+ - Switch on VBUS and enumerate the test device (as in \ref USBH_Bulk_Throughput)
+ - Select alternate setting 1 of the interface (\b SET_INTERFACE) and create isochronous IN and OUT pipes
+ - Stream fixed-size packets (\ref usbh_config "Isochronous packet size") in both directions for the
+   \ref usbh_config "Isochronous duration", one \b PipeTransfer per packet restarted from the pipe events;
+   OUT packets carry a sequence number, the sequence numbers of IN packets are checked
+ - Record the timestamp and SOF number (\b GetFrameNumber) of every packet and report per pipe the packet count,
+   throughput, missed (micro)frames, empty IN packets between the first and the last sequenced packet (device underruns),
+   lost IN packets, the shortest and longest packet period with its SOF number and a histogram of the period jitter,
+   together with the underruns and overruns counted by the test device
+ - Record metrics \c iso_in_missed and \c iso_out_missed (missed (micro)frames) and \c iso_in_period_max and
+   \c iso_out_period_max (longest packet period in us)
+ - \b PipeDelete, \b PortVbusOnOff (VBUS off)
+
+The driver is initialized and powered on by the test group fixture (\b USBH_DV_Setup).
+
+The test fails if the test device is not available or has no isochronous endpoints, if a (micro)frame was missed,
+if a packet was lost or terminated with an error on either side or if the test device reports underruns or overruns.
+*/
+void USBH_Isochronous (void) {
+  uint32_t i, ret;
+
+  if (USBH_BufAlloc() == 0U) {
+    return;
+  }
+  if (USBH_DeviceAttach() != 0U) {
+    ret = 0U;
+    if ((ep_info[USBH_PIPE_ISO_IN].mps == 0U) || (ep_info[USBH_PIPE_ISO_OUT].mps == 0U)) {
+      TEST_FAIL_MESSAGE("[FAILED] Test device has no isochronous endpoints");
+    } else if (USBH_Control(0x01U, 11U, 1U, 0U, NULL, 0U) != 0) {
+      TEST_FAIL_MESSAGE("[FAILED] SET_INTERFACE (alternate setting 1) failed");
+    } else {
+      ret = 1U;
+      for (i = USBH_PIPE_ISO_IN; i < USBH_PIPE_NUM; i++) {
+        PipeHndl[i] = drv->PipeCreate(USBH_DEV_ADDR, dev_speed, 0U, 0U, ep_info[i].addr, ARM_USB_ENDPOINT_ISOCHRONOUS,
+                                      ep_info[i].mps, ep_info[i].interval);
+        if (PipeHndl[i] == 0U) {
+          (void)snprintf(str, sizeof(str), "[FAILED] PipeCreate for endpoint 0x%02X failed", ep_info[i].addr);
+          TEST_FAIL_MESSAGE(str);
+          ret = 0U;
+        }
+      }
+    }
+    if (ret != 0U) {
+      ret = USBH_IsoPhase();
+      if (ret == USBH_PHASE_SKIPPED) {
+        TEST_FAIL_MESSAGE("[FAILED] Test device does not support the isochronous packet size");
+      } else {
+        TEST_ASSERT_MESSAGE(ret == 0U, "[FAILED] Isochronous missed frames, underruns, overruns or errors");
+      }
+    }
+  }
+  USBH_DeviceDetach(1U);
+  USBH_BufFree();
+}
+
 /**
 @}
 */ 
@@ -3018,6 +3018,22 @@ static void station_uninit (void) {
   powered = 0U;
 }
 
+/* Helper function that connects Station once for all socket tests */
+void WIFI_DV_Setup (void) {
+
+  if (socket_funcs_exist != 0U) {
+    station_init (1);
+  }
+}
+
+/* Helper function that disconnects Station after socket tests */
+void WIFI_DV_Teardown (void) {
+
+  if (powered != 0U) {
+    station_uninit ();
+  }
+}
+
 /* Helper function for execution of socket test function in the worker thread */
 static int32_t th_execute (osThreadId_t *id, uint32_t sig, uint32_t tout) {
   osThreadFlagsSet (id, sig);
@@ -8778,13 +8794,13 @@ The test function \b WIFI_Test_Speed tests data transfer speed.
 Stream socket test:
  - Create stream socket
  - Transfer for 4 seconds, send and receive
- - Calculate transfer rate
+ - Calculate transfer rate and check it against minimum (\b WIFI_TEST_SPEED_MIN)
  - Close socket
 
 Datagram socket test:
  - Create datagram socket
  - Transfer for 4 seconds, send and receive
- - Calculate transfer rate
+ - Calculate transfer rate and check it against minimum (\b WIFI_TEST_SPEED_MIN)
  - Close socket
 */
 void WIFI_Test_Speed (void) {
@@ -8832,10 +8848,7 @@ void WIFI_Test_Speed (void) {
       else           break;
     } while (GET_SYSTICK() - ticks < tout);
     /* Check transfer rate */
-    if (n_bytes < 10000) {
-      snprintf(msg_buf, sizeof(msg_buf), "[WARNING] Slow Transfer rate (%d KB/s)", n_bytes / 2048);
-      TEST_MESSAGE(msg_buf);
-    }
+    TEST_METRIC_HIGHER("stream_speed", n_bytes / 2048, "KB/s", (WIFI_TEST_SPEED_MIN != 0) ? WIFI_TEST_SPEED_MIN : METRIC_NO_THRESHOLD);
 
     /* Close stream socket */
     io.sock = sock;
@@ -8869,10 +8882,7 @@ void WIFI_Test_Speed (void) {
       else           break;
     } while (GET_SYSTICK() - ticks < tout);
     /* Check transfer rate */
-    if (n_bytes < 10000) {
-      snprintf(msg_buf, sizeof(msg_buf), "[WARNING] Slow Transfer rate (%d KB/s)", n_bytes / 2048);
-      TEST_MESSAGE(msg_buf);
-    }
+    TEST_METRIC_HIGHER("datagram_speed", n_bytes / 2048, "KB/s", (WIFI_TEST_SPEED_MIN != 0) ? WIFI_TEST_SPEED_MIN : METRIC_NO_THRESHOLD);
 
     /* Close datagram socket */
     io.sock = sock;
@@ -9263,8 +9273,7 @@ void WIFI_Downstream_Rate (void) {
       TEST_ASSERT_MESSAGE(0,msg_buf);
     }
     else if (rval != 0) {
-      snprintf(msg_buf, sizeof(msg_buf), "[INFO] Speed %d KB/s", io.rc/4096);
-      TEST_MESSAGE(msg_buf);
+      TEST_METRIC_HIGHER("downstream_rate", io.rc/4096, "KB/s", (WIFI_DOWNSTREAM_RATE_MIN != 0) ? WIFI_DOWNSTREAM_RATE_MIN : METRIC_NO_THRESHOLD);
     }
 
     /* Close stream socket */
@@ -9331,8 +9340,7 @@ void WIFI_Upstream_Rate (void) {
       TEST_ASSERT_MESSAGE(0,msg_buf);
     }
     else if (rval != 0) {
-      snprintf(msg_buf, sizeof(msg_buf), "[INFO] Speed %d KB/s", io.rc/4096);
-      TEST_MESSAGE(msg_buf);
+      TEST_METRIC_HIGHER("upstream_rate", io.rc/4096, "KB/s", (WIFI_UPSTREAM_RATE_MIN != 0) ? WIFI_UPSTREAM_RATE_MIN : METRIC_NO_THRESHOLD);
     }
 
     /* Close stream socket */
@@ -24,6 +24,7 @@
  */
 
 #include "cmsis_dv.h"
+#include "DV_Config.h"
 #ifdef  RTE_CMSIS_DV_SPI
 #include "DV_SPI_Config.h"
 #endif
@@ -79,6 +80,58 @@ static void TS_Init_ETH (void) {
 static void TS_Uninit_ETH (void) {
   ETH_DV_Uninitialize ();
 }
+static void TS_Setup_ETH (void) {
+  ETH_DV_Setup ();
+}
+static void TS_Teardown_ETH (void) {
+  ETH_DV_Teardown ();
+}
+#endif
+#ifdef  RTE_CMSIS_DV_I2C
+static void TS_Init_I2C (void) {
+  I2C_DV_Initialize ();
+}
+static void TS_Uninit_I2C (void) {
+  I2C_DV_Uninitialize ();
+}
+static void TS_Setup_I2C (void) {
+  I2C_DV_Setup ();
+}
+static void TS_Teardown_I2C (void) {
+  I2C_DV_Teardown ();
+}
+#endif
+#ifdef  RTE_CMSIS_DV_MCI
+static void TS_Setup_MCI (void) {
+  MCI_DV_Setup ();
+}
+static void TS_Teardown_MCI (void) {
+  MCI_DV_Teardown ();
+}
+#endif
+#ifdef  RTE_CMSIS_DV_USBD
+static void TS_Setup_USBD (void) {
+  USBD_DV_Setup ();
+}
+static void TS_Teardown_USBD (void) {
+  USBD_DV_Teardown ();
+}
+#endif
+#ifdef  RTE_CMSIS_DV_USBH
+static void TS_Setup_USBH (void) {
+  USBH_DV_Setup ();
+}
+static void TS_Teardown_USBH (void) {
+  USBH_DV_Teardown ();
+}
+#endif
+#ifdef  RTE_CMSIS_DV_CAN
+static void TS_Setup_CAN (void) {
+  CAN_DV_Setup ();
+}
+static void TS_Teardown_CAN (void) {
+  CAN_DV_Teardown ();
+}
 #endif
 #ifdef  RTE_CMSIS_DV_WIFI
 static void TS_Init_WiFi (void) {
@@ -87,6 +140,12 @@ static void TS_Init_WiFi (void) {
 static void TS_Uninit_WiFi (void) {
   WIFI_DV_Uninitialize ();
 }
+static void TS_Setup_WiFi (void) {
+  WIFI_DV_Setup ();
+}
+static void TS_Teardown_WiFi (void) {
+  WIFI_DV_Teardown ();
+}
 #endif
 
 /*-----------------------------------------------------------------------------
@@ -266,9 +325,9 @@ static TEST_CASE TC_List_ETH[] = {
   TCD ( ETH_MAC_SetBusSpeed,            ETH_MAC_SET_BUS_SPEED_EN        ),
   TCD ( ETH_MAC_Config_Mode,            ETH_MAC_CONFIG_MODE_EN          ),
   TCD ( ETH_MAC_Config_CommonParams,    ETH_MAC_CONFIG_COMMON_PARAMS_EN ),
-  TCD ( ETH_MAC_Control_Filtering,      ETH_MAC_CONTROL_FILTERING_EN    ),
-  TCD ( ETH_MAC_SetAddressFilter,       ETH_MAC_SET_ADDRESS_FILTER_EN   ),
-  TCD ( ETH_MAC_SignalEvent,            ETH_MAC_SIGNAL_EVENT_EN         ),
+  TCF ( ETH_MAC_Control_Filtering,      ETH_MAC_CONTROL_FILTERING_EN    ),
+  TCF ( ETH_MAC_SetAddressFilter,       ETH_MAC_SET_ADDRESS_FILTER_EN   ),
+  TCF ( ETH_MAC_SignalEvent,            ETH_MAC_SIGNAL_EVENT_EN         ),
   TCD ( ETH_MAC_PTP_ControlTimer,       ETH_MAC_PTP_CONTROL_TIMER_EN    ),
   TCD ( ETH_MAC_CheckInvalidInit,       ETH_MAC_CHECK_INVALID_INIT_EN   ),
   TCD ( ETH_PHY_GetVersion,             ETH_PHY_GET_VERSION_EN          ),
@@ -276,9 +335,9 @@ static TEST_CASE TC_List_ETH[] = {
   TCD ( ETH_PHY_PowerControl,           ETH_PHY_POWER_CONTROL_EN        ),
   TCD ( ETH_PHY_Config,                 ETH_PHY_CONFIG_EN               ),
   TCD ( ETH_PHY_CheckInvalidInit,       ETH_PHY_CHECK_INVALID_INIT_EN   ),
-  TCD ( ETH_Loopback_Transfer,          ETH_LOOPBACK_TRANSFER_EN        ),
-  TCD ( ETH_Loopback_PTP,               ETH_LOOPBACK_PTP_EN             ),
-  TCD ( ETH_Loopback_External,          ETH_LOOPBACK_EXTERNAL_EN        ),
+  TCF ( ETH_Loopback_Transfer,          ETH_LOOPBACK_TRANSFER_EN        ),
+  TCF ( ETH_Loopback_PTP,               ETH_LOOPBACK_PTP_EN             ),
+  TCF ( ETH_Loopback_External,          ETH_LOOPBACK_EXTERNAL_EN        ),
 };
 #endif
 
@@ -292,6 +351,18 @@ static TEST_CASE TC_List_I2C[] = {
   TCD ( I2C_BusClear,                   I2C_BUSCLEAR_EN                 ),
   TCD ( I2C_AbortTransfer,              I2C_ABORTTRANSFER_EN            ),
   TCD ( I2C_CheckInvalidInit,           I2C_CHECKINVALIDINIT_EN         ),
+  TCF ( I2C_MasterTransmit_7Bit,        I2C_MASTERTRANSMIT_7BIT_EN      ),
+  TCF ( I2C_MasterReceive_7Bit,         I2C_MASTERRECEIVE_7BIT_EN       ),
+  TCF ( I2C_MasterTransmit_10Bit,       I2C_MASTERTRANSMIT_10BIT_EN     ),
+  TCF ( I2C_MasterReceive_10Bit,        I2C_MASTERRECEIVE_10BIT_EN      ),
+  TCF ( I2C_MasterRepeatedStart,        I2C_MASTERREPEATEDSTART_EN      ),
+  TCF ( I2C_SlaveTransmit,              I2C_SLAVETRANSMIT_EN            ),
+  TCF ( I2C_SlaveReceive,               I2C_SLAVERECEIVE_EN             ),
+  TCF ( I2C_BusSpeed_Standard,          I2C_BUSSPEED_STANDARD_EN        ),
+  TCF ( I2C_BusSpeed_Fast,              I2C_BUSSPEED_FAST_EN            ),
+  TCF ( I2C_BusSpeed_FastPlus,          I2C_BUSSPEED_FASTPLUS_EN        ),
+  TCF ( I2C_BusSpeed_High,              I2C_BUSSPEED_HIGH_EN            ),
+  TCF ( I2C_Throughput,                 I2C_THROUGHPUT_EN               ),
 };
 #endif
 
@@ -305,24 +376,51 @@ static TEST_CASE TC_List_MCI[] = {
   TCD ( MCI_Config_CmdLineMode,         MCI_CONFIG_CMDLINEMODE_EN       ),
   TCD ( MCI_Config_DriverStrength,      MCI_CONFIG_DRIVERSTRENGTH_EN    ),
   TCD ( MCI_CheckInvalidInit,           MCI_CHECKINVALIDINIT_EN         ),
+  /*    MCI Data transfer tests */
+  #if ( MCI_DATA_EN != 0)
+  TCF ( MCI_Card_Initialize,            MCI_CARD_INITIALIZE_EN          ),
+  TCF ( MCI_ReadWrite_Verify,           MCI_READWRITE_VERIFY_EN         ),
+  TCF ( MCI_Throughput_Read,            MCI_THROUGHPUT_READ_EN          ),
+  TCF ( MCI_Throughput_Write,           MCI_THROUGHPUT_WRITE_EN         ),
+  TCF ( MCI_Latency_Profile,            MCI_LATENCY_PROFILE_EN          ),
+  #endif
 };
 #endif
 
 #ifdef  RTE_CMSIS_DV_USBD
+/* Timeout (in seconds) of tests with configured duration: duration + default timeout */
+#define USBD_ISOCHRONOUS_TIMEOUT  ((USBD_ISO_DURATION_MAX / 1000U) + DV_TEST_TIMEOUT)
+
 static TEST_CASE TC_List_USBD[] = {
   TCD ( USBD_GetCapabilities,           USBD_GETCAPABILITIES_EN         ),
   TCD ( USBD_Initialization,            USBD_INITIALIZATION_EN          ),
   TCD ( USBD_PowerControl,              USBD_POWERCONTROL_EN            ),
   TCD ( USBD_CheckInvalidInit,          USBD_CHECKINVALIDINIT_EN        ),
+  /*    USBD Data transfer tests */
+  #if ( USBD_DATA_EN != 0)
+  TCF ( USBD_Bulk_Throughput,           USBD_BULK_THROUGHPUT_EN         ),
+  TCF ( USBD_Multi_Endpoint,            USBD_MULTI_ENDPOINT_EN          ),
+  TCFT( USBD_Isochronous,               USBD_ISOCHRONOUS_EN,            USBD_ISOCHRONOUS_TIMEOUT ),
+  #endif
 };
 #endif
 
 #ifdef  RTE_CMSIS_DV_USBH
+/* Timeout (in seconds) of tests with configured duration: duration + default timeout */
+#define USBH_MULTI_PIPE_TIMEOUT   ((USBH_MULTI_DURATION   / 1000U) + DV_TEST_TIMEOUT)
+#define USBH_ISOCHRONOUS_TIMEOUT  ((USBH_ISO_DURATION     / 1000U) + DV_TEST_TIMEOUT)
+
 static TEST_CASE TC_List_USBH[] = {
   TCD ( USBH_GetCapabilities,           USBH_GETCAPABILITIES_EN         ),
   TCD ( USBH_Initialization,            USBH_INITIALIZATION_EN          ),
   TCD ( USBH_PowerControl,              USBH_POWERCONTROL_EN            ),
   TCD ( USBH_CheckInvalidInit,          USBH_CHECKINVALIDINIT_EN        ),
+  /*    USBH Data transfer tests */
+  #if ( USBH_DATA_EN != 0)
+  TCF ( USBH_Bulk_Throughput,           USBH_BULK_THROUGHPUT_EN         ),
+  TCFT( USBH_Multi_Pipe,                USBH_MULTI_PIPE_EN,             USBH_MULTI_PIPE_TIMEOUT  ),
+  TCFT( USBH_Isochronous,               USBH_ISOCHRONOUS_EN,            USBH_ISOCHRONOUS_TIMEOUT ),
+  #endif
 };
 #endif
 
@@ -331,10 +429,19 @@ static TEST_CASE TC_List_CAN[] = {
   TCD ( CAN_GetCapabilities,            CAN_GETCAPABILITIES_EN          ),
   TCD ( CAN_Initialization,             CAN_INITIALIZATION_EN           ),
   TCD ( CAN_PowerControl,               CAN_POWERCONTROL_EN             ),
-  TCD ( CAN_Loopback_CheckBitrate,      CAN_LOOPBACK_CHECK_BR_EN        ),
-  TCD ( CAN_Loopback_CheckBitrateFD,    CAN_LOOPBACK_CHECK_BR_FD_EN     ),
-  TCD ( CAN_Loopback_Transfer,          CAN_LOOPBACK_TRANSFER_EN        ),
-  TCD ( CAN_Loopback_TransferFD,        CAN_LOOPBACK_TRANSFER_FD_EN     ),
+  TCF ( CAN_Loopback_CheckBitrate,      CAN_LOOPBACK_CHECK_BR_EN        ),
+  TCF ( CAN_Loopback_CheckBitrateFD,    CAN_LOOPBACK_CHECK_BR_FD_EN     ),
+  TCF ( CAN_Loopback_Transfer,          CAN_LOOPBACK_TRANSFER_EN        ),
+  TCF ( CAN_Loopback_TransferFD,        CAN_LOOPBACK_TRANSFER_FD_EN     ),
+  TCF ( CAN_Loopback_BusLoad,           CAN_LOOPBACK_BUS_LOAD_EN        ),
+  TCF ( CAN_Loopback_BusLoadFD,         CAN_LOOPBACK_BUS_LOAD_FD_EN     ),
+  TCF ( CAN_Loopback_MultiObject,       CAN_LOOPBACK_MULTI_OBJ_EN       ),
+  TCF ( CAN_Loopback_Burst,             CAN_LOOPBACK_BURST_EN           ),
+  TCF ( CAN_Loopback_Latency,           CAN_LOOPBACK_LATENCY_EN         ),
+  TCF ( CAN_Loopback_LatencyFD,         CAN_LOOPBACK_LATENCY_FD_EN      ),
+  TCF ( CAN_Loopback_FilterScaling,     CAN_LOOPBACK_FILTER_SCALING_EN  ),
+  TCD ( CAN_ErrorRecovery,              CAN_ERROR_RECOVERY_EN           ),
+  TCF ( CAN_Loopback_ThroughputFD,      CAN_LOOPBACK_THROUGHPUT_FD_EN   ),
 };
 #endif
 
@@ -368,37 +475,37 @@ static TEST_CASE TC_List_WiFi[] = {
   #endif
   /*    WiFi Socket API tests */
   #if ( WIFI_SOCKET_EN != 0)
-  TCD ( WIFI_SocketCreate,              WIFI_SOCKETCREATE_EN            ),
-  TCD ( WIFI_SocketBind,                WIFI_SOCKETBIND_EN              ),
-  TCD ( WIFI_SocketListen,              WIFI_SOCKETLISTEN_EN            ),
-  TCD ( WIFI_SocketAccept,              WIFI_SOCKETACCEPT_EN            ),
-  TCD ( WIFI_SocketAccept_nbio,         WIFI_SOCKETACCEPT_NBIO_EN       ),
-  TCD ( WIFI_SocketConnect,             WIFI_SOCKETCONNECT_EN           ),
-  TCD ( WIFI_SocketConnect_nbio,        WIFI_SOCKETCONNECT_NBIO_EN      ),
-  TCD ( WIFI_SocketRecv,                WIFI_SOCKETRECV_EN              ),
-  TCD ( WIFI_SocketRecv_nbio,           WIFI_SOCKETRECV_NBIO_EN         ),
-  TCD ( WIFI_SocketRecvFrom,            WIFI_SOCKETRECVFROM_EN          ),
-  TCD ( WIFI_SocketRecvFrom_nbio,       WIFI_SOCKETRECVFROM_NBIO_EN     ),
-  TCD ( WIFI_SocketSend,                WIFI_SOCKETSEND_EN              ),
-  TCD ( WIFI_SocketSendTo,              WIFI_SOCKETSENDTO_EN            ),
-  TCD ( WIFI_SocketGetSockName,         WIFI_SOCKETGETSOCKNAME_EN       ),
-  TCD ( WIFI_SocketGetPeerName,         WIFI_SOCKETGETPEERNAME_EN       ),
-  TCD ( WIFI_SocketGetOpt,              WIFI_SOCKETGETOPT_EN            ),
-  TCD ( WIFI_SocketSetOpt,              WIFI_SOCKETSETOPT_EN            ),
-  TCD ( WIFI_SocketClose,               WIFI_SOCKETCLOSE_EN             ),
-  TCD ( WIFI_SocketGetHostByName,       WIFI_SOCKETGETHOSTBYNAME_EN     ),
-  TCD ( WIFI_Ping,                      WIFI_PING_EN                    ),
+  TCF ( WIFI_SocketCreate,              WIFI_SOCKETCREATE_EN            ),
+  TCF ( WIFI_SocketBind,                WIFI_SOCKETBIND_EN              ),
+  TCF ( WIFI_SocketListen,              WIFI_SOCKETLISTEN_EN            ),
+  TCF ( WIFI_SocketAccept,              WIFI_SOCKETACCEPT_EN            ),
+  TCF ( WIFI_SocketAccept_nbio,         WIFI_SOCKETACCEPT_NBIO_EN       ),
+  TCF ( WIFI_SocketConnect,             WIFI_SOCKETCONNECT_EN           ),
+  TCF ( WIFI_SocketConnect_nbio,        WIFI_SOCKETCONNECT_NBIO_EN      ),
+  TCF ( WIFI_SocketRecv,                WIFI_SOCKETRECV_EN              ),
+  TCF ( WIFI_SocketRecv_nbio,           WIFI_SOCKETRECV_NBIO_EN         ),
+  TCF ( WIFI_SocketRecvFrom,            WIFI_SOCKETRECVFROM_EN          ),
+  TCF ( WIFI_SocketRecvFrom_nbio,       WIFI_SOCKETRECVFROM_NBIO_EN     ),
+  TCF ( WIFI_SocketSend,                WIFI_SOCKETSEND_EN              ),
+  TCF ( WIFI_SocketSendTo,              WIFI_SOCKETSENDTO_EN            ),
+  TCF ( WIFI_SocketGetSockName,         WIFI_SOCKETGETSOCKNAME_EN       ),
+  TCF ( WIFI_SocketGetPeerName,         WIFI_SOCKETGETPEERNAME_EN       ),
+  TCF ( WIFI_SocketGetOpt,              WIFI_SOCKETGETOPT_EN            ),
+  TCF ( WIFI_SocketSetOpt,              WIFI_SOCKETSETOPT_EN            ),
+  TCF ( WIFI_SocketClose,               WIFI_SOCKETCLOSE_EN             ),
+  TCF ( WIFI_SocketGetHostByName,       WIFI_SOCKETGETHOSTBYNAME_EN     ),
+  TCF ( WIFI_Ping,                      WIFI_PING_EN                    ),
   #endif
   /*    WiFi Socket Operation tests */
   #if ( WIFI_SOCKET_OP_EN != 0)
-  TCD ( WIFI_Transfer_Fixed,            WIFI_TRANSFER_FIXED_EN          ),
-  TCD ( WIFI_Transfer_Incremental,      WIFI_TRANSFER_INCREMENTAL_EN    ),
-  TCD ( WIFI_Send_Fragmented,           WIFI_SEND_FRAGMENTED_EN         ),
-  TCD ( WIFI_Recv_Fragmented,           WIFI_RECV_FRAGMENTED_EN         ),
-  TCD ( WIFI_Test_Speed,                WIFI_TEST_SPEED_EN              ),
-  TCD ( WIFI_Concurrent_Socket,         WIFI_CONCURRENT_SOCKET_EN       ),
-  TCD ( WIFI_Downstream_Rate,           WIFI_DOWNSTREAM_RATE_EN         ),
-  TCD ( WIFI_Upstream_Rate,             WIFI_UPSTREAM_RATE_EN           ),
+  TCF ( WIFI_Transfer_Fixed,            WIFI_TRANSFER_FIXED_EN          ),
+  TCF ( WIFI_Transfer_Incremental,      WIFI_TRANSFER_INCREMENTAL_EN    ),
+  TCF ( WIFI_Send_Fragmented,           WIFI_SEND_FRAGMENTED_EN         ),
+  TCF ( WIFI_Recv_Fragmented,           WIFI_RECV_FRAGMENTED_EN         ),
+  TCF ( WIFI_Test_Speed,                WIFI_TEST_SPEED_EN              ),
+  TCF ( WIFI_Concurrent_Socket,         WIFI_CONCURRENT_SOCKET_EN       ),
+  TCF ( WIFI_Downstream_Rate,           WIFI_DOWNSTREAM_RATE_EN         ),
+  TCF ( WIFI_Upstream_Rate,             WIFI_UPSTREAM_RATE_EN           ),
   #endif
 };
 #endif
@@ -417,6 +524,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver SPI Test Report",
   TS_Init_SPI,
   TS_Uninit_SPI,
+  NULL,
+  NULL,
   TC_List_SPI,
   ARRAY_SIZE (TC_List_SPI),
 },
@@ -428,6 +537,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver USART Test Report",
   TS_Init_USART,
   TS_Uninit_USART,
+  NULL,
+  NULL,
   TC_List_USART,
   ARRAY_SIZE (TC_List_USART),
 },
@@ -439,6 +550,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver ETH Test Report",
   TS_Init_ETH,
   TS_Uninit_ETH,
+  TS_Setup_ETH,
+  TS_Teardown_ETH,
   TC_List_ETH,
   ARRAY_SIZE (TC_List_ETH),
 },
@@ -448,8 +561,10 @@ TEST_GROUP ts[] = {
 {
   __FILE__, __DATE__, __TIME__,
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver I2C (API v2.3) Test Report",
-  NULL,
-  NULL,
+  TS_Init_I2C,
+  TS_Uninit_I2C,
+  TS_Setup_I2C,
+  TS_Teardown_I2C,
   TC_List_I2C,
   ARRAY_SIZE (TC_List_I2C),
 },
@@ -461,6 +576,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver MCI Test Report",
   NULL,
   NULL,
+  TS_Setup_MCI,
+  TS_Teardown_MCI,
   TC_List_MCI,
   ARRAY_SIZE (TC_List_MCI),
 },
@@ -472,6 +589,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver USBD Test Report",
   NULL,
   NULL,
+  TS_Setup_USBD,
+  TS_Teardown_USBD,
   TC_List_USBD,
   ARRAY_SIZE (TC_List_USBD),
 },
@@ -483,6 +602,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver USBH Test Report",
   NULL,
   NULL,
+  TS_Setup_USBH,
+  TS_Teardown_USBH,
   TC_List_USBH,
   ARRAY_SIZE (TC_List_USBH),
 },
@@ -494,6 +615,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver CAN Test Report",
   NULL,
   NULL,
+  TS_Setup_CAN,
+  TS_Teardown_CAN,
   TC_List_CAN,
   ARRAY_SIZE (TC_List_CAN),
 },
@@ -505,6 +628,8 @@ TEST_GROUP ts[] = {
   "CMSIS-Driver_Validation v" RTE_CMSIS_DV_PACK_VER " CMSIS-Driver WiFi Test Report",
   TS_Init_WiFi,
   TS_Uninit_WiFi,
+  TS_Setup_WiFi,
+  TS_Teardown_WiFi,
   TC_List_WiFi,
   ARRAY_SIZE (TC_List_WiFi),
 },
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     CAN Simulator
+ * Title:       CAN Simulator configuration file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef  CAN_SIM_CONFIG_H_
+#define  CAN_SIM_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h> CAN Simulator
+//   <i> Simulated CAN/CAN FD controller for running DV_CAN tests on a host.
+//   <o0> Driver_CAN# <0-255>
+//     <i> Choose the Driver_CAN# instance exported by the simulator.
+//     <i> For example to export Driver_CAN0 select 0.
+//   <o1> CAN base clock (Hz) <1000000-200000000>
+//     <i> Clock returned by GetClock and used to validate bit timings.
+//   <q2> CAN FD support
+//   <q3> Internal loopback support
+//   <q4> External loopback support
+//   <q5> Restricted mode support
+//   <q6> Monitor mode support
+// </h>
+#define  CAN_SIM_DRV_NUM                0
+#define  CAN_SIM_CLOCK                  80000000
+#define  CAN_SIM_FD                     1
+#define  CAN_SIM_LOOPBACK_INTERNAL      1
+#define  CAN_SIM_LOOPBACK_EXTERNAL      1
+#define  CAN_SIM_RESTRICTED             1
+#define  CAN_SIM_MONITOR                1
+
+// <h> Objects
+//   <o0> Number of objects <1-32>
+//   <o1> Number of receive only objects <0-32>
+//     <i> The first objects are receive only, the remaining objects can transmit and receive.
+//   <o2> Number of filters per object <1-64>
+//     <i> Number of filters an object accepts (1 disables multiple filters capability).
+//   <q3> Exact ID filtering
+//   <q4> Range ID filtering
+//   <q5> Maskable ID filtering
+// </h>
+#define  CAN_SIM_OBJ_NUM                4
+#define  CAN_SIM_OBJ_RX_ONLY_NUM        1
+#define  CAN_SIM_FILTER_NUM             16
+#define  CAN_SIM_FILTER_EXACT           1
+#define  CAN_SIM_FILTER_RANGE           1
+#define  CAN_SIM_FILTER_MASK            1
+
+// <h> Bit timing limits
+//   <i> Bit timings outside these limits, or not exactly dividing the clock, are rejected by SetBitrate.
+//   <o0> Maximum propagation segment + phase segment 1 <2-256>
+//   <o1> Maximum phase segment 2 <1-128>
+//   <o2> Maximum synchronization jump width <1-128>
+//   <o3> Maximum prescaler <1-1024>
+// </h>
+#define  CAN_SIM_TSEG1_MAX              16
+#define  CAN_SIM_TSEG2_MAX              8
+#define  CAN_SIM_SJW_MAX                4
+#define  CAN_SIM_PRESCALER_MAX          1024
+
+// <e> SocketCAN bridge
+//   <i> Send frames transmitted in normal and external loopback mode to a Linux SocketCAN interface
+//   <i> and receive frames from it. Frames sent to the bridge are acknowledged.
+//   <s> Interface name
+// </e>
+#define  CAN_SIM_SOCKETCAN              0
+#define  CAN_SIM_SOCKETCAN_IF           "vcan0"
+
+#endif
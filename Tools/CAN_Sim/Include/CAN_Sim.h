@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     CAN Simulator
+ * Title:       CAN Simulator header file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef CAN_SIM_H_
+#define CAN_SIM_H_
+
+#include <stdint.h>
+
+#define CAN_SIM_VER                     "1.0.0"
+
+// Global functions
+
+// Simulator time (ns), processes pending bus events
+extern uint64_t CAN_Sim_GetTime           (void);
+
+// Number of bits of a frame on the wire (without stuff bits and interframe space)
+//   ext:  0 = standard ID, 1 = extended ID
+//   fd:   0 = classic frame, 1 = CAN FD frame
+//   size: data size in bytes (rounded up to a valid CAN FD data size)
+//   data_bits: returns number of bits sent at data phase bitrate (bit rate switch), can be NULL
+extern uint32_t CAN_Sim_FrameBits         (uint32_t ext, uint32_t fd, uint32_t brs, uint32_t size, uint32_t *data_bits);
+
+#endif
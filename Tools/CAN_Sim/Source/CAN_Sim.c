@@ -0,0 +1,924 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     CAN Simulator
+ * Title:       Simulated CAN/CAN FD controller (ARM_DRIVER_CAN) for host execution
+ *
+ * The simulator models one controller with its own bus:
+ *  - frames occupy the bus for the time of their bit count at nominal (and
+ *    CAN FD data phase) bitrate, followed by the interframe space
+ *  - pending transmit objects arbitrate by identifier when the bus is free
+ *  - in loopback modes transmitted frames are received by own receive objects
+ *  - in normal mode frames are acknowledged only by the SocketCAN bridge;
+ *    without it every transmission ends with an acknowledge error and is
+ *    retransmitted, so the transmit error counter reaches error passive
+ *  - in CAN FD mode frames with more than 8 data bytes are sent as CAN FD
+ *    frames with bit rate switching even if edl/brs are not set in the
+ *    message information (as drivers configuring FD operation globally do)
+ *  - stuff bits are not modeled
+ *
+ * Bus events are processed when the driver API or the simulator time base is
+ * called, so events are signaled in the context of the calling thread and
+ * the driver must be used from a single thread.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "CAN_Sim_Config.h"
+#include "CAN_Sim.h"
+#include "Sim_Time.h"
+
+#include "Driver_CAN.h"
+
+#if (CAN_SIM_SOCKETCAN != 0)
+#include <fcntl.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#endif
+
+#define ARM_CAN_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(1,0) // Driver version
+
+// Frame format bits (without data field and stuff bits)
+//                                       SOF ID  SRR IDE  ID  RTR r1 r0 DLC CRC CRC_DEL ACK EOF
+#define CAN_SIM_STD_FRAME_BITS          ( 1 +11      +1      +1     +1  +4  +15  +1     +2  +7 )
+#define CAN_SIM_EXT_FRAME_BITS          ( 1 +11  +1  +1  +18 +1  +1 +1  +4  +15  +1     +2  +7 )
+//                                       SOF ID  SRR IDE  ID  RRS FDF res BRS                      ACK EOF
+#define CAN_SIM_FD_STD_NOMINAL_BITS     ( 1 +11      +1      +1  +1  +1  +1                       +2  +7 )
+#define CAN_SIM_FD_EXT_NOMINAL_BITS     ( 1 +11  +1  +1  +18 +1  +1  +1  +1                       +2  +7 )
+//                                       ESI DLC SBC CRC_DEL (CRC is 17 or 21 bits)
+#define CAN_SIM_FD_DATA_BITS            ( 1  +4  +4  +1 )
+#define CAN_SIM_IFS_BITS                3U
+// Error frame (error flag, error delimiter) and suspend transmission in error passive state
+#define CAN_SIM_ERROR_FRAME_BITS        (6U + 8U)
+#define CAN_SIM_SUSPEND_BITS            8U
+
+// Error counter limits
+#define CAN_SIM_ERR_WARNING             96U
+#define CAN_SIM_ERR_PASSIVE             128U
+
+// Filter types
+#define CAN_SIM_FLT_FREE                0U
+#define CAN_SIM_FLT_EXACT               1U
+#define CAN_SIM_FLT_RANGE               2U
+#define CAN_SIM_FLT_MASK                3U
+
+typedef struct {
+  uint8_t  type;                        // Filter type
+  uint32_t id;                          // Identifier (with ARM_CAN_ID_IDE_Msk for extended ID)
+  uint32_t arg;                         // Range end or mask
+} CAN_SIM_FILTER;
+
+typedef struct {
+  uint8_t          cfg;                 // Object configuration (ARM_CAN_OBJ_CONFIG)
+  uint8_t          tx_pending;          // Frame waiting for transmission
+  uint8_t          rx_full;             // Received frame not read yet
+  uint8_t          size;                // Data size
+  ARM_CAN_MSG_INFO info;                // Message information
+  uint8_t          data[64];            // Message data
+  uint64_t         tx_req;              // Time from which the frame may be transmitted (ns)
+  CAN_SIM_FILTER   flt[CAN_SIM_FILTER_NUM];
+} CAN_SIM_OBJ;
+
+typedef struct {
+  ARM_CAN_SignalUnitEvent_t   cb_unit_event;
+  ARM_CAN_SignalObjectEvent_t cb_object_event;
+  uint8_t          initialized;
+  uint8_t          powered;
+  uint8_t          mode;                // ARM_CAN_MODE
+  uint8_t          fd_mode;             // CAN FD mode enabled
+  uint8_t          retransmission;      // Automatic retransmission enabled
+  uint8_t          in_process;          // Bus event processing active (callbacks may call the driver)
+  uint8_t          unit_state;          // ARM_CAN_UNIT_STATE_x
+  uint8_t          lec;                 // Last error code
+  uint32_t         tec;                 // Transmit error counter
+  uint32_t         rec;                 // Receive error counter
+  uint32_t         bitrate;             // Nominal bitrate (bit/s)
+  uint32_t         bitrate_fd;          // CAN FD data phase bitrate (bit/s)
+  int32_t          bus_obj;             // Object transmitting on the bus, -1 if none
+  uint64_t         bus_end;             // End of frame on the bus (ns)
+  uint64_t         bus_free;            // Time the bus is free after interframe space (ns)
+  CAN_SIM_OBJ      obj[CAN_SIM_OBJ_NUM];
+#if (CAN_SIM_SOCKETCAN != 0)
+  int              sock;                // SocketCAN socket, -1 if not open
+#endif
+} CAN_SIM;
+
+static CAN_SIM  can_sim;
+
+// Driver Version
+static const ARM_DRIVER_VERSION can_driver_version = { ARM_CAN_API_VERSION, ARM_CAN_DRV_VERSION };
+
+// Driver Capabilities
+static const ARM_CAN_CAPABILITIES can_driver_capabilities = {
+  CAN_SIM_OBJ_NUM,                      // Number of CAN Objects available
+  0U,                                   // Does not support reentrant calls
+  (CAN_SIM_FD                != 0) ? 1U : 0U,
+  (CAN_SIM_RESTRICTED        != 0) ? 1U : 0U,
+  (CAN_SIM_MONITOR           != 0) ? 1U : 0U,
+  (CAN_SIM_LOOPBACK_INTERNAL != 0) ? 1U : 0U,
+  (CAN_SIM_LOOPBACK_EXTERNAL != 0) ? 1U : 0U,
+  0U                                    // Reserved (must be zero)
+};
+
+// Local functions
+
+// CAN FD data size rounded up to a valid data length
+static uint32_t CAN_Sim_FdSize (uint32_t size) {
+  if (size <= 8U)  { return size; }
+  if (size <= 24U) { return (size + 3U) & ~3U; }
+  if (size <= 32U) { return 32U; }
+  if (size <= 48U) { return 48U; }
+  return 64U;
+}
+
+// Data length code of data size
+static uint32_t CAN_Sim_Dlc (uint32_t size) {
+  if (size <= 8U)  { return size; }
+  if (size <= 24U) { return 9U + ((size - 9U) / 4U); }
+  if (size <= 32U) { return 13U; }
+  if (size <= 48U) { return 14U; }
+  return 15U;
+}
+
+// Frame duration on the bus including interframe space (ns)
+static uint64_t CAN_Sim_FrameTime (const CAN_SIM_OBJ *obj) {
+  uint32_t bits, data_bits, ext, fd, brs;
+
+  ext = ((obj->info.id & ARM_CAN_ID_IDE_Msk) != 0U) ? 1U : 0U;
+  fd  = ((obj->info.edl != 0U) && (can_sim.fd_mode != 0U)) ? 1U : 0U;
+  brs = ((fd != 0U) && (obj->info.brs != 0U) && (can_sim.bitrate_fd != 0U)) ? 1U : 0U;
+
+  bits = CAN_Sim_FrameBits(ext, fd, brs, (obj->info.rtr != 0U) ? 0U : obj->size, &data_bits) + CAN_SIM_IFS_BITS;
+
+  return (((uint64_t)bits      * 1000000000U) / can_sim.bitrate) +
+         ((brs != 0U) ? (((uint64_t)data_bits * 1000000000U) / can_sim.bitrate_fd) : 0U);
+}
+
+// Signal unit event on unit state change
+static void CAN_Sim_UpdateState (void) {
+  uint8_t state;
+
+  state = (can_sim.tec >= CAN_SIM_ERR_PASSIVE) ? ARM_CAN_UNIT_STATE_PASSIVE : ARM_CAN_UNIT_STATE_ACTIVE;
+  if (state != can_sim.unit_state) {
+    can_sim.unit_state = state;
+    if (can_sim.cb_unit_event != NULL) {
+      can_sim.cb_unit_event((state == ARM_CAN_UNIT_STATE_PASSIVE) ? ARM_CAN_EVENT_UNIT_PASSIVE : ARM_CAN_EVENT_UNIT_ACTIVE);
+    }
+  }
+}
+
+// Check if identifier passes filter
+static uint32_t CAN_Sim_FilterMatch (const CAN_SIM_FILTER *flt, uint32_t id) {
+
+  switch (flt->type) {
+    case CAN_SIM_FLT_EXACT:
+      return (id == flt->id) ? 1U : 0U;
+    case CAN_SIM_FLT_RANGE:
+      return (((id & ARM_CAN_ID_IDE_Msk) == (flt->id & ARM_CAN_ID_IDE_Msk)) && (id >= flt->id) && (id <= flt->arg)) ? 1U : 0U;
+    case CAN_SIM_FLT_MASK:
+      return (((id & ARM_CAN_ID_IDE_Msk) == (flt->id & ARM_CAN_ID_IDE_Msk)) &&
+              (((id ^ flt->id) & flt->arg & 0x1FFFFFFFU) == 0U)) ? 1U : 0U;
+    default:
+      return 0U;
+  }
+}
+
+// Deliver frame to first receive object with matching filter
+static void CAN_Sim_Receive (const ARM_CAN_MSG_INFO *info, const uint8_t *data, uint32_t size) {
+  CAN_SIM_OBJ *obj;
+  uint32_t i, j, event;
+
+  for (i = 0U; i < CAN_SIM_OBJ_NUM; i++) {
+    obj = &can_sim.obj[i];
+    if (obj->cfg != ARM_CAN_OBJ_RX) {
+      continue;
+    }
+    for (j = 0U; j < CAN_SIM_FILTER_NUM; j++) {
+      if (CAN_Sim_FilterMatch(&obj->flt[j], info->id) != 0U) {
+        break;
+      }
+    }
+    if (j == CAN_SIM_FILTER_NUM) {
+      continue;
+    }
+
+    event = (obj->rx_full != 0U) ? ARM_CAN_EVENT_RECEIVE_OVERRUN : ARM_CAN_EVENT_RECEIVE;
+    obj->info     = *info;
+    obj->info.dlc = CAN_Sim_Dlc(size);
+    obj->size     = (uint8_t)size;
+    obj->rx_full  = 1U;
+    memcpy(obj->data, data, size);
+    if (can_sim.cb_object_event != NULL) {
+      can_sim.cb_object_event(i, event);
+    }
+    return;
+  }
+}
+
+#if (CAN_SIM_SOCKETCAN != 0)
+// Open SocketCAN bridge
+static void CAN_Sim_BridgeOpen (void) {
+  struct sockaddr_can addr;
+  struct ifreq ifr;
+  int enable = 1;
+
+  can_sim.sock = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  if (can_sim.sock < 0) {
+    return;
+  }
+  (void)setsockopt(can_sim.sock, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable));
+  memset(&ifr, 0, sizeof(ifr));
+  strncpy(ifr.ifr_name, CAN_SIM_SOCKETCAN_IF, IFNAMSIZ - 1);
+  memset(&addr, 0, sizeof(addr));
+  addr.can_family = AF_CAN;
+  if ((ioctl(can_sim.sock, SIOCGIFINDEX, &ifr) < 0) ||
+      ((addr.can_ifindex = ifr.ifr_ifindex),
+       (bind(can_sim.sock, (struct sockaddr *)&addr, sizeof(addr)) < 0))) {
+    close(can_sim.sock);
+    can_sim.sock = -1;
+    return;
+  }
+  (void)fcntl(can_sim.sock, F_SETFL, fcntl(can_sim.sock, F_GETFL) | O_NONBLOCK);
+}
+
+// Close SocketCAN bridge
+static void CAN_Sim_BridgeClose (void) {
+  if (can_sim.sock >= 0) {
+    close(can_sim.sock);
+    can_sim.sock = -1;
+  }
+}
+
+// Send frame to SocketCAN bridge, returns 1 if frame was sent (acknowledged)
+static uint32_t CAN_Sim_BridgeSend (const CAN_SIM_OBJ *obj) {
+  struct canfd_frame frame;
+  size_t mtu;
+
+  if (can_sim.sock < 0) {
+    return 0U;
+  }
+  memset(&frame, 0, sizeof(frame));
+  if ((obj->info.id & ARM_CAN_ID_IDE_Msk) != 0U) {
+    frame.can_id = (obj->info.id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+  } else {
+    frame.can_id = obj->info.id & CAN_SFF_MASK;
+  }
+  if (obj->info.rtr != 0U) {
+    frame.can_id |= CAN_RTR_FLAG;
+  }
+  frame.len = (uint8_t)obj->size;
+  memcpy(frame.data, obj->data, obj->size);
+  if ((obj->info.edl != 0U) && (can_sim.fd_mode != 0U)) {
+    frame.len   = (uint8_t)CAN_Sim_FdSize(obj->size);
+    frame.flags = (obj->info.brs != 0U) ? CANFD_BRS : 0U;
+    mtu = CANFD_MTU;
+  } else {
+    mtu = CAN_MTU;
+  }
+  return (write(can_sim.sock, &frame, mtu) == (ssize_t)mtu) ? 1U : 0U;
+}
+
+// Receive frames from SocketCAN bridge
+static void CAN_Sim_BridgeReceive (void) {
+  struct canfd_frame frame;
+  ARM_CAN_MSG_INFO info;
+  ssize_t n;
+
+  if ((can_sim.sock < 0) || (can_sim.mode == ARM_CAN_MODE_INITIALIZATION) || (can_sim.mode == ARM_CAN_MODE_LOOPBACK_INTERNAL)) {
+    return;
+  }
+  for (;;) {
+    n = read(can_sim.sock, &frame, sizeof(frame));
+    if ((n != CAN_MTU) && (n != CANFD_MTU)) {
+      break;
+    }
+    if ((n == CANFD_MTU) && (can_sim.fd_mode == 0U)) {
+      continue;
+    }
+    memset(&info, 0, sizeof(info));
+    if ((frame.can_id & CAN_EFF_FLAG) != 0U) {
+      info.id = ARM_CAN_EXTENDED_ID(frame.can_id & CAN_EFF_MASK);
+    } else {
+      info.id = ARM_CAN_STANDARD_ID(frame.can_id & CAN_SFF_MASK);
+    }
+    info.rtr = ((frame.can_id & CAN_RTR_FLAG) != 0U) ? 1U : 0U;
+    info.edl = (n == CANFD_MTU) ? 1U : 0U;
+    info.brs = ((frame.flags & CANFD_BRS) != 0U) ? 1U : 0U;
+    CAN_Sim_Receive(&info, frame.data, frame.len);
+  }
+}
+#endif
+
+// Complete frame on the bus
+static void CAN_Sim_FrameDone (uint32_t obj_idx) {
+  CAN_SIM_OBJ *obj;
+  uint32_t acked;
+
+  obj   = &can_sim.obj[obj_idx];
+  acked = 0U;
+
+  if ((can_sim.mode == ARM_CAN_MODE_LOOPBACK_INTERNAL) || (can_sim.mode == ARM_CAN_MODE_LOOPBACK_EXTERNAL)) {
+    acked = 1U;
+  }
+#if (CAN_SIM_SOCKETCAN != 0)
+  if ((can_sim.mode == ARM_CAN_MODE_NORMAL) || (can_sim.mode == ARM_CAN_MODE_LOOPBACK_EXTERNAL)) {
+    if (CAN_Sim_BridgeSend(obj) != 0U) {
+      acked = 1U;
+    }
+  }
+#endif
+
+  if (acked == 0U) {
+    // Acknowledge error: error frame, retransmission after error frame (and suspend transmission when error passive)
+    can_sim.lec      = ARM_CAN_LEC_ACK_ERROR;
+    can_sim.bus_free = can_sim.bus_end + ((((uint64_t)CAN_SIM_ERROR_FRAME_BITS +
+                       ((can_sim.unit_state == ARM_CAN_UNIT_STATE_PASSIVE) ? CAN_SIM_SUSPEND_BITS : 0U)) * 1000000000U) / can_sim.bitrate);
+    // Transmit error counter is not increased by acknowledge errors in error passive state
+    if (can_sim.tec < CAN_SIM_ERR_PASSIVE) {
+      if ((can_sim.tec < CAN_SIM_ERR_WARNING) && ((can_sim.tec + 8U) >= CAN_SIM_ERR_WARNING) && (can_sim.cb_unit_event != NULL)) {
+        can_sim.cb_unit_event(ARM_CAN_EVENT_UNIT_WARNING);
+      }
+      can_sim.tec += 8U;
+      CAN_Sim_UpdateState();
+    }
+    if (can_sim.retransmission == 0U) {
+      obj->tx_pending = 0U;
+    } else {
+      obj->tx_req = can_sim.bus_free;
+    }
+    return;
+  }
+
+  can_sim.lec = ARM_CAN_LEC_NO_ERROR;
+  if (can_sim.tec != 0U) {
+    can_sim.tec--;
+    CAN_Sim_UpdateState();
+  }
+  obj->tx_pending = 0U;
+  if (can_sim.cb_object_event != NULL) {
+    can_sim.cb_object_event(obj_idx, ARM_CAN_EVENT_SEND_COMPLETE);
+  }
+  if (can_sim.mode != ARM_CAN_MODE_NORMAL) {
+    // Loopback: frame is received by own receive objects
+    CAN_Sim_Receive(&obj->info, obj->data, (obj->info.rtr != 0U) ? 0U : obj->size);
+  }
+}
+
+// Process bus events up to current time
+static void CAN_Sim_Process (void) {
+  uint64_t now, start;
+  uint32_t i, prio, best_prio;
+  int32_t  best;
+
+  if ((can_sim.in_process != 0U) || (can_sim.powered == 0U) || (can_sim.bitrate == 0U)) {
+    return;
+  }
+  can_sim.in_process = 1U;
+  now = Sim_Time_Now();
+
+  for (;;) {
+    if (can_sim.bus_obj >= 0) {
+      if (now < can_sim.bus_end) {
+        break;
+      }
+      i = (uint32_t)can_sim.bus_obj;
+      can_sim.bus_obj = -1;
+      CAN_Sim_FrameDone(i);
+      continue;
+    }
+
+    if ((can_sim.mode == ARM_CAN_MODE_INITIALIZATION) ||
+        (can_sim.mode == ARM_CAN_MODE_RESTRICTED)     ||
+        (can_sim.mode == ARM_CAN_MODE_MONITOR)) {
+      break;
+    }
+
+    // Frame transmission starts when the bus is free and a frame is pending
+    start = UINT64_MAX;
+    for (i = 0U; i < CAN_SIM_OBJ_NUM; i++) {
+      if ((can_sim.obj[i].tx_pending != 0U) && (can_sim.obj[i].tx_req < start)) {
+        start = can_sim.obj[i].tx_req;
+      }
+    }
+    if (start == UINT64_MAX) {
+      break;
+    }
+    if (start < can_sim.bus_free) {
+      start = can_sim.bus_free;
+    }
+    if (start > now) {
+      break;
+    }
+
+    // Arbitration: lowest base identifier wins, standard frame wins over extended frame with same base identifier
+    best      = -1;
+    best_prio = UINT32_MAX;
+    for (i = 0U; i < CAN_SIM_OBJ_NUM; i++) {
+      if ((can_sim.obj[i].tx_pending == 0U) || (can_sim.obj[i].tx_req > start)) {
+        continue;
+      }
+      if ((can_sim.obj[i].info.id & ARM_CAN_ID_IDE_Msk) != 0U) {
+        prio = ((can_sim.obj[i].info.id & 0x1FFC0000U) << 1) | (1UL << 18) | (can_sim.obj[i].info.id & 0x3FFFFU);
+      } else {
+        prio = (can_sim.obj[i].info.id & 0x7FFU) << 19;
+      }
+      if (prio < best_prio) {
+        best_prio = prio;
+        best      = (int32_t)i;
+      }
+    }
+    can_sim.bus_obj  = best;
+    can_sim.bus_end  = start + CAN_Sim_FrameTime(&can_sim.obj[best]);
+    can_sim.bus_free = can_sim.bus_end;
+  }
+
+#if (CAN_SIM_SOCKETCAN != 0)
+  CAN_Sim_BridgeReceive();
+#endif
+
+  can_sim.in_process = 0U;
+}
+
+// Time of next bus event for the time base (ns)
+static uint64_t CAN_Sim_NextEvent (void) {
+  if (can_sim.in_process != 0U) {
+    return 0U;
+  }
+  // While a frame is on the bus jump to its end
+  if (can_sim.bus_obj >= 0) {
+    return can_sim.bus_end;
+  }
+  return UINT64_MAX;
+}
+
+static const SIM_TIME_CLIENT can_sim_time = { CAN_Sim_NextEvent, CAN_Sim_Process };
+
+// Global functions
+
+uint32_t CAN_Sim_FrameBits (uint32_t ext, uint32_t fd, uint32_t brs, uint32_t size, uint32_t *data_bits) {
+  uint32_t bits, dbits;
+
+  if (fd == 0U) {
+    bits  = ((ext != 0U) ? CAN_SIM_EXT_FRAME_BITS : CAN_SIM_STD_FRAME_BITS) + (size * 8U);
+    dbits = 0U;
+  } else {
+    size  = CAN_Sim_FdSize(size);
+    bits  = (ext != 0U) ? CAN_SIM_FD_EXT_NOMINAL_BITS : CAN_SIM_FD_STD_NOMINAL_BITS;
+    dbits = CAN_SIM_FD_DATA_BITS + (size * 8U) + ((size <= 16U) ? 17U : 21U);
+    if (brs == 0U) {
+      bits += dbits;
+      dbits = 0U;
+    }
+  }
+  if (data_bits != NULL) {
+    *data_bits = dbits;
+  }
+  return bits;
+}
+
+uint64_t CAN_Sim_GetTime (void) {
+  CAN_Sim_Process();
+  return Sim_Time_Now();
+}
+
+// Driver functions
+
+static ARM_DRIVER_VERSION CAN_GetVersion (void) {
+  return can_driver_version;
+}
+
+static ARM_CAN_CAPABILITIES CAN_GetCapabilities (void) {
+  return can_driver_capabilities;
+}
+
+static int32_t CAN_Initialize (ARM_CAN_SignalUnitEvent_t   cb_unit_event,
+                               ARM_CAN_SignalObjectEvent_t cb_object_event) {
+
+  if (can_sim.initialized != 0U) {
+    return ARM_DRIVER_OK;
+  }
+  memset(&can_sim, 0, sizeof(can_sim));
+  can_sim.cb_unit_event   = cb_unit_event;
+  can_sim.cb_object_event = cb_object_event;
+  can_sim.bus_obj         = -1;
+#if (CAN_SIM_SOCKETCAN != 0)
+  can_sim.sock            = -1;
+#endif
+
+  if (Sim_Time_Register(&can_sim_time) != 0) {
+    return ARM_DRIVER_ERROR;
+  }
+  can_sim.initialized     = 1U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t CAN_Uninitialize (void) {
+
+  if (can_sim.powered != 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  can_sim.initialized = 0U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t CAN_PowerControl (ARM_POWER_STATE state) {
+
+  switch (state) {
+    case ARM_POWER_OFF:
+#if (CAN_SIM_SOCKETCAN != 0)
+      CAN_Sim_BridgeClose();
+#endif
+      memset(can_sim.obj, 0, sizeof(can_sim.obj));
+      can_sim.powered        = 0U;
+      can_sim.mode           = ARM_CAN_MODE_INITIALIZATION;
+      can_sim.unit_state     = ARM_CAN_UNIT_STATE_INACTIVE;
+      can_sim.bus_obj        = -1;
+      can_sim.tec            = 0U;
+      can_sim.rec            = 0U;
+      can_sim.lec            = ARM_CAN_LEC_NO_ERROR;
+      return ARM_DRIVER_OK;
+
+    case ARM_POWER_FULL:
+      if (can_sim.initialized == 0U) {
+        return ARM_DRIVER_ERROR;
+      }
+      if (can_sim.powered != 0U) {
+        return ARM_DRIVER_OK;
+      }
+      can_sim.powered        = 1U;
+      can_sim.mode           = ARM_CAN_MODE_INITIALIZATION;
+      can_sim.unit_state     = ARM_CAN_UNIT_STATE_INACTIVE;
+      can_sim.retransmission = 1U;
+      can_sim.bus_obj        = -1;
+#if (CAN_SIM_SOCKETCAN != 0)
+      CAN_Sim_BridgeOpen();
+#endif
+      return ARM_DRIVER_OK;
+
+    case ARM_POWER_LOW:
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+}
+
+static uint32_t CAN_GetClock (void) {
+  return CAN_SIM_CLOCK;
+}
+
+static int32_t CAN_SetBitrate (ARM_CAN_BITRATE_SELECT select, uint32_t bitrate, uint32_t bit_segments) {
+  uint32_t prop_seg, phase_seg1, phase_seg2, sjw, tq;
+
+  if (can_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  if ((select == ARM_CAN_BITRATE_FD_DATA) && (CAN_SIM_FD == 0)) {
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+
+  prop_seg   = (bit_segments      ) & 0xFFU;
+  phase_seg1 = (bit_segments >>  8) & 0xFFU;
+  phase_seg2 = (bit_segments >> 16) & 0xFFU;
+  sjw        = (bit_segments >> 24) & 0xFFU;
+  tq         = 1U + prop_seg + phase_seg1 + phase_seg2;
+
+  if ((bitrate == 0U) || (phase_seg1 == 0U) || (phase_seg2 == 0U) || (sjw == 0U)   ||
+      ((prop_seg + phase_seg1) > CAN_SIM_TSEG1_MAX) || (phase_seg2 > CAN_SIM_TSEG2_MAX) ||
+      (sjw > CAN_SIM_SJW_MAX)  || (sjw > phase_seg1) || (sjw > phase_seg2)) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  // Bitrate must result from an integer prescaler
+  if (((CAN_SIM_CLOCK % ((uint64_t)bitrate * tq)) != 0U) ||
+      ((CAN_SIM_CLOCK /  ((uint64_t)bitrate * tq)) > CAN_SIM_PRESCALER_MAX)) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+
+  if (select == ARM_CAN_BITRATE_FD_DATA) {
+    can_sim.bitrate_fd = bitrate;
+  } else {
+    can_sim.bitrate    = bitrate;
+  }
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t CAN_SetMode (ARM_CAN_MODE mode) {
+
+  if (can_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  switch (mode) {
+    case ARM_CAN_MODE_INITIALIZATION:
+    case ARM_CAN_MODE_NORMAL:
+      break;
+    case ARM_CAN_MODE_RESTRICTED:
+      if (CAN_SIM_RESTRICTED == 0)        { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+      break;
+    case ARM_CAN_MODE_MONITOR:
+      if (CAN_SIM_MONITOR == 0)           { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+      break;
+    case ARM_CAN_MODE_LOOPBACK_INTERNAL:
+      if (CAN_SIM_LOOPBACK_INTERNAL == 0) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+      break;
+    case ARM_CAN_MODE_LOOPBACK_EXTERNAL:
+      if (CAN_SIM_LOOPBACK_EXTERNAL == 0) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+      break;
+    default:
+      return ARM_DRIVER_ERROR_PARAMETER;
+  }
+
+  CAN_Sim_Process();
+
+  // Leaving the bus aborts the frame being transmitted
+  can_sim.mode = (uint8_t)mode;
+  if (mode == ARM_CAN_MODE_INITIALIZATION) {
+    can_sim.bus_obj = -1;
+    can_sim.unit_state = ARM_CAN_UNIT_STATE_INACTIVE;
+  } else {
+    can_sim.bus_free = Sim_Time_Now();
+    if (can_sim.unit_state == ARM_CAN_UNIT_STATE_INACTIVE) {
+      can_sim.unit_state = (can_sim.tec >= CAN_SIM_ERR_PASSIVE) ? ARM_CAN_UNIT_STATE_PASSIVE : ARM_CAN_UNIT_STATE_ACTIVE;
+      if (can_sim.cb_unit_event != NULL) {
+        can_sim.cb_unit_event((can_sim.unit_state == ARM_CAN_UNIT_STATE_PASSIVE) ? ARM_CAN_EVENT_UNIT_PASSIVE : ARM_CAN_EVENT_UNIT_ACTIVE);
+      }
+    }
+  }
+
+  return ARM_DRIVER_OK;
+}
+
+static ARM_CAN_OBJ_CAPABILITIES CAN_ObjectGetCapabilities (uint32_t obj_idx) {
+  ARM_CAN_OBJ_CAPABILITIES obj_cap;
+
+  memset(&obj_cap, 0, sizeof(obj_cap));
+  if (obj_idx < CAN_SIM_OBJ_NUM) {
+    obj_cap.tx               = (obj_idx >= CAN_SIM_OBJ_RX_ONLY_NUM) ? 1U : 0U;
+    obj_cap.rx               = 1U;
+    obj_cap.multiple_filters = (CAN_SIM_FILTER_NUM > 1) ? 1U : 0U;
+    obj_cap.exact_filtering  = (CAN_SIM_FILTER_EXACT != 0) ? 1U : 0U;
+    obj_cap.range_filtering  = (CAN_SIM_FILTER_RANGE != 0) ? 1U : 0U;
+    obj_cap.mask_filtering   = (CAN_SIM_FILTER_MASK  != 0) ? 1U : 0U;
+    obj_cap.message_depth    = 1U;
+  }
+  return obj_cap;
+}
+
+static int32_t CAN_ObjectSetFilter (uint32_t obj_idx, ARM_CAN_FILTER_OPERATION operation, uint32_t id, uint32_t arg) {
+  CAN_SIM_FILTER *flt;
+  uint32_t i, type, add;
+
+  if (obj_idx >= CAN_SIM_OBJ_NUM) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  if (can_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+
+  switch (operation) {
+    case ARM_CAN_FILTER_ID_EXACT_ADD:       type = CAN_SIM_FLT_EXACT; add = 1U; break;
+    case ARM_CAN_FILTER_ID_EXACT_REMOVE:    type = CAN_SIM_FLT_EXACT; add = 0U; break;
+    case ARM_CAN_FILTER_ID_RANGE_ADD:       type = CAN_SIM_FLT_RANGE; add = 1U; break;
+    case ARM_CAN_FILTER_ID_RANGE_REMOVE:    type = CAN_SIM_FLT_RANGE; add = 0U; break;
+    case ARM_CAN_FILTER_ID_MASKABLE_ADD:    type = CAN_SIM_FLT_MASK;  add = 1U; break;
+    case ARM_CAN_FILTER_ID_MASKABLE_REMOVE: type = CAN_SIM_FLT_MASK;  add = 0U; break;
+    default:
+      return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  if (((type == CAN_SIM_FLT_EXACT) && (CAN_SIM_FILTER_EXACT == 0)) ||
+      ((type == CAN_SIM_FLT_RANGE) && (CAN_SIM_FILTER_RANGE == 0)) ||
+      ((type == CAN_SIM_FLT_MASK)  && (CAN_SIM_FILTER_MASK  == 0))) {
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+  if (type == CAN_SIM_FLT_RANGE) {
+    // Range end uses the same identifier format as range start
+    arg |= id & ARM_CAN_ID_IDE_Msk;
+  }
+
+  flt = can_sim.obj[obj_idx].flt;
+  for (i = 0U; i < CAN_SIM_FILTER_NUM; i++) {
+    if (add != 0U) {
+      if (flt[i].type == CAN_SIM_FLT_FREE) {
+        flt[i].type = (uint8_t)type;
+        flt[i].id   = id;
+        flt[i].arg  = arg;
+        return ARM_DRIVER_OK;
+      }
+    } else {
+      if ((flt[i].type == type) && (flt[i].id == id) && ((type == CAN_SIM_FLT_EXACT) || (flt[i].arg == arg))) {
+        flt[i].type = CAN_SIM_FLT_FREE;
+        return ARM_DRIVER_OK;
+      }
+    }
+  }
+
+  // No free filter or filter to remove not found
+  return ARM_DRIVER_ERROR;
+}
+
+static int32_t CAN_ObjectConfigure (uint32_t obj_idx, ARM_CAN_OBJ_CONFIG obj_cfg) {
+  CAN_SIM_OBJ *obj;
+
+  if (obj_idx >= CAN_SIM_OBJ_NUM) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  if (can_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  switch (obj_cfg) {
+    case ARM_CAN_OBJ_INACTIVE:
+    case ARM_CAN_OBJ_RX:
+      break;
+    case ARM_CAN_OBJ_TX:
+      if (obj_idx < CAN_SIM_OBJ_RX_ONLY_NUM) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      break;
+    case ARM_CAN_OBJ_RX_RTR_TX_DATA:
+    case ARM_CAN_OBJ_TX_RTR_RX_DATA:
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+
+  CAN_Sim_Process();
+
+  obj = &can_sim.obj[obj_idx];
+  if (can_sim.bus_obj == (int32_t)obj_idx) {
+    can_sim.bus_obj = -1;
+  }
+  obj->cfg        = (uint8_t)obj_cfg;
+  obj->tx_pending = 0U;
+  obj->rx_full    = 0U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t CAN_MessageSend (uint32_t obj_idx, ARM_CAN_MSG_INFO *msg_info, const uint8_t *data, uint8_t size) {
+  CAN_SIM_OBJ *obj;
+  uint32_t max_size;
+
+  if ((obj_idx >= CAN_SIM_OBJ_NUM) || (msg_info == NULL) || ((data == NULL) && (size != 0U))) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  obj = &can_sim.obj[obj_idx];
+  if ((can_sim.powered == 0U) || (obj->cfg != ARM_CAN_OBJ_TX) || (can_sim.bitrate == 0U) ||
+      (can_sim.mode == ARM_CAN_MODE_INITIALIZATION) || (can_sim.mode == ARM_CAN_MODE_RESTRICTED) ||
+      (can_sim.mode == ARM_CAN_MODE_MONITOR)) {
+    return ARM_DRIVER_ERROR;
+  }
+
+  CAN_Sim_Process();
+
+  if (obj->tx_pending != 0U) {
+    return ARM_DRIVER_ERROR_BUSY;
+  }
+
+  max_size = (can_sim.fd_mode != 0U) ? 64U : 8U;
+  if (size > max_size) {
+    size = (uint8_t)max_size;
+  }
+
+  obj->info       = *msg_info;
+  if ((can_sim.fd_mode != 0U) && (size > 8U) && (msg_info->edl == 0U)) {
+    obj->info.edl = 1U;
+    obj->info.brs = 1U;
+  }
+  obj->info.dlc   = (msg_info->rtr != 0U) ? msg_info->dlc : CAN_Sim_Dlc(size);
+  obj->size       = size;
+  if (size != 0U) {
+    memcpy(obj->data, data, size);
+  }
+  obj->tx_req     = Sim_Time_Now();
+  obj->tx_pending = 1U;
+
+  CAN_Sim_Process();
+
+  return size;
+}
+
+static int32_t CAN_MessageRead (uint32_t obj_idx, ARM_CAN_MSG_INFO *msg_info, uint8_t *data, uint8_t size) {
+  CAN_SIM_OBJ *obj;
+
+  if ((obj_idx >= CAN_SIM_OBJ_NUM) || (msg_info == NULL) || ((data == NULL) && (size != 0U))) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  obj = &can_sim.obj[obj_idx];
+  if ((can_sim.powered == 0U) || (obj->cfg != ARM_CAN_OBJ_RX)) {
+    return ARM_DRIVER_ERROR;
+  }
+
+  CAN_Sim_Process();
+
+  if (obj->rx_full == 0U) {
+    return 0;
+  }
+  if (size > obj->size) {
+    size = obj->size;
+  }
+  *msg_info = obj->info;
+  if (size != 0U) {
+    memcpy(data, obj->data, size);
+  }
+  obj->rx_full = 0U;
+
+  return size;
+}
+
+static int32_t CAN_Control (uint32_t control, uint32_t arg) {
+
+  if (can_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  switch (control & 0xFFU) {
+    case ARM_CAN_SET_FD_MODE:
+      if (CAN_SIM_FD == 0) {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+      }
+      can_sim.fd_mode = (arg != 0U) ? 1U : 0U;
+      return ARM_DRIVER_OK;
+
+    case ARM_CAN_ABORT_MESSAGE_SEND:
+      if (arg >= CAN_SIM_OBJ_NUM) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      CAN_Sim_Process();
+      can_sim.obj[arg].tx_pending = 0U;
+      if (can_sim.bus_obj == (int32_t)arg) {
+        can_sim.bus_obj  = -1;
+        can_sim.bus_free = Sim_Time_Now();
+      }
+      return ARM_DRIVER_OK;
+
+    case ARM_CAN_CONTROL_RETRANSMISSION:
+      can_sim.retransmission = (arg != 0U) ? 1U : 0U;
+      return ARM_DRIVER_OK;
+
+    case ARM_CAN_SET_TRANSCEIVER_DELAY:
+      return ARM_DRIVER_OK;
+
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+}
+
+static ARM_CAN_STATUS CAN_GetStatus (void) {
+  ARM_CAN_STATUS status;
+
+  CAN_Sim_Process();
+
+  memset(&status, 0, sizeof(status));
+  status.unit_state      = can_sim.unit_state;
+  status.last_error_code = can_sim.lec;
+  status.tx_error_count  = (can_sim.tec > 255U) ? 255U : can_sim.tec;
+  status.rx_error_count  = (can_sim.rec > 255U) ? 255U : can_sim.rec;
+
+  return status;
+}
+
+// CAN driver control block
+#define CAN_Sim_Driver_Aux(n)   Driver_CAN##n
+#define CAN_Sim_Driver_Name(n)  CAN_Sim_Driver_Aux(n)
+
+extern \
+ARM_DRIVER_CAN CAN_Sim_Driver_Name(CAN_SIM_DRV_NUM);
+ARM_DRIVER_CAN CAN_Sim_Driver_Name(CAN_SIM_DRV_NUM) = {
+  CAN_GetVersion,
+  CAN_GetCapabilities,
+  CAN_Initialize,
+  CAN_Uninitialize,
+  CAN_PowerControl,
+  CAN_GetClock,
+  CAN_SetBitrate,
+  CAN_SetMode,
+  CAN_ObjectGetCapabilities,
+  CAN_ObjectSetFilter,
+  CAN_ObjectConfigure,
+  CAN_MessageSend,
+  CAN_MessageRead,
+  CAN_Control,
+  CAN_GetStatus
+};
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     I2C Server
+ * Title:       I2C Server configuration file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef  I2C_SERVER_CONFIG_H_
+#define  I2C_SERVER_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h> I2C Server
+//   <i> I2C Server configuration.
+//   <i> Fixed settings used by the I2C Server for command exchange are:
+//   <i> Mode: Slave with 7-bit own address
+//   <o0> Driver_I2C# <0-255>
+//     <i> Choose the Driver_I2C# instance.
+//     <i> For example to use Driver_I2C0 select 0.
+//   <o1> Own address <0x08-0x77>
+//     <i> 7-bit slave address at which the I2C Server receives commands.
+//     <i> Must be the same as the I2C Server address set in the DV_I2C_Config.h file.
+//   <o2> Buffer size <32-65536>
+//     <i> Size of the receive and transmit buffers (in bytes).
+//   <o3> Command timeout (ms) <10-10000>
+//     <i> Timeout for data phases of commands.
+// </h>
+
+#define  I2C_SERVER_DRV_NUM             0
+#define  I2C_SERVER_ADDR                0x4A
+#define  I2C_SERVER_BUF_SIZE            4096
+#define  I2C_SERVER_CMD_TIMEOUT         100
+
+#endif
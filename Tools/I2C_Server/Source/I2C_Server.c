@@ -0,0 +1,1118 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     I2C Server
+ * Title:       I2C Server application
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "I2C_Server_Config.h"
+#include "I2C_Server.h"
+
+#include "cmsis_os2.h"
+#include "cmsis_compiler.h"
+#include "cmsis_vio.h"
+
+#include "Driver_I2C.h"                 // ::CMSIS Driver:I2C
+
+#ifndef  I2C_SERVER_DEBUG
+#define  I2C_SERVER_DEBUG       0
+#endif
+
+// Fixed I2C Server settings (not available through I2C_Server_Config.h)
+#define  I2C_SERVER_BUS_SPEED   ARM_I2C_BUS_SPEED_STANDARD      // Bus speed used in Slave mode for commands
+
+#define  I2C_EVENTS_MASK       (ARM_I2C_EVENT_TRANSFER_DONE       | \
+                                ARM_I2C_EVENT_TRANSFER_INCOMPLETE | \
+                                ARM_I2C_EVENT_ADDRESS_NACK        | \
+                                ARM_I2C_EVENT_ARBITRATION_LOST    | \
+                                ARM_I2C_EVENT_BUS_ERROR)
+
+#define  I2C_EVENTS_ERROR_MASK (ARM_I2C_EVENT_TRANSFER_INCOMPLETE | \
+                                ARM_I2C_EVENT_ADDRESS_NACK        | \
+                                ARM_I2C_EVENT_ARBITRATION_LOST    | \
+                                ARM_I2C_EVENT_BUS_ERROR)
+
+/* Access to Driver_I2C# */
+#define  I2C_Driver_Aux(n)      Driver_I2C##n
+#define  I2C_Driver_Name(n)     I2C_Driver_Aux(n)
+extern   ARM_DRIVER_I2C         I2C_Driver_Name(I2C_SERVER_DRV_NUM);
+#define  drvI2C               (&I2C_Driver_Name(I2C_SERVER_DRV_NUM))
+
+typedef struct {                // I2C Interface settings structure
+  uint32_t mode;                // 0 = Slave, 1 = Master
+  uint32_t addr;                // Own address in Slave mode, Slave address in Master mode
+  uint32_t addr_10bit;          // 0 = 7-bit address, 1 = 10-bit address
+  uint32_t bus_speed;           // ARM_I2C_BUS_SPEED_x
+} I2C_COM_CONFIG_t;
+
+// Structure containing command string and pointer to command handling function
+typedef struct {
+  const char     *command;
+        int32_t (*Command_Func) (const char *command);
+} I2C_CMD_DESC_t;
+
+// Local functions
+
+// Main thread (reception and execution of command)
+__NO_RETURN \
+static void     I2C_Server_Thread       (void *argument);
+
+// I2C Interface communication functions
+static void     I2C_Com_Event           (uint32_t event);
+static int32_t  I2C_Com_Initialize      (void);
+static int32_t  I2C_Com_Uninitialize    (void);
+static int32_t  I2C_Com_PowerOn         (void);
+static int32_t  I2C_Com_PowerOff        (void);
+static int32_t  I2C_Com_Configure       (const I2C_COM_CONFIG_t *config);
+static int32_t  I2C_Com_Wait            (uint32_t timeout);
+static int32_t  I2C_Com_Receive         (                      void *data_in, uint32_t num, uint32_t timeout);
+static int32_t  I2C_Com_Send            (const void *data_out,                uint32_t num, uint32_t timeout);
+static int32_t  I2C_Com_MasterReceive   (                      void *data_in, uint32_t num, uint32_t pending, uint32_t timeout);
+static int32_t  I2C_Com_MasterTransmit  (const void *data_out,                uint32_t num, uint32_t pending, uint32_t timeout);
+static int32_t  I2C_Com_Abort           (void);
+static uint32_t I2C_Com_GetCnt          (void);
+
+// Command handling functions
+static int32_t  I2C_Cmd_GetVer          (const char *cmd);
+static int32_t  I2C_Cmd_GetCap          (const char *cmd);
+static int32_t  I2C_Cmd_SetBuf          (const char *cmd);
+static int32_t  I2C_Cmd_GetBuf          (const char *cmd);
+static int32_t  I2C_Cmd_SetCom          (const char *cmd);
+static int32_t  I2C_Cmd_Xfer            (const char *cmd);
+static int32_t  I2C_Cmd_GetCnt          (const char *cmd);
+
+// Local variables
+
+// Command specification (command string, command handling function)
+static const I2C_CMD_DESC_t i2c_cmd_desc[] = {
+ { "GET VER" , I2C_Cmd_GetVer },
+ { "GET CAP" , I2C_Cmd_GetCap },
+ { "SET BUF" , I2C_Cmd_SetBuf },
+ { "GET BUF" , I2C_Cmd_GetBuf },
+ { "SET COM" , I2C_Cmd_SetCom },
+ { "XFER"    , I2C_Cmd_Xfer   },
+ { "GET CNT" , I2C_Cmd_GetCnt }
+};
+
+static       osThreadId_t       i2c_server_thread_id   =   NULL;
+static       osThreadAttr_t     thread_attr = {
+  .name       = "I2C_Server_Thread",
+  .stack_size = 512U
+};
+
+static       uint8_t            i2c_server_state       =   I2C_SERVER_STATE_RECEPTION;
+static       uint32_t           i2c_cmd_timeout        =   I2C_SERVER_CMD_TIMEOUT;
+static       uint32_t           i2c_xfer_timeout       =   I2C_SERVER_CMD_TIMEOUT;
+static       uint32_t           i2c_xfer_cnt           =   0U;
+static       uint32_t           i2c_xfer_buf_size      =   I2C_SERVER_BUF_SIZE;
+static const I2C_COM_CONFIG_t   i2c_com_config_default = { 0U, I2C_SERVER_ADDR, 0U, I2C_SERVER_BUS_SPEED };
+static       I2C_COM_CONFIG_t   i2c_com_config_xfer;
+static       uint8_t            i2c_cmd_buf_rx[32]        __ALIGNED(4);
+static       uint8_t            i2c_cmd_buf_tx[32]        __ALIGNED(4);
+static       uint8_t           *ptr_i2c_xfer_buf_rx       = NULL;
+static       uint8_t           *ptr_i2c_xfer_buf_tx       = NULL;
+
+// Global functions
+
+/**
+  \fn            int32_t I2C_Server_Start (void)
+  \brief         Initialize, power up, configure I2C interface and start I2C Server thread.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+int32_t I2C_Server_Start (void) {
+  int32_t ret;
+
+  vioInit();
+  (void)vioPrint(vioLevelHeading, "I2C Server v%s", I2C_SERVER_VER);
+
+  // Initialize local variables
+  i2c_server_state  = I2C_SERVER_STATE_RECEPTION;
+  i2c_cmd_timeout   = I2C_SERVER_CMD_TIMEOUT;
+  i2c_xfer_timeout  = I2C_SERVER_CMD_TIMEOUT;
+  i2c_xfer_cnt      = 0U;
+  i2c_xfer_buf_size = I2C_SERVER_BUF_SIZE;
+  memset(i2c_cmd_buf_rx,  0, sizeof(i2c_cmd_buf_rx));
+  memset(i2c_cmd_buf_tx,  0, sizeof(i2c_cmd_buf_tx));
+  memcpy(&i2c_com_config_xfer, &i2c_com_config_default, sizeof(I2C_COM_CONFIG_t));
+
+  // Allocate buffers for data transmission and reception
+  // (I2C transfers are byte oriented so no alignment is required)
+  ptr_i2c_xfer_buf_rx = (uint8_t *)malloc(I2C_SERVER_BUF_SIZE);
+  ptr_i2c_xfer_buf_tx = (uint8_t *)malloc(I2C_SERVER_BUF_SIZE);
+
+  if ((ptr_i2c_xfer_buf_rx != NULL) && (ptr_i2c_xfer_buf_tx != NULL)) {
+    memset(ptr_i2c_xfer_buf_rx, 0, I2C_SERVER_BUF_SIZE);
+    memset(ptr_i2c_xfer_buf_tx, 0, I2C_SERVER_BUF_SIZE);
+    ret = EXIT_SUCCESS;
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    ret = I2C_Com_Initialize();
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    ret = I2C_Com_PowerOn();
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    ret = I2C_Com_Configure(&i2c_com_config_default);
+  }
+
+  if ((ret == EXIT_SUCCESS) && (i2c_server_thread_id == NULL)) {
+    // Create I2C_Server_Thread thread
+    i2c_server_thread_id = osThreadNew(I2C_Server_Thread, NULL, &thread_attr);
+    if (i2c_server_thread_id == NULL) {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    vioPrint(vioLevelError, "Server Start failed!");
+  }
+
+  return ret;
+}
+
+/**
+  \fn            int32_t I2C_Server_Stop (void)
+  \brief         Terminate I2C Server thread, power down and uninitialize I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+int32_t I2C_Server_Stop (void) {
+   int32_t ret;
+  uint32_t i;
+
+  ret = EXIT_FAILURE;
+
+  if (i2c_server_thread_id != NULL) {
+    i2c_server_state = I2C_SERVER_STATE_TERMINATE;
+    for (i = 0U; i < 10U; i++) {
+      if (osThreadGetState(i2c_server_thread_id) == osThreadTerminated) {
+        i2c_server_thread_id = NULL;
+        ret = EXIT_SUCCESS;
+        break;
+      }
+      (void)osDelay(100U);
+    }
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    ret = I2C_Com_PowerOff();
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    ret = I2C_Com_Uninitialize();
+  }
+
+  if (ptr_i2c_xfer_buf_rx != NULL) {
+    free(ptr_i2c_xfer_buf_rx);
+    ptr_i2c_xfer_buf_rx = NULL;
+  }
+  if (ptr_i2c_xfer_buf_tx != NULL) {
+    free(ptr_i2c_xfer_buf_tx);
+    ptr_i2c_xfer_buf_tx = NULL;
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    vioPrint(vioLevelError, "Server Stop failed! ");
+  }
+
+  return ret;
+}
+
+
+// Local functions
+
+/**
+  \fn            static void I2C_Server_Thread (void *argument)
+  \brief         I2C Server thread function.
+  \detail        This is a thread function that waits to receive a command from I2C Client
+                 (Driver Validation suite), and after command is received it is executed
+                 and the process starts again by waiting to receive next command.
+  \param[in]     argument       Not used
+  \return        none
+*/
+static void I2C_Server_Thread (void *argument) {
+  uint8_t i;
+
+  (void)argument;
+
+  for (;;) {
+    switch (i2c_server_state) {
+
+      case I2C_SERVER_STATE_RECEPTION:  // Receive a command
+        if (I2C_Com_Receive(i2c_cmd_buf_rx, sizeof(i2c_cmd_buf_rx), osWaitForever) == EXIT_SUCCESS) {
+          i2c_server_state = I2C_SERVER_STATE_EXECUTION;
+        }
+        // If 32 byte command was not received restart the reception of 32 byte command
+        break;
+
+      case I2C_SERVER_STATE_EXECUTION:  // Execute a command
+        // Find the command and call handling function
+        for (i = 0U; i < (sizeof(i2c_cmd_desc) / sizeof(I2C_CMD_DESC_t)); i++) {
+          if (memcmp(i2c_cmd_buf_rx, i2c_cmd_desc[i].command, strlen(i2c_cmd_desc[i].command)) == 0) {
+            (void)i2c_cmd_desc[i].Command_Func((const char *)i2c_cmd_buf_rx);
+            break;
+          }
+        }
+        vioPrint(vioLevelMessage, "%.20s                    ", i2c_cmd_buf_rx);
+        i2c_server_state = I2C_SERVER_STATE_RECEPTION;
+        break;
+
+      case I2C_SERVER_STATE_TERMINATE:  // Self-terminate the thread
+      default:                          // Should never happen, processed as terminate request
+        vioPrint(vioLevelError, "Server stopped!     ");
+        (void)I2C_Com_Abort();
+        (void)osThreadTerminate(osThreadGetId());
+        break;
+    }
+  }
+}
+
+/**
+  \fn            static void I2C_Com_Event (uint32_t event)
+  \brief         I2C communication event callback (called from I2C driver from IRQ context).
+  \detail        This function dispatches event (flag) to I2C Server thread.
+  \param[in]     event       I2C event
+                   - ARM_I2C_EVENT_TRANSFER_DONE:       Master/Slave Transmit/Receive finished
+                   - ARM_I2C_EVENT_TRANSFER_INCOMPLETE: Master/Slave Transmit/Receive incomplete transfer
+                   - ARM_I2C_EVENT_ADDRESS_NACK:        Address not acknowledged from Slave
+                   - ARM_I2C_EVENT_ARBITRATION_LOST:    Master lost arbitration
+                   - ARM_I2C_EVENT_BUS_ERROR:           Bus error detected (START/STOP at illegal position)
+  \return        none
+*/
+static void I2C_Com_Event (uint32_t event) {
+
+  if (i2c_server_thread_id != NULL) {
+    (void)osThreadFlagsSet(i2c_server_thread_id, event & I2C_EVENTS_MASK);
+  }
+}
+
+/**
+  \fn            static int32_t I2C_Com_Initialize (void)
+  \brief         Initialize I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Initialize (void) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drvI2C->Initialize(I2C_Com_Event) == ARM_DRIVER_OK) {
+    ret = EXIT_SUCCESS;
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Uninitialize (void)
+  \brief         Uninitialize I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Uninitialize (void) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drvI2C->Uninitialize() == ARM_DRIVER_OK) {
+    ret = EXIT_SUCCESS;
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_PowerOn (void)
+  \brief         Power-up I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_PowerOn (void) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drvI2C->PowerControl(ARM_POWER_FULL) == ARM_DRIVER_OK) {
+    ret = EXIT_SUCCESS;
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_PowerOff (void)
+  \brief         Power-down I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_PowerOff (void) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drvI2C->PowerControl(ARM_POWER_OFF) == ARM_DRIVER_OK) {
+    ret = EXIT_SUCCESS;
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Configure (const I2C_COM_CONFIG_t *config)
+  \brief         Configure I2C interface.
+  \detail        In Slave mode the own address is set to the configured address,
+                 in Master mode the own address is cleared.
+  \param[in]     config      Pointer to structure containing I2C interface configuration settings
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Configure (const I2C_COM_CONFIG_t *config) {
+   int32_t ret;
+  uint32_t own_addr;
+
+  ret = EXIT_FAILURE;
+
+  own_addr = 0U;
+  if (config->mode == 0U) {
+    own_addr = config->addr;
+    if (config->addr_10bit != 0U) {
+      own_addr |= ARM_I2C_ADDRESS_10BIT;
+    }
+  }
+
+  if (drvI2C->Control(ARM_I2C_BUS_SPEED, config->bus_speed) == ARM_DRIVER_OK) {
+    if (drvI2C->Control(ARM_I2C_OWN_ADDRESS, own_addr) == ARM_DRIVER_OK) {
+      ret = EXIT_SUCCESS;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Wait (uint32_t timeout)
+  \brief         Wait for the active transfer on I2C interface to finish.
+  \param[in]     timeout     Timeout for transfer (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Transfer finished successfully
+                   - EXIT_FAILURE: Transfer failed or timeout expired (transfer is aborted)
+*/
+static int32_t I2C_Com_Wait (uint32_t timeout) {
+  uint32_t flags, tmo, time;
+   int32_t ret;
+
+  ret  = EXIT_FAILURE;
+  time = timeout;
+
+  while (time != 0U) {
+    if (time > 100U) {
+      tmo = 100U;
+    } else {
+      tmo = time;
+    }
+    flags = osThreadFlagsWait(I2C_EVENTS_MASK, osFlagsWaitAny, tmo);
+    if (flags == osFlagsErrorTimeout) {         // If timeout
+      if (i2c_server_state == I2C_SERVER_STATE_TERMINATE) {
+        break;
+      }
+      if (time != osWaitForever) {
+        time -= tmo;
+      }
+    } else if ((flags & (0x80000000U | I2C_EVENTS_ERROR_MASK | ARM_I2C_EVENT_TRANSFER_DONE)) == ARM_I2C_EVENT_TRANSFER_DONE) {
+      // If done event was signaled without error
+      ret = EXIT_SUCCESS;
+      break;
+    } else {
+      // In all other cases exit with failed status
+      break;
+    }
+  }
+
+  if (ret != EXIT_SUCCESS) {
+    // If transfer was activated but failed then abort the transfer
+    (void)drvI2C->Control(ARM_I2C_ABORT_TRANSFER, 0U);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Receive (void *data_in, uint32_t num, uint32_t timeout)
+  \brief         Receive data (command) over I2C interface in Slave mode.
+  \param[out]    data_in     Pointer to memory where data will be received
+  \param[in]     num         Number of bytes to be received
+  \param[in]     timeout     Timeout for reception (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Receive (void *data_in, uint32_t num, uint32_t timeout) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (i2c_server_thread_id != NULL) {
+    memset(data_in, (int32_t)'?', num);
+    (void)osThreadFlagsClear(I2C_EVENTS_MASK);
+    vioSetSignal (vioLED0, vioLEDon);
+    if (drvI2C->SlaveReceive((uint8_t *)data_in, num) == ARM_DRIVER_OK) {
+      ret = I2C_Com_Wait(timeout);
+    }
+    vioSetSignal (vioLED0, vioLEDoff);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Send (const void *data_out, uint32_t num, uint32_t timeout)
+  \brief         Send data (response) over I2C interface in Slave mode.
+  \param[in]     data_out       Pointer to memory containing data to be sent
+  \param[in]     num            Number of bytes to be sent
+  \param[in]     timeout        Timeout for send (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Send (const void *data_out, uint32_t num, uint32_t timeout) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (i2c_server_thread_id != NULL) {
+    (void)osThreadFlagsClear(I2C_EVENTS_MASK);
+    vioSetSignal (vioLED1, vioLEDon);
+    if (drvI2C->SlaveTransmit((const uint8_t *)data_out, num) == ARM_DRIVER_OK) {
+      ret = I2C_Com_Wait(timeout);
+    }
+    vioSetSignal (vioLED1, vioLEDoff);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_MasterReceive (void *data_in, uint32_t num, uint32_t pending, uint32_t timeout)
+  \brief         Receive data over I2C interface in Master mode from the address set with SET COM command.
+  \param[out]    data_in        Pointer to memory where data will be received
+  \param[in]     num            Number of bytes to be received
+  \param[in]     pending        Transfer operation is pending (Stop condition will not be generated)
+  \param[in]     timeout        Timeout for reception (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_MasterReceive (void *data_in, uint32_t num, uint32_t pending, uint32_t timeout) {
+   int32_t ret;
+  uint32_t addr;
+
+  ret  = EXIT_FAILURE;
+  addr = i2c_com_config_xfer.addr;
+  if (i2c_com_config_xfer.addr_10bit != 0U) {
+    addr |= ARM_I2C_ADDRESS_10BIT;
+  }
+
+  if (i2c_server_thread_id != NULL) {
+    (void)osThreadFlagsClear(I2C_EVENTS_MASK);
+    vioSetSignal (vioLED2, vioLEDon);
+    if (drvI2C->MasterReceive(addr, (uint8_t *)data_in, num, (pending != 0U)) == ARM_DRIVER_OK) {
+      ret = I2C_Com_Wait(timeout);
+    }
+    vioSetSignal (vioLED2, vioLEDoff);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_MasterTransmit (const void *data_out, uint32_t num, uint32_t pending, uint32_t timeout)
+  \brief         Transmit data over I2C interface in Master mode to the address set with SET COM command.
+  \param[in]     data_out       Pointer to memory containing data to be sent
+  \param[in]     num            Number of bytes to be sent
+  \param[in]     pending        Transfer operation is pending (Stop condition will not be generated)
+  \param[in]     timeout        Timeout for send (in ms)
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_MasterTransmit (const void *data_out, uint32_t num, uint32_t pending, uint32_t timeout) {
+   int32_t ret;
+  uint32_t addr;
+
+  ret  = EXIT_FAILURE;
+  addr = i2c_com_config_xfer.addr;
+  if (i2c_com_config_xfer.addr_10bit != 0U) {
+    addr |= ARM_I2C_ADDRESS_10BIT;
+  }
+
+  if (i2c_server_thread_id != NULL) {
+    (void)osThreadFlagsClear(I2C_EVENTS_MASK);
+    vioSetSignal (vioLED2, vioLEDon);
+    if (drvI2C->MasterTransmit(addr, (const uint8_t *)data_out, num, (pending != 0U)) == ARM_DRIVER_OK) {
+      ret = I2C_Com_Wait(timeout);
+    }
+    vioSetSignal (vioLED2, vioLEDoff);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Com_Abort (void)
+  \brief         Abort current transfer on I2C interface.
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Com_Abort (void) {
+  int32_t ret;
+
+  ret = EXIT_FAILURE;
+
+  if (drvI2C->Control(ARM_I2C_ABORT_TRANSFER, 0U) == ARM_DRIVER_OK) {
+    ret = EXIT_SUCCESS;
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static uint32_t I2C_Com_GetCnt (void)
+  \brief         Get number of bytes transferred over I2C interface in last transfer.
+  \return        number of bytes transferred
+*/
+static uint32_t I2C_Com_GetCnt (void) {
+  return i2c_xfer_cnt;
+}
+
+
+// Command handling functions
+
+/**
+  \fn            static int32_t I2C_Cmd_GetVer (const char *cmd)
+  \brief         Handle command "GET VER".
+  \detail        Return I2C Server version over I2C interface (16 bytes).
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_GetVer (const char *cmd) {
+
+  (void)cmd;
+
+  memset(i2c_cmd_buf_tx, 0, 16);
+  memcpy(i2c_cmd_buf_tx, I2C_SERVER_VER, sizeof(I2C_SERVER_VER));
+
+  return (I2C_Com_Send(i2c_cmd_buf_tx, 16U, i2c_cmd_timeout));
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_GetCap (const char *cmd)
+  \brief         Handle command "GET CAP".
+  \detail        Return I2C Server capabilities over I2C interface (32 bytes):
+                  - bus speed mask (bit 0 = Standard, bit 1 = Fast, bit 2 = Fast+, bit 3 = High speed)
+                  - 10-bit addressing support (0 = not supported, 1 = supported)
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_GetCap (const char *cmd) {
+  ARM_I2C_CAPABILITIES capab;
+  int32_t  ret;
+  uint32_t bus_speed_mask, speed;
+
+  (void)cmd;
+
+  ret = EXIT_FAILURE;
+
+  // Determine supported bus speeds
+  bus_speed_mask = 0U;
+  for (speed = ARM_I2C_BUS_SPEED_STANDARD; speed <= ARM_I2C_BUS_SPEED_HIGH; speed++) {
+    if (drvI2C->Control(ARM_I2C_BUS_SPEED, speed) == ARM_DRIVER_OK) {
+      bus_speed_mask |= 1UL << (speed - ARM_I2C_BUS_SPEED_STANDARD);
+    }
+  }
+
+  capab = drvI2C->GetCapabilities();
+
+  // Revert communication settings to default because they were changed during auto-detection of capabilities
+  (void)I2C_Com_Configure(&i2c_com_config_default);
+
+  memset(i2c_cmd_buf_tx, 0, 32);
+  if (snprintf((char *)i2c_cmd_buf_tx, 32, "%02X,%i",
+                bus_speed_mask,
+                capab.address_10_bit) < 32) {
+    ret = I2C_Com_Send(i2c_cmd_buf_tx, 32U, i2c_cmd_timeout);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_SetBuf (const char *cmd)
+  \brief         Handle command "SET BUF RX/TX,len[,pattern]".
+  \detail        Initialize content of the buffer in the following way:
+                  - fill whole buffer with 'pattern' value if it is specified, and 'len' is 0
+                  - fill whole buffer with 0 if 'pattern' is not provided and 'len' is 0
+                  - load 'len' bytes from start of the buffer with content
+                    received in IN data phase
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_SetBuf (const char *cmd) {
+  const char     *ptr_str;
+        uint8_t  *ptr_buf;
+        uint32_t  val, len;
+        uint8_t   pattern;
+         int32_t  ret;
+
+  ret     = EXIT_SUCCESS;
+  ptr_str = NULL;
+  ptr_buf = NULL;
+  val     = 0U;
+  len     = 0U;
+  pattern = 0U;
+
+  // Parse 'RX' or 'TX' selection
+  if        (strstr(cmd, "RX") != NULL) {
+    ptr_buf = ptr_i2c_xfer_buf_rx;
+  } else if (strstr(cmd, "TX") != NULL) {
+    ptr_buf = ptr_i2c_xfer_buf_tx;
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Parse 'len'
+    ptr_str = strstr(cmd, ",");         // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if (val <= i2c_xfer_buf_size) {
+          len = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse optional 'pattern'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%x", &val) == 1) {
+        pattern = (uint8_t)val;
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_buf != NULL)) {
+    // Fill the whole buffer with 'pattern', if 'pattern' was not specified
+    // in the command then the whole buffer will be filled with 0
+    memset(ptr_buf, (int32_t)pattern, i2c_xfer_buf_size);
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_buf != NULL) && (len != 0U)) {
+    // Load 'len' bytes from start of buffer with content received in IN data phase
+    ret = I2C_Com_Receive(ptr_buf, len, i2c_cmd_timeout);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_GetBuf (const char *cmd)
+  \brief         Handle command "GET BUF RX/TX,len".
+  \detail        Send content of buffer over I2C interface.
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_GetBuf (const char *cmd) {
+  const char     *ptr_str;
+  const uint8_t  *ptr_buf;
+        uint32_t  val, len;
+         int32_t  ret;
+
+  ret      = EXIT_SUCCESS;
+  ptr_str  = NULL;
+  ptr_buf  = NULL;
+  val      = 0U;
+  len      = 0U;
+
+  // Parse 'RX' or 'TX' selection
+  if        (strstr(cmd, "RX") != NULL) {
+    ptr_buf = ptr_i2c_xfer_buf_rx;
+  } else if (strstr(cmd, "TX") != NULL) {
+    ptr_buf = ptr_i2c_xfer_buf_tx;
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Parse 'len'
+    ptr_str = strstr(cmd, ",");         // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if ((val > 0U) && (val <= i2c_xfer_buf_size)) {
+          len = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_buf != NULL) && (len != 0U)) {
+    ret = I2C_Com_Send(ptr_buf, len, i2c_cmd_timeout);
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_SetCom (const char *cmd)
+  \brief         Handle command "SET COM mode,addr,addr_10bit,bus_speed".
+  \detail        Set communication configuration settings used for transfers (XFER commands):
+                  - mode:       0 = Slave (addr is own address), 1 = Master (addr is Slave address)
+                  - addr:       address (hexadecimal)
+                  - addr_10bit: 0 = 7-bit address, 1 = 10-bit address
+                  - bus_speed:  1 = Standard, 2 = Fast, 3 = Fast+, 4 = High speed
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_SetCom (const char *cmd) {
+  const char    *ptr_str;
+        uint32_t val;
+         int32_t ret;
+
+  ret = EXIT_SUCCESS;
+  val = 0U;
+
+  ptr_str = &cmd[7];                    // Skip "SET COM"
+  while (*ptr_str == ' ') {             // Skip whitespaces
+    ptr_str++;
+  }
+
+  // Parse 'mode'
+  if (sscanf(ptr_str, "%u", &val) == 1) {
+    if (val <= 1U) {
+      i2c_com_config_xfer.mode = val;
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse 'addr'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%x", &val) == 1) {
+        if (val <= 0x3FFU) {
+          i2c_com_config_xfer.addr = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse 'addr_10bit'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if ((val <= 1U) && ((val == 1U) || (i2c_com_config_xfer.addr <= 0x7FU))) {
+          i2c_com_config_xfer.addr_10bit = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse 'bus_speed'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if ((val >= ARM_I2C_BUS_SPEED_STANDARD) && (val <= ARM_I2C_BUS_SPEED_HIGH)) {
+          i2c_com_config_xfer.bus_speed = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_Xfer (const char *cmd)
+  \brief         Handle command "XFER dir,num[,delay][,timeout]".
+  \detail        Transfer data using settings specified with "SET COM" command, data is sent from
+                 I2C TX buffer and received to I2C RX buffer (buffers must be set with "SET BUF" command
+                 before this command):
+                  - dir 0: I2C Server receives 'num' bytes
+                  - dir 1: I2C Server transmits 'num' bytes
+                  - dir 2: combined transfer of 'num' bytes written to the Slave followed by
+                           repeated start and 'num' bytes read from the Slave
+                           (in Slave mode I2C Server receives and then transmits,
+                            in Master mode I2C Server transmits and then receives)
+                 Transfer is delayed by optional parameter 'delay' in milliseconds
+                 (used in Master mode to allow the Client to prepare Slave operation).
+                 After transfer finishes or 'timeout' expires I2C Server reverts to command reception.
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_Xfer (const char *cmd) {
+  const char    *ptr_str;
+        uint32_t val, dir, num, delay;
+         int32_t ret;
+
+  ret              = EXIT_SUCCESS;
+  val              = 0U;
+  dir              = 0U;
+  num              = 0U;
+  delay            = 0U;
+  i2c_xfer_cnt     = 0U;
+  i2c_xfer_timeout = I2C_SERVER_CMD_TIMEOUT;
+
+  ptr_str = &cmd[4];                    // Skip "XFER"
+  while (*ptr_str == ' ') {             // Skip whitespaces
+    ptr_str++;
+  }
+
+  // Parse 'dir'
+  if (sscanf(ptr_str, "%u", &val) == 1) {
+    if (val <= 2U) {
+      dir = val;
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  } else {
+    ret = EXIT_FAILURE;
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse 'num'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if ((val > 0U) && (val <= i2c_xfer_buf_size)) {
+          num = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    } else {
+      ret = EXIT_FAILURE;
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse optional 'delay'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if (val != osWaitForever) {
+          delay = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    }
+  }
+
+  if ((ret == EXIT_SUCCESS) && (ptr_str != NULL)) {
+    // Parse optional 'timeout'
+    ptr_str = strstr(ptr_str, ",");     // Find ','
+    if (ptr_str != NULL) {              // If ',' was found
+      ptr_str++;                        // Skip ','
+      while (*ptr_str == ' ') {         // Skip whitespaces after ','
+        ptr_str++;
+      }
+      if (sscanf(ptr_str, "%u", &val) == 1) {
+        if ((val != 0U) && (val != osWaitForever)) {
+          i2c_xfer_timeout = val;
+        } else {
+          ret = EXIT_FAILURE;
+        }
+      } else {
+        ret = EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    // Configure communication settings before transfer
+    ret = I2C_Com_Configure(&i2c_com_config_xfer);
+  }
+
+  if ((ret == EXIT_SUCCESS) && (delay != 0U)) {
+    // Delay before transfer is started
+    (void)osDelay(delay);
+  }
+
+  if (ret == EXIT_SUCCESS) {
+    if (i2c_com_config_xfer.mode == 0U) {
+      // Slave mode
+      if ((dir == 0U) || (dir == 2U)) {
+        ret = I2C_Com_Receive(ptr_i2c_xfer_buf_rx, num, i2c_xfer_timeout);
+        i2c_xfer_cnt += (uint32_t)drvI2C->GetDataCount();
+      }
+      if ((ret == EXIT_SUCCESS) && ((dir == 1U) || (dir == 2U))) {
+        ret = I2C_Com_Send(ptr_i2c_xfer_buf_tx, num, i2c_xfer_timeout);
+        i2c_xfer_cnt += (uint32_t)drvI2C->GetDataCount();
+      }
+    } else {
+      // Master mode
+      if ((dir == 1U) || (dir == 2U)) {
+        ret = I2C_Com_MasterTransmit(ptr_i2c_xfer_buf_tx, num, (dir == 2U), i2c_xfer_timeout);
+        i2c_xfer_cnt += (uint32_t)drvI2C->GetDataCount();
+      }
+      if ((ret == EXIT_SUCCESS) && ((dir == 0U) || (dir == 2U))) {
+        ret = I2C_Com_MasterReceive(ptr_i2c_xfer_buf_rx, num, 0U, i2c_xfer_timeout);
+        i2c_xfer_cnt += (uint32_t)drvI2C->GetDataCount();
+      }
+    }
+  }
+
+  // Revert communication settings to default
+  (void)I2C_Com_Configure(&i2c_com_config_default);
+
+  return ret;
+}
+
+/**
+  \fn            static int32_t I2C_Cmd_GetCnt (const char *cmd)
+  \brief         Handle command "GET CNT".
+  \detail        Return number of bytes transferred (sent and received) in last transfer
+                 (requested by last XFER command).
+  \param[in]     cmd            Pointer to null-terminated command string
+  \return        execution status
+                   - EXIT_SUCCESS: Operation successful
+                   - EXIT_FAILURE: Operation failed
+*/
+static int32_t I2C_Cmd_GetCnt (const char *cmd) {
+  int32_t ret;
+
+  (void)cmd;
+
+  ret = EXIT_FAILURE;
+
+  memset(i2c_cmd_buf_tx, 0, 16);
+  if (snprintf((char *)i2c_cmd_buf_tx, 16, "%u", I2C_Com_GetCnt()) < 16) {
+    ret = I2C_Com_Send(i2c_cmd_buf_tx, 16U, i2c_cmd_timeout);
+  }
+
+  return ret;
+}
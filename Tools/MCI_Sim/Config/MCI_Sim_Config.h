@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     MCI Simulator
+ * Title:       MCI Simulator configuration file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef  MCI_SIM_CONFIG_H_
+#define  MCI_SIM_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h> MCI Simulator
+//   <i> Simulated memory card interface with an SD card for running DV_MCI tests on a host.
+//   <o0> Driver_MCI# <0-255>
+//     <i> Choose the Driver_MCI# instance exported by the simulator.
+//     <i> For example to export Driver_MCI0 select 0.
+//   <o1> Base clock (Hz) <1000000-400000000>
+//     <i> Bus clocks are derived from the base clock by an integer divider.
+//   <q2> 4-bit data bus
+//   <q3> 8-bit data bus
+//     <i> The simulated SD card has a 4-bit data bus, transfers with 8-bit data width fail.
+//   <q4> High speed
+//   <q5> UHS-I (1.8V signaling, SDR50, SDR104, DDR50 and tuning)
+//   <q6> Card power control
+//     <i> Card power is switched by CardPower, otherwise the card is powered with the driver.
+// </h>
+#define  MCI_SIM_DRV_NUM                0
+#define  MCI_SIM_BASE_CLOCK             208000000
+#define  MCI_SIM_BUS_4BIT               1
+#define  MCI_SIM_BUS_8BIT               0
+#define  MCI_SIM_HIGH_SPEED             1
+#define  MCI_SIM_UHS                    1
+#define  MCI_SIM_CARD_POWER             1
+
+// <h> Card
+//   <s0> Image file
+//     <i> File backing the card contents, created when it does not exist and extended to the card capacity.
+//     <i> Use an empty string to keep the card contents in memory only.
+//   <o1> Capacity (MB) <1-131072>
+//   <o2> Card capacity type <0=> SDSC (byte addressing) <1=> SDHC/SDXC (block addressing)
+//     <i> SDSC cards are limited to 1024 MB.
+//   <o3> Relative card address <0x0001-0xFFFF>
+//   <o4> Initialization polls <1-1000>
+//     <i> Number of ACMD41 commands answered with busy before the card is ready.
+// </h>
+#define  MCI_SIM_IMAGE                  "mci_sim.img"
+#define  MCI_SIM_CAPACITY               64
+#define  MCI_SIM_HC                     1
+#define  MCI_SIM_RCA                    0xB368
+#define  MCI_SIM_INIT_POLLS             10
+
+// <h> Card timing
+//   <i> Default latencies of a slow card. They can be changed at run time (see MCI_Sim.h).
+//   <o0> Command latency (ns) <0-100000000>
+//     <i> Added to the command and response bit time of every command (controller and interrupt latency).
+//   <o1> Read access time (ns) <0-100000000>
+//     <i> Time from the read command to the first data block.
+//   <o2> Write busy time per block (ns) <0-100000000>
+//     <i> Programming time after each written block; the next block is sent when the card is no longer busy.
+//   <o3> Write busy time per command (ns) <0-1000000000>
+//     <i> Additional programming time at the end of a write (after the single block or the stop command).
+// </h>
+#define  MCI_SIM_CMD_LATENCY            2000
+#define  MCI_SIM_READ_ACCESS            100000
+#define  MCI_SIM_WRITE_BUSY_BLOCK       200000
+#define  MCI_SIM_WRITE_BUSY_CMD         2000000
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     MCI Simulator
+ * Title:       MCI Simulator header file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef MCI_SIM_H_
+#define MCI_SIM_H_
+
+#include <stdint.h>
+
+#define MCI_SIM_VER                     "1.0.0"
+
+// Global functions
+
+// Simulator time (ns), processes pending command and data events
+extern uint64_t MCI_Sim_GetTime           (void);
+
+// Card timing (ns), defaults are set in MCI_Sim_Config.h
+//   cmd:        command index (0..63), latency is added to the default command latency
+//   access_ns:  read access time (read command to first data block)
+//   block_ns:   write busy time per block
+//   cmd_ns:     write busy time per write command
+extern void     MCI_Sim_SetCmdLatency     (uint32_t cmd, uint32_t latency_ns);
+extern void     MCI_Sim_SetReadAccess     (uint32_t access_ns);
+extern void     MCI_Sim_SetBusyTime       (uint32_t block_ns, uint32_t cmd_ns);
+
+#endif
@@ -0,0 +1,1141 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     MCI Simulator
+ * Title:       Simulated memory card interface (ARM_DRIVER_MCI) for host execution
+ *
+ * The simulator models one host controller with an SD card in the slot:
+ *  - card contents are backed by a memory mapped image file
+ *  - the card follows the SD state machine (idle, ready, ident, stby, tran,
+ *    data, rcv, prg) for CMD0, CMD2, CMD3, CMD6, CMD7, CMD8, CMD9, CMD10,
+ *    CMD11, CMD12, CMD13, CMD16, CMD17, CMD18, CMD19, CMD24, CMD25, CMD55,
+ *    ACMD6 and ACMD41; other commands and commands in the wrong state are
+ *    not answered (command timeout)
+ *  - command time is the command and response bit time at the bus clock plus
+ *    a configurable latency per command
+ *  - data blocks take their bit time at the bus clock and data width; reads
+ *    start after the read access time, writes keep the card busy after each
+ *    block and at the end of the write command
+ *  - data transfers fail (transfer error) when host and card data width,
+ *    the access mode (CMD6) and the bus clock or signaling do not match
+ *
+ * Command and data events are processed when the driver API or the simulator
+ * time base is called, so events are signaled in the context of the calling
+ * thread and the driver must be used from a single thread.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MCI_Sim_Config.h"
+#include "MCI_Sim.h"
+#include "Sim_Time.h"
+
+#include "Driver_MCI.h"
+
+#define ARM_MCI_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(1,0) // Driver version
+
+#define MCI_SIM_BLOCK_SIZE              512U
+#define MCI_SIM_BLOCKS                  ((uint32_t)MCI_SIM_CAPACITY * 2048U)
+
+// Card states (card status bits 12:9)
+#define MCI_SIM_ST_IDLE                 0U
+#define MCI_SIM_ST_READY                1U
+#define MCI_SIM_ST_IDENT                2U
+#define MCI_SIM_ST_STBY                 3U
+#define MCI_SIM_ST_TRAN                 4U
+#define MCI_SIM_ST_DATA                 5U
+#define MCI_SIM_ST_RCV                  6U
+#define MCI_SIM_ST_PRG                  7U
+#define MCI_SIM_ST_OFF                  15U
+
+// Card status (R1) bits
+#define MCI_SIM_R1_OUT_OF_RANGE         (1UL << 31)
+#define MCI_SIM_R1_ADDRESS_ERROR        (1UL << 30)
+#define MCI_SIM_R1_BLOCK_LEN_ERROR      (1UL << 29)
+#define MCI_SIM_R1_ILLEGAL_COMMAND      (1UL << 22)
+#define MCI_SIM_R1_READY_FOR_DATA       (1UL << 8)
+#define MCI_SIM_R1_APP_CMD              (1UL << 5)
+
+// OCR bits
+#define MCI_SIM_OCR_BUSY                (1UL << 31)
+#define MCI_SIM_OCR_CCS                 (1UL << 30)
+#define MCI_SIM_OCR_S18                 (1UL << 24)
+#define MCI_SIM_OCR_VDD                 0x00FF8000U
+
+// Bus cycles of command (48), Ncr (8), short (48) or long (136) response and Nrc (8)
+#define MCI_SIM_CMD_CLOCKS              (48U + 8U + 8U)
+// Bus cycles of data block start and end bits, CRC16 and write CRC status token
+#define MCI_SIM_BLOCK_CLOCKS            (2U + 16U)
+#define MCI_SIM_CRC_STATUS_CLOCKS       8U
+// Default data timeout (ns)
+#define MCI_SIM_DATA_TIMEOUT            100000000U
+
+// Data phase of the last command
+#define MCI_SIM_XFER_NONE               0U
+#define MCI_SIM_XFER_READ               1U      // Read card blocks
+#define MCI_SIM_XFER_WRITE              2U      // Write card blocks
+#define MCI_SIM_XFER_REG                3U      // Read 64-byte register (switch status, tuning block)
+
+typedef struct {
+  ARM_MCI_SignalEvent_t cb_event;
+  uint8_t          initialized;
+  uint8_t          powered;
+  uint8_t          in_process;          // Event processing or callback active (callbacks may call the driver)
+  // Host controller
+  uint32_t         clock;               // Bus clock (Hz)
+  uint8_t          width;               // ARM_MCI_BUS_DATA_WIDTH_x
+  uint8_t          speed_mode;          // ARM_MCI_BUS_x speed mode
+  uint8_t          vccq_1v8;            // 1.8V signaling
+  uint8_t          tuning;              // Tuning in progress
+  uint8_t          tuned;               // Sampling clock tuned
+  uint32_t         data_timeout;        // Data timeout (ns)
+  ARM_MCI_STATUS   status;
+  // Command
+  uint8_t          cmd_active;
+  uint8_t          resp_num;            // Number of response words
+  uint32_t         cmd_event;           // Event signaled at command end
+  uint64_t         cmd_end;             // Command end (ns)
+  uint32_t         resp[4];
+  uint32_t        *resp_ptr;
+  // Data transfer
+  uint8_t          xfer_setup;          // SetupTransfer called
+  uint8_t          xfer_pending;        // Data phase starts at command end
+  uint8_t          xfer_active;
+  uint8_t          xfer_kind;           // MCI_SIM_XFER_x
+  uint8_t          xfer_multi;          // Multiple block command (ends with CMD12)
+  uint8_t         *xfer_data;
+  uint32_t         xfer_cnt;            // Number of blocks
+  uint32_t         xfer_size;           // Block size
+  uint32_t         xfer_mode;           // ARM_MCI_TRANSFER_x
+  uint32_t         xfer_done;           // Number of blocks transferred
+  uint32_t         xfer_block;          // Next card block
+  uint32_t         xfer_event;          // Event signaled at transfer end
+  uint64_t         xfer_next;           // End of next block or of the failing transfer (ns)
+  uint8_t          reg[64];             // Register data (switch status, tuning block)
+  // Card
+  uint8_t          card_state;          // MCI_SIM_ST_x
+  uint8_t          app_cmd;             // Next command is application specific
+  uint8_t          v2;                  // CMD8 received (physical layer 2.00 or later host)
+  uint8_t          s18a;                // 1.8V signaling accepted by ACMD41
+  uint8_t          card_1v8;            // Card switched to 1.8V signaling (CMD11)
+  uint8_t          card_4bit;           // Card 4-bit data bus (ACMD6)
+  uint8_t          card_func;           // Access mode (CMD6 function group 1)
+  uint8_t          func_pending;        // Access mode switched after the switch status is sent, 0xFF if none
+  uint32_t         init_polls;          // ACMD41 count
+  uint32_t         ocr;
+  uint32_t         status_err;          // Error bits reported with next R1
+  uint64_t         busy_end;            // End of programming (ns)
+  // Image
+  uint8_t         *image;
+  int              fd;
+} MCI_SIM;
+
+static MCI_SIM  mci_sim;
+
+// Card timing (ns)
+static uint32_t cmd_latency[64];
+static uint32_t read_access   = MCI_SIM_READ_ACCESS;
+static uint32_t busy_block    = MCI_SIM_WRITE_BUSY_BLOCK;
+static uint32_t busy_cmd      = MCI_SIM_WRITE_BUSY_CMD;
+
+// SD tuning block pattern (4-bit bus)
+static const uint8_t tuning_block[64] = {
+  0xFFU, 0x0FU, 0xFFU, 0x00U, 0xFFU, 0xCCU, 0xC3U, 0xCCU, 0xC3U, 0x3CU, 0xCCU, 0xFFU, 0xFEU, 0xFFU, 0xFEU, 0xEFU,
+  0xFFU, 0xDFU, 0xFFU, 0xDDU, 0xFFU, 0xFBU, 0xFFU, 0xFBU, 0xBFU, 0xFFU, 0x7FU, 0xFFU, 0x77U, 0xF7U, 0xBDU, 0xEFU,
+  0xFFU, 0xF0U, 0xFFU, 0xF0U, 0x0FU, 0xFCU, 0xCCU, 0x3CU, 0xCCU, 0x33U, 0xCCU, 0xCFU, 0xFFU, 0xEFU, 0xFFU, 0xEEU,
+  0xFFU, 0xFDU, 0xFFU, 0xFDU, 0xDFU, 0xFFU, 0xBFU, 0xFFU, 0xBBU, 0xFFU, 0xF7U, 0xFFU, 0xF7U, 0x7FU, 0x7BU, 0xDEU
+};
+
+// Maximum bus clock of the access modes (CMD6 function group 1)
+static const uint32_t func_clock[5] = { 25000000U, 50000000U, 100000000U, 208000000U, 50000000U };
+
+// Driver Version
+static const ARM_DRIVER_VERSION mci_driver_version = { ARM_MCI_API_VERSION, ARM_MCI_DRV_VERSION };
+
+// Driver Capabilities
+static const ARM_MCI_CAPABILITIES mci_driver_capabilities = {
+  1U,                                   // cd_state
+  0U,                                   // cd_event
+  1U,                                   // wp_state
+  (MCI_SIM_CARD_POWER != 0) ? 1U : 0U,  // vdd
+  0U,                                   // vdd_1v8
+  (MCI_SIM_CARD_POWER != 0) ? 1U : 0U,  // vccq
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // vccq_1v8
+  0U,                                   // vccq_1v2
+  (MCI_SIM_BUS_4BIT   != 0) ? 1U : 0U,  // data_width_4
+  (MCI_SIM_BUS_8BIT   != 0) ? 1U : 0U,  // data_width_8
+  ((MCI_SIM_BUS_4BIT != 0) && (MCI_SIM_UHS != 0)) ? 1U : 0U,    // data_width_4_ddr
+  ((MCI_SIM_BUS_8BIT != 0) && (MCI_SIM_UHS != 0)) ? 1U : 0U,    // data_width_8_ddr
+  (MCI_SIM_HIGH_SPEED != 0) ? 1U : 0U,  // high_speed
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // uhs_signaling
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // uhs_tuning
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // uhs_sdr50
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // uhs_sdr104
+  (MCI_SIM_UHS        != 0) ? 1U : 0U,  // uhs_ddr50
+  0U,                                   // uhs_driver_type_a
+  0U,                                   // uhs_driver_type_c
+  0U,                                   // uhs_driver_type_d
+  0U,                                   // sdio_interrupt
+  0U,                                   // read_wait
+  0U,                                   // suspend_resume
+  0U,                                   // mmc_interrupt
+  0U,                                   // mmc_boot
+  0U,                                   // rst_n
+  0U,                                   // ccs
+  0U,                                   // ccs_timeout
+  0U                                    // Reserved (must be zero)
+};
+
+// Local functions
+
+// Time of bus clock cycles (ns)
+static uint64_t MCI_Sim_ClockNs (uint32_t clocks) {
+  return ((uint64_t)clocks * 1000000000U) / mci_sim.clock;
+}
+
+// Time of a data block (ns)
+static uint64_t MCI_Sim_BlockNs (uint32_t size, uint32_t write) {
+  uint32_t clocks;
+
+  switch (mci_sim.width) {
+    case ARM_MCI_BUS_DATA_WIDTH_4:     clocks = (size * 8U) / 4U;  break;
+    case ARM_MCI_BUS_DATA_WIDTH_8:     clocks = (size * 8U) / 8U;  break;
+    case ARM_MCI_BUS_DATA_WIDTH_4_DDR: clocks = (size * 8U) / 8U;  break;
+    case ARM_MCI_BUS_DATA_WIDTH_8_DDR: clocks = (size * 8U) / 16U; break;
+    default:                           clocks =  size * 8U;        break;
+  }
+  clocks += MCI_SIM_BLOCK_CLOCKS;
+  if (write != 0U) {
+    clocks += MCI_SIM_CRC_STATUS_CLOCKS;
+  }
+  return MCI_Sim_ClockNs(clocks);
+}
+
+// Check if data can be exchanged with the card at the current bus settings, returns 1 if not
+static uint32_t MCI_Sim_BusError (void) {
+  uint32_t host_4bit, ddr;
+
+  host_4bit = ((mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_4) || (mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_4_DDR)) ? 1U : 0U;
+  ddr       = ((mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_4_DDR) || (mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_8_DDR)) ? 1U : 0U;
+
+  if ((mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_8) || (mci_sim.width == ARM_MCI_BUS_DATA_WIDTH_8_DDR)) {
+    return 1U;
+  }
+  if (host_4bit != mci_sim.card_4bit) {
+    return 1U;
+  }
+  if (ddr != ((mci_sim.card_func == 4U) ? 1U : 0U)) {
+    return 1U;
+  }
+  if (mci_sim.clock > func_clock[mci_sim.card_func]) {
+    return 1U;
+  }
+  if ((mci_sim.card_1v8 != 0U) && (mci_sim.vccq_1v8 == 0U)) {
+    return 1U;
+  }
+  if ((mci_sim.card_func == 3U) && (mci_sim.tuned == 0U) && (mci_sim.tuning == 0U)) {
+    return 1U;
+  }
+  return 0U;
+}
+
+// Set bit field in response (resp[0] holds bits 31:0)
+static void MCI_Sim_SetBits (uint32_t *resp, uint32_t pos, uint32_t len, uint32_t val) {
+  uint32_t i, bit;
+
+  for (i = 0U; i < len; i++) {
+    if ((val & (1UL << i)) != 0U) {
+      bit = pos + i;
+      resp[bit / 32U] |= 1UL << (bit % 32U);
+    }
+  }
+}
+
+// Card identification register
+static void MCI_Sim_Cid (uint32_t *resp) {
+
+  memset(resp, 0, 16U);
+  MCI_Sim_SetBits(resp, 120U,  8U, 0x00U);                // MID
+  MCI_Sim_SetBits(resp, 104U, 16U, ('S' << 8) | 'M');     // OID
+  MCI_Sim_SetBits(resp,  96U,  8U, 'D');                  // PNM "DVSIM"
+  MCI_Sim_SetBits(resp,  64U, 32U, ('V' << 24) | ('S' << 16) | ('I' << 8) | 'M');
+  MCI_Sim_SetBits(resp,  56U,  8U, 0x10U);                // PRV
+  MCI_Sim_SetBits(resp,  24U, 32U, 0x12345678U);          // PSN
+  MCI_Sim_SetBits(resp,   8U, 12U, (26U << 4) | 10U);     // MDT
+  MCI_Sim_SetBits(resp,   0U,  1U, 1U);
+}
+
+// Card specific data register
+static void MCI_Sim_Csd (uint32_t *resp) {
+
+  memset(resp, 0, 16U);
+#if (MCI_SIM_HC != 0)
+  MCI_Sim_SetBits(resp, 126U,  2U, 1U);                   // CSD_STRUCTURE 2.0
+  MCI_Sim_SetBits(resp, 112U,  8U, 0x0EU);                // TAAC
+  MCI_Sim_SetBits(resp,  84U, 12U, 0x5B5U);               // CCC
+  MCI_Sim_SetBits(resp,  48U, 22U, (MCI_SIM_BLOCKS / 1024U) - 1U);
+#else
+  MCI_Sim_SetBits(resp, 126U,  2U, 0U);                   // CSD_STRUCTURE 1.0
+  MCI_Sim_SetBits(resp, 112U,  8U, 0x26U);                // TAAC
+  MCI_Sim_SetBits(resp,  84U, 12U, 0x5F5U);               // CCC
+  MCI_Sim_SetBits(resp,  62U, 12U, (MCI_SIM_BLOCKS / 512U) - 1U);
+  MCI_Sim_SetBits(resp,  47U,  3U, 7U);                   // C_SIZE_MULT
+#endif
+  MCI_Sim_SetBits(resp,  96U,  8U, 0x32U);                // TRAN_SPEED 25MHz
+  MCI_Sim_SetBits(resp,  80U,  4U, 9U);                   // READ_BL_LEN 512
+  MCI_Sim_SetBits(resp,  46U,  1U, 1U);                   // ERASE_BLK_EN
+  MCI_Sim_SetBits(resp,  39U,  7U, 0x7FU);                // SECTOR_SIZE
+  MCI_Sim_SetBits(resp,  22U,  4U, 9U);                   // WRITE_BL_LEN 512
+  MCI_Sim_SetBits(resp,   0U,  1U, 1U);
+}
+
+// Card status (R1), error bits are cleared when reported
+static uint32_t MCI_Sim_CardStatus (void) {
+  uint32_t status;
+
+  status = ((uint32_t)mci_sim.card_state << 9) | mci_sim.status_err;
+  if ((mci_sim.card_state != MCI_SIM_ST_PRG) && (mci_sim.card_state != MCI_SIM_ST_RCV)) {
+    status |= MCI_SIM_R1_READY_FOR_DATA;
+  }
+  if (mci_sim.app_cmd != 0U) {
+    status |= MCI_SIM_R1_APP_CMD;
+  }
+  mci_sim.status_err = 0U;
+
+  return status;
+}
+
+// Reset card to idle state
+static void MCI_Sim_CardReset (uint32_t power_on) {
+
+  mci_sim.card_state = MCI_SIM_ST_IDLE;
+  mci_sim.app_cmd    = 0U;
+  mci_sim.v2         = 0U;
+  mci_sim.s18a       = 0U;
+  mci_sim.card_4bit  = 0U;
+  mci_sim.card_func  = 0U;
+  mci_sim.func_pending = 0xFFU;
+  mci_sim.init_polls = 0U;
+  mci_sim.ocr        = 0U;
+  mci_sim.status_err = 0U;
+  mci_sim.busy_end   = 0U;
+  if (power_on != 0U) {
+    // Only a power cycle returns the card to 3.3V signaling
+    mci_sim.card_1v8 = 0U;
+  }
+}
+
+// Card block of a data address, returns 0 if address is invalid (error bits are set)
+static uint32_t MCI_Sim_Block (uint32_t arg, uint32_t *block) {
+
+#if (MCI_SIM_HC != 0)
+  *block = arg;
+#else
+  if ((arg % MCI_SIM_BLOCK_SIZE) != 0U) {
+    mci_sim.status_err |= MCI_SIM_R1_ADDRESS_ERROR;
+    return 0U;
+  }
+  *block = arg / MCI_SIM_BLOCK_SIZE;
+#endif
+  if (*block >= MCI_SIM_BLOCKS) {
+    mci_sim.status_err |= MCI_SIM_R1_OUT_OF_RANGE;
+    return 0U;
+  }
+  return 1U;
+}
+
+// Execute command on the card, returns 1 if the card responds
+static uint32_t MCI_Sim_Execute (uint32_t cmd, uint32_t arg, uint64_t now) {
+  uint32_t app, rca_ok, block, func;
+  uint8_t  state;
+
+  app    = mci_sim.app_cmd;
+  state  = mci_sim.card_state;
+  rca_ok = ((arg >> 16) == MCI_SIM_RCA) ? 1U : 0U;
+
+  mci_sim.app_cmd = 0U;
+  if (state == MCI_SIM_ST_OFF) {
+    return 0U;
+  }
+
+  switch (cmd) {
+    case 0U:                            // GO_IDLE_STATE
+      MCI_Sim_CardReset(0U);
+      return 0U;
+
+    case 2U:                            // ALL_SEND_CID
+      if (state != MCI_SIM_ST_READY) { break; }
+      MCI_Sim_Cid(mci_sim.resp);
+      mci_sim.card_state = MCI_SIM_ST_IDENT;
+      return 1U;
+
+    case 3U:                            // SEND_RELATIVE_ADDR
+      if ((state != MCI_SIM_ST_IDENT) && (state != MCI_SIM_ST_STBY)) { break; }
+      mci_sim.card_state = MCI_SIM_ST_STBY;
+      mci_sim.resp[0] = ((uint32_t)MCI_SIM_RCA << 16) | (MCI_Sim_CardStatus() & 0x1FFFU);
+      return 1U;
+
+    case 6U:
+      if (state != MCI_SIM_ST_TRAN) { break; }
+      mci_sim.resp[0] = MCI_Sim_CardStatus();
+      if (app != 0U) {                  // SET_BUS_WIDTH
+        mci_sim.card_4bit = ((arg & 3U) == 2U) ? 1U : 0U;
+        return 1U;
+      }
+      // SWITCH_FUNC: 512-bit status of function group 1 (access mode)
+      func = arg & 0x0FU;
+      memset(mci_sim.reg, 0, sizeof(mci_sim.reg));
+      mci_sim.reg[1]  = 100U;           // Maximum current (mA)
+      mci_sim.reg[13] = 0x01U;
+      if (MCI_SIM_HIGH_SPEED != 0) { mci_sim.reg[13] |= 0x02U; }
+      if (mci_sim.card_1v8 != 0U)  { mci_sim.reg[13] |= 0x1EU; }
+      if ((func == 0x0FU) || ((func < 8U) && ((mci_sim.reg[13] & (1U << func)) != 0U))) {
+        if (func == 0x0FU) { func = mci_sim.card_func; }
+        if ((arg & (1UL << 31)) != 0U) {
+          mci_sim.func_pending = (uint8_t)func;
+        }
+        mci_sim.reg[16] = (uint8_t)func;
+      } else {
+        mci_sim.reg[16] = 0x0FU;
+      }
+      mci_sim.xfer_kind  = MCI_SIM_XFER_REG;
+      mci_sim.card_state = MCI_SIM_ST_DATA;
+      return 1U;
+
+    case 7U:                            // SELECT/DESELECT_CARD
+      if (rca_ok == 0U) {
+        if (state == MCI_SIM_ST_TRAN) { mci_sim.card_state = MCI_SIM_ST_STBY; }
+        return 0U;
+      }
+      if ((state != MCI_SIM_ST_STBY) && (state != MCI_SIM_ST_TRAN)) { break; }
+      mci_sim.resp[0]    = MCI_Sim_CardStatus();
+      mci_sim.card_state = MCI_SIM_ST_TRAN;
+      return 1U;
+
+    case 8U:                            // SEND_IF_COND
+      if ((state != MCI_SIM_ST_IDLE) || (((arg >> 8) & 0x0FU) != 1U)) { break; }
+      mci_sim.v2      = 1U;
+      mci_sim.resp[0] = arg & 0xFFFU;
+      return 1U;
+
+    case 9U:                            // SEND_CSD
+    case 10U:                           // SEND_CID
+      if ((state != MCI_SIM_ST_STBY) || (rca_ok == 0U)) { break; }
+      if (cmd == 9U) {
+        MCI_Sim_Csd(mci_sim.resp);
+      } else {
+        MCI_Sim_Cid(mci_sim.resp);
+      }
+      return 1U;
+
+    case 11U:                           // VOLTAGE_SWITCH
+      if ((state != MCI_SIM_ST_READY) || (mci_sim.s18a == 0U)) { break; }
+      mci_sim.card_1v8 = 1U;
+      mci_sim.resp[0]  = MCI_Sim_CardStatus();
+      return 1U;
+
+    case 12U:                           // STOP_TRANSMISSION
+      if ((state != MCI_SIM_ST_DATA) && (state != MCI_SIM_ST_RCV)) { break; }
+      mci_sim.resp[0] = MCI_Sim_CardStatus();
+      if (state == MCI_SIM_ST_RCV) {
+        if (mci_sim.busy_end < now) { mci_sim.busy_end = now; }
+        mci_sim.busy_end  += busy_cmd;
+        mci_sim.card_state = MCI_SIM_ST_PRG;
+      } else {
+        mci_sim.card_state = MCI_SIM_ST_TRAN;
+      }
+      return 1U;
+
+    case 13U:                           // SEND_STATUS
+      if ((state < MCI_SIM_ST_STBY) || (rca_ok == 0U)) { break; }
+      mci_sim.app_cmd = (uint8_t)app;
+      mci_sim.resp[0] = MCI_Sim_CardStatus();
+      mci_sim.app_cmd = 0U;
+      return 1U;
+
+    case 16U:                           // SET_BLOCKLEN
+      if (state != MCI_SIM_ST_TRAN) { break; }
+      if (arg != MCI_SIM_BLOCK_SIZE) {
+        mci_sim.status_err |= MCI_SIM_R1_BLOCK_LEN_ERROR;
+      }
+      mci_sim.resp[0] = MCI_Sim_CardStatus();
+      return 1U;
+
+    case 17U:                           // READ_SINGLE_BLOCK
+    case 18U:                           // READ_MULTIPLE_BLOCK
+    case 24U:                           // WRITE_BLOCK
+    case 25U:                           // WRITE_MULTIPLE_BLOCK
+      if (state != MCI_SIM_ST_TRAN) { break; }
+      if (MCI_Sim_Block(arg, &block) != 0U) {
+        mci_sim.xfer_kind  = (cmd < 24U) ? MCI_SIM_XFER_READ : MCI_SIM_XFER_WRITE;
+        mci_sim.xfer_multi = ((cmd == 18U) || (cmd == 25U)) ? 1U : 0U;
+        mci_sim.xfer_block = block;
+        mci_sim.resp[0]    = MCI_Sim_CardStatus();
+        mci_sim.card_state = (cmd < 24U) ? MCI_SIM_ST_DATA : MCI_SIM_ST_RCV;
+      } else {
+        mci_sim.resp[0]    = MCI_Sim_CardStatus();
+      }
+      return 1U;
+
+    case 19U:                           // SEND_TUNING_BLOCK
+      if ((state != MCI_SIM_ST_TRAN) || (mci_sim.card_1v8 == 0U)) { break; }
+      memcpy(mci_sim.reg, tuning_block, sizeof(mci_sim.reg));
+      mci_sim.resp[0]    = MCI_Sim_CardStatus();
+      mci_sim.xfer_kind  = MCI_SIM_XFER_REG;
+      mci_sim.card_state = MCI_SIM_ST_DATA;
+      return 1U;
+
+    case 41U:                           // SD_SEND_OP_COND
+      if ((app == 0U) || (state != MCI_SIM_ST_IDLE)) { break; }
+      if ((arg & MCI_SIM_OCR_VDD) != 0U) {
+        mci_sim.init_polls++;
+        // High capacity cards stay busy if the host does not support them
+        if ((mci_sim.init_polls >= MCI_SIM_INIT_POLLS) &&
+            ((MCI_SIM_HC == 0) || ((mci_sim.v2 != 0U) && ((arg & MCI_SIM_OCR_CCS) != 0U)))) {
+          mci_sim.ocr = MCI_SIM_OCR_BUSY | MCI_SIM_OCR_VDD;
+          if (MCI_SIM_HC != 0) {
+            mci_sim.ocr |= MCI_SIM_OCR_CCS;
+          }
+          if ((MCI_SIM_UHS != 0) && (mci_sim.v2 != 0U) && ((arg & MCI_SIM_OCR_S18) != 0U) && (mci_sim.card_1v8 == 0U)) {
+            mci_sim.ocr |= MCI_SIM_OCR_S18;
+            mci_sim.s18a = 1U;
+          }
+          mci_sim.card_state = MCI_SIM_ST_READY;
+        }
+      }
+      mci_sim.resp[0] = mci_sim.ocr | MCI_SIM_OCR_VDD;
+      return 1U;
+
+    case 55U:                           // APP_CMD
+      if ((state != MCI_SIM_ST_IDLE) && (rca_ok == 0U)) { break; }
+      mci_sim.app_cmd = 1U;
+      mci_sim.resp[0] = MCI_Sim_CardStatus();
+      return 1U;
+
+    default:
+      break;
+  }
+
+  mci_sim.status_err |= MCI_SIM_R1_ILLEGAL_COMMAND;
+  return 0U;
+}
+
+// Switch access mode selected by CMD6
+static void MCI_Sim_SwitchFunc (void) {
+
+  if (mci_sim.func_pending != 0xFFU) {
+    mci_sim.card_func    = mci_sim.func_pending;
+    mci_sim.func_pending = 0xFFU;
+    mci_sim.tuned        = 0U;
+  }
+}
+
+// Start data phase at time t
+static void MCI_Sim_XferStart (uint64_t t) {
+  uint32_t ok, err;
+
+  mci_sim.xfer_active            = 1U;
+  mci_sim.xfer_done              = 0U;
+  mci_sim.xfer_event             = ARM_MCI_EVENT_TRANSFER_COMPLETE;
+  mci_sim.status.transfer_active = 1U;
+
+  if (mci_sim.xfer_kind == MCI_SIM_XFER_NONE) {
+    // Card sends no data
+    mci_sim.xfer_event = ARM_MCI_EVENT_TRANSFER_TIMEOUT;
+    mci_sim.xfer_next  = t + mci_sim.data_timeout;
+    return;
+  }
+
+  if (mci_sim.xfer_kind == MCI_SIM_XFER_REG) {
+    ok = ((mci_sim.xfer_mode & ARM_MCI_TRANSFER_WRITE) == 0U) && (mci_sim.xfer_size == 64U) && (mci_sim.xfer_cnt == 1U);
+  } else {
+    ok = (mci_sim.xfer_size == MCI_SIM_BLOCK_SIZE) &&
+         (((mci_sim.xfer_mode & ARM_MCI_TRANSFER_WRITE) != 0U) == (mci_sim.xfer_kind == MCI_SIM_XFER_WRITE)) &&
+         ((mci_sim.xfer_multi != 0U) || (mci_sim.xfer_cnt == 1U));
+  }
+  // Switch status is sent in the previous access mode
+  err = MCI_Sim_BusError();
+  MCI_Sim_SwitchFunc();
+  if ((ok == 0U) || (err != 0U)) {
+    // CRC errors or wrong data direction
+    mci_sim.xfer_event = ARM_MCI_EVENT_TRANSFER_ERROR;
+    mci_sim.xfer_next  = t + MCI_Sim_BlockNs(mci_sim.xfer_size, 0U);
+    return;
+  }
+
+  if (mci_sim.xfer_kind == MCI_SIM_XFER_WRITE) {
+    mci_sim.xfer_next = t + MCI_Sim_BlockNs(mci_sim.xfer_size, 1U);
+  } else {
+    mci_sim.xfer_next = t + read_access + MCI_Sim_BlockNs(mci_sim.xfer_size, 0U);
+  }
+}
+
+// Process command and data events up to current time
+static void MCI_Sim_Process (void) {
+  uint64_t now;
+  uint32_t events;
+  uint8_t *data;
+
+  if ((mci_sim.in_process != 0U) || (mci_sim.powered == 0U)) {
+    return;
+  }
+  mci_sim.in_process = 1U;
+  now    = Sim_Time_Now();
+  events = 0U;
+
+  if ((mci_sim.cmd_active != 0U) && (now >= mci_sim.cmd_end)) {
+    mci_sim.cmd_active = 0U;
+    mci_sim.status.command_active = 0U;
+    if (mci_sim.cmd_event == ARM_MCI_EVENT_COMMAND_TIMEOUT) {
+      mci_sim.status.command_timeout = 1U;
+    } else if ((mci_sim.resp_ptr != NULL) && (mci_sim.resp_num != 0U)) {
+      memcpy(mci_sim.resp_ptr, mci_sim.resp, mci_sim.resp_num * sizeof(uint32_t));
+    }
+    events |= mci_sim.cmd_event;
+    if (mci_sim.xfer_pending != 0U) {
+      mci_sim.xfer_pending = 0U;
+      MCI_Sim_XferStart(mci_sim.cmd_end);
+    }
+  }
+
+  while ((mci_sim.xfer_active != 0U) && (now >= mci_sim.xfer_next)) {
+    if (mci_sim.xfer_event != ARM_MCI_EVENT_TRANSFER_COMPLETE) {
+      mci_sim.xfer_active = 0U;
+      mci_sim.status.transfer_active = 0U;
+      if (mci_sim.xfer_event == ARM_MCI_EVENT_TRANSFER_TIMEOUT) {
+        mci_sim.status.transfer_timeout = 1U;
+      } else {
+        mci_sim.status.transfer_error   = 1U;
+      }
+      if (mci_sim.xfer_multi == 0U) {
+        if (mci_sim.card_state == MCI_SIM_ST_DATA) { mci_sim.card_state = MCI_SIM_ST_TRAN; }
+        if (mci_sim.card_state == MCI_SIM_ST_RCV)  { mci_sim.card_state = MCI_SIM_ST_TRAN; }
+      }
+      events |= mci_sim.xfer_event;
+      break;
+    }
+    if ((mci_sim.xfer_kind != MCI_SIM_XFER_REG) && (mci_sim.xfer_block >= MCI_SIM_BLOCKS)) {
+      // Multiple block transfer beyond the card end
+      mci_sim.status_err |= MCI_SIM_R1_OUT_OF_RANGE;
+      mci_sim.xfer_event  = ARM_MCI_EVENT_TRANSFER_ERROR;
+      continue;
+    }
+
+    data = mci_sim.xfer_data + (mci_sim.xfer_done * mci_sim.xfer_size);
+    switch (mci_sim.xfer_kind) {
+      case MCI_SIM_XFER_READ:
+        memcpy(data, &mci_sim.image[(size_t)mci_sim.xfer_block * MCI_SIM_BLOCK_SIZE], MCI_SIM_BLOCK_SIZE);
+        break;
+      case MCI_SIM_XFER_WRITE:
+        memcpy(&mci_sim.image[(size_t)mci_sim.xfer_block * MCI_SIM_BLOCK_SIZE], data, MCI_SIM_BLOCK_SIZE);
+        mci_sim.busy_end = mci_sim.xfer_next + busy_block;
+        break;
+      default:
+        memcpy(data, mci_sim.reg, mci_sim.xfer_size);
+        break;
+    }
+    mci_sim.xfer_done++;
+    mci_sim.xfer_block++;
+
+    if (mci_sim.xfer_done == mci_sim.xfer_cnt) {
+      mci_sim.xfer_active = 0U;
+      mci_sim.status.transfer_active = 0U;
+      events |= ARM_MCI_EVENT_TRANSFER_COMPLETE;
+      if (mci_sim.xfer_kind == MCI_SIM_XFER_REG) {
+        mci_sim.card_state = MCI_SIM_ST_TRAN;
+        if (mci_sim.tuning != 0U) {
+          mci_sim.tuning = 0U;
+          mci_sim.tuned  = 1U;
+        }
+      } else if (mci_sim.xfer_multi == 0U) {
+        if (mci_sim.xfer_kind == MCI_SIM_XFER_WRITE) {
+          mci_sim.busy_end  += busy_cmd;
+          mci_sim.card_state = MCI_SIM_ST_PRG;
+        } else {
+          mci_sim.card_state = MCI_SIM_ST_TRAN;
+        }
+      }
+      break;
+    }
+
+    if (mci_sim.xfer_kind == MCI_SIM_XFER_WRITE) {
+      // Next block is sent when the card finished programming
+      mci_sim.xfer_next = mci_sim.busy_end + MCI_Sim_BlockNs(MCI_SIM_BLOCK_SIZE, 1U);
+    } else {
+      mci_sim.xfer_next += MCI_Sim_BlockNs(MCI_SIM_BLOCK_SIZE, 0U);
+    }
+  }
+
+  if ((mci_sim.card_state == MCI_SIM_ST_PRG) && (now >= mci_sim.busy_end)) {
+    mci_sim.card_state = MCI_SIM_ST_TRAN;
+  }
+
+  // Time does not advance and no further events are processed while the callback runs, so the
+  // timestamps taken in the callback are the event time (data phase completes in a later pass)
+  if ((events != 0U) && (mci_sim.cb_event != NULL)) {
+    mci_sim.cb_event(events);
+  }
+
+  mci_sim.in_process = 0U;
+}
+
+// Map card image
+static int32_t MCI_Sim_ImageOpen (void) {
+  size_t      size;
+  struct stat st;
+
+  size = (size_t)MCI_SIM_BLOCKS * MCI_SIM_BLOCK_SIZE;
+  mci_sim.fd = -1;
+
+  if (MCI_SIM_IMAGE[0] == '\0') {
+    mci_sim.image = (uint8_t *)calloc(1U, size);
+    return (mci_sim.image != NULL) ? ARM_DRIVER_OK : ARM_DRIVER_ERROR;
+  }
+
+  mci_sim.fd = open(MCI_SIM_IMAGE, O_RDWR | O_CREAT, 0644);
+  if (mci_sim.fd < 0) {
+    return ARM_DRIVER_ERROR;
+  }
+  if ((fstat(mci_sim.fd, &st) != 0) || (((size_t)st.st_size < size) && (ftruncate(mci_sim.fd, (off_t)size) != 0))) {
+    close(mci_sim.fd);
+    mci_sim.fd = -1;
+    return ARM_DRIVER_ERROR;
+  }
+  mci_sim.image = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mci_sim.fd, 0);
+  if (mci_sim.image == MAP_FAILED) {
+    mci_sim.image = NULL;
+    close(mci_sim.fd);
+    mci_sim.fd = -1;
+    return ARM_DRIVER_ERROR;
+  }
+
+  return ARM_DRIVER_OK;
+}
+
+// Unmap card image
+static void MCI_Sim_ImageClose (void) {
+
+  if (mci_sim.image == NULL) {
+    return;
+  }
+  if (mci_sim.fd < 0) {
+    free(mci_sim.image);
+  } else {
+    (void)munmap(mci_sim.image, (size_t)MCI_SIM_BLOCKS * MCI_SIM_BLOCK_SIZE);
+    close(mci_sim.fd);
+    mci_sim.fd = -1;
+  }
+  mci_sim.image = NULL;
+}
+
+// Time of next command or data event for the time base (ns)
+static uint64_t MCI_Sim_NextEvent (void) {
+  if (mci_sim.in_process != 0U) {
+    return 0U;
+  }
+  // While a command or data transfer is active jump to its next event
+  if (mci_sim.cmd_active != 0U) {
+    return mci_sim.cmd_end;
+  }
+  if (mci_sim.xfer_active != 0U) {
+    return mci_sim.xfer_next;
+  }
+  return UINT64_MAX;
+}
+
+static const SIM_TIME_CLIENT mci_sim_time = { MCI_Sim_NextEvent, MCI_Sim_Process };
+
+// Global functions
+
+uint64_t MCI_Sim_GetTime (void) {
+  MCI_Sim_Process();
+  return Sim_Time_Now();
+}
+
+// Driver functions
+
+static ARM_DRIVER_VERSION MCI_GetVersion (void) {
+  return mci_driver_version;
+}
+
+static ARM_MCI_CAPABILITIES MCI_GetCapabilities (void) {
+  return mci_driver_capabilities;
+}
+
+static int32_t MCI_Initialize (ARM_MCI_SignalEvent_t cb_event) {
+
+  if (mci_sim.initialized != 0U) {
+    return ARM_DRIVER_OK;
+  }
+  memset(&mci_sim, 0, sizeof(mci_sim));
+  if (Sim_Time_Register(&mci_sim_time) != 0) {
+    return ARM_DRIVER_ERROR;
+  }
+  if (MCI_Sim_ImageOpen() != ARM_DRIVER_OK) {
+    return ARM_DRIVER_ERROR;
+  }
+  mci_sim.cb_event    = cb_event;
+  mci_sim.card_state  = MCI_SIM_ST_OFF;
+  mci_sim.initialized = 1U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_Uninitialize (void) {
+
+  if (mci_sim.powered != 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  MCI_Sim_ImageClose();
+  mci_sim.initialized = 0U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_PowerControl (ARM_POWER_STATE state) {
+
+  switch (state) {
+    case ARM_POWER_OFF:
+      mci_sim.powered      = 0U;
+      mci_sim.cmd_active   = 0U;
+      mci_sim.xfer_active  = 0U;
+      mci_sim.xfer_pending = 0U;
+      mci_sim.xfer_setup   = 0U;
+      mci_sim.card_state   = MCI_SIM_ST_OFF;
+      memset((void *)&mci_sim.status, 0, sizeof(mci_sim.status));
+      return ARM_DRIVER_OK;
+
+    case ARM_POWER_FULL:
+      if (mci_sim.initialized == 0U) {
+        return ARM_DRIVER_ERROR;
+      }
+      if (mci_sim.powered != 0U) {
+        return ARM_DRIVER_OK;
+      }
+      mci_sim.powered      = 1U;
+      mci_sim.clock        = 400000U;
+      mci_sim.width        = ARM_MCI_BUS_DATA_WIDTH_1;
+      mci_sim.speed_mode   = ARM_MCI_BUS_DEFAULT_SPEED;
+      mci_sim.vccq_1v8     = 0U;
+      mci_sim.tuning       = 0U;
+      mci_sim.tuned        = 0U;
+      mci_sim.data_timeout = MCI_SIM_DATA_TIMEOUT;
+      if (MCI_SIM_CARD_POWER == 0) {
+        MCI_Sim_CardReset(1U);
+      }
+      return ARM_DRIVER_OK;
+
+    case ARM_POWER_LOW:
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+}
+
+static int32_t MCI_CardPower (uint32_t voltage) {
+
+  if (MCI_SIM_CARD_POWER == 0) {
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+  if (mci_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+
+  switch (voltage & ARM_MCI_POWER_VDD_Msk) {
+    case 0U:
+      break;
+    case ARM_MCI_POWER_VDD_OFF:
+      mci_sim.card_state = MCI_SIM_ST_OFF;
+      break;
+    case ARM_MCI_POWER_VDD_3V3:
+      if (mci_sim.card_state == MCI_SIM_ST_OFF) {
+        MCI_Sim_CardReset(1U);
+      }
+      break;
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+
+  switch (voltage & ARM_MCI_POWER_VCCQ_Msk) {
+    case 0U:
+      break;
+    case ARM_MCI_POWER_VCCQ_OFF:
+    case ARM_MCI_POWER_VCCQ_3V3:
+      mci_sim.vccq_1v8 = 0U;
+      break;
+    case ARM_MCI_POWER_VCCQ_1V8:
+      if (MCI_SIM_UHS == 0) {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+      }
+      mci_sim.vccq_1v8 = 1U;
+      break;
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_ReadCD (void) {
+  return 1;
+}
+
+static int32_t MCI_ReadWP (void) {
+  return 0;
+}
+
+static int32_t MCI_SendCommand (uint32_t cmd, uint32_t arg, uint32_t flags, uint32_t *response) {
+  uint64_t now;
+  uint32_t resp_type, clocks, ok;
+
+  if (mci_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  MCI_Sim_Process();
+  if ((mci_sim.cmd_active != 0U) || (((flags & ARM_MCI_TRANSFER_DATA) != 0U) && (mci_sim.xfer_active != 0U))) {
+    return ARM_DRIVER_ERROR_BUSY;
+  }
+  if (((flags & ARM_MCI_TRANSFER_DATA) != 0U) && (mci_sim.xfer_setup == 0U)) {
+    return ARM_DRIVER_ERROR;
+  }
+  if ((flags & (ARM_MCI_BOOT_OPERATION | ARM_MCI_BOOT_ALTERNATIVE | ARM_MCI_CCSD | ARM_MCI_CCS)) != 0U) {
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+
+  now       = Sim_Time_Now();
+  cmd      &= 0x3FU;
+  resp_type = flags & ARM_MCI_RESPONSE_Msk;
+
+  mci_sim.xfer_kind = MCI_SIM_XFER_NONE;
+  memset(mci_sim.resp, 0, sizeof(mci_sim.resp));
+  ok = MCI_Sim_Execute(cmd, arg, now);
+
+  clocks = MCI_SIM_CMD_CLOCKS + ((resp_type == ARM_MCI_RESPONSE_LONG) ? 136U : 48U);
+  if ((flags & ARM_MCI_CARD_INITIALIZE) != 0U) {
+    clocks += 74U;
+  }
+  mci_sim.cmd_end   = now + MCI_Sim_ClockNs(clocks) + MCI_SIM_CMD_LATENCY + cmd_latency[cmd];
+  mci_sim.cmd_event = ARM_MCI_EVENT_COMMAND_COMPLETE;
+  if (resp_type == ARM_MCI_RESPONSE_NONE) {
+    mci_sim.resp_num = 0U;
+  } else if (ok == 0U) {
+    mci_sim.cmd_event = ARM_MCI_EVENT_COMMAND_TIMEOUT;
+    mci_sim.resp_num  = 0U;
+  } else {
+    mci_sim.resp_num  = (resp_type == ARM_MCI_RESPONSE_LONG) ? 4U : 1U;
+    if ((resp_type == ARM_MCI_RESPONSE_SHORT_BUSY) && (mci_sim.busy_end > mci_sim.cmd_end)) {
+      // Command completes when the card releases busy
+      mci_sim.cmd_end = mci_sim.busy_end;
+    }
+  }
+  mci_sim.resp_ptr   = response;
+  mci_sim.cmd_active = 1U;
+  mci_sim.status.command_active  = 1U;
+  mci_sim.status.command_timeout = 0U;
+  mci_sim.status.command_error   = 0U;
+
+  if ((flags & ARM_MCI_TRANSFER_DATA) != 0U) {
+    if (ok == 0U) {
+      mci_sim.xfer_kind = MCI_SIM_XFER_NONE;
+    }
+    mci_sim.xfer_setup   = 0U;
+    mci_sim.xfer_pending = 1U;
+    mci_sim.status.transfer_timeout = 0U;
+    mci_sim.status.transfer_error   = 0U;
+  } else {
+    MCI_Sim_SwitchFunc();
+  }
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_SetupTransfer (uint8_t *data, uint32_t block_count, uint32_t block_size, uint32_t mode) {
+
+  if (mci_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  if ((data == NULL) || (block_count == 0U) || (block_size == 0U) || (block_size > MCI_SIM_BLOCK_SIZE)) {
+    return ARM_DRIVER_ERROR_PARAMETER;
+  }
+  if ((mode & ARM_MCI_TRANSFER_STREAM) != 0U) {
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+  MCI_Sim_Process();
+  if ((mci_sim.xfer_active != 0U) || (mci_sim.xfer_pending != 0U)) {
+    return ARM_DRIVER_ERROR_BUSY;
+  }
+  mci_sim.xfer_data  = data;
+  mci_sim.xfer_cnt   = block_count;
+  mci_sim.xfer_size  = block_size;
+  mci_sim.xfer_mode  = mode;
+  mci_sim.xfer_setup = 1U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_AbortTransfer (void) {
+
+  if (mci_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  MCI_Sim_Process();
+  if ((mci_sim.xfer_active != 0U) && (mci_sim.xfer_multi == 0U) && (mci_sim.card_state == MCI_SIM_ST_DATA)) {
+    mci_sim.card_state = MCI_SIM_ST_TRAN;
+  }
+  mci_sim.xfer_active  = 0U;
+  mci_sim.xfer_pending = 0U;
+  mci_sim.xfer_setup   = 0U;
+  mci_sim.status.transfer_active = 0U;
+
+  return ARM_DRIVER_OK;
+}
+
+static int32_t MCI_Control (uint32_t control, uint32_t arg) {
+  uint32_t div;
+
+  if (mci_sim.powered == 0U) {
+    return ARM_DRIVER_ERROR;
+  }
+  switch (control) {
+    case ARM_MCI_BUS_SPEED:
+      if (arg == 0U) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      div = (MCI_SIM_BASE_CLOCK + arg - 1U) / arg;
+      if (div == 0U) { div = 1U; }
+      mci_sim.clock = MCI_SIM_BASE_CLOCK / div;
+      return (int32_t)mci_sim.clock;
+
+    case ARM_MCI_BUS_SPEED_MODE:
+      switch (arg) {
+        case ARM_MCI_BUS_DEFAULT_SPEED:
+          break;
+        case ARM_MCI_BUS_HIGH_SPEED:
+          if (MCI_SIM_HIGH_SPEED == 0) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        case ARM_MCI_BUS_UHS_SDR12:
+        case ARM_MCI_BUS_UHS_SDR25:
+        case ARM_MCI_BUS_UHS_SDR50:
+        case ARM_MCI_BUS_UHS_SDR104:
+        case ARM_MCI_BUS_UHS_DDR50:
+          if (MCI_SIM_UHS == 0) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        default:
+          return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      mci_sim.speed_mode = (uint8_t)arg;
+      mci_sim.tuned      = 0U;
+      return ARM_DRIVER_OK;
+
+    case ARM_MCI_BUS_CMD_MODE:
+      if ((arg != ARM_MCI_BUS_CMD_PUSH_PULL) && (arg != ARM_MCI_BUS_CMD_OPEN_DRAIN)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      return ARM_DRIVER_OK;
+
+    case ARM_MCI_BUS_DATA_WIDTH:
+      switch (arg) {
+        case ARM_MCI_BUS_DATA_WIDTH_1:
+          break;
+        case ARM_MCI_BUS_DATA_WIDTH_4:
+          if (mci_driver_capabilities.data_width_4 == 0U)     { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        case ARM_MCI_BUS_DATA_WIDTH_8:
+          if (mci_driver_capabilities.data_width_8 == 0U)     { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        case ARM_MCI_BUS_DATA_WIDTH_4_DDR:
+          if (mci_driver_capabilities.data_width_4_ddr == 0U) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        case ARM_MCI_BUS_DATA_WIDTH_8_DDR:
+          if (mci_driver_capabilities.data_width_8_ddr == 0U) { return ARM_DRIVER_ERROR_UNSUPPORTED; }
+          break;
+        default:
+          return ARM_DRIVER_ERROR_PARAMETER;
+      }
+      mci_sim.width = (uint8_t)arg;
+      return ARM_DRIVER_OK;
+
+    case ARM_MCI_DRIVER_STRENGTH:
+      return (arg == ARM_MCI_DRIVER_TYPE_B) ? ARM_DRIVER_OK : ARM_DRIVER_ERROR_UNSUPPORTED;
+
+    case ARM_MCI_CONTROL_CLOCK_IDLE:
+      return ARM_DRIVER_OK;
+
+    case ARM_MCI_UHS_TUNING_OPERATION:
+      if (MCI_SIM_UHS == 0) {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+      }
+      mci_sim.tuning = (arg != 0U) ? 1U : 0U;
+      mci_sim.tuned  = 0U;
+      return ARM_DRIVER_OK;
+
+    case ARM_MCI_UHS_TUNING_RESULT:
+      if (MCI_SIM_UHS == 0) {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+      }
+      MCI_Sim_Process();
+      if (mci_sim.tuned  != 0U) { return 0; }
+      if (mci_sim.tuning != 0U) { return 1; }
+      return -1;
+
+    case ARM_MCI_DATA_TIMEOUT:
+      mci_sim.data_timeout = (uint32_t)MCI_Sim_ClockNs(arg);
+      return ARM_DRIVER_OK;
+
+    default:
+      return ARM_DRIVER_ERROR_UNSUPPORTED;
+  }
+}
+
+static ARM_MCI_STATUS MCI_GetStatus (void) {
+
+  MCI_Sim_Process();
+
+  return mci_sim.status;
+}
+
+// MCI driver control block
+#define MCI_Sim_Driver_Aux(n)   Driver_MCI##n
+#define MCI_Sim_Driver_Name(n)  MCI_Sim_Driver_Aux(n)
+
+extern \
+ARM_DRIVER_MCI MCI_Sim_Driver_Name(MCI_SIM_DRV_NUM);
+ARM_DRIVER_MCI MCI_Sim_Driver_Name(MCI_SIM_DRV_NUM) = {
+  MCI_GetVersion,
+  MCI_GetCapabilities,
+  MCI_Initialize,
+  MCI_Uninitialize,
+  MCI_PowerControl,
+  MCI_CardPower,
+  MCI_ReadCD,
+  MCI_ReadWP,
+  MCI_SendCommand,
+  MCI_SetupTransfer,
+  MCI_AbortTransfer,
+  MCI_Control,
+  MCI_GetStatus
+};
@@ -0,0 +1,5 @@
+#!/bin/sh
+# Build Metric_Compare
+cd Source
+gcc -O2 Metric_Compare.c -I ../Include -o ../Metric_Compare
+cd ..
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Metric_Compare
+ * Title:       Test report metric comparison tool definitions
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef __METRIC_COMPARE_H
+#define __METRIC_COMPARE_H
+
+// Defaults
+#define TOLERANCE_DEF           5.0     // Allowed regression (in %)
+#define LINE_MAX_LEN            65536U  // Maximum length of report line
+#define KEY_MAX_LEN             128U    // Maximum length of metric key (test function/metric name)
+#define UNIT_MAX_LEN            16U     // Maximum length of metric unit
+
+// Metric direction (matches METRIC_DIR in DV_Report.h)
+#define DIR_INFO                0       // Informational, not compared
+#define DIR_HIGHER              1       // Higher value is better
+#define DIR_LOWER               2       // Lower value is better
+
+// Exit codes
+#define EXIT_PASS               0       // No regression
+#define EXIT_REGRESSION         1       // At least one metric regressed beyond tolerance
+#define EXIT_ERROR              2       // Invalid arguments or report file
+
+#endif /* __METRIC_COMPARE_H */
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Metric_Compare
+ * Title:       Test report metric comparison tool
+ * Purpose:     Compares metrics of a JSON Lines test report against a baseline
+ *              report (a stored JSON Lines report of a reference run)
+ *               - metrics are matched by test function and metric name
+ *               - metrics with direction (higher/lower is better) regress when
+ *                 they are worse than baseline by more than the tolerance
+ *              Exit code is 1 if any metric regressed, so the tool can gate CI jobs.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#define VERSION     "v1.0"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Metric_Compare.h"
+
+// Metric of a report
+typedef struct {
+  char     key[KEY_MAX_LEN];            // Test function/metric name
+  char     unit[UNIT_MAX_LEN];
+  double   value;
+  int      valid;                       // Value is a number (not null)
+  int      dir;                         // DIR_x
+  int      used;                        // Matched with the other report
+} METRIC;
+
+// Metrics of a report
+typedef struct {
+  METRIC  *m;
+  uint32_t num;
+  uint32_t size;
+} REPORT;
+
+static char line[LINE_MAX_LEN];
+
+static void usage (void) {
+  printf("Usage: Metric_Compare [-t tolerance] <baseline.jsonl> <report.jsonl>\n");
+  printf("  -t tolerance  allowed regression in percent (default %.1f)\n", TOLERANCE_DEF);
+}
+
+/* Skip white space */
+static const char *skip_ws (const char *p) {
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) {
+    p++;
+  }
+  return p;
+}
+
+/* Parse JSON string into buffer (truncated to size), return NULL on error */
+static const char *parse_string (const char *p, char *buf, uint32_t size) {
+  uint32_t n = 0U;
+  char     ch;
+
+  if (*p++ != '"') {
+    return NULL;
+  }
+  while (*p != '"') {
+    if (*p == '\0') {
+      return NULL;
+    }
+    ch = *p++;
+    if (ch == '\\') {
+      ch = *p++;
+      switch (ch) {
+        case 'n': ch = '\n'; break;
+        case 'r': ch = '\r'; break;
+        case 't': ch = '\t'; break;
+        case 'b': ch = '\b'; break;
+        case 'f': ch = '\f'; break;
+        case 'u':
+          /* Non-ASCII characters are not used in metric names */
+          if (strlen(p) < 4U) {
+            return NULL;
+          }
+          p += 4;
+          ch = '?';
+          break;
+        case '\0':
+          return NULL;
+        default:
+          break;
+      }
+    }
+    if ((buf != NULL) && ((n + 1U) < size)) {
+      buf[n++] = ch;
+    }
+  }
+  if (buf != NULL) {
+    buf[n] = '\0';
+  }
+  return (p + 1);
+}
+
+/* Skip JSON value, return NULL on error */
+static const char *skip_value (const char *p) {
+  char close;
+
+  p = skip_ws(p);
+  if (*p == '"') {
+    return parse_string(p, NULL, 0U);
+  }
+  if ((*p == '{') || (*p == '[')) {
+    close = (*p == '{') ? '}' : ']';
+    p = skip_ws(p + 1);
+    if (*p == close) {
+      return (p + 1);
+    }
+    for (;;) {
+      if (close == '}') {
+        p = parse_string(skip_ws(p), NULL, 0U);
+        if (p == NULL) { return NULL; }
+        p = skip_ws(p);
+        if (*p++ != ':') { return NULL; }
+      }
+      p = skip_value(p);
+      if (p == NULL) { return NULL; }
+      p = skip_ws(p);
+      if (*p == close) { return (p + 1); }
+      if (*p++ != ',') { return NULL; }
+    }
+  }
+  /* Number, true, false or null */
+  while ((*p != '\0') && (*p != ',') && (*p != '}') && (*p != ']') &&
+         (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != '\n')) {
+    p++;
+  }
+  return p;
+}
+
+/* Add metric to report */
+static int report_add (REPORT *r, const char *func, const char *name, const char *unit,
+                       double value, int valid, int dir) {
+  METRIC *m;
+
+  if (r->num == r->size) {
+    r->size = (r->size != 0U) ? (r->size * 2U) : 64U;
+    r->m    = realloc(r->m, r->size * sizeof(METRIC));
+    if (r->m == NULL) {
+      return -1;
+    }
+  }
+  m = &r->m[r->num++];
+  snprintf(m->key,  sizeof(m->key),  "%s/%s", func, name);
+  snprintf(m->unit, sizeof(m->unit), "%s", unit);
+  m->value = value;
+  m->valid = valid;
+  m->dir   = dir;
+  m->used  = 0;
+  return 0;
+}
+
+/* Parse metric object of metrics array */
+static const char *parse_metric (const char *p, REPORT *r, const char *func) {
+  char   key[32], name[KEY_MAX_LEN], unit[UNIT_MAX_LEN], str[16];
+  double value = 0.0;
+  int    valid = 0, dir = DIR_INFO;
+  char  *end;
+
+  name[0] = '\0';
+  unit[0] = '\0';
+  p = skip_ws(p);
+  if (*p++ != '{') { return NULL; }
+  p = skip_ws(p);
+  while (*p != '}') {
+    p = parse_string(p, key, sizeof(key));
+    if (p == NULL) { return NULL; }
+    p = skip_ws(p);
+    if (*p++ != ':') { return NULL; }
+    p = skip_ws(p);
+    if (strcmp(key, "name") == 0) {
+      p = parse_string(p, name, sizeof(name));
+    } else if (strcmp(key, "unit") == 0) {
+      p = parse_string(p, unit, sizeof(unit));
+    } else if (strcmp(key, "direction") == 0) {
+      p = parse_string(p, str, sizeof(str));
+      if (p != NULL) {
+        dir = (strcmp(str, "higher") == 0) ? DIR_HIGHER : (strcmp(str, "lower") == 0) ? DIR_LOWER : DIR_INFO;
+      }
+    } else if (strcmp(key, "value") == 0) {
+      value = strtod(p, &end);
+      valid = (end != p);
+      p = skip_value(p);
+    } else {
+      p = skip_value(p);
+    }
+    if (p == NULL) { return NULL; }
+    p = skip_ws(p);
+    if (*p == ',') {
+      p = skip_ws(p + 1);
+    } else if (*p != '}') {
+      return NULL;
+    }
+  }
+  if (report_add(r, func, name, unit, value, valid, dir) != 0) {
+    return NULL;
+  }
+  return (p + 1);
+}
+
+/* Parse report line, metrics of test objects are added to report */
+static int parse_line (const char *p, REPORT *r) {
+  char        key[32], type[16], func[KEY_MAX_LEN];
+  const char *metrics = NULL;
+  const char *q;
+
+  type[0] = '\0';
+  func[0] = '\0';
+  p = skip_ws(p);
+  if (*p != '{') {
+    return 0;                           // Not a report object (console output)
+  }
+  p = skip_ws(p + 1);
+  while (*p != '}') {
+    p = parse_string(p, key, sizeof(key));
+    if (p == NULL) { return -1; }
+    p = skip_ws(p);
+    if (*p++ != ':') { return -1; }
+    p = skip_ws(p);
+    if (strcmp(key, "type") == 0) {
+      p = parse_string(p, type, sizeof(type));
+    } else if (strcmp(key, "func") == 0) {
+      p = parse_string(p, func, sizeof(func));
+    } else {
+      if (strcmp(key, "metrics") == 0) {
+        metrics = p;
+      }
+      p = skip_value(p);
+    }
+    if (p == NULL) { return -1; }
+    p = skip_ws(p);
+    if (*p == ',') {
+      p = skip_ws(p + 1);
+    } else if (*p != '}') {
+      return -1;
+    }
+  }
+  if ((strcmp(type, "test") != 0) || (metrics == NULL) || (*metrics != '[')) {
+    return 0;
+  }
+
+  q = skip_ws(metrics + 1);
+  while (*q != ']') {
+    q = parse_metric(q, r, func);
+    if (q == NULL) { return -1; }
+    q = skip_ws(q);
+    if (*q == ',') {
+      q++;
+    } else if (*q != ']') {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Read report file */
+static int report_read (const char *fn, REPORT *r) {
+  FILE    *f;
+  uint32_t no = 0U;
+
+  f = fopen(fn, "r");
+  if (f == NULL) {
+    printf("Cannot open %s\n", fn);
+    return -1;
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    no++;
+    if (parse_line(line, r) != 0) {
+      printf("%s:%u: invalid report line\n", fn, no);
+      fclose(f);
+      return -1;
+    }
+  }
+  fclose(f);
+  return 0;
+}
+
+/* Find metric by key */
+static METRIC *report_find (REPORT *r, const char *key) {
+  uint32_t i;
+
+  for (i = 0U; i < r->num; i++) {
+    if ((r->m[i].used == 0) && (strcmp(r->m[i].key, key) == 0)) {
+      return &r->m[i];
+    }
+  }
+  return NULL;
+}
+
+int main (int argc, char **argv) {
+  REPORT      base = { NULL, 0U, 0U };
+  REPORT      run  = { NULL, 0U, 0U };
+  METRIC     *b, *m;
+  const char *fn_base = NULL, *fn_run = NULL, *status;
+  double      tol, change;
+  uint32_t    i, regressions = 0U, improvements = 0U, compared = 0U;
+  int         dir, a;
+
+  tol = TOLERANCE_DEF;
+  for (a = 1; a < argc; a++) {
+    if ((strcmp(argv[a], "-t") == 0) && ((a + 1) < argc)) {
+      tol = strtod(argv[++a], NULL);
+    } else if (fn_base == NULL) {
+      fn_base = argv[a];
+    } else if (fn_run == NULL) {
+      fn_run = argv[a];
+    } else {
+      usage();
+      return EXIT_ERROR;
+    }
+  }
+  if ((fn_run == NULL) || (tol < 0.0)) {
+    usage();
+    return EXIT_ERROR;
+  }
+
+  printf("Test report metric comparison tool %s\n", VERSION);
+  if ((report_read(fn_base, &base) != 0) || (report_read(fn_run, &run) != 0)) {
+    return EXIT_ERROR;
+  }
+  printf("Baseline %s: %u metrics, report %s: %u metrics, tolerance %.1f%%\n\n",
+         fn_base, base.num, fn_run, run.num, tol);
+
+  printf("%-48s %14s %14s %-8s %9s  %s\n", "Metric", "Baseline", "Report", "Unit", "Change", "Status");
+  for (i = 0U; i < run.num; i++) {
+    m = &run.m[i];
+    b = report_find(&base, m->key);
+    if (b == NULL) {
+      printf("%-48s %14s %14.6g %-8s %9s  NEW\n", m->key, "-", m->value, m->unit, "");
+      continue;
+    }
+    b->used = 1;
+    dir     = (m->dir != DIR_INFO) ? m->dir : b->dir;
+    if ((m->valid == 0) || (b->valid == 0)) {
+      printf("%-48s %14s %14s %-8s %9s  NO VALUE\n", m->key, "-", "-", m->unit, "");
+      continue;
+    }
+    change = (b->value != 0.0) ? (((m->value - b->value) * 100.0) / b->value) : 0.0;
+    if (b->value < 0.0) {
+      change = -change;
+    }
+    if (dir == DIR_INFO) {
+      status = "INFO";
+    } else {
+      compared++;
+      if (((dir == DIR_HIGHER) && (change < -tol)) || ((dir == DIR_LOWER) && (change > tol))) {
+        status = "REGRESSION";
+        regressions++;
+      } else if (((dir == DIR_HIGHER) && (change > tol)) || ((dir == DIR_LOWER) && (change < -tol))) {
+        status = "IMPROVED";
+        improvements++;
+      } else {
+        status = "OK";
+      }
+    }
+    printf("%-48s %14.6g %14.6g %-8s %+8.1f%%  %s\n", m->key, b->value, m->value, m->unit, change, status);
+  }
+  for (i = 0U; i < base.num; i++) {
+    if (base.m[i].used == 0) {
+      printf("%-48s %14.6g %14s %-8s %9s  MISSING\n", base.m[i].key, base.m[i].value, "-", base.m[i].unit, "");
+    }
+  }
+
+  printf("\n%u metrics compared, %u regressions, %u improvements\n", compared, regressions, improvements);
+
+  free(base.m);
+  free(run.m);
+  return (regressions != 0U) ? EXIT_REGRESSION : EXIT_PASS;
+}
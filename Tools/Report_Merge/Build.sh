@@ -0,0 +1,5 @@
+#!/bin/sh
+# Build Report_Merge
+cd Source
+gcc -O2 Report_Merge.c -I ../Include -o ../Report_Merge
+cd ..
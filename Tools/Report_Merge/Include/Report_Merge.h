@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Report_Merge
+ * Title:       Test report merge tool definitions
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef __REPORT_MERGE_H
+#define __REPORT_MERGE_H
+
+// Limits
+#define LINE_MAX_LEN            65536U  // Maximum length of report line
+#define TITLE_MAX_LEN           256U    // Maximum length of test group title
+#define NAME_MAX_LEN            128U    // Maximum length of test function name
+
+// Report formats
+#define FORMAT_XML              1       // XML report
+#define FORMAT_JSONL            2       // JSON Lines report
+
+// Prefix of shard information line (filtered from merged report)
+#define SHARD_INFO              "Test shard "
+
+// Exit codes
+#define EXIT_PASS               0       // Merged report passed
+#define EXIT_FAIL               1       // Merged report contains failed tests
+#define EXIT_ERROR              2       // Invalid arguments or report file
+
+#endif /* __REPORT_MERGE_H */
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Report_Merge
+ * Title:       Test report merge tool
+ * Purpose:     Merges reports of test shards (boards running the same test image,
+ *              each executing a part of the test cases) into one report
+ *               - XML and JSON Lines report formats are supported
+ *               - test groups are matched by title, test cases by test number
+ *               - test group summaries are recalculated
+ *              Generates test case duration table (cmsis_dv_test_duration)
+ *              from JSON Lines reports, used to balance test cases between shards.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#define VERSION     "v1.0"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Report_Merge.h"
+
+// Test case result (matches TC_RES in DV_Report.h)
+#define RES_PASSED          0
+#define RES_FAILED          1
+#define RES_NOT_EXECUTED    2
+
+// Test case of merged report
+typedef struct {
+  uint32_t no;                          // Test number
+  int      res;                         // Test result (RES_x)
+  char    *text;                        // Test case text (XML element or JSON object)
+} TCASE;
+
+// Test group of merged report
+typedef struct {
+  char     title[TITLE_MAX_LEN];        // Test group title (XML text or JSON string)
+  char    *head;                        // Test group header (date, time, file)
+  char    *info;                        // Test group information
+  int      info_set;                    // Information taken from a report
+  TCASE   *tc;                          // Test cases
+  uint32_t num;                         // Number of test cases
+  uint32_t size;                        // Size of test case array
+} GROUP;
+
+// Recorded test case duration
+typedef struct {
+  char     name[NAME_MAX_LEN];          // Test function name
+  uint32_t duration;                    // Duration in ms
+} DURATION;
+
+static GROUP    *group;                 // Test groups of merged report
+static uint32_t  group_num;
+static DURATION *duration;              // Test case durations
+static uint32_t  duration_num;
+static int       format;                // Report format (FORMAT_x)
+static char      line[LINE_MAX_LEN];
+
+static void usage (void) {
+  printf("Usage: Report_Merge [-o merged] [-d durations.c] <report> [<report> ...]\n");
+  printf("  -o merged       write merged report to file (default: standard output)\n");
+  printf("  -d durations.c  write test case duration table (JSON Lines reports only)\n");
+}
+
+/* Allocate memory, exit on failure */
+static void *mem_alloc (void *ptr, size_t size) {
+  ptr = realloc(ptr, size);
+  if (ptr == NULL) {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_ERROR);
+  }
+  return ptr;
+}
+
+/* Append string to dynamic text */
+static void text_append (char **text, const char *str) {
+  size_t len = (*text != NULL) ? strlen(*text) : 0U;
+
+  *text = mem_alloc(*text, len + strlen(str) + 1U);
+  strcpy(*text + len, str);
+}
+
+/* Copy string with size limit */
+static void str_copy (char *dst, const char *src, size_t len, size_t size) {
+  if (len >= size) {
+    len = size - 1U;
+  }
+  memcpy(dst, src, len);
+  dst[len] = '\0';
+}
+
+/* Find or add test group (new group is inserted after position pos) */
+static GROUP *group_get (const char *title, uint32_t *pos) {
+  uint32_t i;
+
+  for (i = 0U; i < group_num; i++) {
+    if (strcmp(group[i].title, title) == 0) {
+      *pos = i + 1U;
+      return &group[i];
+    }
+  }
+  group = mem_alloc(group, (group_num + 1U) * sizeof(GROUP));
+  memmove(&group[*pos + 1U], &group[*pos], (group_num - *pos) * sizeof(GROUP));
+  group_num++;
+  memset(&group[*pos], 0, sizeof(GROUP));
+  str_copy(group[*pos].title, title, strlen(title), sizeof(group[*pos].title));
+  return &group[(*pos)++];
+}
+
+/* Add test case to test group (test case reported by several shards is added once) */
+static void group_add (GROUP *g, uint32_t no, int res, char *text) {
+  uint32_t i;
+
+  for (i = 0U; i < g->num; i++) {
+    if (g->tc[i].no == no) {
+      free(text);
+      return;
+    }
+  }
+  if (g->num == g->size) {
+    g->size = (g->size != 0U) ? (g->size * 2U) : 32U;
+    g->tc   = mem_alloc(g->tc, g->size * sizeof(TCASE));
+  }
+  /* Keep test cases sorted by test number */
+  for (i = g->num; (i > 0U) && (g->tc[i - 1U].no > no); i--) {
+    g->tc[i] = g->tc[i - 1U];
+  }
+  g->tc[i].no   = no;
+  g->tc[i].res  = res;
+  g->tc[i].text = text;
+  g->num++;
+}
+
+/* Get result from result string */
+static int get_res (const char *str) {
+  if (strncmp(str, "PASSED", 6) == 0) {
+    return RES_PASSED;
+  }
+  if (strncmp(str, "FAILED", 6) == 0) {
+    return RES_FAILED;
+  }
+  return RES_NOT_EXECUTED;
+}
+
+/* Find end of JSON string (str points to opening quote) */
+static const char *json_str_end (const char *str) {
+  for (str++; (*str != '"') && (*str != '\0'); str++) {
+    if ((*str == '\\') && (str[1] != '\0')) {
+      str++;
+    }
+  }
+  return str;
+}
+
+/* Remove line end */
+static void strip (char *str) {
+  size_t len = strlen(str);
+
+  while ((len != 0U) && ((str[len - 1U] == '\n') || (str[len - 1U] == '\r'))) {
+    str[--len] = '\0';
+  }
+}
+
+/* Read XML report */
+static int read_xml (FILE *f) {
+  GROUP   *g   = NULL;
+  char    *tc  = NULL;
+  char    *head = NULL, *info = NULL;
+  char    *end;
+  char     title[TITLE_MAX_LEN];
+  uint32_t pos = 0U, no = 0U;
+  int      res = RES_NOT_EXECUTED, in_info = 0, in_tc = 0, info_set = 0;
+
+  title[0] = '\0';
+  while (fgets(line, sizeof(line), f) != NULL) {
+    strip(line);
+    if (in_tc != 0) {
+      text_append(&tc, line);
+      text_append(&tc, "\n");
+      if (strncmp(line, "<no>", 4) == 0) {
+        no = (uint32_t)strtoul(line + 4, NULL, 10);
+      } else if (strncmp(line, "<res>", 5) == 0) {
+        res = get_res(line + 5);
+      } else if (strcmp(line, "</tc>") == 0) {
+        group_add(g, no, res, tc);
+        tc    = NULL;
+        in_tc = 0;
+      }
+    } else if (in_info != 0) {
+      if (strcmp(line, "</info>") == 0) {
+        in_info = 0;
+      } else if (strncmp(line, SHARD_INFO, strlen(SHARD_INFO)) != 0) {
+        text_append(&info, line);
+        text_append(&info, "\n");
+      }
+    } else if (strcmp(line, "<test>") == 0) {
+      title[0] = '\0';
+      free(head);
+      free(info);
+      head     = NULL;
+      info     = NULL;
+      info_set = 0;
+    } else if (strncmp(line, "<title>", 7) == 0) {
+      end = strstr(line, "</title>");
+      str_copy(title, line + 7, (end != NULL) ? (size_t)(end - line - 7) : strlen(line + 7), sizeof(title));
+    } else if ((strncmp(line, "<date>", 6) == 0) ||
+               (strncmp(line, "<time>", 6) == 0) ||
+               (strncmp(line, "<file>", 6) == 0)) {
+      text_append(&head, line);
+      text_append(&head, "\n");
+    } else if (strcmp(line, "<info>") == 0) {
+      in_info  = 1;
+      info_set = 1;
+    } else if (strcmp(line, "<test_cases>") == 0) {
+      g = group_get(title, &pos);
+      if (g->head == NULL) {
+        g->head = head;
+        head    = NULL;
+      }
+      if ((g->info_set == 0) && (info_set != 0)) {
+        g->info     = info;
+        g->info_set = 1;
+        info        = NULL;
+      }
+    } else if ((strcmp(line, "<tc>") == 0) && (g != NULL)) {
+      tc    = NULL;
+      no    = 0U;
+      res   = RES_NOT_EXECUTED;
+      in_tc = 1;
+      text_append(&tc, "<tc>\n");
+    } else if (strcmp(line, "</test>") == 0) {
+      g = NULL;
+    } else {
+      /* Summary is recalculated, other lines are ignored */
+    }
+  }
+  free(tc);
+  free(head);
+  free(info);
+  return (in_tc != 0) ? -1 : 0;
+}
+
+/* Add test case duration (longest duration of all reports is used) */
+static void duration_add (const char *str) {
+  const char *p, *q, *end;
+  char        name[NAME_MAX_LEN];
+  uint32_t    i, ms;
+
+  p = strstr(str, "\"func\":\"");
+  if (p == NULL) {
+    return;
+  }
+  p  += 7;
+  end = json_str_end(p);
+  str_copy(name, p + 1, (size_t)(end - p - 1), sizeof(name));
+  /* Test duration is the last member (repeat statistics also have a duration) */
+  p = NULL;
+  for (q = strstr(end, "\"duration_us\":"); q != NULL; q = strstr(q + 1, "\"duration_us\":")) {
+    p = q;
+  }
+  if (p == NULL) {
+    return;
+  }
+  ms = (uint32_t)((strtoul(p + 14, NULL, 10) + 999U) / 1000U);
+  if (ms == 0U) {
+    ms = 1U;                            // 0 means duration is not recorded
+  }
+
+  for (i = 0U; i < duration_num; i++) {
+    if (strcmp(duration[i].name, name) == 0) {
+      break;
+    }
+  }
+  if (i == duration_num) {
+    duration = mem_alloc(duration, (duration_num + 1U) * sizeof(DURATION));
+    strcpy(duration[i].name, name);
+    duration[i].duration = 0U;
+    duration_num++;
+  }
+  if (ms > duration[i].duration) {
+    duration[i].duration = ms;
+  }
+}
+
+/* Read JSON Lines report */
+static int read_jsonl (FILE *f) {
+  GROUP      *g = NULL;
+  const char *p, *rest, *end;
+  char        title[TITLE_MAX_LEN];
+  uint32_t    pos = 0U, no, info_set = 0U;
+  int         res;
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    strip(line);
+    if (strncmp(line, "{\"type\":", 8) != 0) {
+      continue;                         // Not a report object (console output)
+    }
+    /* Members following the group number */
+    rest = strstr(line, "\"group\":");
+    if (rest == NULL) {
+      return -1;
+    }
+    rest = strchr(rest, ',');
+    if (rest == NULL) {
+      return -1;
+    }
+    rest++;
+
+    if (strncmp(line + 8, "\"group\"", 7) == 0) {
+      p = strstr(rest, "\"title\":\"");
+      if (p == NULL) {
+        return -1;
+      }
+      end = json_str_end(p + 8);
+      str_copy(title, p + 8, (size_t)(end - p - 7), sizeof(title));
+      g = group_get(title, &pos);
+      if (g->head == NULL) {
+        text_append(&g->head, rest);
+      }
+      info_set = (g->info_set == 0);
+      g->info_set = 1;
+    } else if ((strncmp(line + 8, "\"info\"", 6) == 0) && (g != NULL)) {
+      if ((info_set != 0) && (strstr(rest, "\"text\":\"" SHARD_INFO) != rest)) {
+        text_append(&g->info, rest);
+        text_append(&g->info, "\n");
+      }
+    } else if ((strncmp(line + 8, "\"test\"", 6) == 0) && (g != NULL)) {
+      p = strstr(rest, "\"no\":");
+      if (p == NULL) {
+        return -1;
+      }
+      no = (uint32_t)strtoul(p + 5, NULL, 10);
+      /* Test result follows the metrics (which also have a result) */
+      res = RES_NOT_EXECUTED;
+      for (p = strstr(rest, "\"result\":\""); p != NULL; p = strstr(p + 1, "\"result\":\"")) {
+        res = get_res(p + 10);
+      }
+      duration_add(rest);
+      group_add(g, no, res, strdup(rest));
+    } else {
+      /* Summary is recalculated */
+    }
+  }
+  return 0;
+}
+
+/* Write merged report, return number of failed tests */
+static uint32_t write_report (FILE *f, uint32_t *tests) {
+  const char *tres;
+  char       *info, *nl;
+  uint32_t    i, j, cnt[3], failed = 0U;
+
+  if (format == FORMAT_XML) {
+    fprintf(f, "<?xml version=\"1.0\"?>\n");
+    fprintf(f, "<?xml-stylesheet href=\"TR_Style.xsl\" type=\"text/xsl\" ?>\n");
+    fprintf(f, "<report>\n");
+  }
+  *tests = 0U;
+  for (i = 0U; i < group_num; i++) {
+    cnt[RES_PASSED] = cnt[RES_FAILED] = cnt[RES_NOT_EXECUTED] = 0U;
+    for (j = 0U; j < group[i].num; j++) {
+      cnt[group[i].tc[j].res]++;
+    }
+    tres = (cnt[RES_FAILED] != 0U) ? "FAILED" : (cnt[RES_PASSED] != 0U) ? "PASSED" : "NOT EXECUTED";
+    failed += cnt[RES_FAILED];
+    *tests += group[i].num;
+
+    if (format == FORMAT_XML) {
+      fprintf(f, "<test>\n<title>%s</title>\n%s", group[i].title, (group[i].head != NULL) ? group[i].head : "");
+      fprintf(f, "<group>%u</group>\n<info>\n%s</info>\n<test_cases>\n", i + 1U, (group[i].info != NULL) ? group[i].info : "");
+      for (j = 0U; j < group[i].num; j++) {
+        fprintf(f, "%s", group[i].tc[j].text);
+      }
+      fprintf(f, "</test_cases>\n<summary>\n");
+      fprintf(f, "<tcnt>%u</tcnt>\n<pass>%u</pass>\n<fail>%u</fail>\n<tres>%s</tres>\n",
+                 group[i].num, cnt[RES_PASSED], cnt[RES_FAILED], tres);
+      fprintf(f, "</summary>\n</test>\n");
+    } else {
+      fprintf(f, "{\"type\":\"group\",\"group\":%u,%s\n", i + 1U, group[i].head);
+      if (group[i].info != NULL) {
+        /* Information lines are stored without type and group */
+        info = group[i].info;
+        while ((nl = strchr(info, '\n')) != NULL) {
+          fprintf(f, "{\"type\":\"info\",\"group\":%u,%.*s\n", i + 1U, (int)(nl - info), info);
+          info = nl + 1;
+        }
+      }
+      for (j = 0U; j < group[i].num; j++) {
+        fprintf(f, "{\"type\":\"test\",\"group\":%u,%s\n", i + 1U, group[i].tc[j].text);
+      }
+      fprintf(f, "{\"type\":\"summary\",\"group\":%u,\"tests\":%u,\"passed\":%u,\"failed\":%u,\"result\":\"%s\"}\n",
+                 i + 1U, group[i].num, cnt[RES_PASSED], cnt[RES_FAILED], tres);
+    }
+  }
+  if (format == FORMAT_XML) {
+    fprintf(f, "</report>\n");
+  }
+  return failed;
+}
+
+/* Write test case duration table */
+static int write_durations (const char *fn) {
+  FILE    *f;
+  uint32_t i;
+
+  f = fopen(fn, "w");
+  if (f == NULL) {
+    fprintf(stderr, "Cannot create %s\n", fn);
+    return -1;
+  }
+  fprintf(f, "/* Test case durations recorded by Report_Merge %s */\n\n", VERSION);
+  fprintf(f, "#include <stdint.h>\n#include <string.h>\n\n");
+  fprintf(f, "static const struct {\n  const char *name;\n  uint32_t    duration;\n} dv_duration[] = {\n");
+  for (i = 0U; i < duration_num; i++) {
+    fprintf(f, "  { \"%s\", %uU },\n", duration[i].name, duration[i].duration);
+  }
+  if (duration_num == 0U) {
+    fprintf(f, "  { \"\", 0U },\n");
+  }
+  fprintf(f, "};\n\n");
+  fprintf(f, "/* Recorded test case duration in ms (0 = not recorded) */\n");
+  fprintf(f, "uint32_t cmsis_dv_test_duration (const char *name) {\n");
+  fprintf(f, "  uint32_t i;\n\n");
+  fprintf(f, "  for (i = 0U; i < (sizeof(dv_duration) / sizeof(dv_duration[0])); i++) {\n");
+  fprintf(f, "    if (strcmp(dv_duration[i].name, name) == 0) {\n");
+  fprintf(f, "      return dv_duration[i].duration;\n");
+  fprintf(f, "    }\n  }\n  return 0U;\n}\n");
+  fclose(f);
+  return 0;
+}
+
+int main (int argc, char **argv) {
+  FILE       *f, *out;
+  const char *fn_out = NULL, *fn_dur = NULL;
+  uint32_t    reports = 0U, tests, failed;
+  int         a, fmt, rc;
+
+  for (a = 1; a < argc; a++) {
+    if ((strcmp(argv[a], "-o") == 0) && ((a + 1) < argc)) {
+      fn_out = argv[++a];
+      continue;
+    }
+    if ((strcmp(argv[a], "-d") == 0) && ((a + 1) < argc)) {
+      fn_dur = argv[++a];
+      continue;
+    }
+    if (argv[a][0] == '-') {
+      usage();
+      return EXIT_ERROR;
+    }
+
+    f = fopen(argv[a], "r");
+    if (f == NULL) {
+      fprintf(stderr, "Cannot open %s\n", argv[a]);
+      return EXIT_ERROR;
+    }
+    /* Detect report format */
+    fmt = 0;
+    while ((fmt == 0) && (fgets(line, sizeof(line), f) != NULL)) {
+      if (strstr(line, "<report>") != NULL) {
+        fmt = FORMAT_XML;
+      } else if (strncmp(line, "{\"type\":", 8) == 0) {
+        fmt = FORMAT_JSONL;
+      }
+    }
+    if ((fmt == 0) || ((format != 0) && (fmt != format))) {
+      fprintf(stderr, "%s: %s\n", argv[a], (fmt == 0) ? "unknown report format" : "report format differs");
+      fclose(f);
+      return EXIT_ERROR;
+    }
+    format = fmt;
+    rewind(f);
+    rc = (format == FORMAT_XML) ? read_xml(f) : read_jsonl(f);
+    fclose(f);
+    if (rc != 0) {
+      fprintf(stderr, "%s: invalid report\n", argv[a]);
+      return EXIT_ERROR;
+    }
+    reports++;
+  }
+  if (reports == 0U) {
+    usage();
+    return EXIT_ERROR;
+  }
+
+  out = stdout;
+  if (fn_out != NULL) {
+    out = fopen(fn_out, "w");
+    if (out == NULL) {
+      fprintf(stderr, "Cannot create %s\n", fn_out);
+      return EXIT_ERROR;
+    }
+  }
+  failed = write_report(out, &tests);
+  if (out != stdout) {
+    fclose(out);
+  }
+  if (fn_dur != NULL) {
+    if (format != FORMAT_JSONL) {
+      fprintf(stderr, "Duration table requires JSON Lines reports\n");
+      return EXIT_ERROR;
+    }
+    if (write_durations(fn_dur) != 0) {
+      return EXIT_ERROR;
+    }
+  }
+
+  fprintf(stderr, "Test report merge tool %s: %u reports, %u test groups, %u tests, %u failed\n",
+                  VERSION, reports, group_num, tests, failed);
+  return (failed != 0U) ? EXIT_FAIL : EXIT_PASS;
+}
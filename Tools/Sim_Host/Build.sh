@@ -0,0 +1,18 @@
+#!/bin/sh
+# Build Sim_Host (CAN and MCI driver validation on the simulated drivers)
+# CMSIS_PATH must point to the CMSIS pack root directory (CMSIS-Driver and CMSIS-RTOS2 headers)
+# Additional options are passed to the compiler, for example: ./Build.sh -g -fsanitize=address
+: "${CMSIS_PATH:?CMSIS_PATH is not set}"
+cd Source
+gcc -O2 -D_RTE_ "$@" \
+  -I ../Include -I ../Config -I ../RTE -I ../RTE/CMSIS_Driver_Validation \
+  -I ../../CAN_Sim/Include -I ../../CAN_Sim/Config \
+  -I ../../MCI_Sim/Include -I ../../MCI_Sim/Config \
+  -I ../../../Include -I ../../../Config \
+  -I "$CMSIS_PATH/CMSIS/Driver/Include" -I "$CMSIS_PATH/CMSIS/RTOS2/Include" \
+  main.c os_host.c Sim_Time.c \
+  ../../CAN_Sim/Source/CAN_Sim.c ../../MCI_Sim/Source/MCI_Sim.c \
+  ../../../Source/cmsis_dv.c ../../../Source/DV_Framework.c ../../../Source/DV_Report.c \
+  ../../../Source/DV_CAN.c ../../../Source/DV_MCI.c \
+  -lpthread -lm -o ../Sim_Host
+cd ..
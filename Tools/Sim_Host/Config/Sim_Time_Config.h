@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Simulator time base configuration file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef  SIM_TIME_CONFIG_H_
+#define  SIM_TIME_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h> Time base
+//   <i> Time base shared by all simulated drivers linked into a host build.
+//   <o0> Time base <0=> Host monotonic clock <1=> Simulated
+//     <i> Simulated time advances by the poll step on each timer read and jumps to the next event of the
+//     <i> simulators when they are busy, so tests run deterministically and faster than real time.
+//   <o1> Timer frequency (Hz) <1000000-1000000000>
+//   <o2> Simulated poll step (ns) <1-1000000>
+//   <o3> Number of simulators <1-16>
+//     <i> Maximum number of simulated drivers registered to the time base.
+//   <q4> Provide osKernelGetSysTimerCount and osKernelGetSysTimerFreq
+//     <i> Disable when the host RTOS2 port provides the system timer functions by calling Sim_Time_GetSysTimerCount
+//     <i> and Sim_Time_GetSysTimerFreq.
+// </h>
+#define  SIM_TIME_BASE                  1
+#define  SIM_TIME_TIMER_FREQ            100000000
+#define  SIM_TIME_POLL_NS               1000
+#define  SIM_TIME_CLIENT_NUM            4
+#define  SIM_TIME_OS_SYSTIMER           1
+
+//------------- <<< end of configuration section >>> ---------------------------
+
+#endif /* SIM_TIME_CONFIG_H_ */
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Simulator time base definitions
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef SIM_TIME_H_
+#define SIM_TIME_H_
+
+#include <stdint.h>
+
+// Simulated driver registered to the time base
+typedef struct {
+  uint64_t (*NextEvent) (void);         // Time of next event (ns), UINT64_MAX if idle, 0 while events are processed
+  void     (*Process)   (void);         // Process events up to the current time
+} SIM_TIME_CLIENT;
+
+// Global functions
+
+// Register simulated driver (registering the same driver again has no effect), return 0 on success
+extern int32_t  Sim_Time_Register         (const SIM_TIME_CLIENT *client);
+
+// Current time (ns), without advancing simulated time
+extern uint64_t Sim_Time_Now              (void);
+
+// System timer (SIM_TIME_TIMER_FREQ), advances simulated time and processes events of all simulators
+extern uint32_t Sim_Time_GetSysTimerCount (void);
+extern uint32_t Sim_Time_GetSysTimerFreq  (void);
+
+#endif /* SIM_TIME_H_ */
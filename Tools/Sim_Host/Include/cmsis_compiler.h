@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Compiler definitions for host builds
+ *
+ * Replaces the CMSIS-Core compiler header, which targets Arm processors.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef CMSIS_COMPILER_H_
+#define CMSIS_COMPILER_H_
+
+#ifndef   __WEAK
+  #define __WEAK                        __attribute__((weak))
+#endif
+#ifndef   __NO_RETURN
+  #define __NO_RETURN                   __attribute__((__noreturn__))
+#endif
+#ifndef   __NOP
+  #define __NOP()                       __asm__ volatile ("" ::: "memory")
+#endif
+#ifndef   __DMB
+  #define __DMB()                       __sync_synchronize()
+#endif
+
+#endif /* CMSIS_COMPILER_H_ */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015-2020 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * $Revision:   V1.2.0
+ *
+ * Project:     CMSIS-Driver Validation
+ * Title:       Memory Card Interface (MCI) driver validation 
+ *              configuration file
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef DV_MCI_CONFIG_H_
+#define DV_MCI_CONFIG_H_
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> --------------------
+
+// <h> MCI
+// <i> Memory Card Interface (MCI) driver validation configuration
+// <o> Driver_MCI# <0-255>
+// <i> Choose the Driver_MCI# instance to test.
+// <i> For example to test Driver_MCI0 select 0.
+#define DRV_MCI                         0
+// <h> Data transfer
+// <i> Card and data transfer settings used by the data transfer tests.
+// <o> Card type <0=> SD <1=> MMC/eMMC
+// <i> Type of card inserted (or soldered) for the data transfer tests.
+#define MCI_CARD_TYPE                   0
+// <q> Request 1.8V signaling (SD UHS-I)
+// <i> Switch the card to 1.8V signaling during initialization if the driver supports it.
+// <i> UHS-I bus speed modes (SDR12 .. SDR104, DDR50) are tested only with 1.8V signaling.
+#define MCI_UHS_1V8                     0
+// <o> Test area start block <0-0x7FFFFFFF>
+// <i> First block of the card area used by the data transfer tests.
+// <i> The test area spans (Transfers per measurement * Blocks per multiple block transfer) blocks.
+// <i> Data in the test area is overwritten by the write tests!
+#define MCI_TEST_BLOCK                  0x10000
+// <o> Blocks per multiple block transfer <2-256>
+#define MCI_MULTI_BLOCK_NUM             32
+// <o> Transfers per measurement <1-1000>
+#define MCI_XFER_NUM                    16
+// <o> Transfer timeout (ms) <1-10000>
+// <i> Timeout for data transfer and card programming.
+#define MCI_XFER_TIMEOUT                1000
+// <o> Latency profile iterations <1-10000>
+// <i> Number of single and multiple block write/read sequences profiled by MCI_Latency_Profile.
+#define MCI_LATENCY_NUM                 100
+// </h>
+// <h> Tests
+// <i> Enable / disable tests.
+// <q> MCI_GetCapabilities
+#define MCI_GETCAPABILITIES_EN          1
+// <q> MCI_Initialization
+#define MCI_INITIALIZATION_EN           1
+// <q> MCI_PowerControl
+#define MCI_POWERCONTROL_EN             1
+// <q> MCI_SetBusSpeedMode
+#define MCI_SETBUSSPEEDMODE_EN          1
+// <q> MCI_Config_DataWidth
+#define MCI_CONFIG_DATAWIDTH_EN         1
+// <q> MCI_Config_CmdLineMode
+#define MCI_CONFIG_CMDLINEMODE_EN       1
+// <q> MCI_Config_DriverStrength
+#define MCI_CONFIG_DRIVERSTRENGTH_EN    1
+// <q> MCI_CheckInvalidInit
+#define MCI_CHECKINVALIDINIT_EN         1
+// <e> Data transfer
+// <i> Data transfer tests require a card. Enable / disable data transfer tests.
+#define MCI_DATA_EN                     1
+// <q> MCI_Card_Initialize
+#define MCI_CARD_INITIALIZE_EN          1
+// <q> MCI_ReadWrite_Verify
+// <i> Overwrites data in the test area!
+#define MCI_READWRITE_VERIFY_EN         1
+// <q> MCI_Throughput_Read
+#define MCI_THROUGHPUT_READ_EN          1
+// <q> MCI_Throughput_Write
+// <i> Overwrites data in the test area!
+#define MCI_THROUGHPUT_WRITE_EN         1
+// <q> MCI_Latency_Profile
+// <i> Overwrites data in the test area!
+#define MCI_LATENCY_PROFILE_EN          1
+// </e>
+// </h>
+// </h>
+
+#endif /* DV_MCI_CONFIG_H_ */
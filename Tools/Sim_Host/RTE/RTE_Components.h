@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Component selection of the host build
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef RTE_COMPONENTS_H
+#define RTE_COMPONENTS_H
+
+#define RTE_CMSIS_RTOS2                 /* CMSIS-RTOS2 (host port)            */
+
+#define RTE_CMSIS_DV_PACK_VER           "3.1.0"
+
+#define RTE_CMSIS_DV_CAN                /* Driver Validation CAN (CAN_Sim)    */
+#define RTE_CMSIS_DV_MCI                /* Driver Validation MCI (MCI_Sim)    */
+
+#endif /* RTE_COMPONENTS_H */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Simulator time base
+ *
+ * The time base is shared by all simulated drivers linked into one host
+ * build. Each simulator registers when its driver is initialized; on every
+ * system timer read simulated time advances by the poll step, jumps to the
+ * earliest event of the busy simulators and events of all simulators are
+ * processed.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Sim_Time_Config.h"
+#include "Sim_Time.h"
+
+#if (SIM_TIME_OS_SYSTIMER != 0)
+#include "cmsis_os2.h"
+#endif
+
+static const SIM_TIME_CLIENT *sim_client[SIM_TIME_CLIENT_NUM];
+static uint32_t               sim_client_cnt;
+static uint64_t               sim_time;         // Simulated time (ns)
+#if (SIM_TIME_BASE == 0)
+static uint64_t               host_time_start;  // Host monotonic clock at first time read (ns)
+#endif
+
+// Global functions
+
+int32_t Sim_Time_Register (const SIM_TIME_CLIENT *client) {
+  uint32_t i;
+
+  if ((client == NULL) || (client->NextEvent == NULL) || (client->Process == NULL)) {
+    return -1;
+  }
+  for (i = 0U; i < sim_client_cnt; i++) {
+    if (sim_client[i] == client) {
+      return 0;
+    }
+  }
+  if (sim_client_cnt == SIM_TIME_CLIENT_NUM) {
+    return -1;
+  }
+  sim_client[sim_client_cnt++] = client;
+  return 0;
+}
+
+uint64_t Sim_Time_Now (void) {
+#if (SIM_TIME_BASE == 0)
+  struct timespec ts;
+  uint64_t t;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  t = ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+  if (host_time_start == 0U) {
+    host_time_start = t;
+  }
+  sim_time = t - host_time_start;
+#endif
+  return sim_time;
+}
+
+uint32_t Sim_Time_GetSysTimerCount (void) {
+  uint32_t i;
+#if (SIM_TIME_BASE != 0)
+  uint64_t next, t;
+
+  sim_time += SIM_TIME_POLL_NS;
+  // Jump to the earliest event of the busy simulators, unless one of them is processing events
+  next = UINT64_MAX;
+  for (i = 0U; i < sim_client_cnt; i++) {
+    t = sim_client[i]->NextEvent();
+    if (t < next) {
+      next = t;
+    }
+  }
+  if ((next != UINT64_MAX) && (next > sim_time)) {
+    sim_time = next;
+  }
+#endif
+  for (i = 0U; i < sim_client_cnt; i++) {
+    sim_client[i]->Process();
+  }
+  return (uint32_t)((Sim_Time_Now() * (SIM_TIME_TIMER_FREQ / 1000000U)) / 1000U);
+}
+
+uint32_t Sim_Time_GetSysTimerFreq (void) {
+  return SIM_TIME_TIMER_FREQ;
+}
+
+#if (SIM_TIME_OS_SYSTIMER != 0)
+uint32_t osKernelGetSysTimerCount (void) {
+  return Sim_Time_GetSysTimerCount();
+}
+
+uint32_t osKernelGetSysTimerFreq (void) {
+  return Sim_Time_GetSysTimerFreq();
+}
+#endif
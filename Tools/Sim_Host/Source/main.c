@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       Main module of the host build
+ *
+ * Runs the driver validation on the simulated drivers:
+ *   Sim_Host [<shard index> <shard count>]
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "RTE_Components.h"
+#include "cmsis_os2.h"
+
+#include "cmsis_dv.h"                   // ARM.API::CMSIS Driver Validation:Framework
+
+/*------------------------------------------------------------------------------
+ * main function
+ *----------------------------------------------------------------------------*/
+int main (int argc, char *argv[]) {
+  static DV_SHARD shard;
+
+  if ((argc != 1) && (argc != 3)) {
+    fprintf(stderr, "Usage: %s [<shard index> <shard count>]\n", argv[0]);
+    return 1;
+  }
+
+  setvbuf(stdout, NULL, _IOLBF, 0);     // Line buffered report output
+
+  osKernelInitialize ();                // Initialize CMSIS-RTOS2
+  if (argc == 3) {
+    shard.index = (uint32_t)strtoul(argv[1], NULL, 0);
+    shard.count = (uint32_t)strtoul(argv[2], NULL, 0);
+    osThreadNew (cmsis_dv, &shard, NULL); // Create validation main thread (shard of the tests)
+  } else {
+    osThreadNew (cmsis_dv, NULL, NULL); // Create validation main thread
+  }
+  osKernelStart ();                     // Start thread execution, returns when validation is done
+
+  return 0;
+}
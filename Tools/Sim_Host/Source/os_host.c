@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     Simulator Host
+ * Title:       CMSIS-RTOS2 subset on POSIX threads
+ *
+ * Implements the kernel, thread, thread flags and delay functions used by
+ * the validation framework:
+ *  - threads are POSIX threads, priorities are stored but not applied
+ *  - threads created before osKernelStart wait for the kernel start;
+ *    osKernelStart returns when all threads have ended
+ *  - osThreadTerminate cancels the thread asynchronously, which is adequate
+ *    for a test hanging in a wait loop (a thread terminated while it holds a
+ *    C library lock, for example within printf, blocks the next caller)
+ *  - kernel tick is the host monotonic clock in ms, the system timer is
+ *    provided by the simulator time base (Sim_Time.c)
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "cmsis_os2.h"
+
+#define OS_TICK_FREQ                    1000U
+
+typedef struct {
+  pthread_t        thread;
+  osThreadFunc_t   func;
+  void            *argument;
+  osPriority_t     priority;
+  uint32_t         stack_size;
+  uint32_t         flags;               // Thread flags
+  uint8_t          ended;               // Thread function returned or thread terminated
+} OS_THREAD;
+
+static pthread_mutex_t os_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  os_cond  = PTHREAD_COND_INITIALIZER;
+static uint8_t         os_running;      // Kernel started
+static uint32_t        os_threads;      // Number of threads not ended
+
+static OS_THREAD        os_main = { .priority = osPriorityNormal };
+static __thread OS_THREAD *os_self;
+
+// Local functions
+
+// Lock kernel, thread is not cancelled while it holds the lock
+static void os_Lock (int *state) {
+  (void)pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, state);
+  (void)pthread_mutex_lock(&os_mutex);
+}
+
+static void os_Unlock (int state) {
+  (void)pthread_mutex_unlock(&os_mutex);
+  (void)pthread_setcancelstate(state, NULL);
+}
+
+// Absolute time (condition variable clock) of timeout in kernel ticks
+static void os_Deadline (struct timespec *ts, uint32_t ticks) {
+  uint64_t ns;
+
+  clock_gettime(CLOCK_REALTIME, ts);
+  ns  = (uint64_t)ts->tv_nsec + (((uint64_t)ticks % OS_TICK_FREQ) * (1000000000U / OS_TICK_FREQ));
+  ts->tv_sec  += (time_t)((ticks / OS_TICK_FREQ) + (ns / 1000000000U));
+  ts->tv_nsec  = (long)(ns % 1000000000U);
+}
+
+static void *os_Thread (void *argument) {
+  OS_THREAD *th = argument;
+  int state;
+
+  os_self = th;
+  os_Lock(&state);
+  while (os_running == 0U) {
+    (void)pthread_cond_wait(&os_cond, &os_mutex);
+  }
+  os_Unlock(state);
+
+  (void)pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+  th->func(th->argument);
+  (void)pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+  os_Lock(&state);
+  if (th->ended == 0U) {                // Not terminated meanwhile
+    th->ended = 1U;
+    os_threads--;
+    (void)pthread_detach(th->thread);
+    (void)pthread_cond_broadcast(&os_cond);
+  }
+  os_Unlock(state);
+  return NULL;
+}
+
+// Kernel functions
+
+osStatus_t osKernelInitialize (void) {
+  return osOK;
+}
+
+osStatus_t osKernelStart (void) {
+  int state;
+
+  os_Lock(&state);
+  os_running = 1U;
+  (void)pthread_cond_broadcast(&os_cond);
+  while (os_threads != 0U) {
+    (void)pthread_cond_wait(&os_cond, &os_mutex);
+  }
+  os_Unlock(state);
+  return osOK;
+}
+
+uint32_t osKernelGetTickCount (void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(((uint64_t)ts.tv_sec * OS_TICK_FREQ) + ((uint64_t)ts.tv_nsec / (1000000000U / OS_TICK_FREQ)));
+}
+
+uint32_t osKernelGetTickFreq (void) {
+  return OS_TICK_FREQ;
+}
+
+// Thread functions
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+  pthread_attr_t pattr;
+  OS_THREAD     *th;
+  int            state;
+
+  if (func == NULL) {
+    return NULL;
+  }
+  th = calloc(1U, sizeof(OS_THREAD));
+  if (th == NULL) {
+    return NULL;
+  }
+  th->func     = func;
+  th->argument = argument;
+  th->priority = osPriorityNormal;
+  if (attr != NULL) {
+    if (attr->priority != osPriorityNone) {
+      th->priority = attr->priority;
+    }
+    th->stack_size = attr->stack_size;
+  }
+
+  (void)pthread_attr_init(&pattr);
+  if (th->stack_size >= PTHREAD_STACK_MIN) {
+    (void)pthread_attr_setstacksize(&pattr, th->stack_size);
+  }
+  os_Lock(&state);
+  if (pthread_create(&th->thread, &pattr, os_Thread, th) != 0) {
+    os_Unlock(state);
+    (void)pthread_attr_destroy(&pattr);
+    free(th);
+    return NULL;
+  }
+  os_threads++;
+  os_Unlock(state);
+  (void)pthread_attr_destroy(&pattr);
+  return (osThreadId_t)th;
+}
+
+osThreadId_t osThreadGetId (void) {
+  if (os_self == NULL) {
+    os_self = &os_main;                 // Thread not created by osThreadNew
+  }
+  return (osThreadId_t)os_self;
+}
+
+uint32_t osThreadGetStackSize (osThreadId_t thread_id) {
+  if (thread_id == NULL) {
+    return 0U;
+  }
+  return ((OS_THREAD *)thread_id)->stack_size;
+}
+
+osPriority_t osThreadGetPriority (osThreadId_t thread_id) {
+  if (thread_id == NULL) {
+    return osPriorityError;
+  }
+  return ((OS_THREAD *)thread_id)->priority;
+}
+
+osStatus_t osThreadSetPriority (osThreadId_t thread_id, osPriority_t priority) {
+  if ((thread_id == NULL) || (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+    return osErrorParameter;
+  }
+  ((OS_THREAD *)thread_id)->priority = priority;
+  return osOK;
+}
+
+osStatus_t osThreadTerminate (osThreadId_t thread_id) {
+  OS_THREAD *th = thread_id;
+  int state;
+
+  if ((th == NULL) || (th == &os_main)) {
+    return osErrorParameter;
+  }
+  if (th == os_self) {
+    return osErrorISR;
+  }
+  os_Lock(&state);
+  if (th->ended != 0U) {
+    os_Unlock(state);
+    return osErrorResource;
+  }
+  th->ended = 1U;
+  os_threads--;
+  (void)pthread_cancel(th->thread);
+  (void)pthread_cond_broadcast(&os_cond);
+  os_Unlock(state);
+  (void)pthread_join(th->thread, NULL);
+  return osOK;
+}
+
+// Thread flags functions
+
+uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags) {
+  OS_THREAD *th = thread_id;
+  uint32_t   rflags;
+  int        state;
+
+  if ((th == NULL) || ((flags & 0x80000000U) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+  os_Lock(&state);
+  th->flags |= flags;
+  rflags     = th->flags;
+  (void)pthread_cond_broadcast(&os_cond);
+  os_Unlock(state);
+  return rflags;
+}
+
+uint32_t osThreadFlagsClear (uint32_t flags) {
+  OS_THREAD *th = osThreadGetId();
+  uint32_t   rflags;
+  int        state;
+
+  os_Lock(&state);
+  rflags     = th->flags;
+  th->flags &= ~flags;
+  os_Unlock(state);
+  return rflags;
+}
+
+uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout) {
+  OS_THREAD      *th = osThreadGetId();
+  struct timespec ts;
+  uint32_t        rflags;
+  int             state, done;
+
+  if (timeout != osWaitForever) {
+    os_Deadline(&ts, timeout);
+  }
+  os_Lock(&state);
+  for (;;) {
+    if ((options & osFlagsWaitAll) != 0U) {
+      done = ((th->flags & flags) == flags);
+    } else {
+      done = ((th->flags & flags) != 0U);
+    }
+    if (done) {
+      rflags = th->flags;
+      if ((options & osFlagsNoClear) == 0U) {
+        th->flags &= ~flags;
+      }
+      break;
+    }
+    if (timeout == 0U) {
+      rflags = osFlagsErrorResource;
+      break;
+    }
+    if (timeout == osWaitForever) {
+      (void)pthread_cond_wait(&os_cond, &os_mutex);
+    } else if (pthread_cond_timedwait(&os_cond, &os_mutex, &ts) == ETIMEDOUT) {
+      rflags = osFlagsErrorTimeout;
+      break;
+    }
+  }
+  os_Unlock(state);
+  return rflags;
+}
+
+// Generic wait functions
+
+osStatus_t osDelay (uint32_t ticks) {
+  struct timespec ts;
+
+  ts.tv_sec  = (time_t)(ticks / OS_TICK_FREQ);
+  ts.tv_nsec = (long)((ticks % OS_TICK_FREQ) * (1000000000U / OS_TICK_FREQ));
+  while (nanosleep(&ts, &ts) != 0) {
+    if (errno != EINTR) {
+      break;
+    }
+  }
+  return osOK;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2020 Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026 Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,6 +26,8 @@
 // Definitions
 #define ESC                 0x1b        // Ascii code for ESC
 #define BUFF_SIZE           2000        // Size of buffers (heap: 6000 bytes)
+#define ASSISTANT_SESSIONS  3           // Number of concurrent test assistant sessions
+#define ASSISTANT_BUFF_SIZE 1500        // Size of test assistant session buffer
 
 // Service ports
 #define ECHO_PORT           7           // Echo port number
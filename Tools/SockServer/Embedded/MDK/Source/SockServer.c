@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2020 Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026 Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -278,47 +278,43 @@ void StreamServer (void *argument) {
   }
 }
 
-// Test assistant thread
-void TestAssistant (void *argument) {
+// Test assistant session
+typedef struct {
+  int32_t     sock;             // Accepted session socket
+  SOCKADDR_IN addr;             // Client address
+} ASSISTANT_SESSION;
+
+static osMessageQueueId_t assistant_queue;
+static osSemaphoreId_t    assistant_free;
+
+// Test assistant worker thread (ASSISTANT_SESSIONS instances)
+// (runs one command session at a time, each instance has own buffer)
+static void AssistantThread (void *argument) {
+  static char buffer[ASSISTANT_SESSIONS][ASSISTANT_BUFF_SIZE];
+  char *buff = buffer[(uint32_t)argument];
+  ASSISTANT_SESSION session;
   SOCKADDR_IN sa;
   int32_t sock,sd,rc,sa_len;
-  static char buff[1500];
-
-  while (1) {
-    // Create socket
-    sock = socket (PF_INET, SOCK_STREAM, 0);
 
-    // Server mode first
-    sa.sin_family      = AF_INET;
-    sa.sin_addr.s_addr = INADDR_ANY;
-    sa.sin_port        = htons (ASSISTANT_PORT);
-    bind (sock, (SOCKADDR *)&sa, sizeof(sa));
-    listen (sock, 1);
-
-    while (1) {
-      // Wait for the client to connect
-      sa_len = sizeof (sa);
-      sd = accept (sock, (SOCKADDR *)&sa, &sa_len);
-      if (sd >= 0) {
-        // Set blocking receive timeout
-        uint32_t tout = 2000;
-        setsockopt (sd, SOL_SOCKET, SO_RCVTIMEO, (char *)&tout, sizeof(tout));
-        // Receive the command (tout = 2s)
-        rc = recv (sd, buff, sizeof(buff), 0);
-        if (rc > 0) {
-          buff[rc] = 0;
-          if ((strncmp (buff, "CONNECT TCP", 11) == 0) ||
-              (strncmp (buff, "CONNECT UDP", 11) == 0) ||
-              (strncmp (buff, "SEND TCP", 8) == 0)     ||
-              (strncmp (buff, "RECV TCP", 8) == 0)) {
-            break;
-          }
-        }
-        closesocket (sd);
-        osDelay (10);
-      }
+  for (;;) {
+    // Wait for the session from the listener
+    if (osMessageQueueGet (assistant_queue, &session, NULL, osWaitForever) != osOK) {
+      continue;
+    }
+    sd     = session.sock;
+    sa     = session.addr;
+    sa_len = sizeof (sa);
+
+    // Set blocking receive timeout
+    uint32_t tout = 2000;
+    setsockopt (sd, SOL_SOCKET, SO_RCVTIMEO, (char *)&tout, sizeof(tout));
+    // Receive the command (tout = 2s)
+    rc = recv (sd, buff, ASSISTANT_BUFF_SIZE - 1, 0);
+    if (rc > 0) {
+      buff[rc] = 0;
+    } else {
+      buff[0]  = 0;
     }
-    closesocket (sock);
 
     /* Syntax:  CONNECT <proto>,<ip_addr>,<port>,<delay_ms>
        Param:   <proto>    = protocol (TCP, UDP)
@@ -329,7 +325,8 @@ void TestAssistant (void *argument) {
        Example: CONNECT TCP,192.168.1.200,80,600
        (wait 600ms then connect to 192.168.1.200, port 80)
     */
-    if (buff[0] == 'C') { // CONNECT
+    if ((strncmp (buff, "CONNECT TCP", 11) == 0) ||
+        (strncmp (buff, "CONNECT UDP", 11) == 0)) {
       uint16_t delay,port;
       IN_ADDR  da;
 
@@ -360,8 +357,6 @@ void TestAssistant (void *argument) {
         osDelay (500);
       }
       closesocket (sock);
-      osDelay (10);
-      continue;
     }
 
     /* Syntax:  SEND <proto>,<bsize>,<time_ms>
@@ -369,7 +364,7 @@ void TestAssistant (void *argument) {
                 <bsize>   = size of data block in bytes 
                 <time_ms> = test duration in ms
     */
-    if (buff[0] == 'S') { // SEND
+    else if (strncmp (buff, "SEND TCP", 8) == 0) {
       uint32_t bsize,time,ticks;
       int32_t  i,n,cnt,ch = 'a';
     
@@ -401,17 +396,16 @@ void TestAssistant (void *argument) {
       send (sd, buff, n, 0);
 
       // Let the client close the connection
-      while (recv (sd, buff, sizeof(buff), 0) > 0);
+      while (recv (sd, buff, ASSISTANT_BUFF_SIZE, 0) > 0);
 
       closesocket (sd);
-      continue;
     }
 
     /* Syntax:  RECV <proto>,<bsize>
        Param:   <proto> = protocol (TCP, UDP)
                 <bsize> = size of data block in bytes 
     */
-    if (buff[0] == 'R') { // RECV
+    else if (strncmp (buff, "RECV TCP", 8) == 0) {
       uint32_t bsize;
       int32_t  n,cnt;
     
@@ -438,10 +432,59 @@ void TestAssistant (void *argument) {
       send (sd, buff, n, 0);
  
       // Let the client close the connection
-      while (recv (sd, buff, sizeof(buff), 0) > 0);
+      while (recv (sd, buff, ASSISTANT_BUFF_SIZE, 0) > 0);
 
       closesocket (sd);
-      continue;
     }
+
+    else {
+      // Unknown command or receive timeout
+      closesocket (sd);
+    }
+
+    // Worker is free for the next session
+    osSemaphoreRelease (assistant_free);
+  }
+}
+
+// Test assistant thread
+// (persistent listener, dispatches command sessions to worker threads)
+void TestAssistant (void *argument) {
+  ASSISTANT_SESSION session;
+  SOCKADDR_IN sa;
+  int32_t sock,sa_len;
+  uint32_t i;
+
+  assistant_queue = osMessageQueueNew (ASSISTANT_SESSIONS, sizeof(ASSISTANT_SESSION), NULL);
+  assistant_free  = osSemaphoreNew (ASSISTANT_SESSIONS, ASSISTANT_SESSIONS, NULL);
+  for (i = 0; i < ASSISTANT_SESSIONS; i++) {
+    osThreadNew(AssistantThread, (void *)i, NULL);
+  }
+
+  // Create listening socket
+  sock = socket (PF_INET, SOCK_STREAM, 0);
+
+  sa.sin_family      = AF_INET;
+  sa.sin_addr.s_addr = INADDR_ANY;
+  sa.sin_port        = htons (ASSISTANT_PORT);
+  bind (sock, (SOCKADDR *)&sa, sizeof(sa));
+  listen (sock, ASSISTANT_SESSIONS);
+
+  for (;;) {
+    // Wait for a free worker, pending clients wait in the backlog
+    osSemaphoreAcquire (assistant_free, osWaitForever);
+
+    // Wait for the client to connect
+    do {
+      sa_len = sizeof (sa);
+      session.sock = accept (sock, (SOCKADDR *)&sa, &sa_len);
+      if (session.sock < 0) {
+        osDelay (10);
+      }
+    } while (session.sock < 0);
+
+    // Dispatch session to the free worker
+    session.addr = sa;
+    osMessageQueuePut (assistant_queue, &session, 0, osWaitForever);
   }
 }
@@ -0,0 +1,5 @@
+#!/bin/sh
+# Build USBD_Host (requires libusb-1.0 development package)
+cd Source
+gcc -O2 USBD_Host.c -I ../Include -lusb-1.0 -o ../USBD_Host
+cd ..
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     USBD_Host
+ * Title:       USB Device validation host tool definitions
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef __USBD_HOST_H
+#define __USBD_HOST_H
+
+// Default test device (matches DV_USBD_Config.h defaults)
+#define USBD_HOST_VID           0xC251
+#define USBD_HOST_PID           0x1DA0
+
+// Endpoints of the test device
+#define EP_BULK_OUT             0x01
+#define EP_BULK_IN              0x81
+#define EP_INT_IN               0x82
+#define EP_ISO_IN               0x83    // Alternate setting 1 only
+#define EP_ISO_OUT              0x03    // Alternate setting 1 only
+
+// Vendor requests
+#define VREQ_START              1       // Start phase (wValue: phase, data: total bytes and bytes per transfer)
+#define VREQ_RESULT             2       // Get result of last phase (errors, bytes, time in us)
+#define VREQ_DONE               3       // All phases done
+
+// Phases
+#define PHASE_OUT               1       // Host sends total bytes in transfers of given size
+#define PHASE_IN                2       // Device sends total bytes in transfers of given size
+#define PHASE_ZLP_OUT           3       // Host sends transfers (multiple of max packet size) terminated by ZLP
+#define PHASE_ZLP_IN            4       // Device sends transfers (multiple of max packet size) followed by ZLP
+#define PHASE_MULTI             5       // Concurrent transfers on multiple endpoints (data: duration in ms and endpoint mask)
+#define PHASE_ISO               6       // Isochronous IN and OUT streams (data: duration in ms and bytes per packet)
+
+// Endpoint mask bits of the multiple endpoint phase
+#define MASK_BULK_OUT           (1U << 0)
+#define MASK_BULK_IN            (1U << 1)
+#define MASK_INT_IN             (1U << 2)
+#define MASK_ISO_IN             (1U << 3)
+
+// Defaults
+#define TOTAL_BYTES_DEF         (4U*1024U*1024U)  // Bytes per throughput phase
+#define ZLP_PACKETS             4U                // Transfer size of ZLP phases (in max packet size)
+#define ZLP_TRANSFERS           16U               // Number of transfers in ZLP phases
+#define CTRL_TIMEOUT            1000U             // Control transfer timeout (ms)
+#define BULK_TIMEOUT            5000U             // Bulk transfer timeout (ms)
+#define OPEN_TIMEOUT            30U               // Wait for device (s)
+#define MULTI_TIME_DEF          2000U             // Duration of multiple endpoint phases (ms)
+#define MULTI_BULK_SIZE         16384U            // Bulk transfer size of multiple endpoint phases
+#define MULTI_QUEUE             4U                // Transfers queued per endpoint
+#define MULTI_ISO_PACKETS       8U                // Packets per isochronous transfer
+#define ISO_TIME_DEF            120000U           // Duration of the isochronous phase (ms)
+#define ISO_PACKET_DEF          192U              // Bytes per isochronous packet
+#define ISO_QUEUE               8U                // Isochronous transfers queued per endpoint
+#define ISO_PACKETS             32U               // Packets per isochronous transfer
+
+#endif /* __USBD_HOST_H */
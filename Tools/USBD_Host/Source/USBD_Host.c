@@ -0,0 +1,653 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     USBD_Host
+ * Title:       USB Device validation host tool
+ * Purpose:     Drives the USBD_Bulk_Throughput test of the device under test
+ *               - bulk OUT and bulk IN throughput for a list of transfer sizes
+ *               - bulk OUT and bulk IN transfers terminated by zero-length packet
+ *              Reports throughput (MB/s) and per-transfer latency measured on the host
+ *              and the device side results.
+ *              Drives the USBD_Multi_Endpoint test (option -m)
+ *               - concurrent asynchronous transfers on bulk, interrupt and isochronous
+ *                 endpoints for a set of endpoint combinations
+ *              Drives the USBD_Isochronous test (option -i)
+ *               - isochronous IN and OUT streams with sequence numbered packets
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#define VERSION     "v1.2"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <libusb-1.0/libusb.h>
+#include "USBD_Host.h"
+
+static libusb_device_handle *dev;
+static uint16_t mps;                    // Bulk endpoint maximum packet size
+static uint8_t *buf;
+static double  *lat;                    // Transfer latency samples (in us)
+static uint32_t errors;
+
+// Endpoint stream of the multiple endpoint mode
+typedef struct {
+  const char    *name;
+  uint8_t        ep;
+  uint8_t        type;                  // LIBUSB_TRANSFER_TYPE_x
+  uint32_t       size;                  // Bytes per transfer
+  uint32_t       pending;               // Submitted transfers
+  uint64_t       bytes;
+  uint32_t       transfers;
+  uint32_t       errors;
+  struct libusb_transfer *xfer[MULTI_QUEUE];
+} STREAM;
+
+static STREAM stream[4];
+static int    stop;                     // Do not resubmit completed transfers
+
+// Isochronous stream of the isochronous mode
+typedef struct {
+  uint32_t       seq;                   // Next OUT sequence number or expected IN sequence number
+  uint32_t       pending;               // Submitted transfers
+  uint32_t       packets;
+  uint32_t       empty;                 // IN packets without data between sequenced packets (device underruns)
+  uint32_t       empty_pend;            // IN packets without data since the last sequenced packet
+  uint32_t       synced;                // First sequenced IN packet received
+  uint32_t       lost;                  // IN sequence number gaps
+  uint32_t       errors;
+  struct libusb_transfer *xfer[ISO_QUEUE];
+} ISO_STREAM;
+
+static ISO_STREAM iso[2];               // Isochronous IN, isochronous OUT
+
+// Get monotonic time in microseconds
+static double time_us (void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e6) + ((double)ts.tv_nsec / 1e3);
+}
+
+// Sleep for given number of milliseconds
+static void sleep_ms (uint32_t ms) {
+  struct timespec ts;
+
+  ts.tv_sec  = (time_t)(ms / 1000U);
+  ts.tv_nsec = (long)(ms % 1000U) * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+// Compare function for sorting latency samples
+static int cmp_lat (const void *a, const void *b) {
+  double va = *(const double *)a;
+  double vb = *(const double *)b;
+  return (va > vb) - (va < vb);
+}
+
+// Send START request, returns 0 on success
+static int phase_start (int phase, uint32_t total, uint32_t size) {
+  uint8_t d[8];
+  int     rc;
+
+  d[0] = (uint8_t)total; d[1] = (uint8_t)(total >> 8); d[2] = (uint8_t)(total >> 16); d[3] = (uint8_t)(total >> 24);
+  d[4] = (uint8_t)size;  d[5] = (uint8_t)(size  >> 8); d[6] = (uint8_t)(size  >> 16); d[7] = (uint8_t)(size  >> 24);
+  rc = libusb_control_transfer(dev, LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
+                               VREQ_START, (uint16_t)phase, 0, d, sizeof(d), CTRL_TIMEOUT);
+  return (rc == (int)sizeof(d)) ? 0 : -1;
+}
+
+// Get device side result of last phase, returns 0 on success
+static int phase_result (uint32_t *dev_err, uint32_t *dev_bytes, uint32_t *dev_us) {
+  uint8_t d[12];
+  int     rc, retry;
+
+  /* Device answers after it processed the last transfer of the phase */
+  for (retry = 0; retry < 100; retry++) {
+    rc = libusb_control_transfer(dev, LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
+                                 VREQ_RESULT, 0, 0, d, sizeof(d), CTRL_TIMEOUT);
+    if (rc == (int)sizeof(d)) {
+      *dev_err   = d[0] | (d[1] << 8) | (d[2]  << 16) | ((uint32_t)d[3]  << 24);
+      *dev_bytes = d[4] | (d[5] << 8) | (d[6]  << 16) | ((uint32_t)d[7]  << 24);
+      *dev_us    = d[8] | (d[9] << 8) | (d[10] << 16) | ((uint32_t)d[11] << 24);
+      return 0;
+    }
+    if (rc != LIBUSB_ERROR_PIPE) {
+      break;
+    }
+    sleep_ms(10U);
+  }
+  return -1;
+}
+
+// Run one phase and print the result
+static void phase_run (int phase, uint32_t total, uint32_t size) {
+  static const char *name[] = { "", "OUT", "IN", "OUT+ZLP", "IN+ZLP" };
+  uint32_t i, n, cnt, len, err, dev_err, dev_bytes, dev_us;
+  double   t0, t1, t_start, t_total;
+  int      rc, act;
+
+  if (phase_start(phase, total, size) != 0) {
+    printf("%-8s %7u B: skipped (not accepted by device)\n", name[phase], size);
+    return;
+  }
+
+  err     = 0U;
+  cnt     = 0U;
+  t_start = time_us();
+  for (n = 0U; n < total; n += size) {
+    len = ((total - n) < size) ? (total - n) : size;
+    act = 0;
+    t0  = time_us();
+    switch (phase) {
+      case PHASE_OUT:
+      case PHASE_ZLP_OUT:
+        for (i = 0U; i < len; i++) { buf[i] = (uint8_t)i; }
+        rc = libusb_bulk_transfer(dev, EP_BULK_OUT, buf, (int)len, &act, BULK_TIMEOUT);
+        if ((rc == 0) && (phase == PHASE_ZLP_OUT)) {
+          rc = libusb_bulk_transfer(dev, EP_BULK_OUT, buf, 0, NULL, BULK_TIMEOUT);
+        }
+        break;
+      default:
+        /* Read buffer is one packet larger in ZLP phase: transfer must end with the ZLP */
+        rc = libusb_bulk_transfer(dev, EP_BULK_IN, buf, (int)(len + ((phase == PHASE_ZLP_IN) ? mps : 0U)), &act, BULK_TIMEOUT);
+        if (rc == 0) {
+          for (i = 0U; i < (uint32_t)act; i++) {
+            if (buf[i] != (uint8_t)i) { err++; break; }
+          }
+        }
+        break;
+    }
+    t1 = time_us();
+    if ((rc != 0) || ((uint32_t)act != len)) {
+      printf("%-8s %7u B: transfer %u failed (%s, %d bytes)\n", name[phase], size, cnt, libusb_error_name(rc), act);
+      err++;
+      break;
+    }
+    lat[cnt++] = t1 - t0;
+  }
+  t_total = time_us() - t_start;
+
+  if (phase_result(&dev_err, &dev_bytes, &dev_us) != 0) {
+    printf("%-8s %7u B: no result from device\n", name[phase], size);
+    errors++;
+    return;
+  }
+  errors += err + dev_err;
+
+  if (cnt == 0U) {
+    return;
+  }
+  qsort(lat, cnt, sizeof(double), cmp_lat);
+  printf("%-8s %7u B: %7.2f MB/s, latency min/p50/p99/max %.0f/%.0f/%.0f/%.0f us, device %7.2f MB/s, errors %u/%u\n",
+         name[phase], size, ((double)n / t_total),
+         lat[0], lat[cnt / 2U], lat[(cnt * 99U) / 100U], lat[cnt - 1U],
+         (dev_us != 0U) ? ((double)dev_bytes / dev_us) : 0.0, err, dev_err);
+}
+
+// Asynchronous transfer completion callback of the multiple endpoint mode
+static void LIBUSB_CALL multi_cb (struct libusb_transfer *xfer) {
+  STREAM *st = (STREAM *)xfer->user_data;
+  int     i;
+
+  st->pending--;
+  switch (xfer->status) {
+    case LIBUSB_TRANSFER_COMPLETED:
+      if (xfer->type == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS) {
+        for (i = 0; i < xfer->num_iso_packets; i++) {
+          st->bytes += xfer->iso_packet_desc[i].actual_length;
+        }
+      } else {
+        st->bytes += (uint32_t)xfer->actual_length;
+      }
+      st->transfers++;
+      break;
+    case LIBUSB_TRANSFER_CANCELLED:
+      return;
+    default:
+      if (stop == 0) {
+        st->errors++;
+      }
+      return;
+  }
+  if ((stop == 0) && (libusb_submit_transfer(xfer) == 0)) {
+    st->pending++;
+  }
+}
+
+// Run one multiple endpoint phase with the endpoints selected by mask and print the result
+static void multi_run (uint32_t mask, uint32_t duration) {
+  STREAM  *st;
+  struct timeval tv;
+  uint32_t n, i, err, dev_err, dev_bytes, dev_us;
+  uint16_t iso_mps;
+  double   t_start, t_total;
+  int      alt;
+
+  /* Isochronous endpoint is available in alternate setting 1 only */
+  alt = ((mask & MASK_ISO_IN) != 0U) ? 1 : 0;
+  if (libusb_set_interface_alt_setting(dev, 0, alt) != 0) {
+    printf("Multi %02X: set alternate setting %d failed\n", mask, alt);
+    errors++;
+    return;
+  }
+  iso_mps = 0U;
+  if (alt != 0) {
+    iso_mps = (uint16_t)libusb_get_max_iso_packet_size(libusb_get_device(dev), EP_ISO_IN);
+  }
+
+  stream[0].name = "Bulk OUT";       stream[0].ep = EP_BULK_OUT; stream[0].type = LIBUSB_TRANSFER_TYPE_BULK;
+  stream[0].size = MULTI_BULK_SIZE;
+  stream[1].name = "Bulk IN";        stream[1].ep = EP_BULK_IN;  stream[1].type = LIBUSB_TRANSFER_TYPE_BULK;
+  stream[1].size = MULTI_BULK_SIZE;
+  stream[2].name = "Interrupt IN";   stream[2].ep = EP_INT_IN;   stream[2].type = LIBUSB_TRANSFER_TYPE_INTERRUPT;
+  stream[2].size = (uint32_t)libusb_get_max_packet_size(libusb_get_device(dev), EP_INT_IN);
+  stream[3].name = "Isochronous IN"; stream[3].ep = EP_ISO_IN;   stream[3].type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
+  stream[3].size = iso_mps * MULTI_ISO_PACKETS;
+
+  if (phase_start(PHASE_MULTI, duration, mask) != 0) {
+    printf("Multi %02X: skipped (not accepted by device)\n", mask);
+    (void)libusb_set_interface_alt_setting(dev, 0, 0);
+    return;
+  }
+
+  /* Queue transfers on all selected endpoints */
+  stop    = 0;
+  t_start = time_us();
+  for (n = 0U; n < 4U; n++) {
+    st = &stream[n];
+    st->pending = 0U; st->bytes = 0U; st->transfers = 0U; st->errors = 0U;
+    if ((mask & (1U << n)) == 0U) {
+      continue;
+    }
+    for (i = 0U; i < MULTI_QUEUE; i++) {
+      st->xfer[i] = libusb_alloc_transfer((st->type == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS) ? MULTI_ISO_PACKETS : 0);
+      if (st->xfer[i] == NULL) {
+        st->errors++;
+        continue;
+      }
+      if (st->type == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS) {
+        libusb_fill_iso_transfer(st->xfer[i], dev, st->ep, &buf[(n * MULTI_QUEUE + i) * MULTI_BULK_SIZE], (int)st->size,
+                                 MULTI_ISO_PACKETS, multi_cb, st, 0U);
+        libusb_set_iso_packet_lengths(st->xfer[i], iso_mps);
+      } else if (st->type == LIBUSB_TRANSFER_TYPE_INTERRUPT) {
+        libusb_fill_interrupt_transfer(st->xfer[i], dev, st->ep, &buf[(n * MULTI_QUEUE + i) * MULTI_BULK_SIZE], (int)st->size,
+                                       multi_cb, st, 0U);
+      } else {
+        libusb_fill_bulk_transfer(st->xfer[i], dev, st->ep, &buf[(n * MULTI_QUEUE + i) * MULTI_BULK_SIZE], (int)st->size,
+                                  multi_cb, st, 0U);
+      }
+      if (libusb_submit_transfer(st->xfer[i]) == 0) {
+        st->pending++;
+      } else {
+        st->errors++;
+      }
+    }
+  }
+
+  /* Run for the phase duration, then cancel the queued transfers */
+  tv.tv_sec  = 0;
+  tv.tv_usec = 10000;
+  while ((time_us() - t_start) < ((double)duration * 1e3)) {
+    (void)libusb_handle_events_timeout(NULL, &tv);
+  }
+  stop    = 1;
+  t_total = time_us() - t_start;
+  for (n = 0U; n < 4U; n++) {
+    if ((mask & (1U << n)) == 0U) {
+      continue;
+    }
+    for (i = 0U; i < MULTI_QUEUE; i++) {
+      if (stream[n].xfer[i] != NULL) {
+        (void)libusb_cancel_transfer(stream[n].xfer[i]);
+      }
+    }
+  }
+  for (i = 0U; i < 200U; i++) {
+    if ((stream[0].pending + stream[1].pending + stream[2].pending + stream[3].pending) == 0U) {
+      break;
+    }
+    (void)libusb_handle_events_timeout(NULL, &tv);
+  }
+
+  err = 0U;
+  printf("Multi %02X:\n", mask);
+  for (n = 0U; n < 4U; n++) {
+    st = &stream[n];
+    if ((mask & (1U << n)) == 0U) {
+      continue;
+    }
+    for (i = 0U; i < MULTI_QUEUE; i++) {
+      if (st->xfer[i] != NULL) {
+        libusb_free_transfer(st->xfer[i]);
+        st->xfer[i] = NULL;
+      }
+    }
+    printf("  %-15s %7.2f MB/s, %u transfers, errors %u\n", st->name, ((double)st->bytes / t_total), st->transfers, st->errors);
+    err += st->errors;
+  }
+
+  if (phase_result(&dev_err, &dev_bytes, &dev_us) != 0) {
+    printf("  no result from device\n");
+    errors++;
+  } else {
+    printf("  device %7.2f MB/s total, errors %u\n", (dev_us != 0U) ? ((double)dev_bytes / dev_us) : 0.0, dev_err);
+    errors += err + dev_err;
+  }
+  (void)libusb_set_interface_alt_setting(dev, 0, 0);
+}
+
+// Fill sequence numbers into the packets of an isochronous OUT transfer
+static void iso_fill (struct libusb_transfer *xfer, ISO_STREAM *st) {
+  uint8_t *p;
+  int      i;
+
+  for (i = 0; i < xfer->num_iso_packets; i++) {
+    p = libusb_get_iso_packet_buffer_simple(xfer, (unsigned int)i);
+    p[0] = (uint8_t)st->seq; p[1] = (uint8_t)(st->seq >> 8); p[2] = (uint8_t)(st->seq >> 16); p[3] = (uint8_t)(st->seq >> 24);
+    st->seq++;
+  }
+}
+
+// Asynchronous transfer completion callback of the isochronous mode
+static void LIBUSB_CALL iso_cb (struct libusb_transfer *xfer) {
+  ISO_STREAM *st = (ISO_STREAM *)xfer->user_data;
+  uint8_t    *p;
+  uint32_t    seq;
+  int         i;
+
+  st->pending--;
+  if (xfer->status == LIBUSB_TRANSFER_CANCELLED) {
+    return;
+  }
+  if (xfer->status != LIBUSB_TRANSFER_COMPLETED) {
+    if (stop == 0) {
+      st->errors++;
+    }
+  } else {
+    for (i = 0; i < xfer->num_iso_packets; i++) {
+      if (xfer->iso_packet_desc[i].status != LIBUSB_TRANSFER_COMPLETED) {
+        st->errors++;
+        continue;
+      }
+      st->packets++;
+      if (xfer->endpoint != EP_ISO_IN) {
+        continue;
+      }
+      /* Empty IN packets are device underruns, sequence number gaps are lost packets.
+         Empty packets before the first and after the last sequenced packet are outside the device phase. */
+      if (xfer->iso_packet_desc[i].actual_length < 4U) {
+        st->empty_pend += st->synced;
+        continue;
+      }
+      p   = libusb_get_iso_packet_buffer_simple(xfer, (unsigned int)i);
+      seq = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+      if ((st->synced != 0U) && (seq > st->seq)) {
+        st->lost += seq - st->seq;
+      }
+      st->seq         = seq + 1U;
+      st->empty      += st->empty_pend;
+      st->empty_pend  = 0U;
+      st->synced      = 1U;
+    }
+  }
+  if (xfer->endpoint == EP_ISO_OUT) {
+    iso_fill(xfer, st);
+  }
+  if ((stop == 0) && (libusb_submit_transfer(xfer) == 0)) {
+    st->pending++;
+  }
+}
+
+// Run the isochronous phase with packets of given size and print the result
+static void iso_run (uint32_t duration, uint32_t size) {
+  static const uint8_t iso_ep[2] = { EP_ISO_IN, EP_ISO_OUT };
+  ISO_STREAM *st;
+  struct timeval tv;
+  uint32_t n, i, len, dev_err, dev_bytes, dev_us;
+  double   t_start;
+  int      iso_mps;
+
+  if (libusb_set_interface_alt_setting(dev, 0, 1) != 0) {
+    printf("Isochronous: set alternate setting 1 failed\n");
+    errors++;
+    return;
+  }
+  iso_mps = libusb_get_max_iso_packet_size(libusb_get_device(dev), EP_ISO_IN);
+  if ((iso_mps <= 0) || (iso_mps > 1024) || (phase_start(PHASE_ISO, duration, size) != 0)) {
+    printf("Isochronous %u B: not accepted by device\n", size);
+    (void)libusb_set_interface_alt_setting(dev, 0, 0);
+    errors++;
+    return;
+  }
+
+  /* Queue transfers on the isochronous IN and OUT endpoints */
+  stop = 0;
+  for (n = 0U; n < 2U; n++) {
+    st = &iso[n];
+    memset(st, 0, sizeof(ISO_STREAM));
+    len = (n == 0U) ? (uint32_t)iso_mps : size;
+    for (i = 0U; i < ISO_QUEUE; i++) {
+      st->xfer[i] = libusb_alloc_transfer(ISO_PACKETS);
+      if (st->xfer[i] == NULL) {
+        st->errors++;
+        continue;
+      }
+      libusb_fill_iso_transfer(st->xfer[i], dev, iso_ep[n], &buf[((n * ISO_QUEUE) + i) * ISO_PACKETS * 1024U], (int)(len * ISO_PACKETS),
+                               ISO_PACKETS, iso_cb, st, 0U);
+      libusb_set_iso_packet_lengths(st->xfer[i], len);
+      if (iso_ep[n] == EP_ISO_OUT) {
+        iso_fill(st->xfer[i], st);
+      }
+      if (libusb_submit_transfer(st->xfer[i]) == 0) {
+        st->pending++;
+      } else {
+        st->errors++;
+      }
+    }
+  }
+
+  /* Run for the phase duration, then cancel the queued transfers */
+  printf("Isochronous %u B: streaming for %u s ...\n", size, duration / 1000U);
+  tv.tv_sec  = 0;
+  tv.tv_usec = 10000;
+  t_start    = time_us();
+  while ((time_us() - t_start) < ((double)duration * 1e3)) {
+    (void)libusb_handle_events_timeout(NULL, &tv);
+  }
+  stop = 1;
+  for (n = 0U; n < 2U; n++) {
+    for (i = 0U; i < ISO_QUEUE; i++) {
+      if (iso[n].xfer[i] != NULL) {
+        (void)libusb_cancel_transfer(iso[n].xfer[i]);
+      }
+    }
+  }
+  for (i = 0U; (i < 200U) && ((iso[0].pending + iso[1].pending) != 0U); i++) {
+    (void)libusb_handle_events_timeout(NULL, &tv);
+  }
+  for (n = 0U; n < 2U; n++) {
+    for (i = 0U; i < ISO_QUEUE; i++) {
+      if (iso[n].xfer[i] != NULL) {
+        libusb_free_transfer(iso[n].xfer[i]);
+        iso[n].xfer[i] = NULL;
+      }
+    }
+  }
+
+  printf("  Isochronous IN   %u packets, empty %u, lost %u, errors %u\n", iso[0].packets, iso[0].empty, iso[0].lost, iso[0].errors);
+  printf("  Isochronous OUT  %u packets, errors %u\n", iso[1].packets, iso[1].errors);
+  /* Underruns (empty IN packets) are counted in the device errors */
+  errors += iso[0].lost + iso[0].errors + iso[1].errors;
+  if (phase_result(&dev_err, &dev_bytes, &dev_us) != 0) {
+    printf("  no result from device\n");
+    errors++;
+  } else {
+    printf("  device %7.2f MB/s total, underruns/overruns/errors %u\n", (dev_us != 0U) ? ((double)dev_bytes / dev_us) : 0.0, dev_err);
+    errors += dev_err;
+  }
+  (void)libusb_set_interface_alt_setting(dev, 0, 0);
+}
+
+// Print usage
+static void usage (void) {
+  printf("Usage: USBD_Host [-d vid:pid] [-n bytes] [-m] [-i] [-p bytes] [-t ms] [size ...]\n");
+  printf("  -d vid:pid  test device (default %04x:%04x)\n", USBD_HOST_VID, USBD_HOST_PID);
+  printf("  -n bytes    bytes per throughput phase (default %u)\n", TOTAL_BYTES_DEF);
+  printf("  -m          multiple endpoint mode (USBD_Multi_Endpoint test)\n");
+  printf("  -i          isochronous mode (USBD_Isochronous test)\n");
+  printf("  -p bytes    bytes per isochronous packet (default %u)\n", ISO_PACKET_DEF);
+  printf("  -t ms       duration of each multiple endpoint phase (default %u) or the isochronous phase (default %u)\n",
+         MULTI_TIME_DEF, ISO_TIME_DEF);
+  printf("  size        transfer sizes in bytes (default 64 512 4096 16384)\n");
+}
+
+// Main function
+int main (int argc, char **argv) {
+  static const uint32_t size_def[] = { 64U, 512U, 4096U, 16384U };
+  static const uint32_t mask_def[] = { MASK_BULK_OUT | MASK_BULK_IN,
+                                       MASK_BULK_OUT | MASK_BULK_IN | MASK_INT_IN,
+                                       MASK_INT_IN   | MASK_ISO_IN,
+                                       MASK_BULK_OUT | MASK_BULK_IN | MASK_INT_IN | MASK_ISO_IN };
+  uint32_t sizes[32], size_num, size_min, size_max, total, duration, multi, isoc, iso_size, i;
+  unsigned vid, pid;
+  int      speed, a;
+
+  printf("USB Device validation host tool %s\n", VERSION);
+
+  vid      = USBD_HOST_VID;
+  pid      = USBD_HOST_PID;
+  total    = TOTAL_BYTES_DEF;
+  duration = 0U;
+  multi    = 0U;
+  isoc     = 0U;
+  iso_size = ISO_PACKET_DEF;
+  size_num = 0U;
+  for (a = 1; a < argc; a++) {
+    if ((strcmp(argv[a], "-d") == 0) && ((a + 1) < argc)) {
+      if (sscanf(argv[++a], "%x:%x", &vid, &pid) != 2) { usage(); return 2; }
+    } else if ((strcmp(argv[a], "-n") == 0) && ((a + 1) < argc)) {
+      total = (uint32_t)strtoul(argv[++a], NULL, 0);
+    } else if (strcmp(argv[a], "-m") == 0) {
+      multi = 1U;
+    } else if (strcmp(argv[a], "-i") == 0) {
+      isoc = 1U;
+    } else if ((strcmp(argv[a], "-p") == 0) && ((a + 1) < argc)) {
+      iso_size = (uint32_t)strtoul(argv[++a], NULL, 0);
+    } else if ((strcmp(argv[a], "-t") == 0) && ((a + 1) < argc)) {
+      duration = (uint32_t)strtoul(argv[++a], NULL, 0);
+    } else if ((argv[a][0] >= '1') && (argv[a][0] <= '9') && (size_num < 32U)) {
+      sizes[size_num++] = (uint32_t)strtoul(argv[a], NULL, 0);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (duration == 0U) {
+    duration = (isoc != 0U) ? ISO_TIME_DEF : MULTI_TIME_DEF;
+  }
+  if (size_num == 0U) {
+    memcpy(sizes, size_def, sizeof(size_def));
+    size_num = sizeof(size_def) / sizeof(size_def[0]);
+  }
+  size_min = 0xFFFFFFFFU;
+  size_max = 0U;
+  for (i = 0U; i < size_num; i++) {
+    if (sizes[i] < size_min) { size_min = sizes[i]; }
+    if (sizes[i] > size_max) { size_max = sizes[i]; }
+  }
+
+  if (libusb_init(NULL) != 0) {
+    printf("libusb initialization failed\n");
+    return 1;
+  }
+
+  /* Wait until the device under test runs USBD_Bulk_Throughput */
+  printf("Waiting for device %04x:%04x ...\n", vid, pid);
+  for (i = 0U; (i < (OPEN_TIMEOUT * 10U)) && (dev == NULL); i++) {
+    dev = libusb_open_device_with_vid_pid(NULL, (uint16_t)vid, (uint16_t)pid);
+    if (dev == NULL) {
+      sleep_ms(100U);
+    }
+  }
+  if (dev == NULL) {
+    printf("Device not found\n");
+    libusb_exit(NULL);
+    return 1;
+  }
+  (void)libusb_set_auto_detach_kernel_driver(dev, 1);
+  if (libusb_claim_interface(dev, 0) != 0) {
+    printf("Claim interface failed\n");
+    libusb_close(dev);
+    libusb_exit(NULL);
+    return 1;
+  }
+
+  speed = libusb_get_device_speed(libusb_get_device(dev));
+  mps   = (uint16_t)libusb_get_max_packet_size(libusb_get_device(dev), EP_BULK_IN);
+  printf("Connected at %s speed, bulk max packet size %u bytes\n",
+         (speed == LIBUSB_SPEED_HIGH) ? "high" : ((speed == LIBUSB_SPEED_FULL) ? "full" : "other"), mps);
+
+  if (size_max < (ZLP_PACKETS * mps)) {
+    size_max = ZLP_PACKETS * mps;
+  }
+  if ((multi != 0U) && (size_max < (4U * MULTI_QUEUE * MULTI_BULK_SIZE))) {
+    /* One buffer per queued transfer */
+    size_max = 4U * MULTI_QUEUE * MULTI_BULK_SIZE;
+  }
+  if ((isoc != 0U) && (size_max < (2U * ISO_QUEUE * ISO_PACKETS * 1024U))) {
+    /* One buffer per queued transfer, packets up to 1024 bytes */
+    size_max = 2U * ISO_QUEUE * ISO_PACKETS * 1024U;
+  }
+  buf = malloc(size_max + mps);
+  lat = malloc(sizeof(double) * ((total / size_min) + 1U + ZLP_TRANSFERS));
+  if ((buf == NULL) || (lat == NULL)) {
+    printf("Out of memory\n");
+    return 1;
+  }
+
+  if (isoc != 0U) {
+    iso_run(duration, iso_size);
+  } else if (multi != 0U) {
+    for (i = 0U; i < (sizeof(mask_def) / sizeof(mask_def[0])); i++) {
+      multi_run(mask_def[i], duration);
+    }
+  } else {
+    for (i = 0U; i < size_num; i++) {
+      phase_run(PHASE_OUT, total, sizes[i]);
+      phase_run(PHASE_IN,  total, sizes[i]);
+    }
+    phase_run(PHASE_ZLP_OUT, ZLP_PACKETS * mps * ZLP_TRANSFERS, ZLP_PACKETS * mps);
+    phase_run(PHASE_ZLP_IN,  ZLP_PACKETS * mps * ZLP_TRANSFERS, ZLP_PACKETS * mps);
+  }
+
+  (void)libusb_control_transfer(dev, LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_DEVICE,
+                                VREQ_DONE, 0, 0, NULL, 0, CTRL_TIMEOUT);
+  printf("%s (%u errors)\n", (errors == 0U) ? "PASSED" : "FAILED", errors);
+
+  libusb_release_interface(dev, 0);
+  libusb_close(dev);
+  libusb_exit(NULL);
+  free(buf);
+  free(lat);
+  return (errors == 0U) ? 0 : 1;
+}